@@ -22,9 +22,10 @@ DeclareConstantBuffer(g_constantBuffer_frame, 0)
 };
 
 // Constant buffer draw call
+// This must match the declaration in the vertex shader
 DeclareConstantBuffer(g_constantBuffer_drawCall, 2)
 {
-	Matrix4 g_transform_localToWorld;
+	Matrix4 g_transforms_localToWorld[256];
 };
 
 
@@ -26,9 +26,10 @@ DeclareConstantBuffer(g_constantBuffer_frame, 0)
 };
 
 // Constant buffer draw call
+// One transform per instance, the size must match ConstantBufferFormats::g_maxInstanceCountPerDrawCall
 DeclareConstantBuffer(g_constantBuffer_drawCall, 2)
 {
-	Matrix4 g_transform_localToWorld;
+	Matrix4 g_transforms_localToWorld[256];
 };
 
 #if defined( EAE6320_PLATFORM_D3D )
@@ -57,6 +58,8 @@ layout( location = 1 ) in Vector4 i_vertexColor;
 
 layout( location = 0 ) out Vector4 vertexColor;
 
+#define i_instanceId gl_InstanceID
+
 // Output
 //=======
 // The vertex shader must always output a position value,
@@ -69,7 +72,7 @@ layout( location = 0 ) out Vector4 vertexColor;
 // Entry Point
 //============
 
-VertexMain(i_vertexPosition_local, o_vertexPosition_projected, i_vertexColor, vertexColor)
+VertexMain(i_vertexPosition_local, o_vertexPosition_projected, i_vertexColor, vertexColor, i_instanceId)
 {
 	// Transform the local vertex into world space
 	Vector4 vertexPosition_world;
@@ -77,7 +80,7 @@ VertexMain(i_vertexPosition_local, o_vertexPosition_projected, i_vertexColor, ve
 		// This will be done in a future assignment.
 		// For now, however, local space is treated as if it is the same as world space.
 		Vector4 vertexPosition_local = Vector4( i_vertexPosition_local, 1.0 );
-		vertexPosition_world = MatrixMul(g_transform_localToWorld, vertexPosition_local);
+		vertexPosition_world = MatrixMul(g_transforms_localToWorld[i_instanceId], vertexPosition_local);
 	}
 	// Calculate the position of this vertex projected onto the display
 	{
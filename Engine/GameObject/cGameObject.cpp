@@ -5,6 +5,7 @@
 #include <Engine/Concurrency/cEvent.h>
 #include <Engine/GameObject/cGameObject.h>
 #include <Engine/Graphics/Graphics.h>
+#include <Engine/Physics/Physics.h>
 
 #include <vector>
 #include <functional>
@@ -32,8 +33,6 @@ void eae6320::cGameObject::CleanUp()
 		m_effect.reset();
 	}
 
-	if (m_collider != nullptr) { delete m_collider; m_collider = nullptr; }
-
 	m_self.reset();
 }
 
@@ -71,12 +70,20 @@ void eae6320::cGameObject::InitializeCollider(const Physics::sColliderSetting& i
 eae6320::cGameObject::cGameObject()
 {
 	m_self = std::shared_ptr<cGameObject>(this);
+
+	// The rigid body is integrated by the physics system along with all other bodies
+	m_rigidBodyHandle = Physics::RegisterRigidBody(&m_rigidBody);
 }
 
 
 eae6320::cGameObject::~cGameObject()
 {
 	//CleanUp();
+
+	// A deregistered collider still gets its Exit events, the physics world holds on to this object until then
+	if (m_collider != nullptr) { delete m_collider; m_collider = nullptr; }
+
+	Physics::DeregisterRigidBody(m_rigidBodyHandle);
 }
 
 
@@ -107,6 +114,18 @@ std::weak_ptr<eae6320::Graphics::cEffect> eae6320::cGameObject::GetEffect() cons
 }
 
 
+eae6320::Graphics::cRenderHandle<eae6320::Graphics::cMesh> eae6320::cGameObject::GetMeshHandle() const
+{
+	return m_mesh ? m_mesh->GetHandle() : Graphics::cRenderHandle<Graphics::cMesh>();
+}
+
+
+eae6320::Graphics::cRenderHandle<eae6320::Graphics::cEffect> eae6320::cGameObject::GetEffectHandle() const
+{
+	return m_effect ? m_effect->GetHandle() : Graphics::cRenderHandle<Graphics::cEffect>();
+}
+
+
 eae6320::Physics::sRigidBodyState& eae6320::cGameObject::GetRigidBody()
 {
 	return m_rigidBody;
@@ -136,8 +155,7 @@ eae6320::Math::cMatrix_transformation eae6320::cGameObject::GetPredictedTransfor
 
 void eae6320::cGameObject::UpdateBasedOnTime(const float i_elapsedSecondCount_sinceLastUpdate)
 {
-	// Update rigid body 
-	m_rigidBody.Update(i_elapsedSecondCount_sinceLastUpdate);
+	// Rigid body is updated in batch by Physics::Update_Integration()
 }
 
 
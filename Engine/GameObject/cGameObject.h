@@ -8,6 +8,7 @@
 #include <Engine/Math/cMatrix_transformation.h>
 #include <Engine/Physics/cRigidBody.h>
 #include <Engine/Physics/cColliderBase.h>
+#include <Engine/Physics/cRigidBodyPool.h>
 #include <Engine/UserInput/UserInput.h>
 
 #include <memory>
@@ -50,6 +51,12 @@ namespace eae6320
 
 		std::weak_ptr<Graphics::cEffect> GetEffect() const;
 
+		// The handles that draw packets refer to the mesh and the effect by,
+		// invalid until the render thread has created them
+		Graphics::cRenderHandle<Graphics::cMesh> GetMeshHandle() const;
+
+		Graphics::cRenderHandle<Graphics::cEffect> GetEffectHandle() const;
+
 		Physics::sRigidBodyState& GetRigidBody();
 
 		Physics::cCollider* GetCollider() const;
@@ -81,6 +88,7 @@ namespace eae6320
 		std::shared_ptr<Graphics::cEffect> m_effect;
 
 		Physics::sRigidBodyState m_rigidBody;
+		Physics::sRigidBodyHandle m_rigidBodyHandle;
 		Physics::cCollider* m_collider = nullptr;
 
 	};
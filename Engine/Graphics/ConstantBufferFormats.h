@@ -16,10 +16,12 @@
 #include <Engine/Graphics/cLine.h>
 #include <Engine/Graphics/cMesh.h>
 #include <Engine/Graphics/Configuration.h>
+#include <Engine/Graphics/cRenderHandle.h>
 #include <Engine/Math/cMatrix_transformation.h>
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 
@@ -46,96 +48,85 @@ namespace ConstantBufferFormats
 	};
 
 
-	// Data for rendering an object 
+	// Data that is constant for every instance drawn by a draw call
+	// Meshes that are drawn several times with the same effect are drawn as instances of one draw call,
+	// each instance reads its transform by its instance ID. A draw call that isn't instanced uses the first one.
+	// The count must match the size of the array in the vertex shaders
+	// (256 transforms are 16KB, the smallest uniform block size that OpenGL guarantees)
+	constexpr uint32_t g_maxInstanceCountPerDrawCall = 256;
+	struct sDrawCall
+	{
+		Math::cMatrix_transformation g_transforms_localToWorld[g_maxInstanceCountPerDrawCall];
+	};
+
+
+	// Data for rendering an object
+	// Draw packets are plain data so that submitting a frame is a copy:
+	// the render objects are referred to by handles that the render thread resolves,
+	// and a handle whose object has been cleaned up since submission is skipped
 	struct sNormalRender
 	{
-		std::weak_ptr<cMesh> mesh;
-		std::weak_ptr<cEffect> effect;
+		cRenderHandle<cMesh> mesh;
+		cRenderHandle<cEffect> effect;
 		Math::cMatrix_transformation transform_localToWorld;
 
-		// Initialize / Clean Up
+		// Initialize
 		//----------------------
 
 		sNormalRender() = default;
-		~sNormalRender() = default;
 
-		sNormalRender(std::weak_ptr<cMesh> i_mesh, std::weak_ptr<cEffect> i_effect, Math::cMatrix_transformation i_transform) :
+		sNormalRender(const cRenderHandle<cMesh> i_mesh, const cRenderHandle<cEffect> i_effect, const Math::cMatrix_transformation& i_transform) :
 			mesh(i_mesh), effect(i_effect), transform_localToWorld(i_transform)
 		{ }
 
-		sNormalRender& operator= (sNormalRender& other)
-		{
-			mesh = other.mesh;
-			effect = other.effect;
-			transform_localToWorld = other.transform_localToWorld;
-			return *this;
-		}
-
-		void Initialize(std::weak_ptr<cMesh> i_mesh, std::weak_ptr<cEffect> i_effect, Math::cMatrix_transformation i_transform)
+		void Initialize(const cRenderHandle<cMesh> i_mesh, const cRenderHandle<cEffect> i_effect, const Math::cMatrix_transformation& i_transform)
 		{
 			mesh = i_mesh;
 			effect = i_effect;
 			transform_localToWorld = i_transform;
 		}
 
-		void CleanUp()
-		{
-			mesh.reset();
-			effect.reset();
-		}
-
 		// Implementation 
 		//----------------------
 
-		bool IsValid()
+		bool IsValid() const
 		{
-			return mesh.expired() == false && effect.expired() == false;
+			return mesh.IsValid() && effect.IsValid();
 		}
 	};
+	static_assert(std::is_trivially_copyable<sNormalRender>::value, "Draw packets must be plain data");
 
 
 	// Data for rendering debug information
 	struct sDebugRender
 	{
-		std::weak_ptr<cLine> line;
+		cRenderHandle<cLine> line;
 		Math::cMatrix_transformation transform;
 
-		// Initialize / Clean Up
+		// Initialize
 		//----------------------
 
 		sDebugRender() = default;
-		~sDebugRender() = default;
-
-		sDebugRender& operator= (sDebugRender& other)
-		{
-			line = other.line;
-			transform = other.transform;
-			return *this;
-		}
 
-		sDebugRender(std::weak_ptr<cLine> i_line, Math::cMatrix_transformation i_transform) :
+		sDebugRender(const cRenderHandle<cLine> i_line, const Math::cMatrix_transformation& i_transform) :
 			line(i_line), transform(i_transform)
 		{ }
 
-		void Initialize(std::weak_ptr<cLine> i_line, Math::cMatrix_transformation i_transform)
+		void Initialize(const cRenderHandle<cLine> i_line, const Math::cMatrix_transformation& i_transform)
 		{
 			line = i_line;
 			transform = i_transform;
 		}
 
-		void CleanUp()
-		{
-			line.reset();
-		}
-
 		// Implementation 
 		//----------------------
 
-		bool IsValid()
+		bool IsValid() const
 		{
-			return line.expired() == false;
+			return line.IsValid();
 		}
 	};
+	static_assert(std::is_trivially_copyable<sDebugRender>::value, "Draw packets must be plain data");
 
 
 }// Namespace ConstantBufferFormats
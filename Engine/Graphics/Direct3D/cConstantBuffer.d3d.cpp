@@ -39,6 +39,13 @@ void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t i_shaderTypesT
 
 void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
 {
+	Update( i_data, m_size );
+}
+
+void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data, const size_t i_size )
+{
+	EAE6320_ASSERT( i_size <= m_size );
+
 	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
 	EAE6320_ASSERT( direct3dImmediateContext );
 
@@ -80,7 +87,7 @@ void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
 		memoryToWriteTo = mappedSubResource.pData;
 	}
 	// Copy the new data to the memory that Direct3D has provided
-	memcpy( memoryToWriteTo, i_data, m_size );
+	memcpy( memoryToWriteTo, i_data, i_size );
 }
 
 // Initialize / Clean Up
@@ -0,0 +1,290 @@
+// Includes
+//=========
+
+#include "../cConstantBufferRing.h"
+
+#include "Includes.h"
+#include "../cShader.h"
+#include "../sContext.h"
+
+#include <algorithm>
+#include <d3d11_1.h>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <limits>
+
+// Static Data
+//============
+
+namespace
+{
+	// Direct3D 11.1 binds ranges of constant buffers in "constants", which are 16 bytes each,
+	// and both the first constant and the number of constants must be multiples of 16
+	constexpr size_t s_constantSize = 16;
+	constexpr size_t s_constantCountAlignment = 16;
+}
+
+// Interface
+//==========
+
+// Render
+//-------
+
+eae6320::cResult eae6320::Graphics::cConstantBufferRing::BeginFrame( const size_t i_size )
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+	EAE6320_ASSERT( m_mappedMemory == nullptr );
+
+	m_regionIndex = ( m_regionIndex + 1 ) % RegionCount;
+	m_mappedSize = 0;
+	m_writeOffset = 0;
+
+	if ( i_size > m_regionCapacity )
+	{
+		const auto result = Grow( std::max( i_size, m_regionCapacity * 2 ) );
+		if ( !result )
+		{
+			return result;
+		}
+	}
+	// Wait until the GPU has finished the last frame that read from the region
+	if ( m_isFenceIssued[m_regionIndex] )
+	{
+		m_isFenceIssued[m_regionIndex] = false;
+
+		HRESULT d3dResult;
+		constexpr UINT flushIfNotDone = 0;
+		while ( ( d3dResult = direct3dImmediateContext->GetData( m_fences[m_regionIndex], nullptr, 0, flushIfNotDone ) ) == S_FALSE )
+		{
+			// The GPU is at least two frames behind, which doesn't happen often and doesn't last long
+		}
+		if ( FAILED( d3dResult ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't wait for a constant buffer ring region (HRESULT %#010x)", d3dResult );
+			Logging::OutputError( "Direct3D failed to wait for the GPU to finish with a constant buffer ring region with HRESULT %#010x", d3dResult );
+			return Results::Failure;
+		}
+	}
+	if ( i_size == 0 )
+	{
+		return Results::Success;
+	}
+	// Map the buffer.
+	// The fence made sure that nothing is reading from the region anymore,
+	// and so Direct3D can be promised that nothing that is in use will be overwritten
+	{
+		D3D11_MAPPED_SUBRESOURCE mappedSubResource;
+		constexpr unsigned int noSubResources = 0;
+		const D3D11_MAP mapType = m_hasBeenMapped ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE_DISCARD;
+		constexpr unsigned int noFlags = 0;
+		const auto d3dResult = direct3dImmediateContext->Map( m_buffer, noSubResources, mapType, noFlags, &mappedSubResource );
+		if ( FAILED( d3dResult ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't map the constant buffer ring (HRESULT %#010x)", d3dResult );
+			Logging::OutputError( "Direct3D failed to map the constant buffer ring with HRESULT %#010x", d3dResult );
+			return Results::Failure;
+		}
+		m_hasBeenMapped = true;
+		// The whole buffer is mapped, but only the region is written to
+		m_mappedMemory = static_cast<uint8_t*>( mappedSubResource.pData ) + ( m_regionIndex * m_regionSize );
+		m_mappedSize = i_size;
+	}
+
+	return Results::Success;
+}
+
+void eae6320::Graphics::cConstantBufferRing::EndWrite()
+{
+	if ( m_mappedMemory == nullptr )
+	{
+		return;
+	}
+
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	constexpr unsigned int noSubResources = 0;
+	direct3dImmediateContext->Unmap( m_buffer, noSubResources );
+	m_mappedMemory = nullptr;
+}
+
+void eae6320::Graphics::cConstantBufferRing::Bind( const size_t i_offset, const uint_fast8_t i_shaderTypesToBindTo ) const
+{
+	EAE6320_ASSERT( m_direct3dImmediateContext1 );
+	EAE6320_ASSERT( m_buffer );
+	EAE6320_ASSERT( m_mappedMemory == nullptr );
+	EAE6320_ASSERT( ( i_offset % m_offsetAlignment ) == 0 );
+
+	// Each region has room to bind the whole constant data past its last write
+	const auto firstConstant = static_cast<unsigned int>( i_offset / s_constantSize );
+	const auto constantCount = static_cast<unsigned int>( m_bindSize / s_constantSize );
+	constexpr unsigned int bufferCount = 1;
+	if ( i_shaderTypesToBindTo & static_cast<decltype( i_shaderTypesToBindTo )>( eShaderType::Vertex ) )
+	{
+		m_direct3dImmediateContext1->VSSetConstantBuffers1( static_cast<unsigned int>( m_type ), bufferCount, &m_buffer,
+			&firstConstant, &constantCount );
+	}
+	if ( i_shaderTypesToBindTo & static_cast<decltype( i_shaderTypesToBindTo )>( eShaderType::Fragment ) )
+	{
+		m_direct3dImmediateContext1->PSSetConstantBuffers1( static_cast<unsigned int>( m_type ), bufferCount, &m_buffer,
+			&firstConstant, &constantCount );
+	}
+}
+
+void eae6320::Graphics::cConstantBufferRing::EndFrame()
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+	EAE6320_ASSERT( m_mappedMemory == nullptr );
+	EAE6320_ASSERT( !m_isFenceIssued[m_regionIndex] );
+
+	direct3dImmediateContext->End( m_fences[m_regionIndex] );
+	m_isFenceIssued[m_regionIndex] = true;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cConstantBufferRing::CleanUp()
+{
+	auto result = Results::Success;
+
+	EndWrite();
+	for ( unsigned int i = 0; i < RegionCount; i++ )
+	{
+		if ( m_fences[i] )
+		{
+			m_fences[i]->Release();
+			m_fences[i] = nullptr;
+		}
+		m_isFenceIssued[i] = false;
+	}
+	if ( m_buffer )
+	{
+		m_buffer->Release();
+		m_buffer = nullptr;
+	}
+	if ( m_direct3dImmediateContext1 )
+	{
+		m_direct3dImmediateContext1->Release();
+		m_direct3dImmediateContext1 = nullptr;
+	}
+	m_regionCapacity = m_regionSize = 0;
+
+	return result;
+}
+
+// Implementation
+//===============
+
+// Render
+//-------
+
+eae6320::cResult eae6320::Graphics::cConstantBufferRing::Grow( const size_t i_capacity )
+{
+	auto* const direct3dDevice = sContext::g_context.direct3dDevice;
+	EAE6320_ASSERT( direct3dDevice );
+
+	// Direct3D keeps the old buffer until the draw calls that use it have finished
+	if ( m_buffer )
+	{
+		m_buffer->Release();
+		m_buffer = nullptr;
+	}
+	m_regionCapacity = m_regionSize = 0;
+
+	const auto regionCapacity = GetAlignedSize( i_capacity );
+	const auto regionSize = GetAlignedSize( regionCapacity + m_bindSize );
+	if ( ( regionSize * RegionCount ) > std::numeric_limits<unsigned int>::max() )
+	{
+		EAE6320_ASSERTF( false, "The constant buffer ring can't grow to %u bytes per frame", regionCapacity );
+		Logging::OutputError( "The constant buffer ring is too large to fit into a D3D11_BUFFER_DESC" );
+		return Results::Failure;
+	}
+
+	const auto bufferDescription = [regionSize]
+	{
+		D3D11_BUFFER_DESC bufferDescription{};
+
+		// The byte width is a multiple of the offset alignment, and so also of 16
+		bufferDescription.ByteWidth = static_cast<unsigned int>( regionSize * RegionCount );
+		bufferDescription.Usage = D3D11_USAGE_DYNAMIC;	// The CPU must be able to update the buffer
+		bufferDescription.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		bufferDescription.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;	// The CPU must write, but doesn't read
+		bufferDescription.MiscFlags = 0;
+		bufferDescription.StructureByteStride = 0;	// Not used
+
+		return bufferDescription;
+	}();
+	const auto d3dResult = direct3dDevice->CreateBuffer( &bufferDescription, nullptr, &m_buffer );
+	if ( FAILED( d3dResult ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't grow the constant buffer ring (HRESULT %#010x)", d3dResult );
+		Logging::OutputError( "Direct3D failed to create a constant buffer ring with HRESULT %#010x", d3dResult );
+		return Results::Failure;
+	}
+	m_regionCapacity = regionCapacity;
+	m_regionSize = regionSize;
+
+	// Nothing is reading from the new buffer yet
+	m_hasBeenMapped = false;
+	for ( auto& isFenceIssued : m_isFenceIssued )
+	{
+		isFenceIssued = false;
+	}
+
+	return Results::Success;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cConstantBufferRing::Initialize_platformSpecific()
+{
+	auto* const direct3dDevice = sContext::g_context.direct3dDevice;
+	EAE6320_ASSERT( direct3dDevice );
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	// The driver must be able to bind a range of a constant buffer
+	// and to map a constant buffer without overwriting the ranges that are in use
+	{
+		D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+		const auto d3dResult = direct3dDevice->CheckFeatureSupport( D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof( options ) );
+		if ( FAILED( d3dResult ) || !options.ConstantBufferOffsetting || !options.MapNoOverwriteOnDynamicConstantBuffer )
+		{
+			Logging::OutputMessage( "The Direct3D driver doesn't support binding ranges of constant buffers" );
+			return Results::Failure;
+		}
+	}
+	{
+		const auto d3dResult = direct3dImmediateContext->QueryInterface( __uuidof( ID3D11DeviceContext1 ),
+			reinterpret_cast<void**>( &m_direct3dImmediateContext1 ) );
+		if ( FAILED( d3dResult ) )
+		{
+			Logging::OutputMessage( "The Direct3D runtime doesn't have a Direct3D 11.1 device context (HRESULT %#010x)", d3dResult );
+			return Results::Failure;
+		}
+	}
+	// Create a fence for each region
+	{
+		D3D11_QUERY_DESC queryDescription{};
+		queryDescription.Query = D3D11_QUERY_EVENT;
+		for ( auto& fence : m_fences )
+		{
+			const auto d3dResult = direct3dDevice->CreateQuery( &queryDescription, &fence );
+			if ( FAILED( d3dResult ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't create a constant buffer ring fence (HRESULT %#010x)", d3dResult );
+				Logging::OutputError( "Direct3D failed to create an event query with HRESULT %#010x", d3dResult );
+				return Results::Failure;
+			}
+		}
+	}
+	// The buffer is created by the first frame, once it is known how much is needed
+	m_offsetAlignment = s_constantSize * s_constantCountAlignment;
+	EAE6320_ASSERT( ( m_bindSize % m_offsetAlignment ) == 0 );
+
+	return Results::Success;
+}
@@ -143,7 +143,7 @@ eae6320::cResult eae6320::Graphics::cMesh::CleanUp()
 }
 
 
-void eae6320::Graphics::cMesh::Draw()
+void eae6320::Graphics::cMesh::Bind()
 {
 	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
 	EAE6320_ASSERT(direct3dImmediateContext);
@@ -183,14 +183,30 @@ void eae6320::Graphics::cMesh::Draw()
 		// (meaning that every primitive is a triangle and will be defined by three vertices)
 		direct3dImmediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	}
+}
+
+
+void eae6320::Graphics::cMesh::Draw(const uint32_t i_instanceCount)
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT(direct3dImmediateContext);
 
 	// Render triangles from the currently-bound vertex buffer
 	{
 		//// Old draw call to draw non-indexed, non-instanced primitives.
 		//direct3dImmediateContext->Draw(vertexCountToRender, indexOfFirstVertexToRender);
 
-		// new draw call to draw indexed, non-instanced primitives.
+		// new draw call to draw indexed primitives.
 		// It's possible to start rendering primitives in the middle of the stream
-		direct3dImmediateContext->DrawIndexed(static_cast<unsigned int>(m_indexCountToRender), m_indexOfFirstIndexToUse, m_offsetToAddToEachIndex);
+		if (i_instanceCount == 1)
+		{
+			direct3dImmediateContext->DrawIndexed(static_cast<unsigned int>(m_indexCountToRender), m_indexOfFirstIndexToUse, m_offsetToAddToEachIndex);
+		}
+		else
+		{
+			constexpr unsigned int indexOfFirstInstance = 0;
+			direct3dImmediateContext->DrawIndexedInstanced(static_cast<unsigned int>(m_indexCountToRender), static_cast<unsigned int>(i_instanceCount),
+				m_indexOfFirstIndexToUse, m_offsetToAddToEachIndex, indexOfFirstInstance);
+		}
 	}
 }
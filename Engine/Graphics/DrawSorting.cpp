@@ -0,0 +1,103 @@
+// Includes
+//=========
+
+#include <Engine/Graphics/DrawSorting.h>
+
+#include <Engine/Graphics/cRenderState.h>
+
+#include <cstring>
+#include <utility>
+
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// Non-negative floats order the same way as their bits, so the top 16 bits
+	// (8 of exponent and 8 of mantissa, the sign is always 0) keep the depth order to within a percent at any scale
+	uint64_t QuantizeDepth(const float i_depth);
+}
+
+
+// Interface
+//==========
+
+uint64_t eae6320::Graphics::DrawSorting::MakeSortKey(const uint8_t i_renderStateBits, const uint32_t i_effectId, const uint32_t i_meshId, const float i_depth)
+{
+	constexpr uint64_t idMask = 0xfffff;
+	constexpr uint64_t depthMask = 0xffff;
+
+	// The transparency bit decides the layer, the other state bits follow it
+	const bool isTranslucent = RenderStates::IsAlphaTransparencyEnabled(i_renderStateBits);
+	const uint64_t otherRenderStates = static_cast<uint64_t>((i_renderStateBits >> 1) & 0x7f);
+	const uint64_t effect = static_cast<uint64_t>(i_effectId) & idMask;
+	const uint64_t mesh = static_cast<uint64_t>(i_meshId) & idMask;
+	const uint64_t depth = QuantizeDepth(i_depth);
+
+	if (isTranslucent == false)
+		return (otherRenderStates << 56) | (effect << 36) | (mesh << 16) | depth;
+	else
+		return (uint64_t(1) << 63) | (otherRenderStates << 56) | ((depthMask - depth) << 40) | (effect << 20) | mesh;
+}
+
+
+void eae6320::Graphics::DrawSorting::Sort(std::vector<sDrawItem>& io_items, std::vector<sDrawItem>& io_scratch)
+{
+	constexpr unsigned int digitCount = sizeof(uint64_t);
+	constexpr unsigned int bucketCount = 256;
+
+	const size_t itemCount = io_items.size();
+	if (itemCount < 2)
+		return;
+
+	// Count every digit in a single pass over the keys
+	uint32_t histograms[digitCount][bucketCount];
+	std::memset(histograms, 0, sizeof(histograms));
+	for (const auto& item : io_items)
+	{
+		for (unsigned int digit = 0; digit < digitCount; digit++)
+			histograms[digit][(item.key >> (digit * 8)) & 0xff]++;
+	}
+
+	io_scratch.resize(itemCount);
+	for (unsigned int digit = 0; digit < digitCount; digit++)
+	{
+		uint32_t* const histogram = histograms[digit];
+
+		// When every key has the same byte here the pass wouldn't move anything
+		const unsigned int shift = digit * 8;
+		if (histogram[(io_items[0].key >> shift) & 0xff] == itemCount)
+			continue;
+
+		uint32_t offset = 0;
+		for (unsigned int bucket = 0; bucket < bucketCount; bucket++)
+		{
+			const uint32_t count = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += count;
+		}
+
+		for (const auto& item : io_items)
+			io_scratch[histogram[(item.key >> shift) & 0xff]++] = item;
+		std::swap(io_items, io_scratch);
+	}
+}
+
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	uint64_t QuantizeDepth(const float i_depth)
+	{
+		// Also catches NaN
+		if (!(i_depth > 0.0f))
+			return 0;
+
+		uint32_t bits;
+		std::memcpy(&bits, &i_depth, sizeof(bits));
+		return static_cast<uint64_t>(bits >> 15) & 0xffff;
+	}
+}
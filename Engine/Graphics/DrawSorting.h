@@ -0,0 +1,51 @@
+/*
+	Draw packets are sorted on the render thread by a 64 bit key
+	so that packets that share render state, an effect and a mesh are drawn one after another
+	and the state they share only has to be bound once
+
+	Opaque packets:
+		[63] 0 | [62..56] render state | [55..36] effect | [35..16] mesh | [15..0] depth, front to back
+	Translucent packets are drawn after every opaque one and have to be blended back to front,
+	so their depth comes before the effect and the mesh:
+		[63] 1 | [62..56] render state | [55..40] depth, back to front | [39..20] effect | [19..0] mesh
+*/
+
+#ifndef EAE6320_GRAPHICS_DRAWSORTING_H
+#define EAE6320_GRAPHICS_DRAWSORTING_H
+
+// Includes
+//=========
+
+#include <cstdint>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+namespace Graphics
+{
+namespace DrawSorting
+{
+	struct sDrawItem
+	{
+		uint64_t key;
+		// The index of the draw packet in the frame's submission array
+		uint32_t packetIndex;
+	};
+
+	// The effect and mesh ids are the indices of their render handles, which fit into 20 bits.
+	// The depth is the distance in front of the camera, anything behind it counts as 0
+	uint64_t MakeSortKey(const uint8_t i_renderStateBits, const uint32_t i_effectId, const uint32_t i_meshId, const float i_depth);
+
+	// A stable LSD radix sort on the keys, 8 bits per pass.
+	// Passes over a byte that every key shares are skipped, so a frame whose keys only differ
+	// in a few fields costs a few passes. io_scratch is resized as needed and can be reused every frame
+	void Sort(std::vector<sDrawItem>& io_items, std::vector<sDrawItem>& io_scratch);
+
+}// Namespace DrawSorting
+}// Namespace Graphics
+}// Namespace eae6320
+
+#endif	// EAE6320_GRAPHICS_DRAWSORTING_H
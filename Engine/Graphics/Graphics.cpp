@@ -6,16 +6,23 @@
 #include <Engine/Concurrency/cEvent.h>
 #include <Engine/Concurrency/cMutex.h>
 #include <Engine/Graphics/cConstantBuffer.h>
+#include <Engine/Graphics/cConstantBufferRing.h>
 #include <Engine/Graphics/cEffect.h>
 #include <Engine/Graphics/cMesh.h>
 #include <Engine/Graphics/ConstantBufferFormats.h>
+#include <Engine/Graphics/cRenderObjectTable.h>
 #include <Engine/Graphics/cView.h>
+#include <Engine/Graphics/DrawSorting.h>
 #include <Engine/Graphics/sContext.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/UserOutput/UserOutput.h>
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 
 
@@ -24,15 +31,16 @@
 
 namespace
 {
-	// Memory Budget
-	//-------------------------
-	constexpr uint32_t s_memoryBudget = 100;
-
-
 	// Constant buffer object
 	eae6320::Graphics::cConstantBuffer s_constantBuffer_frame(eae6320::Graphics::ConstantBufferTypes::Frame);
 	eae6320::Graphics::cConstantBuffer s_constantBuffer_drawCall(eae6320::Graphics::ConstantBufferTypes::DrawCall);
-	
+
+	// The transforms of every draw call of a frame are written to the ring at once
+	// and each draw call binds its range of it.
+	// When the platform can't bind ranges the draw call constant buffer is updated before each draw call instead
+	eae6320::Graphics::cConstantBufferRing s_constantBufferRing_drawCall(eae6320::Graphics::ConstantBufferTypes::DrawCall);
+	bool s_isConstantBufferRingUsable = false;
+
 
 	// Submission Data
 	//-------------------------
@@ -43,9 +51,17 @@ namespace
 	{
 		eae6320::Graphics::ConstantBufferFormats::sFrame constantData_frame;
 
-		eae6320::Graphics::ConstantBufferFormats::sNormalRender constantData_normalRender[s_memoryBudget];
+		// Only the first count entries of each array belong to the frame. The arrays keep the size of the busiest
+		// frame so far and are reused every frame, so a scene that doesn't grow submits without allocating
+		std::vector<eae6320::Graphics::ConstantBufferFormats::sNormalRender> constantData_normalRender;
+		uint32_t normalRenderCount = 0;
 
-		eae6320::Graphics::ConstantBufferFormats::sDebugRender constantData_debugRender[s_memoryBudget];
+		std::vector<eae6320::Graphics::ConstantBufferFormats::sDebugRender> constantData_debugRender;
+		uint32_t debugRenderCount = 0;
+
+		// Written by the render thread when it renders this data,
+		// so the application thread reads it after the data has been handed back for submission
+		eae6320::Graphics::sRenderStatistics statistics;
 
 		// Color data to clear the last frame (set background color for this frame)
 		// Black is usually used
@@ -115,6 +131,46 @@ namespace
 	eae6320::Concurrency::cMutex s_renderObjectCleanUpMutex;
 
 
+	// Render Objects
+	//-------------------------
+
+	// Every render object that has been created and not cleaned up yet, by the handle in the draw packets.
+	// They are only touched on the render thread
+	eae6320::Graphics::cRenderObjectTable<eae6320::Graphics::cMesh> s_meshes;
+	eae6320::Graphics::cRenderObjectTable<eae6320::Graphics::cEffect> s_effects;
+	eae6320::Graphics::cRenderObjectTable<eae6320::Graphics::cLine> s_lines;
+
+	// The loaded meshes and effects by the paths they were loaded from, so that they can be shared.
+	// An entry of an object that has been cleaned up stays until the path is loaded again
+	std::unordered_map<std::string, eae6320::Graphics::cRenderHandle<eae6320::Graphics::cMesh>> s_meshesByPath;
+	std::unordered_map<std::string, eae6320::Graphics::cRenderHandle<eae6320::Graphics::cEffect>> s_effectsByPaths;
+
+	// The normal draw packets of the frame being rendered in the order they are drawn in,
+	// kept between frames so that sorting doesn't allocate
+	std::vector<eae6320::Graphics::DrawSorting::sDrawItem> s_drawItems;
+	std::vector<eae6320::Graphics::DrawSorting::sDrawItem> s_drawItems_scratch;
+
+	// A draw call of the frame being rendered, which either draws instances of a mesh with an effect or a debug line
+	struct sDrawBatch
+	{
+		eae6320::Graphics::cEffect* effect = nullptr;
+		eae6320::Graphics::cMesh* mesh = nullptr;
+		eae6320::Graphics::cLine* line = nullptr;
+		// The index in s_drawItems of the first instance of a mesh, or the index of a line's debug packet
+		uint32_t firstPacket = 0;
+		uint32_t instanceCount = 0;
+		// Where the transforms of the instances are in the constant buffer ring
+		size_t constantOffset = 0;
+	};
+	std::vector<sDrawBatch> s_drawBatches;
+
+	// The transforms of the next draw call, and the ones that are in the draw call constant buffer.
+	// Only the first s_instanceCount_uploaded transforms of the buffer are defined
+	eae6320::Graphics::ConstantBufferFormats::sDrawCall s_constantData_drawCall;
+	eae6320::Graphics::ConstantBufferFormats::sDrawCall s_constantData_drawCall_uploaded;
+	uint32_t s_instanceCount_uploaded = 0;
+
+
 	// View Data
 	//-------------------------
 
@@ -129,6 +185,34 @@ namespace
 namespace
 {
 	eae6320::cResult InitializeViews(const eae6320::Graphics::sInitializationParameters& i_initializationParameters);
+
+	// Grow a submission array to at least i_count entries, at least doubling it so that a growing scene reallocates rarely
+	template <class tRenderData>
+	void ReserveSubmission(std::vector<tRenderData>& io_renderDataArray, uint32_t i_count);
+
+	// Append draw packets to a submission array
+	template <class tRenderData>
+	void AppendSubmission(std::vector<tRenderData>& io_renderDataArray, uint32_t& io_count, const tRenderData i_renderDataArray[], uint32_t i_count);
+
+	// Fill s_drawItems with the packets whose render objects still exist, sorted by their keys
+	void SortNormalRenderData(const sDataRequiredToRenderAFrame& i_frameData);
+
+	// Fill s_drawBatches with the draw calls of the sorted packets followed by those of the debug packets.
+	// A run of packets that share an effect and a mesh is drawn as instances of one draw call
+	void BatchDrawCalls(const sDataRequiredToRenderAFrame& i_frameData);
+
+	// Copy the transforms of a draw call's instances to o_transforms
+	void CopyTransforms(const sDataRequiredToRenderAFrame& i_frameData, const sDrawBatch& i_drawBatch, eae6320::Math::cMatrix_transformation* const o_transforms);
+
+	// Write the transforms of every draw call to the constant buffer ring and store where they went in the draw calls.
+	// Returns false if the ring couldn't be written to this frame
+	bool WriteDrawCallConstantsToRing(const sDataRequiredToRenderAFrame& i_frameData, eae6320::Graphics::sRenderStatistics& io_statistics);
+
+	// Upload the first i_instanceCount transforms of s_constantData_drawCall unless they are the ones that were uploaded last
+	void UpdateDrawCallConstants(const uint32_t i_instanceCount, eae6320::Graphics::sRenderStatistics& io_statistics);
+
+	// The key that identifies an effect by its shader paths
+	std::string GetEffectKey(const std::string& i_vertexShaderPath, const std::string& i_fragmentShaderPath);
 }
 
 
@@ -173,63 +257,53 @@ void eae6320::Graphics::SubmitCameraMatrices(
 
 eae6320::cResult eae6320::Graphics::SubmitNormalRenderData(
 	ConstantBufferFormats::sNormalRender i_normalDataArray[],
-	uint32_t i_normalDataCount = s_memoryBudget)
+	uint32_t i_normalDataCount)
 {
-	if (i_normalDataCount < 0 || s_memoryBudget < i_normalDataCount)
-	{
-		EAE6320_ASSERTF(false, "Mesh-effect data number exceeds memory budget limit: (%u)", s_memoryBudget);
-		Logging::OutputError("Mesh-effect data number exceeds memory budget limit: (%u)", s_memoryBudget);
-		UserOutput::Print("Mesh-effect data number exceeds memory budget limit: (%u)", s_memoryBudget);
+	EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread_frame);
+	auto& frameData = *s_dataBeingSubmittedByApplicationThread_frame;
 
-		return Results::Failure;
-	}
-	else
-	{
-		EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread_frame);
-		auto& constantData_normalRender = s_dataBeingSubmittedByApplicationThread_frame->constantData_normalRender;
+	// Appended after anything submitted earlier in the frame,
+	// entries without a mesh or an effect are skipped when the frame is rendered
+	AppendSubmission(frameData.constantData_normalRender, frameData.normalRenderCount, i_normalDataArray, i_normalDataCount);
 
-		for (uint32_t i = 0; i < i_normalDataCount; i++)
-		{
-			if (i_normalDataArray[i].IsValid())
-			{
-				constantData_normalRender[i].Initialize(
-					i_normalDataArray[i].mesh, i_normalDataArray[i].effect,
-					i_normalDataArray[i].transform_localToWorld);
-			}
-		}
-
-		return Results::Success;
-	}
+	return Results::Success;
 }
 
 
 eae6320::cResult eae6320::Graphics::SubmitDebugRenderData(
 	ConstantBufferFormats::sDebugRender i_debugDataArray[],
-	uint32_t i_debugDataCount = s_memoryBudget)
+	uint32_t i_debugDataCount)
 {
-	if (i_debugDataCount < 0 || s_memoryBudget < i_debugDataCount)
-	{
-		EAE6320_ASSERTF(false, "Mesh-effect data number exceeds memory budget limit: (%u)", s_memoryBudget);
-		Logging::OutputError("Mesh-effect data number exceeds memory budget limit: (%u)", s_memoryBudget);
-		UserOutput::Print("Mesh-effect data number exceeds memory budget limit: (%u)", s_memoryBudget);
+	EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread_frame);
+	auto& frameData = *s_dataBeingSubmittedByApplicationThread_frame;
 
-		return Results::Failure;
-	}
-	else
-	{
-		EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread_frame);
-		auto& constantData_debugRender = s_dataBeingSubmittedByApplicationThread_frame->constantData_debugRender;
+	AppendSubmission(frameData.constantData_debugRender, frameData.debugRenderCount, i_debugDataArray, i_debugDataCount);
 
-		for (uint32_t i = 0; i < i_debugDataCount; i++)
-		{
-			if (i_debugDataArray[i].IsValid())
-			{
-				constantData_debugRender[i].Initialize(i_debugDataArray[i].line, i_debugDataArray[i].transform);
-			}
-		}
+	return Results::Success;
+}
+
+
+eae6320::cResult eae6320::Graphics::SubmitInstancedRenderData(
+	const cRenderHandle<cMesh> i_mesh, const cRenderHandle<cEffect> i_effect,
+	const Math::cMatrix_transformation i_transforms[], uint32_t i_instanceCount)
+{
+	EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread_frame);
+	auto& frameData = *s_dataBeingSubmittedByApplicationThread_frame;
 
-		return Results::Success;
+	ReserveSubmission(frameData.constantData_normalRender, frameData.normalRenderCount + i_instanceCount);
+	for (uint32_t i = 0; i < i_instanceCount; i++)
+	{
+		frameData.constantData_normalRender[frameData.normalRenderCount++].Initialize(i_mesh, i_effect, i_transforms[i]);
 	}
+
+	return Results::Success;
+}
+
+
+eae6320::Graphics::sRenderStatistics eae6320::Graphics::GetRenderStatistics()
+{
+	EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread_frame);
+	return s_dataBeingSubmittedByApplicationThread_frame->statistics;
 }
 
 
@@ -259,7 +333,12 @@ void eae6320::Graphics::InitializeRenderObjects()
 				sMeshBuilder builder = s_meshInitializeQueue.front();
 				s_meshInitializeQueue.pop();
 
-				cMesh::Create(builder.meshPtr, builder.meshPath);
+				const auto sharedMesh = s_meshesByPath.find(builder.meshPath);
+				if ((sharedMesh != s_meshesByPath.end()) && s_meshes.AddUser(sharedMesh->second, builder.meshPtr))
+					continue;
+
+				if (cMesh::Create(builder.meshPtr, builder.meshPath))
+					s_meshesByPath[builder.meshPath] = s_meshes.Add(builder.meshPtr);
 			}
 		}
 		// Initialize effect objects
@@ -269,7 +348,13 @@ void eae6320::Graphics::InitializeRenderObjects()
 				sEffectBuilder builder = s_effectInitializeQueue.front();
 				s_effectInitializeQueue.pop();
 
-				cEffect::Create(builder.effectPtr, builder.vertexShaderPath, builder.fragmentShaderPath);
+				const auto key = GetEffectKey(builder.vertexShaderPath, builder.fragmentShaderPath);
+				const auto sharedEffect = s_effectsByPaths.find(key);
+				if ((sharedEffect != s_effectsByPaths.end()) && s_effects.AddUser(sharedEffect->second, builder.effectPtr))
+					continue;
+
+				if (cEffect::Create(builder.effectPtr, builder.vertexShaderPath, builder.fragmentShaderPath))
+					s_effectsByPaths[key] = s_effects.Add(builder.effectPtr);
 			}
 		}
 		// Initialize line objects
@@ -279,7 +364,8 @@ void eae6320::Graphics::InitializeRenderObjects()
 				sLineBuilder builder = s_lineInitializeQueue.front();
 				s_lineInitializeQueue.pop();
 
-				cLine::Create(builder.linePtr, builder.vertexData, builder.vertexCount, builder.indexData, builder.indexCount);
+				if (cLine::Create(builder.linePtr, builder.vertexData, builder.vertexCount, builder.indexData, builder.indexCount))
+					s_lines.Add(builder.linePtr);
 
 				delete[] builder.vertexData;
 				delete[] builder.indexData;
@@ -307,7 +393,9 @@ void eae6320::Graphics::CleanUpRenderObjects()
 				std::shared_ptr<cMesh> task = s_meshCleanUpQueue.front();
 				s_meshCleanUpQueue.pop();
 
-				EAE6320_ASSERT(task.use_count() <= 1);
+				// After its last user is gone the task holds the only reference, so the object is destroyed here
+				if (task && s_meshes.Release(task->GetHandle()))
+					EAE6320_ASSERT(task.use_count() <= 1);
 				task.reset();
 			}
 		}
@@ -318,7 +406,9 @@ void eae6320::Graphics::CleanUpRenderObjects()
 				std::shared_ptr<cEffect> task = s_effectCleanUpQueue.front();
 				s_effectCleanUpQueue.pop();
 
-				EAE6320_ASSERT(task.use_count() <= 1);
+				// After its last user is gone the task holds the only reference, so the object is destroyed here
+				if (task && s_effects.Release(task->GetHandle()))
+					EAE6320_ASSERT(task.use_count() <= 1);
 				task.reset();
 			}
 		}
@@ -329,7 +419,9 @@ void eae6320::Graphics::CleanUpRenderObjects()
 				std::shared_ptr<cLine> task = s_lineCleanUpQueue.front();
 				s_lineCleanUpQueue.pop();
 
-				EAE6320_ASSERT(task.use_count() <= 1);
+				// After its last user is gone the task holds the only reference, so the object is destroyed here
+				if (task && s_lines.Release(task->GetHandle()))
+					EAE6320_ASSERT(task.use_count() <= 1);
 				task.reset();
 			}
 		}
@@ -452,8 +544,6 @@ void eae6320::Graphics::RenderFrame()
 
 	EAE6320_ASSERT(s_dataBeingRenderedByRenderThread_frame);
 	auto& constantData_frame = s_dataBeingRenderedByRenderThread_frame->constantData_frame;
-	auto& constantData_normalRender = s_dataBeingRenderedByRenderThread_frame->constantData_normalRender;
-	auto& constantData_debugRender = s_dataBeingRenderedByRenderThread_frame->constantData_debugRender;
 
 	// Clear back buffer
 	{
@@ -465,36 +555,79 @@ void eae6320::Graphics::RenderFrame()
 		s_constantBuffer_frame.Update(&constantData_frame);
 	}
 
-	// Bind effects and draw meshes
-	{
-		for (int i = 0; i < s_memoryBudget; i++)
-		{
-			if (constantData_normalRender[i].IsValid())
-			{
-				s_constantBuffer_drawCall.Update(&constantData_normalRender[i].transform_localToWorld);
+	auto& statistics = s_dataBeingRenderedByRenderThread_frame->statistics;
+	statistics = sRenderStatistics();
 
-				if (constantData_normalRender[i].effect.expired() == false)
-					constantData_normalRender[i].effect.lock()->Bind();
+	// Bind effects and draw meshes and debug lines
+	{
+		SortNormalRenderData(*s_dataBeingRenderedByRenderThread_frame);
+		BatchDrawCalls(*s_dataBeingRenderedByRenderThread_frame);
 
-				if (constantData_normalRender[i].mesh.expired() == false)
-					constantData_normalRender[i].mesh.lock()->Draw();
-			}
+		const auto shaderTypes_drawCall = static_cast<uint_fast8_t>(eShaderType::Vertex) | static_cast<uint_fast8_t>(eShaderType::Fragment);
+		const bool areDrawCallConstantsInRing = s_isConstantBufferRingUsable
+			&& WriteDrawCallConstantsToRing(*s_dataBeingRenderedByRenderThread_frame, statistics);
+		if (!areDrawCallConstantsInRing)
+		{
+			// A range of the ring may still be bound from an earlier frame,
+			// and the draw call constant buffer may have been changed since it was last uploaded by this function
+			s_constantBuffer_drawCall.Bind(shaderTypes_drawCall);
+			s_instanceCount_uploaded = 0;
 		}
-	}
-
-	// Drawing debug lines of colliders
-	{
-		Math::cMatrix_transformation transform = Math::cMatrix_transformation();
 
-		for (int i = 0; i < s_memoryBudget; i++)
+		// Sorting puts the packets that share an effect and a mesh next to each other,
+		// so each of them is only bound when it differs from the one before
+		const cEffect* boundEffect = nullptr;
+		const cMesh* boundMesh = nullptr;
+		for (const auto& drawBatch : s_drawBatches)
 		{
-			if (constantData_debugRender[i].IsValid())
+			if (areDrawCallConstantsInRing)
+			{
+				s_constantBufferRing_drawCall.Bind(drawBatch.constantOffset, shaderTypes_drawCall);
+			}
+			else
 			{
-				s_constantBuffer_drawCall.Update(&constantData_debugRender[i].transform);
+				CopyTransforms(*s_dataBeingRenderedByRenderThread_frame, drawBatch, s_constantData_drawCall.g_transforms_localToWorld);
+				UpdateDrawCallConstants(drawBatch.instanceCount, statistics);
+			}
 
-				if (constantData_debugRender[i].line.expired() == false)
-					constantData_debugRender[i].line.lock()->Draw();
+			if (drawBatch.line)
+			{
+				drawBatch.line->Draw();
 			}
+			else
+			{
+				if (drawBatch.effect != boundEffect)
+				{
+					drawBatch.effect->Bind();
+					boundEffect = drawBatch.effect;
+					statistics.effectBindCount++;
+				}
+				else
+				{
+					statistics.effectBindsAvoided++;
+				}
+
+				if (drawBatch.mesh != boundMesh)
+				{
+					drawBatch.mesh->Bind();
+					boundMesh = drawBatch.mesh;
+					statistics.meshBindCount++;
+				}
+				else
+				{
+					statistics.meshBindsAvoided++;
+				}
+
+				drawBatch.mesh->Draw(drawBatch.instanceCount);
+			}
+			statistics.drawCount++;
+			statistics.instanceCount += drawBatch.instanceCount;
+		}
+
+		// The ring's region can be written to again once the GPU has finished these draw calls
+		if (areDrawCallConstantsInRing)
+		{
+			s_constantBufferRing_drawCall.EndFrame();
 		}
 	}
 
@@ -504,18 +637,10 @@ void eae6320::Graphics::RenderFrame()
 	}
 
 	// After all of the data that was submitted for this frame has been used
-	// you must make sure that it is all cleaned up and cleared out
-	// so that the struct can be re-used (i.e. so that data for a new frame can be submitted to it)
-	// We only need to clean up the mesh-effect pair data after each frame is rendered.
-	// Because the draw-call data for an old mesh-effect pair will be overwirte by the data form new 
-	// mesh-effect pair. Other old draw-call data won't be add to the buffer bacause its corresponding 
-	// mesh-effect pair is not exist.
-	{
-		for (int i = 0; i < s_memoryBudget; i++)
-		{
-			constantData_normalRender[i].CleanUp();
-			constantData_debugRender[i].CleanUp();
-		}
+	// it must be cleared out so that the struct can be re-used (i.e. so that data for a new frame can be submitted to it)
+	{
+		s_dataBeingRenderedByRenderThread_frame->normalRenderCount = 0;
+		s_dataBeingRenderedByRenderThread_frame->debugRenderCount = 0;
 	}
 
 }
@@ -560,6 +685,14 @@ eae6320::cResult eae6320::Graphics::Initialize(const sInitializationParameters&
 			EAE6320_ASSERTF(false, "Can't initialize Graphics without draw call constant buffer");
 			return result;
 		}
+
+		// Graphics works without the ring, just slower
+		s_isConstantBufferRingUsable = s_constantBufferRing_drawCall.Initialize();
+		if (!s_isConstantBufferRingUsable)
+		{
+			Logging::OutputMessage("The draw call constant buffer will be updated before every draw call");
+			s_constantBufferRing_drawCall.CleanUp();
+		}
 	}
 	// Initialize the events
 	{
@@ -608,6 +741,13 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 
 	{
 		CleanUpRenderObjects();
+
+		// Anything that is still alive is released by whoever else holds it
+		s_meshes.Clear();
+		s_effects.Clear();
+		s_lines.Clear();
+		s_meshesByPath.clear();
+		s_effectsByPaths.clear();
 	}
 
 	// view clean up
@@ -615,34 +755,6 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 		result = s_view.CleanUp();
 	}
 
-	// Constant data in constant buffer clean up
-	{
-		// Submitted data clean up
-		{
-			EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread_frame);
-			auto& submitted_normalRender = s_dataBeingSubmittedByApplicationThread_frame->constantData_normalRender;
-			auto& submitted_debugRender = s_dataBeingSubmittedByApplicationThread_frame->constantData_debugRender;
-
-			for (int i = 0; i < s_memoryBudget; i++)
-			{
-				submitted_normalRender[i].CleanUp();
-				submitted_debugRender[i].CleanUp();
-			}
-		}
-		//	Render data clean up 
-		{
-			EAE6320_ASSERT(s_dataBeingRenderedByRenderThread_frame);
-			auto& renderData_normalRender = s_dataBeingRenderedByRenderThread_frame->constantData_normalRender;
-			auto& renderData_debugRender = s_dataBeingRenderedByRenderThread_frame->constantData_debugRender;
-
-			for (int i = 0; i < s_memoryBudget; i++)
-			{
-				renderData_normalRender[i].CleanUp();
-				renderData_debugRender[i].CleanUp();
-			}
-		}
-
-	}
 	// Constant buffers clean up
 	{
 		const auto result_constantBuffer_frame = s_constantBuffer_frame.CleanUp();
@@ -663,6 +775,16 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 				result = result_constantBuffer_drawCall;
 			}
 		}
+		const auto result_constantBufferRing_drawCall = s_constantBufferRing_drawCall.CleanUp();
+		if (!result_constantBufferRing_drawCall)
+		{
+			EAE6320_ASSERT(false);
+			if (result)
+			{
+				result = result_constantBufferRing_drawCall;
+			}
+		}
+		s_isConstantBufferRingUsable = false;
 	}
 
 	{
@@ -692,4 +814,144 @@ namespace
 		// view initialize
 		return s_view.Initialize(i_initializationParameters);
 	}
+
+	template <class tRenderData>
+	void ReserveSubmission(std::vector<tRenderData>& io_renderDataArray, uint32_t i_count)
+	{
+		if (io_renderDataArray.size() < i_count)
+			io_renderDataArray.resize(std::max<size_t>(i_count, io_renderDataArray.size() * 2));
+	}
+
+	void SortNormalRenderData(const sDataRequiredToRenderAFrame& i_frameData)
+	{
+		// Depth is the distance along the camera's forward direction, which is its -Z axis
+		const auto& transform_worldToCamera = i_frameData.constantData_frame.g_transform_worldToCamera;
+
+		s_drawItems.clear();
+		for (uint32_t i = 0; i < i_frameData.normalRenderCount; i++)
+		{
+			// Render objects may have been cleaned up since they were submitted,
+			// in which case their handles no longer resolve
+			const auto& renderData = i_frameData.constantData_normalRender[i];
+			const auto* const effect = s_effects.Get(renderData.effect);
+			if ((effect == nullptr) || (s_meshes.Get(renderData.mesh) == nullptr))
+				continue;
+
+			const float depth = -(transform_worldToCamera * renderData.transform_localToWorld.GetTranslation()).z;
+			const uint64_t key = eae6320::Graphics::DrawSorting::MakeSortKey(effect->GetRenderStateBits(),
+				static_cast<uint32_t>(renderData.effect.GetIndex()), static_cast<uint32_t>(renderData.mesh.GetIndex()), depth);
+			s_drawItems.push_back({ key, i });
+		}
+
+		eae6320::Graphics::DrawSorting::Sort(s_drawItems, s_drawItems_scratch);
+	}
+
+	void BatchDrawCalls(const sDataRequiredToRenderAFrame& i_frameData)
+	{
+		s_drawBatches.clear();
+
+		const auto drawItemCount = static_cast<uint32_t>(s_drawItems.size());
+		for (uint32_t firstDrawItem = 0; firstDrawItem < drawItemCount; )
+		{
+			const auto& firstRenderData = i_frameData.constantData_normalRender[s_drawItems[firstDrawItem].packetIndex];
+
+			sDrawBatch drawBatch;
+			drawBatch.effect = s_effects.Get(firstRenderData.effect);
+			drawBatch.mesh = s_meshes.Get(firstRenderData.mesh);
+			EAE6320_ASSERT(drawBatch.effect && drawBatch.mesh);
+			drawBatch.firstPacket = firstDrawItem;
+			for (uint32_t i = firstDrawItem; (i < drawItemCount) && (drawBatch.instanceCount < eae6320::Graphics::ConstantBufferFormats::g_maxInstanceCountPerDrawCall); i++)
+			{
+				const auto& renderData = i_frameData.constantData_normalRender[s_drawItems[i].packetIndex];
+				if ((renderData.effect != firstRenderData.effect) || (renderData.mesh != firstRenderData.mesh))
+					break;
+				drawBatch.instanceCount++;
+			}
+			firstDrawItem += drawBatch.instanceCount;
+
+			s_drawBatches.push_back(drawBatch);
+		}
+
+		for (uint32_t i = 0; i < i_frameData.debugRenderCount; i++)
+		{
+			// Render objects may have been cleaned up since they were submitted,
+			// in which case their handles no longer resolve
+			if (auto* const line = s_lines.Get(i_frameData.constantData_debugRender[i].line))
+			{
+				sDrawBatch drawBatch;
+				drawBatch.line = line;
+				drawBatch.firstPacket = i;
+				drawBatch.instanceCount = 1;
+				s_drawBatches.push_back(drawBatch);
+			}
+		}
+	}
+
+	void CopyTransforms(const sDataRequiredToRenderAFrame& i_frameData, const sDrawBatch& i_drawBatch, eae6320::Math::cMatrix_transformation* const o_transforms)
+	{
+		if (i_drawBatch.line)
+		{
+			o_transforms[0] = i_frameData.constantData_debugRender[i_drawBatch.firstPacket].transform;
+			return;
+		}
+
+		for (uint32_t i = 0; i < i_drawBatch.instanceCount; i++)
+			o_transforms[i] = i_frameData.constantData_normalRender[s_drawItems[i_drawBatch.firstPacket + i].packetIndex].transform_localToWorld;
+	}
+
+	bool WriteDrawCallConstantsToRing(const sDataRequiredToRenderAFrame& i_frameData, eae6320::Graphics::sRenderStatistics& io_statistics)
+	{
+		// Only the transforms of the instances are written, not the whole array
+		size_t size = 0;
+		for (const auto& drawBatch : s_drawBatches)
+			size += s_constantBufferRing_drawCall.GetAlignedSize(sizeof(eae6320::Math::cMatrix_transformation) * drawBatch.instanceCount);
+		if (!s_constantBufferRing_drawCall.BeginFrame(size))
+			return false;
+
+		for (auto& drawBatch : s_drawBatches)
+		{
+			void* const memory = s_constantBufferRing_drawCall.Allocate(
+				sizeof(eae6320::Math::cMatrix_transformation) * drawBatch.instanceCount, drawBatch.constantOffset);
+			CopyTransforms(i_frameData, drawBatch, static_cast<eae6320::Math::cMatrix_transformation*>(memory));
+			io_statistics.drawCallConstantUpdateCount++;
+		}
+
+		s_constantBufferRing_drawCall.EndWrite();
+		return true;
+	}
+
+	void UpdateDrawCallConstants(const uint32_t i_instanceCount, eae6320::Graphics::sRenderStatistics& io_statistics)
+	{
+		EAE6320_ASSERT((i_instanceCount > 0) && (i_instanceCount <= eae6320::Graphics::ConstantBufferFormats::g_maxInstanceCountPerDrawCall));
+
+		// Only the transforms of the instances are uploaded, not the whole array
+		const size_t size = sizeof(eae6320::Math::cMatrix_transformation) * i_instanceCount;
+		if ((i_instanceCount == s_instanceCount_uploaded) && (std::memcmp(&s_constantData_drawCall, &s_constantData_drawCall_uploaded, size) == 0))
+		{
+			io_statistics.drawCallConstantUpdatesAvoided++;
+			return;
+		}
+
+		s_constantBuffer_drawCall.Update(&s_constantData_drawCall, size);
+		std::memcpy(&s_constantData_drawCall_uploaded, &s_constantData_drawCall, size);
+		s_instanceCount_uploaded = i_instanceCount;
+		io_statistics.drawCallConstantUpdateCount++;
+	}
+
+	std::string GetEffectKey(const std::string& i_vertexShaderPath, const std::string& i_fragmentShaderPath)
+	{
+		// A path can't contain a line break
+		return i_vertexShaderPath + '\n' + i_fragmentShaderPath;
+	}
+
+	template <class tRenderData>
+	void AppendSubmission(std::vector<tRenderData>& io_renderDataArray, uint32_t& io_count, const tRenderData i_renderDataArray[], uint32_t i_count)
+	{
+		if (i_count == 0)
+			return;
+
+		ReserveSubmission(io_renderDataArray, io_count + i_count);
+		std::memcpy(io_renderDataArray.data() + io_count, i_renderDataArray, sizeof(tRenderData) * i_count);
+		io_count += i_count;
+	}
 }
@@ -52,6 +52,9 @@ namespace Graphics
 		Math::cMatrix_transformation i_transform_cameraToProjectedMatrix);
 
 
+	// The render data functions below append to whatever was submitted earlier in the frame,
+	// so they can be called any number of times and there is no limit on the count
+
 	eae6320::cResult SubmitNormalRenderData(
 		ConstantBufferFormats::sNormalRender i_normalDataArray[],
 		uint32_t i_normalDataCount);
@@ -61,6 +64,13 @@ namespace Graphics
 		ConstantBufferFormats::sDebugRender i_debugDataArray[],
 		uint32_t i_debugDataCount);
 
+	// Draw one mesh with one effect at each of the transforms.
+	// Packets that share a mesh and an effect are drawn as instances of one draw call however they were submitted,
+	// this just saves building a normal render data entry per transform
+	eae6320::cResult SubmitInstancedRenderData(
+		const cRenderHandle<cMesh> i_mesh, const cRenderHandle<cEffect> i_effect,
+		const Math::cMatrix_transformation i_transforms[], uint32_t i_instanceCount);
+
 
 	// When the application is ready to submit data for a new frame
 	// it should call this before submitting anything
@@ -86,6 +96,8 @@ namespace Graphics
 
 	void InitializeRenderObjects();
 
+	// Meshes and effects are shared: a task for a path (or pair of shader paths) that is already loaded
+	// gets the existing object, which is what lets identical objects be drawn as instances of one draw call
 	void AddMeshInitializeTask(std::shared_ptr<cMesh>& i_meshPtr, const std::string& i_meshPath);
 
 	void AddEffectInitializeTask(std::shared_ptr<cEffect>& i_effectPtr, const std::string& i_vertexShaderPath, const std::string& i_fragmentShaderPath);
@@ -104,6 +116,34 @@ namespace Graphics
 	void AddLineCleanUpTask(std::shared_ptr<cLine> i_line);
 
 
+	// Statistics
+	//-----------
+
+	// How much binding the render thread avoided by drawing the packets in sorted order
+	struct sRenderStatistics
+	{
+		// Draw calls, and the objects they drew (more than one per draw call when instancing)
+		uint32_t drawCount = 0;
+		uint32_t instanceCount = 0;
+
+		uint32_t effectBindCount = 0;
+		uint32_t effectBindsAvoided = 0;
+
+		uint32_t meshBindCount = 0;
+		uint32_t meshBindsAvoided = 0;
+
+		// When the draw call constants are written to the constant buffer ring every draw call writes its own range,
+		// so updates are only avoided when the draw call constant buffer is updated before each draw call
+		uint32_t drawCallConstantUpdateCount = 0;
+		uint32_t drawCallConstantUpdatesAvoided = 0;
+	};
+
+	// This should be called from the application loop thread after WaitUntilDataForANewFrameCanBeSubmitted().
+	// It returns the statistics of the last frame that was rendered from the data being submitted to,
+	// which is two frames behind the one being submitted
+	sRenderStatistics GetRenderStatistics();
+
+
 	// Render
 	//-------
 
@@ -24,8 +24,14 @@ void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t ) const
 }
 
 void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
+{
+	Update( i_data, m_size );
+}
+
+void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data, const size_t i_size )
 {
 	EAE6320_ASSERT( m_bufferId != 0 );
+	EAE6320_ASSERT( i_size <= m_size );
 
 	// Make the uniform buffer active
 	{
@@ -35,7 +41,7 @@ void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
 	// Copy the updated memory to the GPU
 	{
 		GLintptr updateAtTheBeginning = 0;
-		glBufferSubData( GL_UNIFORM_BUFFER, updateAtTheBeginning, static_cast<GLsizeiptr>( m_size ), i_data );
+		glBufferSubData( GL_UNIFORM_BUFFER, updateAtTheBeginning, static_cast<GLsizeiptr>( i_size ), i_data );
 		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
 	}
 }
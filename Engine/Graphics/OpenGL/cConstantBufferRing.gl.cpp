@@ -0,0 +1,238 @@
+// Includes
+//=========
+
+#include "../cConstantBufferRing.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Interface
+//==========
+
+// Render
+//-------
+
+eae6320::cResult eae6320::Graphics::cConstantBufferRing::BeginFrame( const size_t i_size )
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+	EAE6320_ASSERT( m_mappedMemory == nullptr );
+
+	m_regionIndex = ( m_regionIndex + 1 ) % RegionCount;
+	m_mappedSize = 0;
+	m_writeOffset = 0;
+
+	if ( i_size > m_regionCapacity )
+	{
+		const auto result = Grow( std::max( i_size, m_regionCapacity * 2 ) );
+		if ( !result )
+		{
+			return result;
+		}
+	}
+	// Wait until the GPU has finished the last frame that read from the region
+	if ( auto& fence = m_fences[m_regionIndex] )
+	{
+		// The fence's commands must be flushed once, or it may never be signaled
+		GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		constexpr GLuint64 timeout_nanoseconds = 1000000000;
+		GLenum waitResult;
+		while ( ( waitResult = glClientWaitSync( fence, flags, timeout_nanoseconds ) ) == GL_TIMEOUT_EXPIRED )
+		{
+			flags = 0;
+		}
+		glDeleteSync( fence );
+		fence = nullptr;
+		if ( waitResult == GL_WAIT_FAILED )
+		{
+			const auto errorCode = glGetError();
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to wait for the GPU to finish with a constant buffer ring region: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return Results::Failure;
+		}
+	}
+	if ( i_size == 0 )
+	{
+		return Results::Success;
+	}
+	// Map the region.
+	// The fence made sure that nothing is reading from it anymore,
+	// and so OpenGL doesn't have to synchronize or keep its old contents
+	{
+		glBindBuffer( GL_UNIFORM_BUFFER, m_bufferId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+
+		constexpr GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+		auto* const mappedMemory = glMapBufferRange( GL_UNIFORM_BUFFER,
+			static_cast<GLintptr>( m_regionIndex * m_regionSize ), static_cast<GLsizeiptr>( i_size ), access );
+		if ( mappedMemory == nullptr )
+		{
+			const auto errorCode = glGetError();
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to map the constant buffer ring %u: %s",
+				m_bufferId, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return Results::Failure;
+		}
+		m_mappedMemory = static_cast<uint8_t*>( mappedMemory );
+		m_mappedSize = i_size;
+	}
+
+	return Results::Success;
+}
+
+void eae6320::Graphics::cConstantBufferRing::EndWrite()
+{
+	if ( m_mappedMemory == nullptr )
+	{
+		return;
+	}
+
+	glBindBuffer( GL_UNIFORM_BUFFER, m_bufferId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	// The contents can (rarely) be lost while the buffer is mapped,
+	// in which case this frame's draw calls use undefined constant data
+	if ( glUnmapBuffer( GL_UNIFORM_BUFFER ) == GL_FALSE )
+	{
+		Logging::OutputError( "The contents of the constant buffer ring %u were lost while it was mapped", m_bufferId );
+	}
+	m_mappedMemory = nullptr;
+}
+
+void eae6320::Graphics::cConstantBufferRing::Bind( const size_t i_offset, const uint_fast8_t ) const
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+	EAE6320_ASSERT( m_mappedMemory == nullptr );
+	EAE6320_ASSERT( ( i_offset % m_offsetAlignment ) == 0 );
+
+	// A uniform block must be backed by at least its whole size,
+	// which is why each region has room to bind that much past its last write.
+	// (Just like for cConstantBuffer the shader types aren't used)
+	glBindBufferRange( GL_UNIFORM_BUFFER, static_cast<GLuint>( m_type ), m_bufferId,
+		static_cast<GLintptr>( i_offset ), static_cast<GLsizeiptr>( m_bindSize ) );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+}
+
+void eae6320::Graphics::cConstantBufferRing::EndFrame()
+{
+	EAE6320_ASSERT( m_mappedMemory == nullptr );
+
+	auto& fence = m_fences[m_regionIndex];
+	EAE6320_ASSERT( fence == nullptr );
+	constexpr GLbitfield noFlags = 0;
+	fence = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, noFlags );
+	EAE6320_ASSERT( fence != nullptr );
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cConstantBufferRing::CleanUp()
+{
+	auto result = Results::Success;
+
+	EndWrite();
+	for ( auto& fence : m_fences )
+	{
+		if ( fence )
+		{
+			glDeleteSync( fence );
+			fence = nullptr;
+		}
+	}
+	if ( m_bufferId != 0 )
+	{
+		constexpr GLsizei bufferCount = 1;
+		glDeleteBuffers( bufferCount, &m_bufferId );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to delete the constant buffer ring: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		}
+		m_bufferId = 0;
+	}
+	m_regionCapacity = m_regionSize = 0;
+
+	return result;
+}
+
+// Implementation
+//===============
+
+// Render
+//-------
+
+eae6320::cResult eae6320::Graphics::cConstantBufferRing::Grow( const size_t i_capacity )
+{
+	m_regionCapacity = GetAlignedSize( i_capacity );
+	m_regionSize = GetAlignedSize( m_regionCapacity + m_bindSize );
+
+	// Allocating new storage orphans the old one,
+	// which OpenGL keeps until the draw calls that use it have finished
+	glBindBuffer( GL_UNIFORM_BUFFER, m_bufferId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	constexpr GLenum usage = GL_STREAM_DRAW;	// The buffer is written once per frame and used to draw
+	glBufferData( GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>( m_regionSize * RegionCount ), nullptr, usage );
+	const auto errorCode = glGetError();
+	if ( errorCode != GL_NO_ERROR )
+	{
+		m_regionCapacity = m_regionSize = 0;
+		EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		Logging::OutputError( "OpenGL failed to grow the constant buffer ring %u: %s",
+			m_bufferId, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		return Results::Failure;
+	}
+
+	// Nothing is reading from the new storage yet
+	for ( auto& fence : m_fences )
+	{
+		if ( fence )
+		{
+			glDeleteSync( fence );
+			fence = nullptr;
+		}
+	}
+
+	return Results::Success;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cConstantBufferRing::Initialize_platformSpecific()
+{
+	// Binding a range is part of core OpenGL since uniform buffers are,
+	// but the implementation decides how its offsets must be aligned
+	{
+		GLint offsetAlignment = 0;
+		glGetIntegerv( GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to get the uniform buffer offset alignment: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return Results::Failure;
+		}
+		m_offsetAlignment = static_cast<size_t>( std::max( offsetAlignment, 1 ) );
+	}
+	// Get a buffer ID.
+	// Its storage is allocated by the first frame, once it is known how much is needed
+	{
+		constexpr GLsizei bufferCount = 1;
+		glGenBuffers( bufferCount, &m_bufferId );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to get an unused uniform buffer ID for a constant buffer ring: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return Results::Failure;
+		}
+	}
+
+	return Results::Success;
+}
@@ -295,15 +295,19 @@ eae6320::cResult eae6320::Graphics::cMesh::CleanUp()
 }
 
 
-void eae6320::Graphics::cMesh::Draw()
+void eae6320::Graphics::cMesh::Bind()
 {
-	// Draw mesh. Bind a specific vertex buffer and index buffer to the device as a data source
+	// Bind a specific vertex buffer and index buffer to the device as a data source
 	{
 		EAE6320_ASSERT(m_vertexArrayId != 0);
 		glBindVertexArray(m_vertexArrayId);
 		EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
 	}
+}
+
 
+void eae6320::Graphics::cMesh::Draw(const uint32_t i_instanceCount)
+{
 	// Render triangles from the currently-bound vertex buffer
 	{
 		// The mode defines how to interpret multiple vertices as a single "primitive";
@@ -312,7 +316,10 @@ void eae6320::Graphics::cMesh::Draw()
 		constexpr GLenum mode = GL_TRIANGLES;
 		// It's possible to start rendering primitives in the middle of the stream
 		const GLvoid* const offset = 0;
-		glDrawElements(mode, static_cast<GLsizei>(m_indexCountToRender), GL_UNSIGNED_SHORT, offset);
+		if (i_instanceCount == 1)
+			glDrawElements(mode, static_cast<GLsizei>(m_indexCountToRender), GL_UNSIGNED_SHORT, offset);
+		else
+			glDrawElementsInstanced(mode, static_cast<GLsizei>(m_indexCountToRender), GL_UNSIGNED_SHORT, offset, static_cast<GLsizei>(i_instanceCount));
 		EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
 	}
 } 
\ No newline at end of file
@@ -66,6 +66,7 @@ namespace Graphics
 		//	* Draw Call:
 		//		* These are values that are associated with a specific draw call
 		//		* The constant buffer must be updated and bound for every draw call that is made
+		//			(an instanced draw call has one set of values per instance)
 		DrawCall = 2,
 
 		Count,
@@ -102,6 +103,9 @@ namespace Graphics
 		// The specified data must be the appropriate Graphics::ConstantBufferFormats struct corresponding to this constant buffer's type!
 		// This function only needs to be called when the constant data that the GPU is using needs to change.
 		void Update( const void* const i_data );
+		// Only copies the first i_size bytes, for constant data whose tail isn't used by the next draw call
+		// (the rest of the buffer's contents are undefined afterwards)
+		void Update( const void* const i_data, const size_t i_size );
 
 		// Initialize / Clean Up
 		//----------------------
@@ -0,0 +1,71 @@
+// Includes
+//=========
+
+#include "cConstantBufferRing.h"
+
+#include "ConstantBufferFormats.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Math/Functions.h>
+
+// Interface
+//==========
+
+// Render
+//-------
+
+size_t eae6320::Graphics::cConstantBufferRing::GetAlignedSize( const size_t i_size ) const
+{
+	EAE6320_ASSERT( m_offsetAlignment > 0 );
+	return Math::RoundUpToMultiple( i_size, m_offsetAlignment );
+}
+
+void* eae6320::Graphics::cConstantBufferRing::Allocate( const size_t i_size, size_t& o_offset )
+{
+	EAE6320_ASSERT( m_mappedMemory );
+	EAE6320_ASSERT( i_size <= m_bindSize );
+
+	const auto offsetInRegion = m_writeOffset;
+	m_writeOffset += GetAlignedSize( i_size );
+	EAE6320_ASSERTF( m_writeOffset <= m_mappedSize,
+		"More constant data (%u bytes) was written than BeginFrame() was told about (%u bytes)", m_writeOffset, m_mappedSize );
+
+	o_offset = ( m_regionIndex * m_regionSize ) + offsetInRegion;
+	return m_mappedMemory + offsetInRegion;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cConstantBufferRing::Initialize()
+{
+	// Find the size of the type's struct
+	switch ( m_type )
+	{
+		case ConstantBufferTypes::Frame: m_bindSize = sizeof( ConstantBufferFormats::sFrame ); break;
+		case ConstantBufferTypes::DrawCall: m_bindSize = sizeof( ConstantBufferFormats::sDrawCall ); break;
+
+	default:
+
+		EAE6320_ASSERTF( false, "Unsupported constant buffer type %u", m_type );
+		Logging::OutputError( "A constant buffer ring can't be initialized with the type %u", m_type );
+		return Results::Failure;
+	}
+	EAE6320_ASSERT( m_bindSize > 0 );
+
+	return Initialize_platformSpecific();
+}
+
+eae6320::Graphics::cConstantBufferRing::cConstantBufferRing( const ConstantBufferTypes i_type )
+	:
+	m_type( i_type )
+{
+
+}
+
+eae6320::Graphics::cConstantBufferRing::~cConstantBufferRing()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
@@ -0,0 +1,155 @@
+/*
+	A constant buffer ring holds the constant data of every draw call of a frame in one large buffer
+
+	Instead of overwriting a single constant buffer before every draw call
+	(which makes the driver either wait for the previous draw call or make a copy of the buffer),
+	the data of all draw calls of a frame is written once at the start of the frame
+	and each draw call binds the range of the buffer that holds its data.
+
+	The buffer is split into one region per frame that can be in flight.
+	A frame writes to its region without any synchronization by the driver,
+	and so before a region is written to again the ring waits on a fence
+	that was inserted after the last frame that used it
+*/
+
+#ifndef EAE6320_GRAPHICS_CCONSTANTBUFFERRING_H
+#define EAE6320_GRAPHICS_CCONSTANTBUFFERRING_H
+
+// Includes
+//=========
+
+#include "Configuration.h"
+
+#include "cConstantBuffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+#ifdef EAE6320_PLATFORM_GL
+	#include "OpenGL/Includes.h"
+#endif
+
+// Forward Declarations
+//=====================
+
+#ifdef EAE6320_PLATFORM_D3D
+	struct ID3D11Buffer;
+	struct ID3D11DeviceContext1;
+	struct ID3D11Query;
+#endif
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+namespace Graphics
+{
+	class cConstantBufferRing
+	{
+		// Interface
+		//==========
+
+	public:
+
+		// Render
+		//-------
+
+		// The space that writing i_size bytes takes in a frame's region,
+		// which is what BeginFrame() must be told for every write of the frame
+		size_t GetAlignedSize( const size_t i_size ) const;
+
+		// Makes the next region writable, waiting for the GPU to finish the frame that used it last.
+		// i_size is the sum of the aligned sizes of everything that will be written this frame,
+		// and the buffer grows if a region can't hold it
+		cResult BeginFrame( const size_t i_size );
+		// Returns memory in the frame's region to write i_size bytes of constant data to,
+		// and the offset that must be bound for a draw call to use it
+		void* Allocate( const size_t i_size, size_t& o_offset );
+		// Must be called after all of the frame's data has been written and before the first draw call that uses it
+		void EndWrite();
+		// Makes the shaders use the constant data at i_offset
+		// until a different range or constant buffer of the ring's type is bound.
+		// i_shaderTypesToBindTo works the same way as for a cConstantBuffer
+		void Bind( const size_t i_offset, const uint_fast8_t i_shaderTypesToBindTo ) const;
+		// Must be called after the frame's last draw call that uses the region
+		void EndFrame();
+
+		// Initialize / Clean Up
+		//----------------------
+
+		// Fails if the platform can't bind a range of a constant buffer,
+		// in which case a single cConstantBuffer must be updated before every draw call instead
+		cResult Initialize();
+		cResult CleanUp();
+
+		cConstantBufferRing( const ConstantBufferTypes i_type );
+		~cConstantBufferRing();
+
+		// Data
+		//=====
+
+	private:
+
+		// One region is written to while the GPU may still be reading from the two before it
+		static constexpr unsigned int RegionCount = 3;
+
+		// The size of the constant data of the ring's type.
+		// This much is always bound, even when a draw call only uses the start of it
+		size_t m_bindSize = 0;
+		// Offsets that are bound must be a multiple of this
+		size_t m_offsetAlignment = 0;
+		// The size of each region, which has room for the capacity
+		// and for a full m_bindSize to be bound at the end of the capacity
+		size_t m_regionCapacity = 0;
+		size_t m_regionSize = 0;
+
+		// The state of the frame being written
+		unsigned int m_regionIndex = 0;
+		uint8_t* m_mappedMemory = nullptr;
+		size_t m_mappedSize = 0;
+		size_t m_writeOffset = 0;
+
+#if defined( EAE6320_PLATFORM_D3D )
+		ID3D11Buffer* m_buffer = nullptr;
+		// Binding a range of a constant buffer needs Direct3D 11.1
+		ID3D11DeviceContext1* m_direct3dImmediateContext1 = nullptr;
+		// Event queries are the fences of Direct3D 11
+		ID3D11Query* m_fences[RegionCount] = {};
+		bool m_isFenceIssued[RegionCount] = {};
+		// A dynamic buffer must be discarded the first time it is mapped
+		bool m_hasBeenMapped = false;
+#elif defined( EAE6320_PLATFORM_GL )
+		GLuint m_bufferId = 0;
+		GLsync m_fences[RegionCount] = {};
+#endif
+
+		const ConstantBufferTypes m_type = ConstantBufferTypes::Invalid;
+
+		// Implementation
+		//---------------
+
+	private:
+
+		// Render
+		//-------
+
+		// Makes room for regions of at least i_capacity bytes.
+		// Whatever the GPU is still reading from the old buffer stays alive until it is done
+		cResult Grow( const size_t i_capacity );
+
+		// Initialize / Clean Up
+		//----------------------
+
+		cResult Initialize_platformSpecific();
+
+		cConstantBufferRing( const cConstantBufferRing& ) = delete;
+		cConstantBufferRing( cConstantBufferRing&& ) = delete;
+		cConstantBufferRing& operator =( const cConstantBufferRing& ) = delete;
+		cConstantBufferRing& operator =( cConstantBufferRing&& ) = delete;
+	};
+}
+}
+
+#endif	// EAE6320_GRAPHICS_CCONSTANTBUFFERRING_H
@@ -58,6 +58,12 @@ eae6320::cResult eae6320::Graphics::cEffect::Create(std::shared_ptr<cEffect>& o_
 }
 
 
+uint8_t eae6320::Graphics::cEffect::GetRenderStateBits() const
+{
+	return m_renderState ? m_renderState->GetRenderStateBits() : cRenderState::g_invalidRenderStateBits;
+}
+
+
 eae6320::Graphics::cEffect::~cEffect()
 {
 	const auto result = CleanUp();
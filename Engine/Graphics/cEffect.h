@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <Engine/Graphics/cRenderHandle.h>
 #include <Engine/Graphics/cRenderState.h>
 #include <Engine/Graphics/cShader.h>
 #include <Engine/Results/Results.h>
@@ -55,6 +56,15 @@ namespace Graphics
 
 		void Bind();
 
+		// Access
+		//--------------------------
+
+		// Invalid until the render thread has created the object
+		cRenderHandle<cEffect> GetHandle() const { return m_handle; }
+
+		// A concatenation of RenderStates::eRenderState bits
+		uint8_t GetRenderStateBits() const;
+
 
 		// Implementation
 		//==============================
@@ -85,7 +95,15 @@ namespace Graphics
 #if defined ( EAE6320_PLATFORM_GL )
 		GLuint m_programId = 0;
 #endif
-		
+
+		// Assigned by the render object table when the object is created
+		cRenderHandle<cEffect> m_handle;
+
+		// Friends
+		//=====================
+
+		template <class> friend class cRenderObjectTable;
+
 	};
 
 
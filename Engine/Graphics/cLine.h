@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Engine/Graphics/cRenderHandle.h>
 #include <Engine/Graphics/VertexFormats.h>
 #include <Engine/Results/Results.h>
 
@@ -50,6 +51,12 @@ namespace Graphics
 
 		void Draw();
 
+		// Access
+		//--------------------------
+
+		// Invalid until the render thread has created the object
+		cRenderHandle<cLine> GetHandle() const { return m_handle; }
+
 
 		// Implementation
 		//=====================
@@ -84,7 +91,15 @@ namespace Graphics
 		GLuint m_vertexBufferId = 0;
 		GLuint m_indexBufferId = 0;
 #endif
-		
+
+		// Assigned by the render object table when the object is created
+		cRenderHandle<cLine> m_handle;
+
+		// Friends
+		//=====================
+
+		template <class> friend class cRenderObjectTable;
+
 	};
 
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <Engine/Graphics/cRenderHandle.h>
 #include <Engine/Graphics/VertexFormats.h>
 #include <Engine/Results/Results.h>
 
@@ -57,7 +58,18 @@ namespace Graphics
 		// Render
 		//--------------------------
 
-		void Draw();
+		// Bind the vertex and index buffers; consecutive draws of the same mesh only need to bind once
+		void Bind();
+
+		// Draw the mesh that is currently bound, which must be this one.
+		// More than one instance is drawn with a single instanced draw call
+		void Draw(const uint32_t i_instanceCount = 1);
+
+		// Access
+		//--------------------------
+
+		// Invalid until the render thread has created the object
+		cRenderHandle<cMesh> GetHandle() const { return m_handle; }
 
 
 		// Implementation
@@ -108,6 +120,14 @@ namespace Graphics
 		GLuint m_indexBufferId = 0;
 #endif
 
+		// Assigned by the render object table when the object is created
+		cRenderHandle<cMesh> m_handle;
+
+		// Friends
+		//=====================
+
+		template <class> friend class cRenderObjectTable;
+
 	};
 
 
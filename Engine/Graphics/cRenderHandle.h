@@ -0,0 +1,104 @@
+/*
+	A render handle is a small integer that refers to a render object (a mesh, an effect or a line)
+	that lives on the render thread
+
+	Draw packets store render handles instead of smart pointers so that they are plain data:
+	the application thread can copy them without touching reference counts,
+	and the render thread resolves them through a cRenderObjectTable.
+	A handle of an object that has been cleaned up resolves to nothing
+	because the table changes the generation of the slot when it is freed
+*/
+
+#ifndef EAE6320_GRAPHICS_CRENDERHANDLE_H
+#define EAE6320_GRAPHICS_CRENDERHANDLE_H
+
+// Includes
+//=========
+
+#include <cstdint>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+namespace Graphics
+{
+	template <class tObject> class cRenderObjectTable;
+}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+namespace Graphics
+{
+	// Handles are templated for type safety:
+	// A mesh handle can't be used to look up an effect
+	template <class tObject>
+	class cRenderHandle
+	{
+		// Interface
+		//==========
+
+	public:
+
+		// Access
+		//-------
+
+		bool IsValid() const { return GetIndex() != InvalidIndex; }
+
+		// The index is dense and stays below the number of objects of the type that are alive at once,
+		// so it can be used to order draw calls by object
+		uint_fast32_t GetIndex() const { return static_cast<uint_fast32_t>(m_value & IndexMask); }
+		uint_fast16_t GetGeneration() const { return static_cast<uint_fast16_t>(m_value >> GenerationShift); }
+
+		// Initialize / Clean Up
+		//----------------------
+
+		cRenderHandle() = default;
+
+		// Comparison
+		//-----------
+
+		bool operator ==(const cRenderHandle i_rhs) const { return m_value == i_rhs.m_value; }
+		bool operator !=(const cRenderHandle i_rhs) const { return m_value != i_rhs.m_value; }
+
+		// Data
+		//=====
+
+	private:
+
+		// The lowest 20 bits are the index of the slot in the table,
+		// the remaining 12 bits are the generation of the slot when the handle was made.
+		// The largest possible index is used as an invalid index
+		static constexpr uint32_t IndexMask = 0xfffff;
+		static constexpr uint32_t GenerationShift = 20;
+		static constexpr uint32_t GenerationMask = 0xfff;
+		static constexpr uint32_t InvalidIndex = IndexMask;
+
+		uint32_t m_value = InvalidIndex;
+
+		// Implementation
+		//===============
+
+	private:
+
+		cRenderHandle(const uint_fast32_t i_index, const uint_fast16_t i_generation)
+			:
+			m_value(static_cast<uint32_t>(i_index | ((i_generation & GenerationMask) << GenerationShift)))
+		{
+		}
+
+		// Friends
+		//========
+
+		// Only the table that owns the objects makes handles
+		template <class> friend class cRenderObjectTable;
+	};
+}
+}
+
+#endif	// EAE6320_GRAPHICS_CRENDERHANDLE_H
@@ -0,0 +1,74 @@
+/*
+	A render object table owns the render objects of one type on the render thread
+	and hands out the cRenderHandles that draw packets use to refer to them
+
+	The table is only used from the render thread, so it needs no synchronization.
+	Holding a reference to every live object also makes sure
+	that the graphics API objects are released on the render thread
+*/
+
+#ifndef EAE6320_GRAPHICS_CRENDEROBJECTTABLE_H
+#define EAE6320_GRAPHICS_CRENDEROBJECTTABLE_H
+
+// Includes
+//=========
+
+#include "cRenderHandle.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+namespace Graphics
+{
+	// The object type must declare cRenderObjectTable<tObject> a friend
+	// and have a cRenderHandle<tObject> m_handle that the table fills in
+	template <class tObject>
+	class cRenderObjectTable
+	{
+		// Interface
+		//==========
+
+	public:
+
+		// Access
+		//-------
+
+		// Null if the handle is invalid or its object has been released
+		tObject* Get(const cRenderHandle<tObject> i_handle) const;
+
+		// Initialize / Clean Up
+		//----------------------
+
+		// Start owning the object and store its handle in it, the object starts with one user.
+		// Fails (and returns an invalid handle) when every index is in use
+		cRenderHandle<tObject> Add(const std::shared_ptr<tObject>& i_object);
+		// Share an object that is already in the table with another user by copying the table's reference to o_object.
+		// Fails if the handle no longer resolves
+		bool AddUser(const cRenderHandle<tObject> i_handle, std::shared_ptr<tObject>& o_object);
+		// Count one user less. After the last one the table releases its reference,
+		// handles to the object stop resolving to it, and true is returned
+		bool Release(const cRenderHandle<tObject> i_handle);
+		void Clear();
+
+		// Data
+		//=====
+
+	private:
+
+		std::vector<std::shared_ptr<tObject>> m_objects;
+		std::vector<uint16_t> m_generations;
+		std::vector<uint32_t> m_userCounts;
+		std::vector<uint32_t> m_freeIndices;
+	};
+}
+}
+
+#include "cRenderObjectTable.inl"
+
+#endif	// EAE6320_GRAPHICS_CRENDEROBJECTTABLE_H
@@ -0,0 +1,101 @@
+#ifndef EAE6320_GRAPHICS_CRENDEROBJECTTABLE_INL
+#define EAE6320_GRAPHICS_CRENDEROBJECTTABLE_INL
+
+// Includes
+//=========
+
+#include "cRenderObjectTable.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Interface
+//==========
+
+// Access
+//-------
+
+template <class tObject>
+tObject* eae6320::Graphics::cRenderObjectTable<tObject>::Get(const cRenderHandle<tObject> i_handle) const
+{
+	const auto index = i_handle.GetIndex();
+	if ((index < m_objects.size()) && (m_generations[index] == i_handle.GetGeneration()))
+		return m_objects[index].get();
+	return nullptr;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+template <class tObject>
+eae6320::Graphics::cRenderHandle<tObject> eae6320::Graphics::cRenderObjectTable<tObject>::Add(const std::shared_ptr<tObject>& i_object)
+{
+	EAE6320_ASSERT(i_object);
+
+	uint32_t index;
+	if (m_freeIndices.empty() == false)
+	{
+		index = m_freeIndices.back();
+		m_freeIndices.pop_back();
+	}
+	else if (m_objects.size() < cRenderHandle<tObject>::InvalidIndex)
+	{
+		index = static_cast<uint32_t>(m_objects.size());
+		m_objects.emplace_back();
+		m_generations.push_back(0);
+		m_userCounts.push_back(0);
+	}
+	else
+	{
+		EAE6320_ASSERTF(false, "Too many render objects of one type are alive at once");
+		Logging::OutputError("A render object couldn't get a handle because too many of its type are alive at once");
+		return cRenderHandle<tObject>();
+	}
+
+	m_objects[index] = i_object;
+	m_userCounts[index] = 1;
+	const cRenderHandle<tObject> handle(index, m_generations[index]);
+	i_object->m_handle = handle;
+	return handle;
+}
+
+template <class tObject>
+bool eae6320::Graphics::cRenderObjectTable<tObject>::AddUser(const cRenderHandle<tObject> i_handle, std::shared_ptr<tObject>& o_object)
+{
+	if (Get(i_handle) == nullptr)
+		return false;
+
+	const auto index = i_handle.GetIndex();
+	m_userCounts[index]++;
+	o_object = m_objects[index];
+	return true;
+}
+
+template <class tObject>
+bool eae6320::Graphics::cRenderObjectTable<tObject>::Release(const cRenderHandle<tObject> i_handle)
+{
+	if (Get(i_handle) == nullptr)
+		return false;
+
+	const auto index = i_handle.GetIndex();
+	EAE6320_ASSERT(m_userCounts[index] > 0);
+	if (--m_userCounts[index] > 0)
+		return false;
+
+	// The generation wraps around after it runs out of bits
+	m_objects[index].reset();
+	m_generations[index] = static_cast<uint16_t>((m_generations[index] + 1) & cRenderHandle<tObject>::GenerationMask);
+	m_freeIndices.push_back(static_cast<uint32_t>(index));
+	return true;
+}
+
+template <class tObject>
+void eae6320::Graphics::cRenderObjectTable<tObject>::Clear()
+{
+	m_objects.clear();
+	m_generations.clear();
+	m_userCounts.clear();
+	m_freeIndices.clear();
+}
+
+#endif	// EAE6320_GRAPHICS_CRENDEROBJECTTABLE_INL
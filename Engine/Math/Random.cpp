@@ -5,6 +5,8 @@
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Math/Random.h>
 
+#include <cfloat>
+#include <climits>
 #include <random>
 
 
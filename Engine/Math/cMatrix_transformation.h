@@ -71,10 +71,10 @@ namespace eae6320
 			//-------
 
 			// A world-to-camera transform (for rendering) can be created by specifying the relative camera data
-			static constexpr cMatrix_transformation CreateWorldToCameraTransform(
+			static cMatrix_transformation CreateWorldToCameraTransform(
 				const cQuaternion& i_cameraOrientation, const sVector& i_cameraPosition );
 			// If a camera's local-to-world transform has already been created then it can be specified instead to save calculations
-			static constexpr cMatrix_transformation CreateWorldToCameraTransform( const cMatrix_transformation& transform_localCameraToWorld );
+			static cMatrix_transformation CreateWorldToCameraTransform( const cMatrix_transformation& transform_localCameraToWorld );
 
 			// A camera-to-projected transform (for rendering) can be created by specifying the relative data
 			static cMatrix_transformation CreateCameraToProjectedTransform_perspective(
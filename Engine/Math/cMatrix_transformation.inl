@@ -78,13 +78,13 @@ constexpr eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transform
 // Camera
 //-------
 
-constexpr eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::CreateWorldToCameraTransform(
+inline eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::CreateWorldToCameraTransform(
 	const cQuaternion& i_cameraOrientation, const sVector& i_cameraPosition )
 {
 	return CreateWorldToCameraTransform( cMatrix_transformation( i_cameraOrientation, i_cameraPosition ) );
 }
 
-constexpr eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::CreateWorldToCameraTransform( const cMatrix_transformation& i_transform_localCameraToWorld )
+inline eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::CreateWorldToCameraTransform( const cMatrix_transformation& i_transform_localCameraToWorld )
 {
 	// Many simplifying assumptions can be made in order to create the inverse
 	// because in our class a camera can only ever have rotation and translation
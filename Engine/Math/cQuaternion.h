@@ -60,12 +60,19 @@ namespace eae6320
 			// it is more efficient to extract the forward direction from that
 			constexpr sVector CalculateForwardDirection() const;
 
+			// Components are exposed for code that stores orientations as separate arrays
+			constexpr float GetW() const;
+			constexpr float GetX() const;
+			constexpr float GetY() const;
+			constexpr float GetZ() const;
+
 			// Initialization / Clean Up
 			//--------------------------
 
 			constexpr cQuaternion() = default;	// Identity
 			cQuaternion( const float i_angleInRadians,	// A positive angle rotates counter-clockwise (right-handed) around the axis
 				const sVector i_axisOfRotation_normalized );
+			constexpr cQuaternion( const float i_w, const float i_x, const float i_y, const float i_z );
 
 			// Data
 			//=====
@@ -82,11 +89,6 @@ namespace eae6320
 
 		private:
 
-			// Initialization / Clean Up
-			//--------------------------
-
-			constexpr cQuaternion( const float i_w, const float i_x, const float i_y, const float i_z );
-
 			// Friends
 			//========
 
@@ -74,8 +74,25 @@ constexpr eae6320::Math::sVector eae6320::Math::cQuaternion::CalculateForwardDir
 	return sVector( -_2xz - _2yw, -_2yz + _2xw, -1.0f + _2xx + _2yy );
 }
 
-// Implementation
-//===============
+constexpr float eae6320::Math::cQuaternion::GetW() const
+{
+	return m_w;
+}
+
+constexpr float eae6320::Math::cQuaternion::GetX() const
+{
+	return m_x;
+}
+
+constexpr float eae6320::Math::cQuaternion::GetY() const
+{
+	return m_y;
+}
+
+constexpr float eae6320::Math::cQuaternion::GetZ() const
+{
+	return m_z;
+}
 
 // Initialization / Clean Up
 //--------------------------
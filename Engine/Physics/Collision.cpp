@@ -1,38 +1,20 @@
 // Includes
 //=========
 
-#include <Engine/GameObject/cGameObject.h>
-#include <Engine/Logging/Logging.h>
 #include <Engine/Physics/Collision.h>
+#include <Engine/Physics/Physics.h>
 #include <Engine/Physics/cAABBCollider.h>
+#include <Engine/Physics/cCapsuleCollider.h>
+#include <Engine/Physics/cOBBCollider.h>
 #include <Engine/Physics/cSphereCollider.h>
 
-
-#include <unordered_map>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
 
 
 
-// Static Data
-//============
-
-namespace
-{
-	uint8_t s_collisionType;
-
-	std::unordered_map<eae6320::Physics::cCollider*, std::vector<eae6320::Physics::cCollider*>>
-		s_collisionMap;
-
-	// Buffer for sweep and prune algorithm
-	std::vector<eae6320::Physics::cCollider*> s_orderedColliderList_xAxis;
-	std::vector<eae6320::Physics::cCollider*> s_orderedColliderList_yAxis;
-	std::vector<eae6320::Physics::cCollider*> s_orderedColliderList_zAxis;
-
-	// Buffer for BVH algorithm
-	eae6320::Physics::cBVHTree s_BVHTree;
-}
-
-
 // Helper Funcitons Forward Declaraction
 //============
 
@@ -43,186 +25,274 @@ namespace Physics
 namespace Collision
 {
 
-	// Comparators
+	// Dispatch
 	//----------------------
 
-	auto s_comparator_xAxis = [](cCollider* i_lhs, cCollider* i_rhs) -> bool
-	{
-		return i_lhs->GetMinExtent_world().x < i_rhs->GetMinExtent_world().x;
-	};
+	bool IsOverlaps_None(cCollider* i_lhs, cCollider* i_rhs);
 
-	auto s_comparator_yAxis = [](cCollider* i_lhs, cCollider* i_rhs) -> bool
-	{
-		return i_lhs->GetMinExtent_world().y < i_rhs->GetMinExtent_world().y;
-	};
+	template <class tLhs, class tRhs>
+	bool IsOverlaps_Typed(cCollider* i_lhs, cCollider* i_rhs);
 
-	auto s_comparator_zAxis = [](cCollider* i_lhs, cCollider* i_rhs) -> bool
-	{
-		return i_lhs->GetMinExtent_world().z < i_rhs->GetMinExtent_world().z;
-	};
+	template <class tLhs, class tRhs>
+	bool IsOverlaps_TypedSwapped(cCollider* i_lhs, cCollider* i_rhs);
 
+	bool GenerateContact_None(cCollider* i_lhs, cCollider* i_rhs, sContactManifold& o_manifold);
 
-	// Broad Phase: Sweep and Prune
-	//----------------------
+	template <class tLhs, class tRhs>
+	bool GenerateContact_Typed(cCollider* i_lhs, cCollider* i_rhs, sContactManifold& o_manifold);
 
-	void Initialize_SweepAndPrune(const std::vector<cCollider*>& i_allColliderList);
+	template <class tLhs, class tRhs>
+	bool GenerateContact_TypedSwapped(cCollider* i_lhs, cCollider* i_rhs, sContactManifold& o_manifold);
 
-	void RegisterCollider_SweepAndPrune(cCollider* i_collider);
+	bool Sweep_None(const cCollider* i_collider, const Math::sVector& i_translation, const cCollider* i_target, float& o_timeOfImpact);
 
-	eae6320::cResult DeregisterCollider_SweepAndPrune(cCollider* i_collider);
+	/* Both colliders are treated as their world AABBs, so hits can come early */
+	bool Sweep_Bounds(const cCollider* i_collider, const Math::sVector& i_translation, const cCollider* i_target, float& o_timeOfImpact);
 
-	void CollisionDetection_BroadPhase_SweepAndPrune();
+	template <class tCollider, class tTarget>
+	bool Sweep_Typed(const cCollider* i_collider, const Math::sVector& i_translation, const cCollider* i_target, float& o_timeOfImpact);
 
 
-	// Broad Phase: BVH Tree
+	// Contact Generation
 	//----------------------
 
-	void Initialize_BVH(const std::vector<cCollider*>& i_allColliderList);
+	bool GenerateContact(const cSphereCollider* i_lhs, const cSphereCollider* i_rhs, sContactManifold& o_manifold);
 
-	void RegisterCollider_BVH(cCollider* i_collider);
+	bool GenerateContact(const cAABBCollider* i_lhs, const cSphereCollider* i_rhs, sContactManifold& o_manifold);
 
-	cResult DeregisterCollider_BVH(cCollider* i_collider);
+	bool GenerateContact(const cAABBCollider* i_lhs, const cAABBCollider* i_rhs, sContactManifold& o_manifold);
 
-	void CollisionDetection_BroadPhase_BVH();
+	bool GenerateContact(const cAABBCollider* i_lhs, const cOBBCollider* i_rhs, sContactManifold& o_manifold);
 
+	bool GenerateContact(const cAABBCollider* i_lhs, const cCapsuleCollider* i_rhs, sContactManifold& o_manifold);
 
-	// Narrow Phase
-	//----------------------
+	bool GenerateContact(const cOBBCollider* i_lhs, const cSphereCollider* i_rhs, sContactManifold& o_manifold);
+
+	bool GenerateContact(const cOBBCollider* i_lhs, const cOBBCollider* i_rhs, sContactManifold& o_manifold);
+
+	bool GenerateContact(const cOBBCollider* i_lhs, const cCapsuleCollider* i_rhs, sContactManifold& o_manifold);
+
+	bool GenerateContact(const cSphereCollider* i_lhs, const cCapsuleCollider* i_rhs, sContactManifold& o_manifold);
 
-	void CollisionDetection_NarrowPhase_Overlap(std::unordered_map<cCollider*, std::vector<cCollider*>>& i_CollisionMap_broadPhase);
+	bool GenerateContact(const cCapsuleCollider* i_lhs, const cCapsuleCollider* i_rhs, sContactManifold& o_manifold);
 
-	void InvokeCollisionCallback(std::unordered_map<cCollider*, std::vector<cCollider*>>& i_newCollisionMap);
+	// Spheres and capsules are both segments with a radius, a sphere's segment is a single point.
+	// Every contact of these shapes comes down to one of the three functions below
 
+	bool GenerateContact_Segments(const Math::sVector& i_pointA_lhs, const Math::sVector& i_pointB_lhs, float i_radius_lhs,
+		const Math::sVector& i_pointA_rhs, const Math::sVector& i_pointB_rhs, float i_radius_rhs, sContactManifold& o_manifold);
 
-	// Collision Resolution
+	bool GenerateContact_BoxSegment(const sOrientedBox& i_box, const Math::sVector& i_pointA, const Math::sVector& i_pointB, float i_radius,
+		sContactManifold& o_manifold);
+
+	bool GenerateContact_Boxes(const sOrientedBox& i_lhs, const sOrientedBox& i_rhs, sContactManifold& o_manifold);
+
+
+	// Time of Impact
 	//----------------------
 
-	void CollisionResolution(cCollider* i_lhs, cCollider* i_rhs);
+	bool Sweep(const cSphereCollider* i_collider, const Math::sVector& i_translation, const cSphereCollider* i_target, float& o_timeOfImpact);
 
-	void CollisionResolution(cSphereCollider* i_lhs, cSphereCollider* i_rhs);
+	bool Sweep(const cSphereCollider* i_collider, const Math::sVector& i_translation, const cAABBCollider* i_target, float& o_timeOfImpact);
 
-	void CollisionResolution(cAABBCollider* i_lhs, cSphereCollider* i_rhs);
+	bool Sweep(const cAABBCollider* i_collider, const Math::sVector& i_translation, const cSphereCollider* i_target, float& o_timeOfImpact);
 
-	void CollisionResolution(cAABBCollider* i_lhs, cAABBCollider* i_rhs);
+	bool Sweep(const cAABBCollider* i_collider, const Math::sVector& i_translation, const cAABBCollider* i_target, float& o_timeOfImpact);
 
+	bool Sweep(const cSphereCollider* i_collider, const Math::sVector& i_translation, const cOBBCollider* i_target, float& o_timeOfImpact);
+
+	bool Sweep(const cSphereCollider* i_collider, const Math::sVector& i_translation, const cCapsuleCollider* i_target, float& o_timeOfImpact);
+
+	bool Sweep(const cCapsuleCollider* i_collider, const Math::sVector& i_translation, const cSphereCollider* i_target, float& o_timeOfImpact);
 
 }// Namespace Collision
 }// Namespace Physics
 }// Namespace eae6320
 
 
-
-// Interface Implementation
+// Dispatch Tables
 //============
 
-bool eae6320::Physics::Collision::IsOverlaps(cCollider* i_lhs, cCollider* i_rhs)
+namespace eae6320
+{
+namespace Physics
 {
-	switch (i_lhs->GetType())
+namespace Collision
+{
+
+	constexpr size_t s_colliderTypeCount = 5;
+
+	// Indexed by [lhs type][rhs type]. Each entry casts to the concrete colliders with
+	// static_cast, so no type switch or dynamic_cast is left in the per-pair path
+	using fOverlapFunction = bool(*)(cCollider*, cCollider*);
+	const fOverlapFunction s_overlapTable[s_colliderTypeCount][s_colliderTypeCount] =
 	{
+		// None
+		{ IsOverlaps_None, IsOverlaps_None, IsOverlaps_None, IsOverlaps_None, IsOverlaps_None },
+		// Sphere
+		{ IsOverlaps_None, IsOverlaps_Typed<cSphereCollider, cSphereCollider>, IsOverlaps_Typed<cSphereCollider, cAABBCollider>,
+			IsOverlaps_TypedSwapped<cOBBCollider, cSphereCollider>, IsOverlaps_TypedSwapped<cCapsuleCollider, cSphereCollider> },
+		// AABB
+		{ IsOverlaps_None, IsOverlaps_TypedSwapped<cSphereCollider, cAABBCollider>, IsOverlaps_Typed<cAABBCollider, cAABBCollider>,
+			IsOverlaps_TypedSwapped<cOBBCollider, cAABBCollider>, IsOverlaps_TypedSwapped<cCapsuleCollider, cAABBCollider> },
+		// OBB
+		{ IsOverlaps_None, IsOverlaps_Typed<cOBBCollider, cSphereCollider>, IsOverlaps_Typed<cOBBCollider, cAABBCollider>,
+			IsOverlaps_Typed<cOBBCollider, cOBBCollider>, IsOverlaps_TypedSwapped<cCapsuleCollider, cOBBCollider> },
+		// Capsule
+		{ IsOverlaps_None, IsOverlaps_Typed<cCapsuleCollider, cSphereCollider>, IsOverlaps_Typed<cCapsuleCollider, cAABBCollider>,
+			IsOverlaps_Typed<cCapsuleCollider, cOBBCollider>, IsOverlaps_Typed<cCapsuleCollider, cCapsuleCollider> },
+	};
 
-	case eColliderType::Sphere:
+	using fContactFunction = bool(*)(cCollider*, cCollider*, sContactManifold&);
+	const fContactFunction s_contactTable[s_colliderTypeCount][s_colliderTypeCount] =
 	{
-		if (i_rhs->GetType() == eColliderType::Sphere)
-		{
-			return dynamic_cast<cSphereCollider*>(i_lhs)->IsOverlaps(*dynamic_cast<cSphereCollider*>(i_rhs));
-		}
-		else if (i_rhs->GetType() == eColliderType::AABB)
-		{
-			return dynamic_cast<cSphereCollider*>(i_lhs)->IsOverlaps(*dynamic_cast<cAABBCollider*>(i_rhs));
-		}
-		else
-			return false;
-	}
+		// None
+		{ GenerateContact_None, GenerateContact_None, GenerateContact_None, GenerateContact_None, GenerateContact_None },
+		// Sphere
+		{ GenerateContact_None, GenerateContact_Typed<cSphereCollider, cSphereCollider>, GenerateContact_TypedSwapped<cAABBCollider, cSphereCollider>,
+			GenerateContact_TypedSwapped<cOBBCollider, cSphereCollider>, GenerateContact_Typed<cSphereCollider, cCapsuleCollider> },
+		// AABB
+		{ GenerateContact_None, GenerateContact_Typed<cAABBCollider, cSphereCollider>, GenerateContact_Typed<cAABBCollider, cAABBCollider>,
+			GenerateContact_Typed<cAABBCollider, cOBBCollider>, GenerateContact_Typed<cAABBCollider, cCapsuleCollider> },
+		// OBB
+		{ GenerateContact_None, GenerateContact_Typed<cOBBCollider, cSphereCollider>, GenerateContact_TypedSwapped<cAABBCollider, cOBBCollider>,
+			GenerateContact_Typed<cOBBCollider, cOBBCollider>, GenerateContact_Typed<cOBBCollider, cCapsuleCollider> },
+		// Capsule
+		{ GenerateContact_None, GenerateContact_TypedSwapped<cSphereCollider, cCapsuleCollider>, GenerateContact_TypedSwapped<cAABBCollider, cCapsuleCollider>,
+			GenerateContact_TypedSwapped<cOBBCollider, cCapsuleCollider>, GenerateContact_Typed<cCapsuleCollider, cCapsuleCollider> },
+	};
 
-	case eColliderType::AABB:
+	// Indexed by [moving collider type][target type]
+	using fSweepFunction = bool(*)(const cCollider*, const Math::sVector&, const cCollider*, float&);
+	const fSweepFunction s_sweepTable[s_colliderTypeCount][s_colliderTypeCount] =
 	{
-		if (i_rhs->GetType() == eColliderType::Sphere)
-		{
-			return dynamic_cast<cSphereCollider*>(i_rhs)->IsOverlaps(*dynamic_cast<cAABBCollider*>(i_lhs));
-		}
-		else if (i_rhs->GetType() == eColliderType::AABB)
-		{
-			return dynamic_cast<cAABBCollider*>(i_lhs)->IsOverlaps(*dynamic_cast<cAABBCollider*>(i_rhs));
-		}
-		else
-			return false;
-	}
+		// None
+		{ Sweep_None, Sweep_None, Sweep_None, Sweep_None, Sweep_None },
+		// Sphere
+		{ Sweep_None, Sweep_Typed<cSphereCollider, cSphereCollider>, Sweep_Typed<cSphereCollider, cAABBCollider>,
+			Sweep_Typed<cSphereCollider, cOBBCollider>, Sweep_Typed<cSphereCollider, cCapsuleCollider> },
+		// AABB
+		{ Sweep_None, Sweep_Typed<cAABBCollider, cSphereCollider>, Sweep_Typed<cAABBCollider, cAABBCollider>, Sweep_Bounds, Sweep_Bounds },
+		// OBB
+		{ Sweep_None, Sweep_Bounds, Sweep_Bounds, Sweep_Bounds, Sweep_Bounds },
+		// Capsule
+		{ Sweep_None, Sweep_Typed<cCapsuleCollider, cSphereCollider>, Sweep_Bounds, Sweep_Bounds, Sweep_Bounds },
+	};
 
-	default:
-		return false;
+}// Namespace Collision
+}// Namespace Physics
+}// Namespace eae6320
 
-	}
 
+
+// Shapes
+//============
+
+eae6320::Physics::Collision::sOrientedBox::sOrientedBox(const Math::sVector& i_center, const Math::cQuaternion& i_orientation, const Math::sVector& i_halfExtents)
+	:
+	center(i_center), halfExtents(i_halfExtents)
+{
+	axes[0] = i_orientation * Math::sVector(1.0f, 0.0f, 0.0f);
+	axes[1] = i_orientation * Math::sVector(0.0f, 1.0f, 0.0f);
+	axes[2] = i_orientation * Math::sVector(0.0f, 0.0f, 1.0f);
 }
 
 
-void eae6320::Physics::Collision::Initialize(const std::vector<cCollider*>& i_allColliderList, uint8_t i_collisionType)
+eae6320::Physics::Collision::sOrientedBox::sOrientedBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent)
+	:
+	center((i_minExtent + i_maxExtent) * 0.5f), halfExtents((i_maxExtent - i_minExtent) * 0.5f)
 {
-	s_collisionType = i_collisionType;
+	axes[0] = Math::sVector(1.0f, 0.0f, 0.0f);
+	axes[1] = Math::sVector(0.0f, 1.0f, 0.0f);
+	axes[2] = Math::sVector(0.0f, 0.0f, 1.0f);
+}
 
-	if ((s_collisionType & eCollisionType::BroadPhase_SweepAndPrune) != 0)
-		Initialize_SweepAndPrune(i_allColliderList);
-	else if ((s_collisionType & eCollisionType::BroadPhase_BVH) != 0)
-		Initialize_BVH(i_allColliderList);
-	else
-		Initialize_SweepAndPrune(i_allColliderList);
+
+eae6320::Math::sVector eae6320::Physics::Collision::sOrientedBox::ToLocal(const Math::sVector& i_point) const
+{
+	const Math::sVector offset = i_point - center;
+	return Math::sVector(Dot(offset, axes[0]), Dot(offset, axes[1]), Dot(offset, axes[2]));
+}
+
+
+eae6320::Math::sVector eae6320::Physics::Collision::sOrientedBox::ToWorld(const Math::sVector& i_point_local) const
+{
+	return center + axes[0] * i_point_local.x + axes[1] * i_point_local.y + axes[2] * i_point_local.z;
+}
+
+
+float eae6320::Physics::Collision::sOrientedBox::GetProjectedRadius(const Math::sVector& i_axis) const
+{
+	return halfExtents.x * std::abs(Dot(axes[0], i_axis))
+		+ halfExtents.y * std::abs(Dot(axes[1], i_axis))
+		+ halfExtents.z * std::abs(Dot(axes[2], i_axis));
+}
+
+
+eae6320::Math::sVector eae6320::Physics::Collision::sOrientedBox::GetClosestPoint(const Math::sVector& i_point) const
+{
+	return ToWorld(Math::Min(Math::Max(ToLocal(i_point), -halfExtents), halfExtents));
+}
+
+
+eae6320::Math::sVector eae6320::Physics::Collision::sOrientedBox::GetSupportPoint(const Math::sVector& i_direction) const
+{
+	return ToWorld(Math::sVector(
+		Dot(axes[0], i_direction) < 0.0f ? -halfExtents.x : halfExtents.x,
+		Dot(axes[1], i_direction) < 0.0f ? -halfExtents.y : halfExtents.y,
+		Dot(axes[2], i_direction) < 0.0f ? -halfExtents.z : halfExtents.z));
+}
+
+
+
+// Interface Implementation
+//============
+
+bool eae6320::Physics::Collision::IsOverlaps(cCollider* i_lhs, cCollider* i_rhs)
+{
+	return s_overlapTable[static_cast<uint8_t>(i_lhs->GetType())][static_cast<uint8_t>(i_rhs->GetType())](i_lhs, i_rhs);
+}
+
+
+void eae6320::Physics::Collision::Initialize(const std::vector<cCollider*>& i_allColliderList, uint8_t i_collisionType)
+{
+	GetDefaultWorld().Initialize(i_allColliderList, i_collisionType);
 }
 
 
 void eae6320::Physics::Collision::Update_CollisionDetection()
 {
-	if ((s_collisionType & eCollisionType::BroadPhase_SweepAndPrune) != 0)
-		CollisionDetection_BroadPhase_SweepAndPrune();
-	else if ((s_collisionType & eCollisionType::BroadPhase_BVH) != 0)
-		CollisionDetection_BroadPhase_BVH();
-	else
-		CollisionDetection_BroadPhase_SweepAndPrune();
+	GetDefaultWorld().Update_CollisionDetection();
 }
 
 
 void eae6320::Physics::Collision::Update_CollisionResolution()
 {
-	for (auto item : s_collisionMap)
-	{
-		// If the owner of the collider is not active, do nothing
-		if (item.first->m_gameobject.lock()->IsActive() == false)
-			continue;
-
-		cCollider* collider_lhs = item.first;
-		for (auto collider_rhs : item.second)
-		{
-			if (collider_lhs->m_gameobject.lock()->IsActive())
-				CollisionResolution(collider_lhs, collider_rhs);
-		}
-	}
+	GetDefaultWorld().Update_CollisionResolution();
 }
 
 
 void eae6320::Physics::Collision::RegisterCollider(cCollider* i_collider)
 {
-	if ((s_collisionType & eCollisionType::BroadPhase_SweepAndPrune) != 0)
-		RegisterCollider_SweepAndPrune(i_collider);
-	else if ((s_collisionType & eCollisionType::BroadPhase_BVH) != 0)
-		RegisterCollider_BVH(i_collider);
-	else
-		RegisterCollider_SweepAndPrune(i_collider);
+	GetDefaultWorld().RegisterCollider(i_collider);
+}
+
+
+void eae6320::Physics::Collision::RegisterColliders(const std::vector<cCollider*>& i_colliders)
+{
+	GetDefaultWorld().RegisterColliders(i_colliders);
 }
 
 
 eae6320::cResult eae6320::Physics::Collision::DeregisterCollider(cCollider* i_collider)
 {
-	if ((s_collisionType & eCollisionType::BroadPhase_SweepAndPrune) != 0)
-		return DeregisterCollider_SweepAndPrune(i_collider);
-	else if ((s_collisionType & eCollisionType::BroadPhase_BVH) != 0)
-		return DeregisterCollider_BVH(i_collider);
-	else
-		return DeregisterCollider_SweepAndPrune(i_collider);
+	return GetDefaultWorld().DeregisterCollider(i_collider);
 }
 
 
-std::list<std::pair<std::weak_ptr<eae6320::Graphics::cLine>, eae6320::Math::cMatrix_transformation>> eae6320::Physics::Collision::GetBVHRenderData()
+std::list<std::pair<eae6320::Graphics::cRenderHandle<eae6320::Graphics::cLine>, eae6320::Math::cMatrix_transformation>> eae6320::Physics::Collision::GetBVHRenderData()
 {
-	return s_BVHTree.GetRenderData();
+	return GetDefaultWorld().GetBVHRenderData();
 }
 
 
@@ -230,503 +300,769 @@ std::list<std::pair<std::weak_ptr<eae6320::Graphics::cLine>, eae6320::Math::cMat
 // Helper Funcitons Implementation
 //==================================
 
-// Broad Phase: Sweep and Prune
+// Contact Generation
 //============
 
-void eae6320::Physics::Collision::Initialize_SweepAndPrune(const std::vector<cCollider*>& i_allColliderList)
+bool eae6320::Physics::Collision::GenerateContact(cCollider* i_lhs, cCollider* i_rhs, sContactManifold& o_manifold)
 {
-	// Initialize buffers
-	{
-		s_orderedColliderList_xAxis = std::vector<cCollider*>(i_allColliderList);
-		s_orderedColliderList_yAxis = std::vector<cCollider*>(i_allColliderList);
-		s_orderedColliderList_zAxis = std::vector<cCollider*>(i_allColliderList);
+	// Keep the pair in the same order as the pair cache, so warm starting finds its impulse
+	if (i_rhs->GetID() < i_lhs->GetID())
+		std::swap(i_lhs, i_rhs);
 
-		for (cCollider* collider : i_allColliderList)
-		{
-			s_collisionMap[collider] = std::vector<cCollider*>(0);
-		}
-	}
+	o_manifold.lhs = i_lhs;
+	o_manifold.rhs = i_rhs;
 
-	// Initial collision detection
-	{
-		CollisionDetection_BroadPhase_SweepAndPrune();
-	}
+	return s_contactTable[static_cast<uint8_t>(i_lhs->GetType())][static_cast<uint8_t>(i_rhs->GetType())](i_lhs, i_rhs, o_manifold);
 }
 
 
-void eae6320::Physics::Collision::RegisterCollider_SweepAndPrune(cCollider* i_collider)
+bool eae6320::Physics::Collision::GenerateContact(const cSphereCollider* i_lhs, const cSphereCollider* i_rhs, sContactManifold& o_manifold)
 {
-	s_orderedColliderList_xAxis.push_back(i_collider);
-	s_orderedColliderList_yAxis.push_back(i_collider);
-	s_orderedColliderList_zAxis.push_back(i_collider);
+	const Math::sVector centroid_lhs = i_lhs->GetCentroid_world();
+	const Math::sVector centroid_rhs = i_rhs->GetCentroid_world();
 
-	s_collisionMap[i_collider] = std::vector<cCollider*>(0);
+	// normal start from the centroid of lhs, points to the centroid of rhs
+	Math::sVector collisionNormal = centroid_rhs - centroid_lhs;
+	const float centroidDistance = collisionNormal.GetLength();
+	const float radiusDistance = i_lhs->GetRadius() + i_rhs->GetRadius();
 
-	CollisionDetection_BroadPhase_SweepAndPrune();
+	if (centroidDistance > radiusDistance)
+		return false;
+
+	// Concentric spheres have no preferred direction, push them apart vertically
+	collisionNormal = (centroidDistance > 0.0f) ? (collisionNormal / centroidDistance) : Math::sVector(0.0f, 1.0f, 0.0f);
+
+	o_manifold.normal = collisionNormal;
+	o_manifold.depth = radiusDistance - centroidDistance;
+	o_manifold.point = centroid_lhs + collisionNormal * (i_lhs->GetRadius() - 0.5f * o_manifold.depth);
+	return true;
 }
 
 
-eae6320::cResult eae6320::Physics::Collision::DeregisterCollider_SweepAndPrune(cCollider* i_collider)
+bool eae6320::Physics::Collision::GenerateContact(const cAABBCollider* i_lhs, const cSphereCollider* i_rhs, sContactManifold& o_manifold)
 {
-	// Remove collider from axis order list
-	{
-		auto iter_xAxis = s_orderedColliderList_xAxis.begin();
-		auto iter_yAxis = s_orderedColliderList_yAxis.begin();
-		auto iter_zAxis = s_orderedColliderList_zAxis.begin();
+	const Math::sVector sphereCentroid = i_rhs->GetCentroid_world();
 
-		if ((iter_xAxis = std::find(s_orderedColliderList_xAxis.begin(), s_orderedColliderList_xAxis.end(), i_collider)) != s_orderedColliderList_xAxis.end() &&
-			(iter_yAxis = std::find(s_orderedColliderList_yAxis.begin(), s_orderedColliderList_yAxis.end(), i_collider)) != s_orderedColliderList_yAxis.end() &&
-			(iter_zAxis = std::find(s_orderedColliderList_zAxis.begin(), s_orderedColliderList_zAxis.end(), i_collider)) != s_orderedColliderList_zAxis.end())
-		{
-			s_orderedColliderList_xAxis.erase(iter_xAxis);
-			s_orderedColliderList_yAxis.erase(iter_yAxis);
-			s_orderedColliderList_zAxis.erase(iter_zAxis);
-		}
-		else
-		{
-			Logging::OutputError("Physics::Collision: Trying to remove a non-existed collider");
-			return Results::Failure;
-		}
-	}
+	// Closest point on or inside the AABB to the centroid of sphere
+	const Math::sVector closestPoint = i_lhs->GetClosestPoint(sphereCentroid);
+	const Math::sVector offset = sphereCentroid - closestPoint;
+	const float distance = offset.GetLength();
 
-	// Remove collider from collision map
+	// Centroid outside of the AABB: the normal points from the closest point to the centroid
+	if (distance > 0.0f)
 	{
-		auto iter = s_collisionMap.begin();
+		if (distance > i_rhs->GetRadius())
+			return false;
 
-		if ((iter = s_collisionMap.find(i_collider)) != s_collisionMap.end())
-		{
-			s_collisionMap.erase(i_collider);
-		}
-		else
-		{
-			Logging::OutputError("Physics::Collision: Trying to remove a non-existed collider");
-			return Results::Failure;
-		}
+		o_manifold.normal = offset / distance;
+		o_manifold.depth = i_rhs->GetRadius() - distance;
+		o_manifold.point = closestPoint - o_manifold.normal * (0.5f * o_manifold.depth);
+		return true;
 	}
 
-	// Re-calculate collision map
+	// Centroid inside of the AABB: push the sphere out through the nearest face
+	const Math::sVector minExtent = i_lhs->GetMinExtent_world();
+	const Math::sVector maxExtent = i_lhs->GetMaxExtent_world();
+
+	const float faceDistances[6] =
 	{
-		CollisionDetection_BroadPhase_SweepAndPrune();
+		sphereCentroid.x - minExtent.x, maxExtent.x - sphereCentroid.x,
+		sphereCentroid.y - minExtent.y, maxExtent.y - sphereCentroid.y,
+		sphereCentroid.z - minExtent.z, maxExtent.z - sphereCentroid.z,
+	};
+	const Math::sVector faceNormals[6] =
+	{
+		Math::sVector(-1.0f, 0.0f, 0.0f), Math::sVector(1.0f, 0.0f, 0.0f),
+		Math::sVector(0.0f, -1.0f, 0.0f), Math::sVector(0.0f, 1.0f, 0.0f),
+		Math::sVector(0.0f, 0.0f, -1.0f), Math::sVector(0.0f, 0.0f, 1.0f),
+	};
+
+	size_t nearestFace = 0;
+	for (size_t i = 1; i < 6; i++)
+	{
+		if (faceDistances[i] < faceDistances[nearestFace])
+			nearestFace = i;
 	}
 
-	return Results::Success;
+	o_manifold.normal = faceNormals[nearestFace];
+	o_manifold.depth = i_rhs->GetRadius() + faceDistances[nearestFace];
+	o_manifold.point = sphereCentroid;
+	return true;
 }
 
 
-void eae6320::Physics::Collision::CollisionDetection_BroadPhase_SweepAndPrune()
+bool eae6320::Physics::Collision::GenerateContact(const cAABBCollider* i_lhs, const cAABBCollider* i_rhs, sContactManifold& o_manifold)
 {
-	// Update collider data
+	const Math::sVector minExtent_lhs = i_lhs->GetMinExtent_world();
+	const Math::sVector maxExtent_lhs = i_lhs->GetMaxExtent_world();
+	const Math::sVector minExtent_rhs = i_rhs->GetMinExtent_world();
+	const Math::sVector maxExtent_rhs = i_rhs->GetMaxExtent_world();
+
+	// The intersection of the two boxes
+	const Math::sVector minOverlap = Math::sVector(
+		std::max(minExtent_lhs.x, minExtent_rhs.x), std::max(minExtent_lhs.y, minExtent_rhs.y), std::max(minExtent_lhs.z, minExtent_rhs.z));
+	const Math::sVector maxOverlap = Math::sVector(
+		std::min(maxExtent_lhs.x, maxExtent_rhs.x), std::min(maxExtent_lhs.y, maxExtent_rhs.y), std::min(maxExtent_lhs.z, maxExtent_rhs.z));
+	const Math::sVector overlap = maxOverlap - minOverlap;
+
+	if (overlap.x < 0.0f || overlap.y < 0.0f || overlap.z < 0.0f)
+		return false;
+
+	// The boxes get away from each other along the axis of least overlap
+	const Math::sVector centroidOffset = i_rhs->GetCentroid_world() - i_lhs->GetCentroid_world();
+	if (overlap.x <= overlap.y && overlap.x <= overlap.z)
 	{
-		std::sort(s_orderedColliderList_xAxis.begin(), s_orderedColliderList_xAxis.end(), s_comparator_xAxis);
-		std::sort(s_orderedColliderList_yAxis.begin(), s_orderedColliderList_yAxis.end(), s_comparator_yAxis);
-		std::sort(s_orderedColliderList_zAxis.begin(), s_orderedColliderList_zAxis.end(), s_comparator_zAxis);
+		o_manifold.normal = Math::sVector(centroidOffset.x < 0.0f ? -1.0f : 1.0f, 0.0f, 0.0f);
+		o_manifold.depth = overlap.x;
 	}
-
-	std::unordered_map<cCollider*, std::vector<cCollider*>> collisionMap_broadPhase;
-	for (const auto& item : s_collisionMap)
+	else if (overlap.y <= overlap.z)
 	{
-		collisionMap_broadPhase[item.first] = std::vector<cCollider*>(0);
+		o_manifold.normal = Math::sVector(0.0f, centroidOffset.y < 0.0f ? -1.0f : 1.0f, 0.0f);
+		o_manifold.depth = overlap.y;
 	}
-
-	// Sweep and prune the X axis
+	else
 	{
-		// Iterate X axis, find all potential collision along X axis
-		for (size_t i = 0; i < s_orderedColliderList_xAxis.size() - 1; i++)
-		{
-			for (size_t j = i + 1; j < s_orderedColliderList_xAxis.size(); j++)
-			{
-				cCollider* collider_i = s_orderedColliderList_xAxis[i];
-				cCollider* collider_j = s_orderedColliderList_xAxis[j];
-
-				// Possible to have collision
-				if (collider_i->GetMaxExtent_world().x >= collider_j->GetMinExtent_world().x)
-				{
-					collisionMap_broadPhase[collider_i].push_back(collider_j);
-				}
-				// Impossbile to have collision
-				else
-				{
-					break;
-				}
-			}
-		}
+		o_manifold.normal = Math::sVector(0.0f, 0.0f, centroidOffset.z < 0.0f ? -1.0f : 1.0f);
+		o_manifold.depth = overlap.z;
 	}
 
-	// Sweep and prune the Y axis
-	{
-		// Create buffer
-		std::unordered_map<cCollider*, std::vector<cCollider*>> collisionAtYAxis;
-		for (const auto& item : collisionMap_broadPhase)
-		{
-			collisionAtYAxis[item.first] = std::vector<cCollider*>(0);
-		}
+	o_manifold.point = (minOverlap + maxOverlap) * 0.5f;
+	return true;
+}
 
-		// Iterate Y axis, find all potential collision along Y axis, select those who already have potential collision in X axis 
-		for (size_t i = 0; i < s_orderedColliderList_yAxis.size() - 1; i++)
-		{
-			for (size_t j = i + 1; j < s_orderedColliderList_yAxis.size(); j++)
-			{
-				cCollider* collider_i = s_orderedColliderList_yAxis[i];
-				cCollider* collider_j = s_orderedColliderList_yAxis[j];
-
-				// Possible to have collision
-				if (collider_i->GetMaxExtent_world().y >= collider_j->GetMinExtent_world().y)
-				{
-					const auto& collisionList_i = collisionMap_broadPhase[collider_i];
-					const auto& collisionList_j = collisionMap_broadPhase[collider_j];
-
-					if (std::find(collisionList_i.begin(), collisionList_i.end(), collider_j) != collisionList_i.end())
-						collisionAtYAxis[collider_i].push_back(collider_j);
-					else if (std::find(collisionList_j.begin(), collisionList_j.end(), collider_i) != collisionList_j.end())
-						collisionAtYAxis[collider_j].push_back(collider_i);
-				}
-				// Impossbile to have collision
-				else
-				{
-					break;
-				}
-			}
-		}
 
-		for (auto& collision : collisionMap_broadPhase)
-		{
-			collision.second.swap(collisionAtYAxis[collision.first]);
-		}
-	}
+bool eae6320::Physics::Collision::GenerateContact(const cAABBCollider* i_lhs, const cOBBCollider* i_rhs, sContactManifold& o_manifold)
+{
+	return GenerateContact_Boxes(sOrientedBox(i_lhs->GetMinExtent_world(), i_lhs->GetMaxExtent_world()), i_rhs->GetBox_world(), o_manifold);
+}
+
+
+bool eae6320::Physics::Collision::GenerateContact(const cAABBCollider* i_lhs, const cCapsuleCollider* i_rhs, sContactManifold& o_manifold)
+{
+	Math::sVector pointA, pointB;
+	i_rhs->GetSegment_world(pointA, pointB);
+	return GenerateContact_BoxSegment(sOrientedBox(i_lhs->GetMinExtent_world(), i_lhs->GetMaxExtent_world()), pointA, pointB,
+		i_rhs->GetRadius(), o_manifold);
+}
+
+
+bool eae6320::Physics::Collision::GenerateContact(const cOBBCollider* i_lhs, const cSphereCollider* i_rhs, sContactManifold& o_manifold)
+{
+	const Math::sVector centroid = i_rhs->GetCentroid_world();
+	return GenerateContact_BoxSegment(i_lhs->GetBox_world(), centroid, centroid, i_rhs->GetRadius(), o_manifold);
+}
+
 
-	// Sweep and prune the Z axis
+bool eae6320::Physics::Collision::GenerateContact(const cOBBCollider* i_lhs, const cOBBCollider* i_rhs, sContactManifold& o_manifold)
+{
+	return GenerateContact_Boxes(i_lhs->GetBox_world(), i_rhs->GetBox_world(), o_manifold);
+}
+
+
+bool eae6320::Physics::Collision::GenerateContact(const cOBBCollider* i_lhs, const cCapsuleCollider* i_rhs, sContactManifold& o_manifold)
+{
+	Math::sVector pointA, pointB;
+	i_rhs->GetSegment_world(pointA, pointB);
+	return GenerateContact_BoxSegment(i_lhs->GetBox_world(), pointA, pointB, i_rhs->GetRadius(), o_manifold);
+}
+
+
+bool eae6320::Physics::Collision::GenerateContact(const cSphereCollider* i_lhs, const cCapsuleCollider* i_rhs, sContactManifold& o_manifold)
+{
+	const Math::sVector centroid = i_lhs->GetCentroid_world();
+	Math::sVector pointA, pointB;
+	i_rhs->GetSegment_world(pointA, pointB);
+	return GenerateContact_Segments(centroid, centroid, i_lhs->GetRadius(), pointA, pointB, i_rhs->GetRadius(), o_manifold);
+}
+
+
+bool eae6320::Physics::Collision::GenerateContact(const cCapsuleCollider* i_lhs, const cCapsuleCollider* i_rhs, sContactManifold& o_manifold)
+{
+	Math::sVector pointA_lhs, pointB_lhs, pointA_rhs, pointB_rhs;
+	i_lhs->GetSegment_world(pointA_lhs, pointB_lhs);
+	i_rhs->GetSegment_world(pointA_rhs, pointB_rhs);
+	return GenerateContact_Segments(pointA_lhs, pointB_lhs, i_lhs->GetRadius(), pointA_rhs, pointB_rhs, i_rhs->GetRadius(), o_manifold);
+}
+
+
+bool eae6320::Physics::Collision::GenerateContact_Segments(const Math::sVector& i_pointA_lhs, const Math::sVector& i_pointB_lhs, float i_radius_lhs,
+	const Math::sVector& i_pointA_rhs, const Math::sVector& i_pointB_rhs, float i_radius_rhs, sContactManifold& o_manifold)
+{
+	// Same as two spheres, centered on the closest points of the segments
+	float t_lhs, t_rhs;
+	GetClosestPointsOfSegments(i_pointA_lhs, i_pointB_lhs, i_pointA_rhs, i_pointB_rhs, t_lhs, t_rhs);
+	const Math::sVector closestPoint_lhs = i_pointA_lhs + (i_pointB_lhs - i_pointA_lhs) * t_lhs;
+	const Math::sVector closestPoint_rhs = i_pointA_rhs + (i_pointB_rhs - i_pointA_rhs) * t_rhs;
+
+	Math::sVector collisionNormal = closestPoint_rhs - closestPoint_lhs;
+	const float distance = collisionNormal.GetLength();
+	const float radiusDistance = i_radius_lhs + i_radius_rhs;
+
+	if (distance > radiusDistance)
+		return false;
+
+	// Crossing segments have no preferred direction, push them apart vertically
+	collisionNormal = (distance > 0.0f) ? (collisionNormal / distance) : Math::sVector(0.0f, 1.0f, 0.0f);
+
+	o_manifold.normal = collisionNormal;
+	o_manifold.depth = radiusDistance - distance;
+	o_manifold.point = closestPoint_lhs + collisionNormal * (i_radius_lhs - 0.5f * o_manifold.depth);
+	return true;
+}
+
+
+bool eae6320::Physics::Collision::GenerateContact_BoxSegment(const sOrientedBox& i_box, const Math::sVector& i_pointA, const Math::sVector& i_pointB, float i_radius,
+	sContactManifold& o_manifold)
+{
+	Math::sVector boxPoint;
+	const float t = GetClosestPointOfSegmentAndBox(i_pointA, i_pointB, i_box, boxPoint);
+	const Math::sVector segmentPoint = i_pointA + (i_pointB - i_pointA) * t;
+	const Math::sVector offset = segmentPoint - boxPoint;
+	const float distance = offset.GetLength();
+
+	// Segment outside of the box: the normal points from the closest point of the box to the segment
+	if (distance > 0.0f)
 	{
-		// Create buffer
-		std::unordered_map<cCollider*, std::vector<cCollider*>> collisionAtZAxis;
-		for (const auto& item : collisionMap_broadPhase)
-		{
-			collisionAtZAxis[item.first] = std::vector<cCollider*>(0);
-		}
+		if (distance > i_radius)
+			return false;
 
-		// Iterate Z axis, find all potential collision along Z axis, select those who already have potential collision in X and Y axis 
-		for (size_t i = 0; i < s_orderedColliderList_zAxis.size() - 1; i++)
-		{
-			for (size_t j = i + 1; j < s_orderedColliderList_zAxis.size(); j++)
-			{
-				cCollider* collider_i = s_orderedColliderList_zAxis[i];
-				cCollider* collider_j = s_orderedColliderList_zAxis[j];
-
-				// Possible to have collision
-				if (collider_i->GetMaxExtent_world().z >= collider_j->GetMinExtent_world().z)
-				{
-					const auto& collisionList_i = collisionMap_broadPhase[collider_i];
-					const auto& collisionList_j = collisionMap_broadPhase[collider_j];
-
-					if (std::find(collisionList_i.begin(), collisionList_i.end(), collider_j) != collisionList_i.end())
-						collisionAtZAxis[collider_i].push_back(collider_j);
-					else if (std::find(collisionList_j.begin(), collisionList_j.end(), collider_i) != collisionList_j.end())
-						collisionAtZAxis[collider_j].push_back(collider_i);
-				}
-				// Impossbile to have collision
-				else
-				{
-					break;
-				}
-			}
-		}
+		o_manifold.normal = offset / distance;
+		o_manifold.depth = i_radius - distance;
+		o_manifold.point = boxPoint - o_manifold.normal * (0.5f * o_manifold.depth);
+		return true;
+	}
+
+	// Segment inside of the box: push it out through the face nearest to the point found
+	const Math::sVector point_local = i_box.ToLocal(segmentPoint);
+	const float position[3] = { point_local.x, point_local.y, point_local.z };
+	const float halfExtents[3] = { i_box.halfExtents.x, i_box.halfExtents.y, i_box.halfExtents.z };
 
-		for (auto& collision : collisionMap_broadPhase)
+	size_t nearestAxis = 0;
+	float nearestFaceDistance = std::numeric_limits<float>::max();
+	for (size_t axis = 0; axis < 3; axis++)
+	{
+		const float faceDistance = halfExtents[axis] - std::abs(position[axis]);
+		if (faceDistance < nearestFaceDistance)
 		{
-			collision.second.swap(collisionAtZAxis[collision.first]);
+			nearestFaceDistance = faceDistance;
+			nearestAxis = axis;
 		}
 	}
 
-	// Proceed to narrow phase collision detection
-	{
-		if ((s_collisionType & eCollisionType::NarrowPhase_Overlaps) != 0)
-			CollisionDetection_NarrowPhase_Overlap(collisionMap_broadPhase);
-		else
-			CollisionDetection_NarrowPhase_Overlap(collisionMap_broadPhase);
-	}
-	
+	o_manifold.normal = (position[nearestAxis] < 0.0f) ? -i_box.axes[nearestAxis] : i_box.axes[nearestAxis];
+	o_manifold.depth = i_radius + nearestFaceDistance;
+	o_manifold.point = segmentPoint;
+	return true;
+}
+
+
+bool eae6320::Physics::Collision::GenerateContact_Boxes(const sOrientedBox& i_lhs, const sOrientedBox& i_rhs, sContactManifold& o_manifold)
+{
+	if (!IsOverlaps(i_lhs, i_rhs, o_manifold.normal, o_manifold.depth))
+		return false;
+
+	// The corner of rhs that is the deepest inside lhs, moved halfway out.
+	// The solver only uses the normal and the depth, so a single point is enough
+	o_manifold.point = i_rhs.GetSupportPoint(-o_manifold.normal) + o_manifold.normal * (0.5f * o_manifold.depth);
+	return true;
 }
 
 
 
-// Broad Phase: BVH Tree
+// Time of Impact
 //============
 
-void eae6320::Physics::Collision::Initialize_BVH(const std::vector<cCollider*>& i_allColliderList)
+bool eae6320::Physics::Collision::Sweep(const cCollider* i_collider, const Math::sVector& i_translation, const cCollider* i_target, float& o_timeOfImpact)
 {
-	// Initialize buffer
-	for (cCollider* collider : i_allColliderList)
-	{
-		s_collisionMap[collider] = std::vector<cCollider*>(0);
-	}
+	return s_sweepTable[static_cast<uint8_t>(i_collider->GetType())][static_cast<uint8_t>(i_target->GetType())](i_collider, i_translation, i_target, o_timeOfImpact);
+}
 
-	// Initialize collision detection
-	for (cCollider* collider : i_allColliderList)
-	{
-		s_BVHTree.Add(collider);
-	}
 
-	// Initialize BVH tree rendering data
-	//s_BVHTree.InitialzieRenderData();
+bool eae6320::Physics::Collision::Sweep(const cSphereCollider* i_collider, const Math::sVector& i_translation, const cSphereCollider* i_target, float& o_timeOfImpact)
+{
+	// The centroid of the moving sphere against the target grown by the moving radius
+	Math::sVector normal;
+	return RayCastSphere(i_collider->GetCentroid_world() - i_translation, i_translation, 1.0f,
+		i_target->GetCentroid_world(), i_target->GetRadius() + i_collider->GetRadius(), o_timeOfImpact, normal);
+}
 
-	// Initial collision detection
-	CollisionDetection_BroadPhase_BVH();
+
+bool eae6320::Physics::Collision::Sweep(const cSphereCollider* i_collider, const Math::sVector& i_translation, const cAABBCollider* i_target, float& o_timeOfImpact)
+{
+	// The box is grown by the radius without rounding its edges, so hits near an edge come slightly early
+	const Math::sVector margin = Math::sVector(i_collider->GetRadius(), i_collider->GetRadius(), i_collider->GetRadius());
+
+	Math::sVector normal;
+	return RayCastBox(i_collider->GetCentroid_world() - i_translation, i_translation, 1.0f,
+		i_target->GetMinExtent_world() - margin, i_target->GetMaxExtent_world() + margin, o_timeOfImpact, normal);
 }
 
 
-void eae6320::Physics::Collision::RegisterCollider_BVH(cCollider* i_collider)
+bool eae6320::Physics::Collision::Sweep(const cAABBCollider* i_collider, const Math::sVector& i_translation, const cSphereCollider* i_target, float& o_timeOfImpact)
 {
-	s_BVHTree.Add(i_collider);
-	s_collisionMap[i_collider] = std::vector<cCollider*>(0);
+	// The sphere is treated as its bounding box here, which is slightly early near the corners as well
+	const Math::sVector halfExtent = (i_collider->GetMaxExtent_world() - i_collider->GetMinExtent_world()) * 0.5f;
+	const Math::sVector margin = halfExtent + i_target->GetRadius();
 
-	CollisionDetection_BroadPhase_BVH();
+	Math::sVector normal;
+	return RayCastBox(i_collider->GetCentroid_world() - i_translation, i_translation, 1.0f,
+		i_target->GetCentroid_world() - margin, i_target->GetCentroid_world() + margin, o_timeOfImpact, normal);
 }
 
 
-eae6320::cResult eae6320::Physics::Collision::DeregisterCollider_BVH(cCollider* i_collider)
+bool eae6320::Physics::Collision::Sweep(const cAABBCollider* i_collider, const Math::sVector& i_translation, const cAABBCollider* i_target, float& o_timeOfImpact)
 {
-	// Remove collider from BVH tree
-	s_BVHTree.Remove(i_collider);
+	// The centroid of the moving box against the target grown by the half extent of the moving box
+	const Math::sVector halfExtent = (i_collider->GetMaxExtent_world() - i_collider->GetMinExtent_world()) * 0.5f;
 
-	// Remove collider from collision map
-	{
-		auto iter = s_collisionMap.begin();
+	Math::sVector normal;
+	return RayCastBox(i_collider->GetCentroid_world() - i_translation, i_translation, 1.0f,
+		i_target->GetMinExtent_world() - halfExtent, i_target->GetMaxExtent_world() + halfExtent, o_timeOfImpact, normal);
+}
+
+
+bool eae6320::Physics::Collision::Sweep(const cSphereCollider* i_collider, const Math::sVector& i_translation, const cOBBCollider* i_target, float& o_timeOfImpact)
+{
+	// Same as against an AABB, in the frame of the box
+	sOrientedBox box = i_target->GetBox_world();
+	box.halfExtents += i_collider->GetRadius();
+
+	Math::sVector normal;
+	return RayCastBox(i_collider->GetCentroid_world() - i_translation, i_translation, 1.0f, box, o_timeOfImpact, normal);
+}
+
+
+bool eae6320::Physics::Collision::Sweep(const cSphereCollider* i_collider, const Math::sVector& i_translation, const cCapsuleCollider* i_target, float& o_timeOfImpact)
+{
+	// A capsule grown by a radius is still a capsule, so this one is exact
+	Math::sVector pointA, pointB, normal;
+	i_target->GetSegment_world(pointA, pointB);
+	return RayCastCapsule(i_collider->GetCentroid_world() - i_translation, i_translation, 1.0f,
+		pointA, pointB, i_target->GetRadius() + i_collider->GetRadius(), o_timeOfImpact, normal);
+}
+
+
+bool eae6320::Physics::Collision::Sweep(const cCapsuleCollider* i_collider, const Math::sVector& i_translation, const cSphereCollider* i_target, float& o_timeOfImpact)
+{
+	// The sphere moving the other way against the capsule where it started
+	Math::sVector pointA, pointB, normal;
+	i_collider->GetSegment_world(pointA, pointB);
+	return RayCastCapsule(i_target->GetCentroid_world(), -i_translation, 1.0f,
+		pointA - i_translation, pointB - i_translation, i_collider->GetRadius() + i_target->GetRadius(), o_timeOfImpact, normal);
+}
 
-		if ((iter = s_collisionMap.find(i_collider)) != s_collisionMap.end())
+
+bool eae6320::Physics::Collision::RayCastSphere(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxT,
+	const Math::sVector& i_center, float i_radius, float& o_t, Math::sVector& o_normal)
+{
+	// Solve |origin + t * direction - center| = radius for the smaller t
+	const Math::sVector offset = i_origin - i_center;
+	const float a = Dot(i_direction, i_direction);
+	const float b = Dot(offset, i_direction);
+	const float c = Dot(offset, offset) - i_radius * i_radius;
+
+	// Starting inside, not moving, or moving away
+	if (c <= 0.0f || a <= 0.0f || b >= 0.0f)
+		return false;
+
+	const float discriminant = b * b - a * c;
+	if (discriminant < 0.0f)
+		return false;
+
+	const float t = (-b - std::sqrt(discriminant)) / a;
+	if (t > i_maxT)
+		return false;
+
+	o_t = t;
+	o_normal = (offset + i_direction * t) / i_radius;
+	return true;
+}
+
+
+bool eae6320::Physics::Collision::RayCastBox(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxT,
+	const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, float& o_t, Math::sVector& o_normal)
+{
+	const float origin[3] = { i_origin.x, i_origin.y, i_origin.z };
+	const float direction[3] = { i_direction.x, i_direction.y, i_direction.z };
+	const float minExtent[3] = { i_minExtent.x, i_minExtent.y, i_minExtent.z };
+	const float maxExtent[3] = { i_maxExtent.x, i_maxExtent.y, i_maxExtent.z };
+
+	// Intersect the slabs of the three axes, the ray is inside the box between the last entry and the first exit
+	float entry = -std::numeric_limits<float>::max();
+	float exit = std::numeric_limits<float>::max();
+	size_t entryAxis = 0;
+	for (size_t axis = 0; axis < 3; axis++)
+	{
+		if (direction[axis] == 0.0f)
 		{
-			s_collisionMap.erase(i_collider);
+			if (origin[axis] < minExtent[axis] || origin[axis] > maxExtent[axis])
+				return false;
+			continue;
 		}
-		else
+
+		float t0 = (minExtent[axis] - origin[axis]) / direction[axis];
+		float t1 = (maxExtent[axis] - origin[axis]) / direction[axis];
+		if (t0 > t1)
+			std::swap(t0, t1);
+
+		if (t0 > entry)
 		{
-			Logging::OutputError("Physics::Collision: Trying to remove a non-existed collider");
-			return Results::Failure;
+			entry = t0;
+			entryAxis = axis;
 		}
+		exit = std::min(exit, t1);
+		if (entry > exit)
+			return false;
 	}
 
-	// Re-calculate collision map
-	CollisionDetection_BroadPhase_BVH();
+	// A ray that starts inside entered the box before its origin
+	if (entry < 0.0f || entry > i_maxT)
+		return false;
+
+	float normal[3] = { 0.0f, 0.0f, 0.0f };
+	normal[entryAxis] = (direction[entryAxis] > 0.0f) ? -1.0f : 1.0f;
 
-	return Results::Success;
+	o_t = entry;
+	o_normal = Math::sVector(normal[0], normal[1], normal[2]);
+	return true;
 }
 
 
-void eae6320::Physics::Collision::CollisionDetection_BroadPhase_BVH()
+bool eae6320::Physics::Collision::RayCastCapsule(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxT,
+	const Math::sVector& i_pointA, const Math::sVector& i_pointB, float i_radius, float& o_t, Math::sVector& o_normal)
 {
-	// Update collider data
-	s_BVHTree.Update();
-
-	// Collision detection for each colliders
-	std::unordered_map<cCollider*, std::vector<cCollider*>> collisionMap_broadPhase;
-	for (const auto& item : s_collisionMap)
-	{
-		// If the owner of the collider is not active, do nothing
-		if (item.first->m_gameobject.lock()->IsActive() == false)
-			continue;
-
-		collisionMap_broadPhase[item.first] = std::vector<cCollider*>(0);
+	// Starting inside
+	const float t_start = GetClosestPointOnSegment(i_origin, i_pointA, i_pointB);
+	if (Math::SqDistance(i_origin, i_pointA + (i_pointB - i_pointA) * t_start) <= i_radius * i_radius)
+		return false;
 
-		std::vector<cCollider*> collisionList = s_BVHTree.Query(item.first);
+	bool isHit = false;
+	float t = i_maxT;
+	Math::sVector normal;
 
-		// Ignore duplicate collision
-		for (cCollider* collider : collisionList)
+	// The side of the capsule: solve |offset from the axis| = radius for the smaller t,
+	// with the hit between the two end caps
+	const Math::sVector axis = i_pointB - i_pointA;
+	const Math::sVector offset = i_origin - i_pointA;
+	const float axisAxis = Dot(axis, axis);
+	if (axisAxis > 0.0f)
+	{
+		const float axisDirection = Dot(axis, i_direction);
+		const float axisOffset = Dot(axis, offset);
+		const float a = axisAxis * Dot(i_direction, i_direction) - axisDirection * axisDirection;
+		const float b = axisAxis * Dot(offset, i_direction) - axisOffset * axisDirection;
+		const float c = axisAxis * (Dot(offset, offset) - i_radius * i_radius) - axisOffset * axisOffset;
+
+		// A ray parallel to the axis can only hit an end cap
+		const float discriminant = b * b - a * c;
+		if (a > 0.0f && discriminant >= 0.0f)
 		{
-			if (collisionMap_broadPhase.find(collider) == collisionMap_broadPhase.end() &&
-				collider->m_gameobject.lock()->IsActive())
-				collisionMap_broadPhase[item.first].push_back(collider);
+			const float t_side = (-b - std::sqrt(discriminant)) / a;
+			const float axial = axisOffset + t_side * axisDirection;
+			if (t_side >= 0.0f && t_side <= t && axial >= 0.0f && axial <= axisAxis)
+			{
+				isHit = true;
+				t = t_side;
+				normal = (offset + i_direction * t_side - axis * (axial / axisAxis)) / i_radius;
+			}
 		}
 	}
 
-	// Proceed to narrow phase collision detection
+	// The end caps
+	const Math::sVector caps[2] = { i_pointA, i_pointB };
+	for (const auto& cap : caps)
 	{
-		if ((s_collisionType & eCollisionType::NarrowPhase_Overlaps) != 0)
-			CollisionDetection_NarrowPhase_Overlap(collisionMap_broadPhase);
-		else
-			CollisionDetection_NarrowPhase_Overlap(collisionMap_broadPhase);
+		float t_cap;
+		Math::sVector normal_cap;
+		if (RayCastSphere(i_origin, i_direction, t, cap, i_radius, t_cap, normal_cap) && (!isHit || t_cap < t))
+		{
+			isHit = true;
+			t = t_cap;
+			normal = normal_cap;
+		}
 	}
+
+	if (!isHit)
+		return false;
+
+	o_t = t;
+	o_normal = normal;
+	return true;
+}
+
+
+bool eae6320::Physics::Collision::RayCastBox(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxT,
+	const sOrientedBox& i_box, float& o_t, Math::sVector& o_normal)
+{
+	// The axes of the box are orthonormal, so t is the same in its frame
+	const Math::sVector direction_local = Math::sVector(
+		Dot(i_direction, i_box.axes[0]), Dot(i_direction, i_box.axes[1]), Dot(i_direction, i_box.axes[2]));
+
+	Math::sVector normal_local;
+	if (!RayCastBox(i_box.ToLocal(i_origin), direction_local, i_maxT, -i_box.halfExtents, i_box.halfExtents, o_t, normal_local))
+		return false;
+
+	o_normal = i_box.axes[0] * normal_local.x + i_box.axes[1] * normal_local.y + i_box.axes[2] * normal_local.z;
+	return true;
 }
 
 
 
-// Narrow Phase
+// Closest Points
 //============
 
-void eae6320::Physics::Collision::CollisionDetection_NarrowPhase_Overlap(std::unordered_map<cCollider*, std::vector<cCollider*>>& i_CollisionMap_broadPhase)
+float eae6320::Physics::Collision::GetClosestPointOnSegment(const Math::sVector& i_point, const Math::sVector& i_pointA, const Math::sVector& i_pointB)
 {
-	// Perform narrow phase collision detection for the data from broad phase
+	const Math::sVector segment = i_pointB - i_pointA;
+	const float lengthSquared = Dot(segment, segment);
+	if (lengthSquared <= 0.0f)
+		return 0.0f;
+
+	return std::min(std::max(Dot(i_point - i_pointA, segment) / lengthSquared, 0.0f), 1.0f);
+}
+
+
+void eae6320::Physics::Collision::GetClosestPointsOfSegments(const Math::sVector& i_pointA0, const Math::sVector& i_pointB0,
+	const Math::sVector& i_pointA1, const Math::sVector& i_pointB1, float& o_t0, float& o_t1)
+{
+	// Real-Time Collision Detection, 5.1.9
+	const Math::sVector segment0 = i_pointB0 - i_pointA0;
+	const Math::sVector segment1 = i_pointB1 - i_pointA1;
+	const Math::sVector offset = i_pointA0 - i_pointA1;
+	const float lengthSquared0 = Dot(segment0, segment0);
+	const float lengthSquared1 = Dot(segment1, segment1);
+	const float offset1 = Dot(segment1, offset);
+
+	// Either or both segments are points
+	if (lengthSquared0 <= 0.0f && lengthSquared1 <= 0.0f)
 	{
-		for (auto& collision : i_CollisionMap_broadPhase)
-		{
-			cCollider* collider_lhs = collision.first;
+		o_t0 = o_t1 = 0.0f;
+		return;
+	}
+	if (lengthSquared0 <= 0.0f)
+	{
+		o_t0 = 0.0f;
+		o_t1 = std::min(std::max(offset1 / lengthSquared1, 0.0f), 1.0f);
+		return;
+	}
+
+	const float offset0 = Dot(segment0, offset);
+	if (lengthSquared1 <= 0.0f)
+	{
+		o_t0 = std::min(std::max(-offset0 / lengthSquared0, 0.0f), 1.0f);
+		o_t1 = 0.0f;
+		return;
+	}
+
+	// The closest points of the two lines, with the first one clamped to its segment.
+	// Parallel segments have no single closest point, any t0 works
+	const float segment01 = Dot(segment0, segment1);
+	const float denominator = lengthSquared0 * lengthSquared1 - segment01 * segment01;
+	float t0 = (denominator > 0.0f) ? std::min(std::max((segment01 * offset1 - offset0 * lengthSquared1) / denominator, 0.0f), 1.0f) : 0.0f;
+
+	// The point of the second segment closest to that one, and if it had to be clamped, the first point again
+	float t1 = (segment01 * t0 + offset1) / lengthSquared1;
+	if (t1 < 0.0f)
+	{
+		t1 = 0.0f;
+		t0 = std::min(std::max(-offset0 / lengthSquared0, 0.0f), 1.0f);
+	}
+	else if (t1 > 1.0f)
+	{
+		t1 = 1.0f;
+		t0 = std::min(std::max((segment01 - offset0) / lengthSquared0, 0.0f), 1.0f);
+	}
 
-			auto iter = collision.second.begin();
-			while (iter != collision.second.end())
+	o_t0 = t0;
+	o_t1 = t1;
+}
+
+
+float eae6320::Physics::Collision::GetClosestPointOfSegmentAndBox(const Math::sVector& i_pointA, const Math::sVector& i_pointB, const sOrientedBox& i_box,
+	Math::sVector& o_boxPoint)
+{
+	// Search in the frame of the box, where the closest point of the box is a clamp
+	const Math::sVector pointA_local = i_box.ToLocal(i_pointA);
+	const Math::sVector segment_local = i_box.ToLocal(i_pointB) - pointA_local;
+	const auto GetSqDistance = [&](float i_t)
+	{
+		const Math::sVector point = pointA_local + segment_local * i_t;
+		return Math::SqDistance(point, Math::Min(Math::Max(point, -i_box.halfExtents), i_box.halfExtents));
+	};
+
+	// Each iteration keeps 0.618 of the interval, 24 of them leave less than 1e-5 of the segment
+	constexpr float goldenRatio = 0.618034f;
+	constexpr size_t iterationCount = 24;
+
+	float t = 0.0f;
+	if (Dot(segment_local, segment_local) > 0.0f)
+	{
+		float lower = 0.0f, upper = 1.0f;
+		float t0 = upper - goldenRatio, t1 = lower + goldenRatio;
+		float sqDistance0 = GetSqDistance(t0), sqDistance1 = GetSqDistance(t1);
+		for (size_t i = 0; i < iterationCount; i++)
+		{
+			if (sqDistance0 <= sqDistance1)
 			{
-				if (IsOverlaps(collider_lhs, *iter) == false)
-				{
-					iter = collision.second.erase(iter);
-				}
-				else
-				{
-					iter++;
-				}
+				upper = t1;
+				t1 = t0;
+				sqDistance1 = sqDistance0;
+				t0 = upper - goldenRatio * (upper - lower);
+				sqDistance0 = GetSqDistance(t0);
+			}
+			else
+			{
+				lower = t0;
+				t0 = t1;
+				sqDistance0 = sqDistance1;
+				t1 = lower + goldenRatio * (upper - lower);
+				sqDistance1 = GetSqDistance(t1);
 			}
-
-			collision.second.shrink_to_fit();
 		}
-	}
+		t = (lower + upper) * 0.5f;
 
-	InvokeCollisionCallback(i_CollisionMap_broadPhase);
+		// The search never reaches the end points themselves
+		if (GetSqDistance(0.0f) < GetSqDistance(t))
+			t = 0.0f;
+		if (GetSqDistance(1.0f) < GetSqDistance(t))
+			t = 1.0f;
+	}
 
-	s_collisionMap.swap(i_CollisionMap_broadPhase);
+	const Math::sVector point_local = pointA_local + segment_local * t;
+	o_boxPoint = i_box.ToWorld(Math::Min(Math::Max(point_local, -i_box.halfExtents), i_box.halfExtents));
+	return t;
 }
 
 
-void eae6320::Physics::Collision::InvokeCollisionCallback(std::unordered_map<cCollider*, std::vector<cCollider*>>& i_newCollisionMap)
+bool eae6320::Physics::Collision::IsOverlaps(const sOrientedBox& i_lhs, const sOrientedBox& i_rhs, Math::sVector& o_normal, float& o_depth)
 {
-	// Invoke OnCollisionExit for colliders that on longer overlap in current frame 
+	// Edge axes are only taken when they are clearly shallower than the best face axis,
+	// otherwise nearly parallel edges make the normal flicker between frames
+	constexpr float edgeAxisBias = 1.05f;
+	// Cross products of nearly parallel edges are too short to be normalized reliably, their faces are tested already
+	constexpr float minCrossLengthSquared = 1.0e-6f;
+
+	const Math::sVector centerOffset = i_rhs.center - i_lhs.center;
+	float minDepth = std::numeric_limits<float>::max();
+	Math::sVector minAxis;
+
+	// Depth of the boxes along a unit axis, negative if the axis separates them
+	const auto GetDepth = [&](const Math::sVector& i_axis)
 	{
-		for (const auto& collision : s_collisionMap)
-		{
-			cCollider* collider_lhs = collision.first;
+		return i_lhs.GetProjectedRadius(i_axis) + i_rhs.GetProjectedRadius(i_axis) - std::abs(Dot(centerOffset, i_axis));
+	};
 
-			for (cCollider* collider_rhs : collision.second)
+	for (size_t i = 0; i < 2; i++)
+	{
+		const sOrientedBox& box = (i == 0) ? i_lhs : i_rhs;
+		for (const auto& axis : box.axes)
+		{
+			const float depth = GetDepth(axis);
+			if (depth < 0.0f)
+				return false;
+			if (depth < minDepth)
 			{
-				if ((i_newCollisionMap.find(collider_lhs) == i_newCollisionMap.end() ||
-						std::find(i_newCollisionMap[collider_lhs].begin(), i_newCollisionMap[collider_lhs].end(), collider_rhs) == i_newCollisionMap[collider_lhs].end()) &&
-					(i_newCollisionMap.find(collider_rhs) == i_newCollisionMap.end() || 
-						std::find(i_newCollisionMap[collider_rhs].begin(), i_newCollisionMap[collider_rhs].end(), collider_lhs) == i_newCollisionMap[collider_rhs].end()))
-				{
-					if (collider_lhs->OnCollisionExit != nullptr && collider_lhs->m_gameobject.lock()->IsActive())
-						collider_lhs->OnCollisionExit(collider_lhs, collider_rhs);
-					if (collider_rhs->OnCollisionExit != nullptr && collider_rhs->m_gameobject.lock()->IsActive())
-						collider_rhs->OnCollisionExit(collider_rhs, collider_lhs);
-				}
+				minDepth = depth;
+				minAxis = axis;
 			}
 		}
 	}
 
-	// Invoke OnCollisionEnter and OnCollisionStay for colliders that having overlap in current frame 
+	for (const auto& axis_lhs : i_lhs.axes)
 	{
-		for (const auto& collision : i_newCollisionMap)
+		for (const auto& axis_rhs : i_rhs.axes)
 		{
-			cCollider* collider_lhs = collision.first;
-
-			for (cCollider* collider_rhs : collision.second)
+			Math::sVector axis = Cross(axis_lhs, axis_rhs);
+			const float lengthSquared = Dot(axis, axis);
+			if (lengthSquared < minCrossLengthSquared)
+				continue;
+			axis /= std::sqrt(lengthSquared);
+
+			const float depth = GetDepth(axis);
+			if (depth < 0.0f)
+				return false;
+			if (depth * edgeAxisBias < minDepth)
 			{
-				if ((s_collisionMap.find(collider_lhs) == s_collisionMap.end() ||
-						std::find(s_collisionMap[collider_lhs].begin(), s_collisionMap[collider_lhs].end(), collider_rhs) == s_collisionMap[collider_lhs].end()) &&
-					(s_collisionMap.find(collider_rhs) == s_collisionMap.end() || 
-						std::find(s_collisionMap[collider_rhs].begin(), s_collisionMap[collider_rhs].end(), collider_lhs) == s_collisionMap[collider_rhs].end()))
-				{
-					if (collider_lhs->OnCollisionEnter != nullptr && collider_lhs->m_gameobject.lock()->IsActive())
-						collider_lhs->OnCollisionEnter(collider_lhs, collider_rhs);
-					if (collider_rhs->OnCollisionEnter != nullptr && collider_rhs->m_gameobject.lock()->IsActive())
-						collider_rhs->OnCollisionEnter(collider_rhs, collider_lhs);
-				}
-				else
-				{
-					if (collider_lhs->OnCollisionStay != nullptr && collider_lhs->m_gameobject.lock()->IsActive())
-						collider_lhs->OnCollisionStay(collider_lhs, collider_rhs);
-					if (collider_rhs->OnCollisionStay != nullptr && collider_rhs->m_gameobject.lock()->IsActive())
-						collider_rhs->OnCollisionStay(collider_rhs, collider_lhs);
-				}
+				minDepth = depth;
+				minAxis = axis;
 			}
 		}
 	}
 
+	o_normal = (Dot(centerOffset, minAxis) < 0.0f) ? -minAxis : minAxis;
+	o_depth = minDepth;
+	return true;
 }
 
 
 
-// Collision Resolution
+// Dispatch
 //============
 
-void eae6320::Physics::Collision::CollisionResolution(cCollider* i_lhs, cCollider* i_rhs)
+bool eae6320::Physics::Collision::IsOverlaps_None(cCollider*, cCollider*)
 {
-	switch (i_lhs->GetType())
-	{
-	case eColliderType::Sphere:
-	{
-		if (i_rhs->GetType() == eColliderType::Sphere)
-			CollisionResolution(dynamic_cast<cSphereCollider*>(i_lhs), dynamic_cast<cSphereCollider*>(i_rhs));
-		else if (i_rhs->GetType() == eColliderType::AABB)
-			CollisionResolution(dynamic_cast<cAABBCollider*>(i_rhs), dynamic_cast<cSphereCollider*>(i_lhs));
-		break;
-	}
-	case eColliderType::AABB:
-	{
-		if (i_rhs->GetType() == eColliderType::Sphere)
-			CollisionResolution(dynamic_cast<cAABBCollider*>(i_lhs), dynamic_cast<cSphereCollider*>(i_rhs));
-		else if (i_rhs->GetType() == eColliderType::AABB) 
-			CollisionResolution(dynamic_cast<cAABBCollider*>(i_lhs), dynamic_cast<cAABBCollider*>(i_rhs));
-		break;
-	}
-	default:
-		break;
-	}
+	return false;
 }
 
 
-void eae6320::Physics::Collision::CollisionResolution(cSphereCollider* i_lhs, cSphereCollider* i_rhs)
+template <class tLhs, class tRhs>
+bool eae6320::Physics::Collision::IsOverlaps_Typed(cCollider* i_lhs, cCollider* i_rhs)
 {
-	// normal start from the centroid of lhs, points to the centroid of rhs
-	Math::sVector collisionNormal = i_rhs->GetCentroid_world() - i_lhs->GetCentroid_world();
-	collisionNormal = (collisionNormal == Math::sVector()) ? Math::sVector() : collisionNormal.GetNormalized();
+	return static_cast<tLhs*>(i_lhs)->IsOverlaps(*static_cast<tRhs*>(i_rhs));
+}
 
-	float centroidSqDistance = Math::SqDistance(i_lhs->GetCentroid_world(), i_rhs->GetCentroid_world());
-	float raidusDistance = i_lhs->GetRadius() + i_rhs->GetRadius();
-	float collisionDepth = raidusDistance - sqrtf(centroidSqDistance);
 
-	// resolve collision
-	if (i_lhs->m_objectRigidBody->isStatic == false && i_lhs->m_objectRigidBody->isTrigger == false && i_rhs->m_objectRigidBody->isTrigger == false)
-		i_lhs->m_objectRigidBody->Translate(0.5f * collisionNormal * collisionDepth * -1.0f);
-	if (i_rhs->m_objectRigidBody->isStatic == false && i_lhs->m_objectRigidBody->isTrigger == false && i_rhs->m_objectRigidBody->isTrigger == false)
-		i_rhs->m_objectRigidBody->Translate(0.5f * collisionNormal * collisionDepth);
+template <class tLhs, class tRhs>
+bool eae6320::Physics::Collision::IsOverlaps_TypedSwapped(cCollider* i_lhs, cCollider* i_rhs)
+{
+	return static_cast<tLhs*>(i_rhs)->IsOverlaps(*static_cast<tRhs*>(i_lhs));
 }
 
 
-void eae6320::Physics::Collision::CollisionResolution(cAABBCollider* i_lhs, cSphereCollider* i_rhs)
+bool eae6320::Physics::Collision::GenerateContact_None(cCollider*, cCollider*, sContactManifold&)
 {
-	// Closest point on or inside the AABB to the centroid of sphere
-	Math::sVector closestPoint = i_lhs->GetClosestPoint(i_rhs->GetCentroid_world());
-
-	// Collision normal is calculated based on the princile that AABB and sphere want to 
-	// get away from each other by traveling minimum distance. Thus, the collision normal 
-	// is the normalized vector from closest point to centroid;
-	Math::sVector AABBNormal = i_lhs->GetCentroid_world() - closestPoint;
-	AABBNormal = (AABBNormal == Math::sVector()) ? Math::sVector() : AABBNormal.GetNormalized();
-	Math::sVector sphereNormal = i_rhs->GetCentroid_world() - closestPoint;
-	sphereNormal = (sphereNormal == Math::sVector()) ? Math::sVector() : sphereNormal.GetNormalized();
+	return false;
+}
 
-	float collisionDepth = i_rhs->GetRadius() - sqrtf(Math::SqDistance(closestPoint, i_rhs->GetCentroid_world()));
 
-	// resolve collision
-	if (i_lhs->m_objectRigidBody->isStatic == false && i_lhs->m_objectRigidBody->isTrigger == false && i_rhs->m_objectRigidBody->isTrigger == false)
-		i_lhs->m_objectRigidBody->Translate(0.5f * AABBNormal * collisionDepth);
-	if (i_rhs->m_objectRigidBody->isStatic == false && i_lhs->m_objectRigidBody->isTrigger == false && i_rhs->m_objectRigidBody->isTrigger == false)
-		i_rhs->m_objectRigidBody->Translate(0.5f * sphereNormal * collisionDepth);
+template <class tLhs, class tRhs>
+bool eae6320::Physics::Collision::GenerateContact_Typed(cCollider* i_lhs, cCollider* i_rhs, sContactManifold& o_manifold)
+{
+	return GenerateContact(static_cast<const tLhs*>(i_lhs), static_cast<const tRhs*>(i_rhs), o_manifold);
 }
 
 
-void eae6320::Physics::Collision::CollisionResolution(cAABBCollider* i_lhs, cAABBCollider* i_rhs)
+template <class tLhs, class tRhs>
+bool eae6320::Physics::Collision::GenerateContact_TypedSwapped(cCollider* i_lhs, cCollider* i_rhs, sContactManifold& o_manifold)
 {
-	// Closest point on or inside the AABB to the centroid of another AABB
-	Math::sVector closestPointLeftCentroidToRightAABB = i_rhs->GetClosestPoint(i_lhs->GetCentroid_world());
-	Math::sVector closestPointRightCentroidToLeftAABB = i_lhs->GetClosestPoint(i_rhs->GetCentroid_world());
+	// The normal has to point from i_lhs to i_rhs
+	const bool isGenerated = GenerateContact(static_cast<const tLhs*>(i_rhs), static_cast<const tRhs*>(i_lhs), o_manifold);
+	o_manifold.normal = -o_manifold.normal;
+	return isGenerated;
+}
 
-	// Collision normal is calculated based on the princile that both AABB want to 
-	// get away from each other by traveling minimum distance. Thus, the collision normal 
-	// is the normalized vector from closest point to centroid;
-	Math::sVector lhsNormal = i_lhs->GetCentroid_world() - closestPointLeftCentroidToRightAABB;
-	lhsNormal = (lhsNormal == Math::sVector()) ? Math::sVector() : lhsNormal.GetNormalized();
-	Math::sVector rhsNormal = i_rhs->GetCentroid_world() - closestPointRightCentroidToLeftAABB;
-	rhsNormal = (rhsNormal == Math::sVector()) ? Math::sVector() : rhsNormal.GetNormalized();
 
-	float collisionDepth = sqrtf(Math::SqDistance(closestPointLeftCentroidToRightAABB, closestPointRightCentroidToLeftAABB));
+bool eae6320::Physics::Collision::Sweep_None(const cCollider*, const Math::sVector&, const cCollider*, float&)
+{
+	return false;
+}
+
 
-	// resolve collision
-	if (i_lhs->m_objectRigidBody->isStatic == false && i_lhs->m_objectRigidBody->isTrigger == false && i_rhs->m_objectRigidBody->isTrigger == false)
-		i_lhs->m_objectRigidBody->Translate(0.5f * lhsNormal * collisionDepth);
-	if (i_rhs->m_objectRigidBody->isStatic == false && i_lhs->m_objectRigidBody->isTrigger == false && i_rhs->m_objectRigidBody->isTrigger == false)
-		i_rhs->m_objectRigidBody->Translate(0.5f * rhsNormal * collisionDepth);
+bool eae6320::Physics::Collision::Sweep_Bounds(const cCollider* i_collider, const Math::sVector& i_translation, const cCollider* i_target, float& o_timeOfImpact)
+{
+	// The centroid of the moving bounds against the target bounds grown by the half extent of the moving ones
+	const Math::sVector minExtent = i_collider->GetMinExtent_world();
+	const Math::sVector maxExtent = i_collider->GetMaxExtent_world();
+	const Math::sVector halfExtent = (maxExtent - minExtent) * 0.5f;
+
+	Math::sVector normal;
+	return RayCastBox((minExtent + maxExtent) * 0.5f - i_translation, i_translation, 1.0f,
+		i_target->GetMinExtent_world() - halfExtent, i_target->GetMaxExtent_world() + halfExtent, o_timeOfImpact, normal);
 }
 
+
+template <class tCollider, class tTarget>
+bool eae6320::Physics::Collision::Sweep_Typed(const cCollider* i_collider, const Math::sVector& i_translation, const cCollider* i_target, float& o_timeOfImpact)
+{
+	return Sweep(static_cast<const tCollider*>(i_collider), i_translation, static_cast<const tTarget*>(i_target), o_timeOfImpact);
+}
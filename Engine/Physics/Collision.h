@@ -3,8 +3,11 @@
 // Includes
 //=========
 
+#include <Engine/Math/cQuaternion.h>
+#include <Engine/Math/sVector.h>
 #include <Engine/Physics/cBVHTree.h>
 #include <Engine/Physics/cColliderBase.h>
+#include <Engine/Physics/cContactSolver.h>
 #include <Engine/Results/Results.h>
 
 #include <list>
@@ -34,6 +37,53 @@ namespace Collision
 		BroadPhase_BVH				= 1 << 1,
 
 		NarrowPhase_Overlaps		= 1 << 2,
+
+		// Sweep and prune that keeps its sorted endpoints and pair set across frames
+		BroadPhase_IncrementalSweepAndPrune	= 1 << 3,
+
+		// Hashed grid with a level per power of two cell size, for bounded scenes of many similar-size objects
+		BroadPhase_SpatialHash		= 1 << 4,
+	};
+
+}// Namespace Collision
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Shapes
+//==========
+
+namespace eae6320
+{
+namespace Physics
+{
+namespace Collision
+{
+
+	/* A box with axes of its own. An AABB is the same box with the world axes */
+	struct sOrientedBox
+	{
+		Math::sVector center;
+		// Unit vectors
+		Math::sVector axes[3];
+		Math::sVector halfExtents;
+
+		sOrientedBox() = default;
+		sOrientedBox(const Math::sVector& i_center, const Math::cQuaternion& i_orientation, const Math::sVector& i_halfExtents);
+		sOrientedBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent);
+
+		/* The position of a world point in the frame of the box */
+		Math::sVector ToLocal(const Math::sVector& i_point) const;
+		Math::sVector ToWorld(const Math::sVector& i_point_local) const;
+
+		/* Half the size of the box along the unit vector i_axis */
+		float GetProjectedRadius(const Math::sVector& i_axis) const;
+
+		/* The point of the box closest to i_point, i_point itself if it is inside */
+		Math::sVector GetClosestPoint(const Math::sVector& i_point) const;
+
+		/* The corner that is the furthest along i_direction */
+		Math::sVector GetSupportPoint(const Math::sVector& i_direction) const;
 	};
 
 }// Namespace Collision
@@ -53,17 +103,71 @@ namespace Collision
 
 	bool IsOverlaps(cCollider* i_lhs, cCollider* i_rhs);
 
+	/* Fill o_manifold with the contact of two overlapping colliders, returns false if they don't overlap.
+	 * The manifold always has the collider with the lower id as lhs */
+	bool GenerateContact(cCollider* i_lhs, cCollider* i_rhs, sContactManifold& o_manifold);
+
+	/* i_collider is where it is at the end of a step in which it moved by i_translation. Outputs the fraction of
+	 * i_translation at which it first touches i_target. Returns false if it doesn't hit i_target on the way, or if
+	 * the two already overlapped at the start of the step */
+	bool Sweep(const cCollider* i_collider, const Math::sVector& i_translation, const cCollider* i_target, float& o_timeOfImpact);
+
+	/* Smallest t in [0, i_maxT] at which i_origin + t * i_direction enters the sphere, along with the outward normal there.
+	 * Returns false if the ray misses or starts inside. t is a distance if i_direction is a unit vector */
+	bool RayCastSphere(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxT,
+		const Math::sVector& i_center, float i_radius, float& o_t, Math::sVector& o_normal);
+
+	/* Same as RayCastSphere() for an axis-aligned box, the normal is the one of the face the ray enters through */
+	bool RayCastBox(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxT,
+		const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, float& o_t, Math::sVector& o_normal);
+
+	/* Same as RayCastSphere() for a capsule, the set of points within i_radius of the segment from i_pointA to i_pointB */
+	bool RayCastCapsule(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxT,
+		const Math::sVector& i_pointA, const Math::sVector& i_pointB, float i_radius, float& o_t, Math::sVector& o_normal);
+
+	/* Same as RayCastBox() for a box with axes of its own */
+	bool RayCastBox(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxT,
+		const sOrientedBox& i_box, float& o_t, Math::sVector& o_normal);
+
+	// Closest Points
+	//------------------------------
+	// Positions along a segment are fractions in [0, 1] from its first point to its second one
+
+	float GetClosestPointOnSegment(const Math::sVector& i_point, const Math::sVector& i_pointA, const Math::sVector& i_pointB);
+
+	/* Where the segments [i_pointA0, i_pointB0] and [i_pointA1, i_pointB1] come closest to each other */
+	void GetClosestPointsOfSegments(const Math::sVector& i_pointA0, const Math::sVector& i_pointB0,
+		const Math::sVector& i_pointA1, const Math::sVector& i_pointB1, float& o_t0, float& o_t1);
+
+	/* Where the segment comes closest to the box, along with the point of the box there. The distance to a box
+	 * is convex along a segment, so its minimum is found by a golden section search */
+	float GetClosestPointOfSegmentAndBox(const Math::sVector& i_pointA, const Math::sVector& i_pointB, const sOrientedBox& i_box,
+		Math::sVector& o_boxPoint);
+
+	/* Separating axis test over the 3 face axes of each box and the 9 cross products of their axes.
+	 * If the boxes overlap, outputs the axis of least penetration, pointing from i_lhs to i_rhs, and the depth along it */
+	bool IsOverlaps(const sOrientedBox& i_lhs, const sOrientedBox& i_rhs, Math::sVector& o_normal, float& o_depth);
+
+	// The functions below work on the default physics world, see Physics::GetDefaultWorld()
+	//------------------------------
+
 	void Initialize(const std::vector<cCollider*>& i_allColliderList, uint8_t i_collisionType);
 
 	void Update_CollisionDetection();
 
+	/* Solve the contacts of the last collision detection with the velocities and positions of the rigid bodies */
 	void Update_CollisionResolution();
 
+	/* Registration is deferred, new colliders join the broad phase at the beginning of the next Update_CollisionDetection() */
 	void RegisterCollider(cCollider* i_collider);
 
+	void RegisterColliders(const std::vector<cCollider*>& i_colliders);
+
+	/* Deregistration is deferred too, the collider leaves the broad phase at the beginning of the next Update_CollisionDetection().
+	 * The colliders that still touch it get OnCollisionExit in that update, and its game object is kept alive until then */
 	cResult DeregisterCollider(cCollider* i_collider);
 
-	std::list<std::pair<std::weak_ptr<Graphics::cLine>, Math::cMatrix_transformation>> GetBVHRenderData();
+	std::list<std::pair<Graphics::cRenderHandle<Graphics::cLine>, Math::cMatrix_transformation>> GetBVHRenderData();
 
 
 }// Namespace Collision
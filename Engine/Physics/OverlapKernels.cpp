@@ -0,0 +1,565 @@
+// Includes
+//=========
+
+#include <Engine/Logging/Logging.h>
+#include <Engine/Physics/OverlapKernels.h>
+#include <Engine/Physics/cAABBCollider.h>
+#include <Engine/Physics/cSphereCollider.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+	#define EAE6320_OVERLAPKERNELS_X86
+
+	#include <immintrin.h>
+	#if defined( _MSC_VER )
+		#include <intrin.h>
+	#endif
+#endif
+
+// MSVC allows intrinsics of any instruction set in any function,
+// GCC and Clang need the instruction set enabled per function
+#if defined( EAE6320_OVERLAPKERNELS_X86 ) && !defined( _MSC_VER )
+	#define EAE6320_TARGET_SSE __attribute__(( target( "sse2" ) ))
+	#define EAE6320_TARGET_AVX __attribute__(( target( "avx" ) ))
+#else
+	#define EAE6320_TARGET_SSE
+	#define EAE6320_TARGET_AVX
+#endif
+
+
+// Helper Function Declarations
+//=============================
+
+namespace eae6320
+{
+namespace Physics
+{
+namespace OverlapKernels
+{
+
+	// Each kernel tests pairs [i_begin, i_end)
+	using fSphereSphereKernel = void(*)(const sSphereArray&, const sSphereArray&, size_t, size_t, uint8_t*);
+	using fSphereAABBKernel = void(*)(const sSphereArray&, const sAABBArray&, size_t, size_t, uint8_t*);
+	using fAABBAABBKernel = void(*)(const sAABBArray&, const sAABBArray&, size_t, size_t, uint8_t*);
+
+	void IsOverlaps_SphereSphere_Scalar(const sSphereArray& i_lhs, const sSphereArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results);
+	void IsOverlaps_SphereAABB_Scalar(const sSphereArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results);
+	void IsOverlaps_AABBAABB_Scalar(const sAABBArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results);
+
+#if defined( EAE6320_OVERLAPKERNELS_X86 )
+	EAE6320_TARGET_SSE void IsOverlaps_SphereSphere_SSE(const sSphereArray& i_lhs, const sSphereArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results);
+	EAE6320_TARGET_SSE void IsOverlaps_SphereAABB_SSE(const sSphereArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results);
+	EAE6320_TARGET_SSE void IsOverlaps_AABBAABB_SSE(const sAABBArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results);
+
+	EAE6320_TARGET_AVX void IsOverlaps_SphereSphere_AVX(const sSphereArray& i_lhs, const sSphereArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results);
+	EAE6320_TARGET_AVX void IsOverlaps_SphereAABB_AVX(const sSphereArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results);
+	EAE6320_TARGET_AVX void IsOverlaps_AABBAABB_AVX(const sAABBArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results);
+#endif
+
+	const char* GetInstructionSetName(eInstructionSet i_instructionSet);
+
+}// Namespace OverlapKernels
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Static Data
+//============
+
+namespace eae6320
+{
+namespace Physics
+{
+namespace OverlapKernels
+{
+
+	// Indexed by eInstructionSet
+	const fSphereSphereKernel s_sphereSphereKernels[] =
+	{
+		IsOverlaps_SphereSphere_Scalar,
+#if defined( EAE6320_OVERLAPKERNELS_X86 )
+		IsOverlaps_SphereSphere_SSE,
+		IsOverlaps_SphereSphere_AVX,
+#endif
+	};
+
+	const fSphereAABBKernel s_sphereAABBKernels[] =
+	{
+		IsOverlaps_SphereAABB_Scalar,
+#if defined( EAE6320_OVERLAPKERNELS_X86 )
+		IsOverlaps_SphereAABB_SSE,
+		IsOverlaps_SphereAABB_AVX,
+#endif
+	};
+
+	const fAABBAABBKernel s_AABBAABBKernels[] =
+	{
+		IsOverlaps_AABBAABB_Scalar,
+#if defined( EAE6320_OVERLAPKERNELS_X86 )
+		IsOverlaps_AABBAABB_SSE,
+		IsOverlaps_AABBAABB_AVX,
+#endif
+	};
+
+	eInstructionSet s_instructionSet = GetSupportedInstructionSet();
+
+}// Namespace OverlapKernels
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Shape Arrays Implementation
+//============================
+
+void eae6320::Physics::OverlapKernels::sSphereArray::Clear()
+{
+	centerX.clear();
+	centerY.clear();
+	centerZ.clear();
+	radius.clear();
+}
+
+
+void eae6320::Physics::OverlapKernels::sSphereArray::Push(const Math::sVector& i_center, float i_radius)
+{
+	centerX.push_back(i_center.x);
+	centerY.push_back(i_center.y);
+	centerZ.push_back(i_center.z);
+	radius.push_back(i_radius);
+}
+
+
+void eae6320::Physics::OverlapKernels::sAABBArray::Clear()
+{
+	minX.clear();
+	minY.clear();
+	minZ.clear();
+	maxX.clear();
+	maxY.clear();
+	maxZ.clear();
+}
+
+
+void eae6320::Physics::OverlapKernels::sAABBArray::Push(const Math::sVector& i_min, const Math::sVector& i_max)
+{
+	minX.push_back(i_min.x);
+	minY.push_back(i_min.y);
+	minZ.push_back(i_min.z);
+	maxX.push_back(i_max.x);
+	maxY.push_back(i_max.y);
+	maxZ.push_back(i_max.z);
+}
+
+
+// Interface Implementation
+//=========================
+
+eae6320::Physics::OverlapKernels::eInstructionSet eae6320::Physics::OverlapKernels::GetSupportedInstructionSet()
+{
+#if defined( EAE6320_OVERLAPKERNELS_X86 )
+	#if defined( _MSC_VER )
+	{
+		int cpuInfo[4];
+		__cpuid(cpuInfo, 1);
+
+		const bool isSSE2Supported = (cpuInfo[3] & (1 << 26)) != 0;
+		const bool isOSXSAVESupported = (cpuInfo[2] & (1 << 27)) != 0;
+		const bool isAVXSupported = (cpuInfo[2] & (1 << 28)) != 0;
+
+		// The OS must also save the YMM registers on context switch
+		if (isOSXSAVESupported && isAVXSupported && (_xgetbv(0) & 0x6) == 0x6)
+			return eInstructionSet::AVX;
+		else if (isSSE2Supported)
+			return eInstructionSet::SSE;
+	}
+	#else
+	{
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx"))
+			return eInstructionSet::AVX;
+		else if (__builtin_cpu_supports("sse2"))
+			return eInstructionSet::SSE;
+	}
+	#endif
+#endif
+
+	return eInstructionSet::Scalar;
+}
+
+
+eae6320::Physics::OverlapKernels::eInstructionSet eae6320::Physics::OverlapKernels::GetInstructionSet()
+{
+	return s_instructionSet;
+}
+
+
+void eae6320::Physics::OverlapKernels::SetInstructionSet(eInstructionSet i_instructionSet)
+{
+	s_instructionSet = std::min(i_instructionSet, GetSupportedInstructionSet());
+}
+
+
+void eae6320::Physics::OverlapKernels::IsOverlaps(const sSphereArray& i_lhs, const sSphereArray& i_rhs, std::vector<uint8_t>& o_results)
+{
+	const size_t count = std::min(i_lhs.Size(), i_rhs.Size());
+	o_results.resize(count);
+
+	if (count > 0)
+		s_sphereSphereKernels[static_cast<uint8_t>(s_instructionSet)](i_lhs, i_rhs, 0, count, o_results.data());
+}
+
+
+void eae6320::Physics::OverlapKernels::IsOverlaps(const sSphereArray& i_lhs, const sAABBArray& i_rhs, std::vector<uint8_t>& o_results)
+{
+	const size_t count = std::min(i_lhs.Size(), i_rhs.Size());
+	o_results.resize(count);
+
+	if (count > 0)
+		s_sphereAABBKernels[static_cast<uint8_t>(s_instructionSet)](i_lhs, i_rhs, 0, count, o_results.data());
+}
+
+
+void eae6320::Physics::OverlapKernels::IsOverlaps(const sAABBArray& i_lhs, const sAABBArray& i_rhs, std::vector<uint8_t>& o_results)
+{
+	const size_t count = std::min(i_lhs.Size(), i_rhs.Size());
+	o_results.resize(count);
+
+	if (count > 0)
+		s_AABBAABBKernels[static_cast<uint8_t>(s_instructionSet)](i_lhs, i_rhs, 0, count, o_results.data());
+}
+
+
+void eae6320::Physics::OverlapKernels::RunBenchmark(size_t i_pairCount, uint32_t i_iterationCount, std::vector<sBenchmarkResult>& o_results)
+{
+	o_results.clear();
+
+	// Random shapes in a volume dense enough that a good share of the pairs overlap
+	std::mt19937 randomEngine(6320);
+	std::uniform_real_distribution<float> positionDistribution(0.0f, 10.0f);
+	std::uniform_real_distribution<float> sizeDistribution(0.1f, 2.0f);
+
+	std::vector<sRigidBodyState> rigidBodies(i_pairCount * 2);
+	std::vector<cSphereCollider> sphereColliders;
+	std::vector<cAABBCollider> AABBColliders;
+	sphereColliders.reserve(i_pairCount * 2);
+	AABBColliders.reserve(i_pairCount * 2);
+
+	sSphereArray sphereArray_lhs, sphereArray_rhs;
+	sAABBArray AABBArray_lhs, AABBArray_rhs;
+
+	for (size_t i = 0; i < i_pairCount * 2; i++)
+	{
+		rigidBodies[i].position = Math::sVector(positionDistribution(randomEngine), positionDistribution(randomEngine), positionDistribution(randomEngine));
+
+		const float size = sizeDistribution(randomEngine);
+		sphereColliders.push_back(cSphereCollider(Math::sVector(), size));
+		AABBColliders.push_back(cAABBCollider(Math::sVector(-size, -size, -size), Math::sVector(size, size, size)));
+		sphereColliders.back().m_objectRigidBody = &rigidBodies[i];
+		AABBColliders.back().m_objectRigidBody = &rigidBodies[i];
+
+		sSphereArray& sphereArray = (i < i_pairCount) ? sphereArray_lhs : sphereArray_rhs;
+		sAABBArray& AABBArray = (i < i_pairCount) ? AABBArray_lhs : AABBArray_rhs;
+		sphereArray.Push(sphereColliders.back().GetCentroid_world(), sphereColliders.back().GetRadius());
+		AABBArray.Push(AABBColliders.back().GetMinExtent_world(), AABBColliders.back().GetMaxExtent_world());
+	}
+
+	auto measure = [i_pairCount, i_iterationCount](const auto& i_kernel) -> double
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		for (uint32_t iteration = 0; iteration < i_iterationCount; iteration++)
+		{
+			i_kernel();
+		}
+		const double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+		return (elapsedSeconds > 0.0) ? static_cast<double>(i_pairCount) * i_iterationCount / elapsedSeconds : 0.0;
+	};
+
+	std::vector<uint8_t> colliderResults(i_pairCount);
+	std::vector<uint8_t> kernelResults;
+	uint8_t* colliderResult = colliderResults.data();
+
+	// The per-collider path that the narrow phase used before the kernels
+	o_results.push_back({ "Sphere-Sphere (collider)", eInstructionSet::Scalar, measure([&]()
+		{
+			for (size_t i = 0; i < i_pairCount; i++)
+				colliderResult[i] = sphereColliders[i].IsOverlaps(sphereColliders[i_pairCount + i]) ? 1 : 0;
+		}) });
+	const std::vector<uint8_t> sphereSphereReference = colliderResults;
+
+	o_results.push_back({ "Sphere-AABB (collider)", eInstructionSet::Scalar, measure([&]()
+		{
+			for (size_t i = 0; i < i_pairCount; i++)
+				colliderResult[i] = sphereColliders[i].IsOverlaps(AABBColliders[i_pairCount + i]) ? 1 : 0;
+		}) });
+	const std::vector<uint8_t> sphereAABBReference = colliderResults;
+
+	o_results.push_back({ "AABB-AABB (collider)", eInstructionSet::Scalar, measure([&]()
+		{
+			for (size_t i = 0; i < i_pairCount; i++)
+				colliderResult[i] = AABBColliders[i].IsOverlaps(AABBColliders[i_pairCount + i]) ? 1 : 0;
+		}) });
+	const std::vector<uint8_t> AABBAABBReference = colliderResults;
+
+	// The batched kernels on every supported instruction set
+	const eInstructionSet previousInstructionSet = s_instructionSet;
+	const uint8_t supportedInstructionSetCount = static_cast<uint8_t>(GetSupportedInstructionSet()) + 1;
+
+	for (uint8_t i = 0; i < supportedInstructionSetCount; i++)
+	{
+		const eInstructionSet instructionSet = static_cast<eInstructionSet>(i);
+		SetInstructionSet(instructionSet);
+
+		o_results.push_back({ "Sphere-Sphere (batch)", instructionSet,
+			measure([&]() { IsOverlaps(sphereArray_lhs, sphereArray_rhs, kernelResults); }) });
+		if (kernelResults != sphereSphereReference)
+			Logging::OutputError("Physics::OverlapKernels: Sphere-Sphere %s kernel disagrees with the collider test", GetInstructionSetName(instructionSet));
+
+		o_results.push_back({ "Sphere-AABB (batch)", instructionSet,
+			measure([&]() { IsOverlaps(sphereArray_lhs, AABBArray_rhs, kernelResults); }) });
+		if (kernelResults != sphereAABBReference)
+			Logging::OutputError("Physics::OverlapKernels: Sphere-AABB %s kernel disagrees with the collider test", GetInstructionSetName(instructionSet));
+
+		o_results.push_back({ "AABB-AABB (batch)", instructionSet,
+			measure([&]() { IsOverlaps(AABBArray_lhs, AABBArray_rhs, kernelResults); }) });
+		if (kernelResults != AABBAABBReference)
+			Logging::OutputError("Physics::OverlapKernels: AABB-AABB %s kernel disagrees with the collider test", GetInstructionSetName(instructionSet));
+	}
+
+	s_instructionSet = previousInstructionSet;
+
+	for (const sBenchmarkResult& result : o_results)
+	{
+		Logging::OutputMessage("Physics::OverlapKernels: %s, %s: %.0f pairs/s",
+			result.kernelName, GetInstructionSetName(result.instructionSet), result.pairsPerSecond);
+	}
+}
+
+
+// Helper Function Definitions
+//============================
+
+namespace eae6320
+{
+namespace Physics
+{
+namespace OverlapKernels
+{
+
+	// Scalar
+	//-------
+
+	void IsOverlaps_SphereSphere_Scalar(const sSphereArray& i_lhs, const sSphereArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results)
+	{
+		for (size_t i = i_begin; i < i_end; i++)
+		{
+			const float dx = i_lhs.centerX[i] - i_rhs.centerX[i];
+			const float dy = i_lhs.centerY[i] - i_rhs.centerY[i];
+			const float dz = i_lhs.centerZ[i] - i_rhs.centerZ[i];
+			const float radiusDistance = i_lhs.radius[i] + i_rhs.radius[i];
+
+			o_results[i] = (dx * dx + dy * dy + dz * dz <= radiusDistance * radiusDistance) ? 1 : 0;
+		}
+	}
+
+
+	void IsOverlaps_SphereAABB_Scalar(const sSphereArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results)
+	{
+		for (size_t i = i_begin; i < i_end; i++)
+		{
+			// Distance from the sphere center to its closest point in the box
+			const float dx = std::min(std::max(i_lhs.centerX[i], i_rhs.minX[i]), i_rhs.maxX[i]) - i_lhs.centerX[i];
+			const float dy = std::min(std::max(i_lhs.centerY[i], i_rhs.minY[i]), i_rhs.maxY[i]) - i_lhs.centerY[i];
+			const float dz = std::min(std::max(i_lhs.centerZ[i], i_rhs.minZ[i]), i_rhs.maxZ[i]) - i_lhs.centerZ[i];
+			const float radius = i_lhs.radius[i];
+
+			o_results[i] = (dx * dx + dy * dy + dz * dz <= radius * radius) ? 1 : 0;
+		}
+	}
+
+
+	void IsOverlaps_AABBAABB_Scalar(const sAABBArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results)
+	{
+		for (size_t i = i_begin; i < i_end; i++)
+		{
+			const bool isOverlaps =
+				i_lhs.minX[i] <= i_rhs.maxX[i] && i_rhs.minX[i] <= i_lhs.maxX[i] &&
+				i_lhs.minY[i] <= i_rhs.maxY[i] && i_rhs.minY[i] <= i_lhs.maxY[i] &&
+				i_lhs.minZ[i] <= i_rhs.maxZ[i] && i_rhs.minZ[i] <= i_lhs.maxZ[i];
+
+			o_results[i] = isOverlaps ? 1 : 0;
+		}
+	}
+
+
+#if defined( EAE6320_OVERLAPKERNELS_X86 )
+
+	void WriteMask(int i_mask, size_t i_width, uint8_t* o_results)
+	{
+		for (size_t k = 0; k < i_width; k++)
+		{
+			o_results[k] = static_cast<uint8_t>((i_mask >> k) & 1);
+		}
+	}
+
+
+	// SSE, 4 pairs per iteration
+	//---------------------------
+
+	EAE6320_TARGET_SSE void IsOverlaps_SphereSphere_SSE(const sSphereArray& i_lhs, const sSphereArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results)
+	{
+		size_t i = i_begin;
+		for (; i + 4 <= i_end; i += 4)
+		{
+			const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&i_lhs.centerX[i]), _mm_loadu_ps(&i_rhs.centerX[i]));
+			const __m128 dy = _mm_sub_ps(_mm_loadu_ps(&i_lhs.centerY[i]), _mm_loadu_ps(&i_rhs.centerY[i]));
+			const __m128 dz = _mm_sub_ps(_mm_loadu_ps(&i_lhs.centerZ[i]), _mm_loadu_ps(&i_rhs.centerZ[i]));
+			const __m128 radiusDistance = _mm_add_ps(_mm_loadu_ps(&i_lhs.radius[i]), _mm_loadu_ps(&i_rhs.radius[i]));
+
+			const __m128 sqDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			const __m128 isOverlaps = _mm_cmple_ps(sqDistance, _mm_mul_ps(radiusDistance, radiusDistance));
+
+			WriteMask(_mm_movemask_ps(isOverlaps), 4, o_results + i);
+		}
+
+		IsOverlaps_SphereSphere_Scalar(i_lhs, i_rhs, i, i_end, o_results);
+	}
+
+
+	EAE6320_TARGET_SSE void IsOverlaps_SphereAABB_SSE(const sSphereArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results)
+	{
+		size_t i = i_begin;
+		for (; i + 4 <= i_end; i += 4)
+		{
+			const __m128 centerX = _mm_loadu_ps(&i_lhs.centerX[i]);
+			const __m128 centerY = _mm_loadu_ps(&i_lhs.centerY[i]);
+			const __m128 centerZ = _mm_loadu_ps(&i_lhs.centerZ[i]);
+			const __m128 radius = _mm_loadu_ps(&i_lhs.radius[i]);
+
+			const __m128 dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(centerX, _mm_loadu_ps(&i_rhs.minX[i])), _mm_loadu_ps(&i_rhs.maxX[i])), centerX);
+			const __m128 dy = _mm_sub_ps(_mm_min_ps(_mm_max_ps(centerY, _mm_loadu_ps(&i_rhs.minY[i])), _mm_loadu_ps(&i_rhs.maxY[i])), centerY);
+			const __m128 dz = _mm_sub_ps(_mm_min_ps(_mm_max_ps(centerZ, _mm_loadu_ps(&i_rhs.minZ[i])), _mm_loadu_ps(&i_rhs.maxZ[i])), centerZ);
+
+			const __m128 sqDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			const __m128 isOverlaps = _mm_cmple_ps(sqDistance, _mm_mul_ps(radius, radius));
+
+			WriteMask(_mm_movemask_ps(isOverlaps), 4, o_results + i);
+		}
+
+		IsOverlaps_SphereAABB_Scalar(i_lhs, i_rhs, i, i_end, o_results);
+	}
+
+
+	EAE6320_TARGET_SSE void IsOverlaps_AABBAABB_SSE(const sAABBArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results)
+	{
+		size_t i = i_begin;
+		for (; i + 4 <= i_end; i += 4)
+		{
+			const __m128 isOverlapsX = _mm_and_ps(
+				_mm_cmple_ps(_mm_loadu_ps(&i_lhs.minX[i]), _mm_loadu_ps(&i_rhs.maxX[i])),
+				_mm_cmple_ps(_mm_loadu_ps(&i_rhs.minX[i]), _mm_loadu_ps(&i_lhs.maxX[i])));
+			const __m128 isOverlapsY = _mm_and_ps(
+				_mm_cmple_ps(_mm_loadu_ps(&i_lhs.minY[i]), _mm_loadu_ps(&i_rhs.maxY[i])),
+				_mm_cmple_ps(_mm_loadu_ps(&i_rhs.minY[i]), _mm_loadu_ps(&i_lhs.maxY[i])));
+			const __m128 isOverlapsZ = _mm_and_ps(
+				_mm_cmple_ps(_mm_loadu_ps(&i_lhs.minZ[i]), _mm_loadu_ps(&i_rhs.maxZ[i])),
+				_mm_cmple_ps(_mm_loadu_ps(&i_rhs.minZ[i]), _mm_loadu_ps(&i_lhs.maxZ[i])));
+
+			WriteMask(_mm_movemask_ps(_mm_and_ps(_mm_and_ps(isOverlapsX, isOverlapsY), isOverlapsZ)), 4, o_results + i);
+		}
+
+		IsOverlaps_AABBAABB_Scalar(i_lhs, i_rhs, i, i_end, o_results);
+	}
+
+
+	// AVX, 8 pairs per iteration
+	//---------------------------
+
+	EAE6320_TARGET_AVX void IsOverlaps_SphereSphere_AVX(const sSphereArray& i_lhs, const sSphereArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results)
+	{
+		size_t i = i_begin;
+		for (; i + 8 <= i_end; i += 8)
+		{
+			const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&i_lhs.centerX[i]), _mm256_loadu_ps(&i_rhs.centerX[i]));
+			const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&i_lhs.centerY[i]), _mm256_loadu_ps(&i_rhs.centerY[i]));
+			const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&i_lhs.centerZ[i]), _mm256_loadu_ps(&i_rhs.centerZ[i]));
+			const __m256 radiusDistance = _mm256_add_ps(_mm256_loadu_ps(&i_lhs.radius[i]), _mm256_loadu_ps(&i_rhs.radius[i]));
+
+			const __m256 sqDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+			const __m256 isOverlaps = _mm256_cmp_ps(sqDistance, _mm256_mul_ps(radiusDistance, radiusDistance), _CMP_LE_OQ);
+
+			WriteMask(_mm256_movemask_ps(isOverlaps), 8, o_results + i);
+		}
+
+		IsOverlaps_SphereSphere_Scalar(i_lhs, i_rhs, i, i_end, o_results);
+	}
+
+
+	EAE6320_TARGET_AVX void IsOverlaps_SphereAABB_AVX(const sSphereArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results)
+	{
+		size_t i = i_begin;
+		for (; i + 8 <= i_end; i += 8)
+		{
+			const __m256 centerX = _mm256_loadu_ps(&i_lhs.centerX[i]);
+			const __m256 centerY = _mm256_loadu_ps(&i_lhs.centerY[i]);
+			const __m256 centerZ = _mm256_loadu_ps(&i_lhs.centerZ[i]);
+			const __m256 radius = _mm256_loadu_ps(&i_lhs.radius[i]);
+
+			const __m256 dx = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(centerX, _mm256_loadu_ps(&i_rhs.minX[i])), _mm256_loadu_ps(&i_rhs.maxX[i])), centerX);
+			const __m256 dy = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(centerY, _mm256_loadu_ps(&i_rhs.minY[i])), _mm256_loadu_ps(&i_rhs.maxY[i])), centerY);
+			const __m256 dz = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(centerZ, _mm256_loadu_ps(&i_rhs.minZ[i])), _mm256_loadu_ps(&i_rhs.maxZ[i])), centerZ);
+
+			const __m256 sqDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+			const __m256 isOverlaps = _mm256_cmp_ps(sqDistance, _mm256_mul_ps(radius, radius), _CMP_LE_OQ);
+
+			WriteMask(_mm256_movemask_ps(isOverlaps), 8, o_results + i);
+		}
+
+		IsOverlaps_SphereAABB_Scalar(i_lhs, i_rhs, i, i_end, o_results);
+	}
+
+
+	EAE6320_TARGET_AVX void IsOverlaps_AABBAABB_AVX(const sAABBArray& i_lhs, const sAABBArray& i_rhs, size_t i_begin, size_t i_end, uint8_t* o_results)
+	{
+		size_t i = i_begin;
+		for (; i + 8 <= i_end; i += 8)
+		{
+			const __m256 isOverlapsX = _mm256_and_ps(
+				_mm256_cmp_ps(_mm256_loadu_ps(&i_lhs.minX[i]), _mm256_loadu_ps(&i_rhs.maxX[i]), _CMP_LE_OQ),
+				_mm256_cmp_ps(_mm256_loadu_ps(&i_rhs.minX[i]), _mm256_loadu_ps(&i_lhs.maxX[i]), _CMP_LE_OQ));
+			const __m256 isOverlapsY = _mm256_and_ps(
+				_mm256_cmp_ps(_mm256_loadu_ps(&i_lhs.minY[i]), _mm256_loadu_ps(&i_rhs.maxY[i]), _CMP_LE_OQ),
+				_mm256_cmp_ps(_mm256_loadu_ps(&i_rhs.minY[i]), _mm256_loadu_ps(&i_lhs.maxY[i]), _CMP_LE_OQ));
+			const __m256 isOverlapsZ = _mm256_and_ps(
+				_mm256_cmp_ps(_mm256_loadu_ps(&i_lhs.minZ[i]), _mm256_loadu_ps(&i_rhs.maxZ[i]), _CMP_LE_OQ),
+				_mm256_cmp_ps(_mm256_loadu_ps(&i_rhs.minZ[i]), _mm256_loadu_ps(&i_lhs.maxZ[i]), _CMP_LE_OQ));
+
+			WriteMask(_mm256_movemask_ps(_mm256_and_ps(_mm256_and_ps(isOverlapsX, isOverlapsY), isOverlapsZ)), 8, o_results + i);
+		}
+
+		IsOverlaps_AABBAABB_Scalar(i_lhs, i_rhs, i, i_end, o_results);
+	}
+
+#endif
+
+
+	const char* GetInstructionSetName(eInstructionSet i_instructionSet)
+	{
+		switch (i_instructionSet)
+		{
+		case eInstructionSet::SSE:
+			return "SSE";
+		case eInstructionSet::AVX:
+			return "AVX";
+		default:
+			return "Scalar";
+		}
+	}
+
+}// Namespace OverlapKernels
+}// Namespace Physics
+}// Namespace eae6320
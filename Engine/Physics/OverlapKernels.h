@@ -0,0 +1,106 @@
+/*
+	Batched overlap tests for the narrow phase.
+	Shapes are gathered into structure-of-arrays buffers and tested 4 (SSE) or 8 (AVX) pairs at a time
+*/
+
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Math/sVector.h>
+
+#include <cstdint>
+#include <vector>
+
+
+// Shape Arrays
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+namespace OverlapKernels
+{
+
+	struct sSphereArray
+	{
+		std::vector<float> centerX;
+		std::vector<float> centerY;
+		std::vector<float> centerZ;
+		std::vector<float> radius;
+
+		void Clear();
+		void Push(const Math::sVector& i_center, float i_radius);
+		size_t Size() const { return radius.size(); }
+	};
+
+	struct sAABBArray
+	{
+		std::vector<float> minX;
+		std::vector<float> minY;
+		std::vector<float> minZ;
+		std::vector<float> maxX;
+		std::vector<float> maxY;
+		std::vector<float> maxZ;
+
+		void Clear();
+		void Push(const Math::sVector& i_min, const Math::sVector& i_max);
+		size_t Size() const { return minX.size(); }
+	};
+
+	enum class eInstructionSet : uint8_t
+	{
+		Scalar	= 0,
+		SSE		= 1,
+		AVX		= 2,
+	};
+
+	struct sBenchmarkResult
+	{
+		const char* kernelName;
+		eInstructionSet instructionSet;
+		double pairsPerSecond;
+	};
+
+}// Namespace OverlapKernels
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Interface
+//==========
+
+namespace eae6320
+{
+namespace Physics
+{
+namespace OverlapKernels
+{
+
+	/* The widest instruction set supported by both the build and the running CPU */
+	eInstructionSet GetSupportedInstructionSet();
+
+	/* Kernels are selected on first use from GetSupportedInstructionSet().
+	 * Forcing a narrower set is meant for benchmarks and debugging; a wider set than supported is clamped */
+	eInstructionSet GetInstructionSet();
+	void SetInstructionSet(eInstructionSet i_instructionSet);
+
+	// Pair i is (i_lhs[i], i_rhs[i]). o_results[i] is set to 1 if the pair overlaps, otherwise 0.
+	// Touching shapes count as overlapping, matching the collider IsOverlaps() functions
+	//------------------------------
+
+	void IsOverlaps(const sSphereArray& i_lhs, const sSphereArray& i_rhs, std::vector<uint8_t>& o_results);
+
+	void IsOverlaps(const sSphereArray& i_lhs, const sAABBArray& i_rhs, std::vector<uint8_t>& o_results);
+
+	void IsOverlaps(const sAABBArray& i_lhs, const sAABBArray& i_rhs, std::vector<uint8_t>& o_results);
+
+	/* Time every kernel on every supported instruction set, along with the per-collider scalar path,
+	 * over i_pairCount random pairs. Results are also written to the log */
+	void RunBenchmark(size_t i_pairCount, uint32_t i_iterationCount, std::vector<sBenchmarkResult>& o_results);
+
+}// Namespace OverlapKernels
+}// Namespace Physics
+}// Namespace eae6320
@@ -4,4 +4,36 @@
 #include <Engine/Physics/Physics.h>
 
 
+// Interface Implementation
+//============
 
+eae6320::Physics::cPhysicsWorld& eae6320::Physics::GetDefaultWorld()
+{
+	// Created on first use, game objects may register their rigid bodies before main() starts
+	static cPhysicsWorld s_defaultWorld;
+	return s_defaultWorld;
+}
+
+
+eae6320::Physics::sRigidBodyHandle eae6320::Physics::RegisterRigidBody(sRigidBodyState* i_rigidBody)
+{
+	return GetDefaultWorld().RegisterRigidBody(i_rigidBody);
+}
+
+
+eae6320::cResult eae6320::Physics::DeregisterRigidBody(const sRigidBodyHandle& i_handle)
+{
+	return GetDefaultWorld().DeregisterRigidBody(i_handle);
+}
+
+
+eae6320::Physics::sRigidBodyState* eae6320::Physics::GetRigidBody(const sRigidBodyHandle& i_handle)
+{
+	return GetDefaultWorld().GetRigidBody(i_handle);
+}
+
+
+void eae6320::Physics::Update_Integration(const float i_secondCountToIntegrate)
+{
+	GetDefaultWorld().Update_Integration(i_secondCountToIntegrate);
+}
@@ -4,10 +4,39 @@
 //=========
 
 #include <Engine/Physics/Collision.h>
+#include <Engine/Physics/cPhysicsWorld.h>
+#include <Engine/Physics/cRigidBodyPool.h>
+
+
+// Interface
+//==========
 
 namespace eae6320
 {
 namespace Physics
 {
+
+	// World
+	//-------------
+
+	/* The world behind the free functions of Physics and Physics::Collision. Its thread count can be changed at any time between two steps */
+	cPhysicsWorld& GetDefaultWorld();
+
+	// Rigid Bodies
+	//-------------
+
+	/* The rigid body must stay at the same address until it is deregistered */
+	sRigidBodyHandle RegisterRigidBody(sRigidBodyState* i_rigidBody);
+
+	cResult DeregisterRigidBody(const sRigidBodyHandle& i_handle);
+
+	sRigidBodyState* GetRigidBody(const sRigidBodyHandle& i_handle);
+
+	// Update
+	//-------
+
+	/* Integrate every registered dynamic rigid body in one batch */
+	void Update_Integration(const float i_secondCountToIntegrate);
+
 }// Namespace Physics
-}// Namespace eae6320
\ No newline at end of file
+}// Namespace eae6320
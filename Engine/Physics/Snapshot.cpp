@@ -0,0 +1,127 @@
+// Includes
+//=========
+
+#include <Engine/Logging/Logging.h>
+#include <Engine/Physics/Snapshot.h>
+
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Word i of a buffer, the bytes past its end read as zero
+	uint32_t LoadWord(const std::vector<uint8_t>& i_buffer, size_t i_word);
+	void StoreWord(std::vector<uint8_t>& io_buffer, size_t i_word, uint32_t i_value);
+
+	size_t GetWordCount(size_t i_byteCount);
+}
+
+
+// Delta Encoding
+//=============
+
+void eae6320::Physics::Snapshot::EncodeDelta(const std::vector<uint8_t>& i_snapshot, const std::vector<uint8_t>& i_base, std::vector<uint8_t>& o_delta)
+{
+	// The delta is the size of the snapshot followed by runs of unchanged words, each one followed by
+	// the changed words up to the next run: [unchanged count][changed count][changed words]...
+	cWriter writer(o_delta);
+	writer.Write(static_cast<uint64_t>(i_snapshot.size()));
+
+	const size_t wordCount = GetWordCount(i_snapshot.size());
+	size_t word = 0;
+	while (word < wordCount)
+	{
+		const size_t runBegin = word;
+		while ((word < wordCount) && (LoadWord(i_snapshot, word) == LoadWord(i_base, word)))
+			word++;
+		const uint32_t unchangedCount = static_cast<uint32_t>(word - runBegin);
+
+		// A single unchanged word between changed ones costs more as a run than as a changed word
+		const size_t changedBegin = word;
+		while ((word < wordCount) && ((LoadWord(i_snapshot, word) != LoadWord(i_base, word))
+			|| ((word + 1 < wordCount) && (LoadWord(i_snapshot, word + 1) != LoadWord(i_base, word + 1)))))
+		{
+			word++;
+		}
+		const uint32_t changedCount = static_cast<uint32_t>(word - changedBegin);
+
+		writer.Write(unchangedCount);
+		writer.Write(changedCount);
+		for (size_t i = changedBegin; i < word; i++)
+			writer.Write(LoadWord(i_snapshot, i) ^ LoadWord(i_base, i));
+	}
+}
+
+
+eae6320::cResult eae6320::Physics::Snapshot::DecodeDelta(const std::vector<uint8_t>& i_delta, const std::vector<uint8_t>& i_base, std::vector<uint8_t>& o_snapshot)
+{
+	cReader reader(i_delta);
+
+	uint64_t snapshotSize;
+	if (reader.Read(snapshotSize) == false)
+	{
+		Logging::OutputError("Physics::Snapshot: The delta is too short to be a snapshot delta");
+		return Results::Failure;
+	}
+
+	const size_t wordCount = GetWordCount(static_cast<size_t>(snapshotSize));
+	o_snapshot.resize(wordCount * sizeof(uint32_t));
+
+	size_t word = 0;
+	while (word < wordCount)
+	{
+		uint32_t unchangedCount, changedCount;
+		if ((reader.Read(unchangedCount) == false) || (reader.Read(changedCount) == false)
+			|| (word + unchangedCount + changedCount > wordCount))
+		{
+			Logging::OutputError("Physics::Snapshot: The delta is corrupted or was encoded against another base");
+			return Results::Failure;
+		}
+
+		for (const size_t end = word + unchangedCount; word < end; word++)
+			StoreWord(o_snapshot, word, LoadWord(i_base, word));
+
+		for (const size_t end = word + changedCount; word < end; word++)
+		{
+			uint32_t difference;
+			if (reader.Read(difference) == false)
+			{
+				Logging::OutputError("Physics::Snapshot: The delta is truncated");
+				return Results::Failure;
+			}
+			StoreWord(o_snapshot, word, LoadWord(i_base, word) ^ difference);
+		}
+	}
+
+	o_snapshot.resize(static_cast<size_t>(snapshotSize));
+	return Results::Success;
+}
+
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	uint32_t LoadWord(const std::vector<uint8_t>& i_buffer, size_t i_word)
+	{
+		uint32_t value = 0;
+		const size_t offset = i_word * sizeof(uint32_t);
+		if (offset + sizeof(uint32_t) <= i_buffer.size())
+			std::memcpy(&value, i_buffer.data() + offset, sizeof(uint32_t));
+		else if (offset < i_buffer.size())
+			std::memcpy(&value, i_buffer.data() + offset, i_buffer.size() - offset);
+		return value;
+	}
+
+	void StoreWord(std::vector<uint8_t>& io_buffer, size_t i_word, uint32_t i_value)
+	{
+		std::memcpy(io_buffer.data() + i_word * sizeof(uint32_t), &i_value, sizeof(uint32_t));
+	}
+
+	size_t GetWordCount(size_t i_byteCount)
+	{
+		return (i_byteCount + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+	}
+}
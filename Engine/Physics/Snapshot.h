@@ -0,0 +1,186 @@
+/*
+	Flat binary snapshots of the physics world.
+	A snapshot is written as one byte stream, every part of the world appends its state in turn and reads it
+	back in the same order. Snapshots can be delta encoded against an earlier snapshot of the same world
+*/
+
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Results/Results.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+
+// Snapshot Streams
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+namespace Snapshot
+{
+
+	/* Writes over a byte buffer from its start and trims it to the written size when the writer goes away.
+	 * A buffer that is reused every tick only grows when a snapshot is larger than any before it, and the
+	 * bytes it already has are overwritten instead of being cleared first */
+	class cWriter
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		cWriter(std::vector<uint8_t>& io_buffer) : m_buffer(io_buffer) {}
+		~cWriter() { m_buffer.resize(m_size); }
+
+		cWriter(const cWriter&) = delete;
+		cWriter& operator =(const cWriter&) = delete;
+
+		/* Space for i_size bytes that the caller fills in, valid until the next write */
+		uint8_t* Allocate(size_t i_size)
+		{
+			if (m_size + i_size > m_buffer.size())
+				m_buffer.resize(std::max(m_size + i_size, m_buffer.size() * 2));
+			uint8_t* const data = m_buffer.data() + m_size;
+			m_size += i_size;
+			return data;
+		}
+
+		void WriteBytes(const void* i_data, size_t i_size)
+		{
+			std::memcpy(Allocate(i_size), i_data, i_size);
+		}
+
+		template <class T>
+		void Write(const T& i_value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only plain data can be written to a snapshot");
+			WriteBytes(&i_value, sizeof(T));
+		}
+
+		/* The element count followed by the elements */
+		template <class T, class tAllocator>
+		void WriteArray(const std::vector<T, tAllocator>& i_values)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only plain data can be written to a snapshot");
+			Write(static_cast<uint32_t>(i_values.size()));
+			WriteBytes(i_values.data(), i_values.size() * sizeof(T));
+		}
+
+
+		// Data
+		//=========================
+
+	private:
+
+		std::vector<uint8_t>& m_buffer;
+		size_t m_size = 0;
+	};
+
+	/* Reads a buffer written by cWriter. Every read fails once the buffer is used up,
+	 * so a truncated snapshot is found without checking each read */
+	class cReader
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		cReader(const std::vector<uint8_t>& i_buffer) : m_data(i_buffer.data()), m_remainingSize(i_buffer.size()) {}
+
+		bool ReadBytes(void* o_data, size_t i_size)
+		{
+			const uint8_t* const data = Consume(i_size);
+			if (data == nullptr)
+				return false;
+			std::memcpy(o_data, data, i_size);
+			return true;
+		}
+
+		template <class T>
+		bool Read(T& o_value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only plain data can be read from a snapshot");
+			return ReadBytes(&o_value, sizeof(T));
+		}
+
+		/* Resizing to the size the array already has doesn't touch its elements, so only the copy is paid for */
+		template <class T, class tAllocator>
+		bool ReadArray(std::vector<T, tAllocator>& o_values)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only plain data can be read from a snapshot");
+			uint32_t count;
+			if ((Read(count) == false) || (static_cast<size_t>(count) * sizeof(T) > m_remainingSize))
+			{
+				m_hasFailed = true;
+				return false;
+			}
+			o_values.resize(count);
+			return ReadBytes(o_values.data(), count * sizeof(T));
+		}
+
+		/* The next i_size bytes to be read in place, null if there aren't as many left */
+		const uint8_t* Consume(size_t i_size)
+		{
+			if (i_size > m_remainingSize)
+			{
+				m_remainingSize = 0;
+				m_hasFailed = true;
+				return nullptr;
+			}
+			const uint8_t* const data = m_data;
+			m_data += i_size;
+			m_remainingSize -= i_size;
+			return data;
+		}
+
+		bool HasFailed() const { return m_hasFailed; }
+		bool IsAtEnd() const { return m_remainingSize == 0; }
+		size_t GetRemainingSize() const { return m_remainingSize; }
+
+
+		// Data
+		//=========================
+
+	private:
+
+		const uint8_t* m_data;
+		size_t m_remainingSize;
+		bool m_hasFailed = false;
+	};
+
+}// Namespace Snapshot
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Delta Encoding
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+namespace Snapshot
+{
+
+	/* Encode i_snapshot as the difference to i_base. Both are compared as 32 bit words, words that didn't change
+	 * are stored as the length of their run and the others as their XOR with the base. Bodies that are asleep or
+	 * static, the BVH nodes that weren't refit and the pairs that stayed in the cache all shrink to a few bytes.
+	 * i_base may be any earlier snapshot, including one of a different size */
+	void EncodeDelta(const std::vector<uint8_t>& i_snapshot, const std::vector<uint8_t>& i_base, std::vector<uint8_t>& o_delta);
+
+	/* Rebuild the snapshot that EncodeDelta() was given from the delta and the same base */
+	cResult DecodeDelta(const std::vector<uint8_t>& i_delta, const std::vector<uint8_t>& i_base, std::vector<uint8_t>& o_snapshot);
+
+}// Namespace Snapshot
+}// Namespace Physics
+}// Namespace eae6320
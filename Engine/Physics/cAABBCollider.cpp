@@ -1,6 +1,7 @@
 // Includes
 //=========
 
+#include <Engine/Physics/Collision.h>
 #include <Engine/Physics/cAABBCollider.h>
 
 
@@ -117,6 +118,50 @@ void eae6320::Physics::cAABBCollider::UpdateExtents(const Math::sVector& i_min,
 }
 
 
+bool eae6320::Physics::cAABBCollider::RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+	float& o_distance, Math::sVector& o_normal) const
+{
+	return Collision::RayCastBox(i_origin, i_direction, i_maxDistance, GetMinExtent_world(), GetMaxExtent_world(), o_distance, o_normal);
+}
+
+
+bool eae6320::Physics::cAABBCollider::SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+	float& o_distance, Math::sVector& o_normal) const
+{
+	// The box is grown by the radius without rounding its edges, so hits near an edge come slightly early
+	const Math::sVector margin = Math::sVector(i_radius, i_radius, i_radius);
+	return Collision::RayCastBox(i_origin, i_direction, i_maxDistance, GetMinExtent_world() - margin, GetMaxExtent_world() + margin, o_distance, o_normal);
+}
+
+
+bool eae6320::Physics::cAABBCollider::IsContainsPoint(const Math::sVector& i_point) const
+{
+	const Math::sVector minExtent = GetMinExtent_world();
+	const Math::sVector maxExtent = GetMaxExtent_world();
+
+	return minExtent.x <= i_point.x && i_point.x <= maxExtent.x &&
+		   minExtent.y <= i_point.y && i_point.y <= maxExtent.y &&
+		   minExtent.z <= i_point.z && i_point.z <= maxExtent.z;
+}
+
+
+bool eae6320::Physics::cAABBCollider::IsOverlapsSphere(const Math::sVector& i_center, float i_radius) const
+{
+	return GetSqDistanceTo(i_center) <= i_radius * i_radius;
+}
+
+
+bool eae6320::Physics::cAABBCollider::IsOverlapsBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const
+{
+	const Math::sVector minExtent = GetMinExtent_world();
+	const Math::sVector maxExtent = GetMaxExtent_world();
+
+	return minExtent.x <= i_maxExtent.x && i_minExtent.x <= maxExtent.x &&
+		   minExtent.y <= i_maxExtent.y && i_minExtent.y <= maxExtent.y &&
+		   minExtent.z <= i_maxExtent.z && i_minExtent.z <= maxExtent.z;
+}
+
+
 void eae6320::Physics::cAABBCollider::GenerateRenderData(
 	uint32_t& o_vertexCount, std::vector<Math::sVector>& o_vertexData, 
 	uint32_t& o_indexCount, std::vector<uint16_t>& o_indexData)
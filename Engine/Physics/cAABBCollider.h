@@ -69,6 +69,21 @@ namespace Physics
 
 		void UpdateExtents(const Math::sVector& i_min, const Math::sVector& i_max);
 
+		// Queries
+		//--------------------------
+
+		bool RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+			float& o_distance, Math::sVector& o_normal) const final;
+
+		bool SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+			float& o_distance, Math::sVector& o_normal) const final;
+
+		bool IsContainsPoint(const Math::sVector& i_point) const final;
+
+		bool IsOverlapsSphere(const Math::sVector& i_center, float i_radius) const final;
+
+		bool IsOverlapsBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const final;
+
 		// Render / Debug
 		//--------------------------
 
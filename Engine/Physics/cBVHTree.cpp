@@ -2,245 +2,505 @@
 //=========
 
 #include <Engine/Graphics/Graphics.h>
+#include <Engine/Logging/Logging.h>
 #include <Engine/Physics/cBVHTree.h>
 #include <Engine/Physics/Collision.h>
 
-#include <queue>
+#include <algorithm>
+#include <cstring>
+
+
+// Helper Functions
+//==================
+
+namespace
+{
+	float GetSurfaceArea(const eae6320::Math::sVector& i_minExtent, const eae6320::Math::sVector& i_maxExtent)
+	{
+		eae6320::Math::sVector size = i_maxExtent - i_minExtent;
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	float GetUnionSurfaceArea(const eae6320::Physics::sBVHNode& i_lhs, const eae6320::Physics::sBVHNode& i_rhs)
+	{
+		return GetSurfaceArea(eae6320::Math::Min(i_lhs.minExtent, i_rhs.minExtent), eae6320::Math::Max(i_lhs.maxExtent, i_rhs.maxExtent));
+	}
+
+	/* The stack of a depth first descent, owned by the query that uses it so that queries can run on several threads
+	 * and filters can start queries of their own. A descent never holds more than one entry per level of the tree,
+	 * so the stack only allocates for trees deeper than its inline capacity */
+	template <class tEntry, size_t tInlineCapacity = 64>
+	class cTraversalStack
+	{
+	public:
+
+		bool empty() const { return m_size == 0; }
+
+		tEntry& back() { return (m_size > tInlineCapacity) ? m_overflow.back() : m_inline[m_size - 1]; }
+
+		void push_back(const tEntry& i_entry)
+		{
+			if (m_size < tInlineCapacity)
+				m_inline[m_size] = i_entry;
+			else
+				m_overflow.push_back(i_entry);
+			m_size++;
+		}
+
+		void pop_back()
+		{
+			if (m_size > tInlineCapacity)
+				m_overflow.pop_back();
+			m_size--;
+		}
+
+	private:
+
+		tEntry m_inline[tInlineCapacity];
+		std::vector<tEntry> m_overflow;
+		size_t m_size = 0;
+	};
+}
 
 
 
 // sBVHNode Implementation
 //==================
 
-eae6320::Physics::sBVHNode::sBVHNode() :
-	parent(nullptr), collider(nullptr), childrenCrossed(false)
+bool eae6320::Physics::sBVHNode::IsLeaf() const
 {
-	children[0] = nullptr;
-	children[1] = nullptr;
+	return children[0] == BVH_NULL_NODE;
 }
 
 
-bool eae6320::Physics::sBVHNode::IsLeaf() const
+float eae6320::Physics::sBVHNode::GetSurfaceArea() const
 {
-	return children[0] == nullptr;
+	Math::sVector size = maxExtent - minExtent;
+	return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
 }
 
 
-void eae6320::Physics::sBVHNode::SetBranch(sBVHNode* i_node0, sBVHNode* i_node1)
+// cBVHTree Implementation
+//==================
+
+int32_t eae6320::Physics::cBVHTree::Search(cCollider* i_collider) const
 {
-	i_node0->parent = this;
-	i_node1->parent = this;
+	auto iter = m_leafIndices.find(i_collider);
 
-	children[0] = i_node0;
-	children[1] = i_node1;
+	return (iter != m_leafIndices.end()) ? iter->second : BVH_NULL_NODE;
 }
 
 
-void eae6320::Physics::sBVHNode::SetLeaf(cCollider* i_collider)
+void eae6320::Physics::cBVHTree::Add(cCollider* i_collider)
 {
-	this->collider = i_collider;
+	const int32_t leaf = AllocateNode();
+	m_nodes[leaf].collider = i_collider;
+	m_nodes[leaf].height = 0;
+	m_leafIndices[i_collider] = leaf;
+
+	UpdateLeafExtents(leaf);
+
+	// Create debug cLine objects, one for new node, the other for branch node if the tree is not empty
+	const size_t newNodeCount = (m_root != BVH_NULL_NODE) ? 2 : 1;
+	for (size_t i = 0; i < newNodeCount; i++)
+	{
+		m_renderData.push_back({ nullptr, Math::cMatrix_transformation() });
+		RenderInitializeHelper(m_renderData.back().first);
+	}
 
-	children[0] = nullptr;
-	children[1] = nullptr;
+	InsertLeaf(leaf);
 }
 
 
-void eae6320::Physics::sBVHNode::UpdateFatAABB(float i_margin)
+void eae6320::Physics::cBVHTree::Add(const std::vector<cCollider*>& i_colliders)
 {
-	if (IsLeaf())
+	if (i_colliders.empty())
+		return;
+
+	// Create leaf nodes for all new colliders
+	std::vector<int32_t> leaves;
+	leaves.reserve(i_colliders.size());
+	for (cCollider* collider : i_colliders)
 	{
-		// make fat AABB, the min/max extent directly represents the world cooridnate of 
-		// the associated collider. Thus the fat AABB should have ZERO world position
-		const Math::sVector marginVec(i_margin, i_margin, i_margin);
-		fatAABB.UpdateExtents(collider->GetMinExtent_world() - marginVec, collider->GetMaxExtent_world() + marginVec);
+		const int32_t leaf = AllocateNode();
+		m_nodes[leaf].collider = collider;
+		m_nodes[leaf].height = 0;
+		m_leafIndices[collider] = leaf;
+
+		UpdateLeafExtents(leaf);
+		leaves.push_back(leaf);
 	}
-	else
+
+	// Build a subtree of the new leaves, then insert the subtree as one node
+	const int32_t subtree = BuildSubtree(leaves, 0, leaves.size());
+	size_t newNodeCount = 2 * leaves.size() - 1;
+
+	if (m_root != BVH_NULL_NODE)
+		newNodeCount++;
+
+	InsertLeaf(subtree);
+
+	// Create one debug cLine object for each new node
+	for (size_t i = 0; i < newNodeCount; i++)
 	{
-		// make union of child nodes' AABB
-		fatAABB = children[0]->fatAABB.Union(children[1]->fatAABB);
+		m_renderData.push_back({ nullptr, Math::cMatrix_transformation() });
+		RenderInitializeHelper(m_renderData.back().first);
 	}
 }
 
 
-eae6320::Physics::sBVHNode* eae6320::Physics::sBVHNode::GetSibling() const
+void eae6320::Physics::cBVHTree::Remove(cCollider* i_collider)
 {
-	return (this == parent->children[0]) ?
-		parent->children[1] :
-		parent->children[0];
-}
-
+	auto iter = m_leafIndices.find(i_collider);
+	if (iter == m_leafIndices.end())
+		return;
 
-// cBVHTree Implementation
-//==================
+	const int32_t leaf = iter->second;
+	m_leafIndices.erase(iter);
 
-eae6320::Physics::sBVHNode* eae6320::Physics::cBVHTree::Search(cCollider* i_collider)
-{
-	if (m_root == nullptr)
-		return nullptr;
+	// Release the cLine instance for both leaf node and branch node
+	const size_t releasedNodeCount = (leaf != m_root) ? 2 : 1;
 
-	std::queue<sBVHNode*> container;
-	container.push(m_root);
+	RemoveLeaf(leaf);
+	FreeNode(leaf);
 
-	while (container.empty() == false)
+	for (size_t i = 0; i < releasedNodeCount; i++)
 	{
-		sBVHNode* current = container.front();
-		container.pop();
-
-		if (current->collider == i_collider)
-		{
-			return current;
-		}
-		else if (current->IsLeaf() == false)
+		if (Graphics::AcquireRenderObjectCleanUpMutex() == WAIT_OBJECT_0)
 		{
-			if (Collision::IsOverlaps(&(current->children[0]->fatAABB), i_collider))
-				container.push(current->children[0]);
-			if (Collision::IsOverlaps(&(current->children[1]->fatAABB), i_collider))
-				container.push(current->children[1]);
+			Graphics::AddLineCleanUpTask(m_renderData.back().first);
+			Graphics::ReleaseRenderObjectCleanUpMutex();
+			m_renderData.pop_back();
 		}
 	}
-
-	return nullptr;
 }
 
 
-void eae6320::Physics::cBVHTree::Add(cCollider* i_collider)
+void eae6320::Physics::cBVHTree::Update(const bool i_checkSleepingLeaves)
 {
-	if (m_root != nullptr)
+	// grab all leaves whose fat AABB doesn't contain the collider's AABB anymore
+	m_invalidNodes.clear();
+	for (int32_t i = 0; i < static_cast<int32_t>(m_nodes.size()); i++)
 	{
-		// if this is not the first node of the tree, insert node to tree
-		sBVHNode* node = new sBVHNode();
-		node->SetLeaf(i_collider);
-		node->UpdateFatAABB(m_margin);
-		InsertNode(node, &m_root);
+		const sBVHNode& node = m_nodes[i];
+		if (node.height != 0)
+			continue;
 
-		// Create two new debug cLine object, one for new node, the other for branch node
-		{
-			m_renderData.push_back({ nullptr, Math::cMatrix_transformation() });
-			RenderInitializeHelper(m_renderData.back().first);
+		// Sleeping bodies don't move, so their leaves can't have left the fat AABB
+		if ((i_checkSleepingLeaves == false) && node.collider->m_objectRigidBody != nullptr && node.collider->m_objectRigidBody->isSleeping)
+			continue;
+
+		const Math::sVector minExtent = node.collider->GetMinExtent_world();
+		const Math::sVector maxExtent = node.collider->GetMaxExtent_world();
 
-			m_renderData.push_back({ nullptr, Math::cMatrix_transformation() });
-			RenderInitializeHelper(m_renderData.back().first);
+		if (minExtent.x < node.minExtent.x || minExtent.y < node.minExtent.y || minExtent.z < node.minExtent.z ||
+			maxExtent.x > node.maxExtent.x || maxExtent.y > node.maxExtent.y || maxExtent.z > node.maxExtent.z)
+		{
+			m_invalidNodes.push_back(i);
 		}
 	}
-	else
+
+	// re-insert invalid leaves, the rest of the tree keeps its shape
+	for (int32_t leaf : m_invalidNodes)
 	{
-		// if this is the first node, make it root
-		m_root = new sBVHNode();
-		m_root->SetLeaf(i_collider);
-		m_root->UpdateFatAABB(m_margin);
+		RemoveLeaf(leaf);
+		UpdateLeafExtents(leaf);
+		InsertLeaf(leaf);
+	}
 
-		// Create one new debug cLine objec for the new node
-		{
-			m_renderData.push_back({ nullptr, Math::cMatrix_transformation() });
-			RenderInitializeHelper(m_renderData.back().first);
-		}
+	m_invalidNodes.clear();
+
+	// Update rendering data
+	{
+		RenderUpdateHelper();
 	}
 }
 
 
-void eae6320::Physics::cBVHTree::Remove(cCollider* i_collider)
+eae6320::Physics::sBVHTreeQuality eae6320::Physics::cBVHTree::GetTreeQuality() const
 {
-	sBVHNode* node = Search(i_collider);
+	sBVHTreeQuality quality;
+
+	if (m_root == BVH_NULL_NODE)
+		return quality;
 
-	if (node != nullptr)
+	float branchArea = 0.0f;
+	for (const sBVHNode& node : m_nodes)
 	{
-		node->collider = nullptr;
-		RemoveNode(node);
+		if (node.height < 0)
+			continue;
+
+		quality.nodeCount++;
+
+		if (node.IsLeaf())
+			quality.leafCount++;
+		else
+			branchArea += node.GetSurfaceArea();
 	}
+
+	const float rootArea = m_nodes[m_root].GetSurfaceArea();
+	quality.totalSAHCost = (rootArea > 0.0f) ? branchArea / rootArea : 0.0f;
+	quality.maxDepth = m_nodes[m_root].height;
+
+	return quality;
 }
 
 
-void eae6320::Physics::cBVHTree::Update()
+void eae6320::Physics::cBVHTree::WriteSnapshot(Snapshot::cWriter& io_writer) const
 {
-	if (m_root != nullptr)
+	io_writer.Write(static_cast<uint32_t>(m_nodes.size()));
+	io_writer.Write(m_root);
+	io_writer.Write(m_nodeCount);
+
+	// Free nodes hold nothing but their link, so only the order of the free list is written for them
+	uint8_t* data = io_writer.Allocate(static_cast<size_t>(m_nodeCount) * s_nodeSnapshotSize);
+	for (int32_t i = 0; i < static_cast<int32_t>(m_nodes.size()); i++)
+	{
+		if (m_nodes[i].height < 0)
+			continue;
+
+		std::memcpy(data, &i, sizeof(int32_t));
+		std::memcpy(data + sizeof(int32_t), &m_nodes[i], sizeof(sBVHNode));
+		data += s_nodeSnapshotSize;
+	}
+
+	data = io_writer.Allocate((m_nodes.size() - static_cast<size_t>(m_nodeCount)) * sizeof(int32_t));
+	for (int32_t node = m_freeList; node != BVH_NULL_NODE; node = m_nodes[node].parent)
+	{
+		std::memcpy(data, &node, sizeof(int32_t));
+		data += sizeof(int32_t);
+	}
+}
+
+
+eae6320::cResult eae6320::Physics::cBVHTree::ReadSnapshot(Snapshot::cReader& io_reader)
+{
+	uint32_t poolSize;
+	int32_t nodeCount;
+	if ((io_reader.Read(poolSize) == false) || (io_reader.Read(m_snapshotRoot) == false) || (io_reader.Read(nodeCount) == false)
+		|| (nodeCount < 0) || (static_cast<uint32_t>(nodeCount) > poolSize)
+		|| (io_reader.GetRemainingSize() < (static_cast<size_t>(nodeCount) * s_nodeSnapshotSize) + ((poolSize - nodeCount) * sizeof(int32_t))))
+	{
+		Logging::OutputError("Physics::cBVHTree: The snapshot is truncated");
+		return Results::Failure;
+	}
+	const int32_t freeCount = static_cast<int32_t>(poolSize) - nodeCount;
+	const auto isInPool = [poolSize](int32_t i_node) { return (i_node >= 0) && (static_cast<uint32_t>(i_node) < poolSize); };
+	const auto isLinkValid = [&isInPool](int32_t i_node) { return (i_node == BVH_NULL_NODE) || isInPool(i_node); };
+
+	// Resizing to the size the pool already has doesn't touch its nodes, every node is written below
+	m_snapshotNodes.resize(poolSize);
+	m_isSnapshotNodeRead.assign(poolSize, 0);
+	m_snapshotNodeCount = nodeCount;
+
+	// Every leaf has to belong to a collider of this tree, and there have to be as many leaves as colliders.
+	// Leaves keep their node until they are removed, so most of them are found in the same node without a lookup
+	size_t leafCount = 0;
+	m_haveSnapshotLeavesMoved = false;
+	const uint8_t* data = io_reader.Consume(static_cast<size_t>(nodeCount) * s_nodeSnapshotSize);
+	for (int32_t n = 0; n < nodeCount; n++, data += s_nodeSnapshotSize)
 	{
-		if (m_root->IsLeaf())
+		int32_t i;
+		std::memcpy(&i, data, sizeof(int32_t));
+		if ((isInPool(i) == false) || (m_isSnapshotNodeRead[i] != 0))
 		{
-			m_root->UpdateFatAABB(m_margin);
+			Logging::OutputError("Physics::cBVHTree: The snapshot has a node outside of the pool or twice");
+			return Results::Failure;
 		}
-		else
+		m_isSnapshotNodeRead[i] = 1;
+
+		sBVHNode& node = m_snapshotNodes[i];
+		std::memcpy(&node, data + sizeof(int32_t), sizeof(sBVHNode));
+		if ((node.height < 0) || (isLinkValid(node.parent) == false)
+			|| (isLinkValid(node.children[0]) == false) || (isLinkValid(node.children[1]) == false))
 		{
-			// grab all invalid nodes
-			m_invalidNodes.clear();
-			UpdateInvalidNodeHelper(m_root, m_invalidNodes);
+			Logging::OutputError("Physics::cBVHTree: The snapshot has a node with invalid links");
+			return Results::Failure;
+		}
+		if (node.height != 0)
+			continue;
 
-			// re-insert all invalid nodes
-			for (sBVHNode* node : m_invalidNodes)
-			{
-				// grab parent link (pointer to another pointer that points to parent)
-				sBVHNode* parent = node->parent;
-				sBVHNode* sibling = node->GetSibling();
-				sBVHNode** parentLink = (parent->parent != nullptr) ?
-					(parent == parent->parent->children[0] ? &parent->parent->children[0] : &parent->parent->children[1]) :
-					&m_root;
-
-				// replace parent with sibling
-				sibling->parent = (parent->parent != nullptr) ?
-					parent->parent : 
-					nullptr;		// if sibling's parent is root, root has null parent
-
-				// let grand parent's child points to sibling (which was originally pointed to the parent of the sibling)
-				*parentLink = sibling;
-				delete parent;
-
-				// re-insert node
-				node->UpdateFatAABB(m_margin);
-				InsertNode(node, &m_root);
-			}
+		leafCount++;
+		if ((static_cast<size_t>(i) < m_nodes.size()) && (m_nodes[i].height == 0) && (m_nodes[i].collider == node.collider))
+			continue;
 
-			m_invalidNodes.clear();
+		if (m_leafIndices.find(node.collider) == m_leafIndices.end())
+		{
+			Logging::OutputError("Physics::cBVHTree: The snapshot has a leaf of a collider that isn't in the tree");
+			return Results::Failure;
 		}
+		m_haveSnapshotLeavesMoved = true;
+	}
+	if (leafCount != m_leafIndices.size())
+	{
+		Logging::OutputError("Physics::cBVHTree: The snapshot has %u leaves but the tree has %u colliders",
+			static_cast<uint32_t>(leafCount), static_cast<uint32_t>(m_leafIndices.size()));
+		return Results::Failure;
+	}
+	if ((m_snapshotRoot != BVH_NULL_NODE) && ((isInPool(m_snapshotRoot) == false) || (m_isSnapshotNodeRead[m_snapshotRoot] == 0)))
+	{
+		Logging::OutputError("Physics::cBVHTree: The snapshot has a root that isn't in use");
+		return Results::Failure;
 	}
 
-	// Update rendering data
+	// The free list is rebuilt in the same order, so the next nodes that are allocated are the same ones
+	m_snapshotFreeList = BVH_NULL_NODE;
+	data = io_reader.Consume(freeCount * sizeof(int32_t));
+	for (int32_t n = freeCount - 1; n >= 0; n--)
 	{
-		RenderUpdateHelper();
+		int32_t i;
+		std::memcpy(&i, data + (n * sizeof(int32_t)), sizeof(int32_t));
+		if ((isInPool(i) == false) || (m_isSnapshotNodeRead[i] != 0))
+		{
+			Logging::OutputError("Physics::cBVHTree: The snapshot has a free node outside of the pool or twice");
+			return Results::Failure;
+		}
+		m_isSnapshotNodeRead[i] = 1;
+
+		m_snapshotNodes[i] = sBVHNode();
+		m_snapshotNodes[i].parent = m_snapshotFreeList;
+		m_snapshotFreeList = i;
+	}
+
+	return Results::Success;
+}
+
+
+void eae6320::Physics::cBVHTree::ApplySnapshot()
+{
+	std::swap(m_nodes, m_snapshotNodes);
+	if (m_haveSnapshotLeavesMoved)
+	{
+		for (int32_t i = 0; i < static_cast<int32_t>(m_nodes.size()); i++)
+		{
+			if (m_nodes[i].height == 0)
+				m_leafIndices[m_nodes[i].collider] = i;
+		}
 	}
+	m_root = m_snapshotRoot;
+	m_freeList = m_snapshotFreeList;
+	m_nodeCount = m_snapshotNodeCount;
 }
 
 
-std::list<std::pair<eae6320::Physics::cCollider*, eae6320::Physics::cCollider*>>& eae6320::Physics::cBVHTree::ComputePairs()
+const std::vector<std::pair<eae6320::Physics::cCollider*, eae6320::Physics::cCollider*>>& eae6320::Physics::cBVHTree::ComputePairs()
 {
 	m_pairs.clear();
 
-	if (m_root == nullptr || m_root->IsLeaf())
+	if (m_root == BVH_NULL_NODE || m_nodes[m_root].IsLeaf())
 		return m_pairs;
 
-	// clear Node::childrenCrossed flags
-	ClearChildrenCrossFlagHelper(m_root);
-
-	// base recursive call
-	ComputePairsHelper(m_root->children[0], m_root->children[1]);
+	ComputePairs({ m_root, m_root }, m_pairs, m_pairStack);
 
 	return m_pairs;
 }
 
 
+void eae6320::Physics::cBVHTree::SplitPairTasks(size_t i_minTaskCount, std::vector<std::pair<int32_t, int32_t>>& o_tasks) const
+{
+	SplitPairTasks(*this, i_minTaskCount, o_tasks);
+}
+
+
+void eae6320::Physics::cBVHTree::SplitPairTasks(const cBVHTree& i_other, size_t i_minTaskCount, std::vector<std::pair<int32_t, int32_t>>& o_tasks) const
+{
+	o_tasks.clear();
+
+	if (m_root == BVH_NULL_NODE || i_other.m_root == BVH_NULL_NODE || (&i_other == this && m_nodes[m_root].IsLeaf()))
+		return;
+
+	// Descend one level of every task at a time until there are enough tasks. Overlapping
+	// leaf pairs can't be split any further and are kept as they are
+	o_tasks.push_back({ m_root, i_other.m_root });
+
+	std::vector<std::pair<int32_t, int32_t>> nextTasks;
+	while (o_tasks.size() < i_minTaskCount)
+	{
+		nextTasks.clear();
+		bool isSplit = false;
+
+		for (const auto& task : o_tasks)
+		{
+			if (DescendPair(task.first, i_other, task.second, nextTasks))
+				nextTasks.push_back(task);
+			else
+				isSplit = true;
+		}
+
+		o_tasks.swap(nextTasks);
+
+		if (isSplit == false)
+			break;
+	}
+}
+
+
+void eae6320::Physics::cBVHTree::ComputePairs(const std::pair<int32_t, int32_t>& i_task, std::vector<std::pair<cCollider*, cCollider*>>& o_pairs, std::vector<std::pair<int32_t, int32_t>>& io_pairStack) const
+{
+	ComputePairs(*this, i_task, o_pairs, io_pairStack);
+}
+
+
+void eae6320::Physics::cBVHTree::ComputePairs(const cBVHTree& i_other, const std::pair<int32_t, int32_t>& i_task, std::vector<std::pair<cCollider*, cCollider*>>& o_pairs,
+	std::vector<std::pair<int32_t, int32_t>>& io_pairStack) const
+{
+	/*
+	* Simultaneous descent of the two trees. When both are this tree, a node paired with itself
+	* splits into its two self pairs plus the pair of its children, so every leaf pair is visited once.
+	* Two different nodes are only descended when their fat AABBs overlap and their layers accept
+	* each other, splitting the one with larger surface area first.
+	*/
+
+	io_pairStack.clear();
+	io_pairStack.push_back(i_task);
+
+	while (io_pairStack.empty() == false)
+	{
+		const std::pair<int32_t, int32_t> nodePair = io_pairStack.back();
+		io_pairStack.pop_back();
+
+		if (DescendPair(nodePair.first, i_other, nodePair.second, io_pairStack) == false)
+			continue;
+
+		// 2 leaves, report pair if the colliders are interested in each other
+		cCollider* collider0 = m_nodes[nodePair.first].collider;
+		cCollider* collider1 = i_other.m_nodes[nodePair.second].collider;
+		if (collider0->CanCollideWith(collider1))
+			o_pairs.push_back({ collider0, collider1 });
+	}
+}
+
+
 std::vector<eae6320::Physics::cCollider*> eae6320::Physics::cBVHTree::Query(cCollider* i_collider) const
 {
 	std::vector<cCollider*> result = std::vector<cCollider*>(0);
-	std::queue<sBVHNode*> container;
 
-	if (m_root == nullptr)
+	if (m_root == BVH_NULL_NODE)
 		return result;
 
-	container.push(m_root);
-	while (container.empty() == false)
+	const Math::sVector minExtent = i_collider->GetMinExtent_world();
+	const Math::sVector maxExtent = i_collider->GetMaxExtent_world();
+
+	cTraversalStack<int32_t> traversalStack;
+	traversalStack.push_back(m_root);
+	while (traversalStack.empty() == false)
 	{
-		sBVHNode* current = container.front();
-		container.pop();
+		const int32_t current = traversalStack.back();
+		traversalStack.pop_back();
+
+		const sBVHNode& node = m_nodes[current];
+		if (IsOverlaps(current, minExtent, maxExtent) == false)
+			continue;
 
-		if (current->IsLeaf())
+		if (node.IsLeaf())
 		{
-			if (Collision::IsOverlaps(i_collider, current->collider) && i_collider != current->collider)
-				result.push_back(current->collider);
+			if (node.collider != i_collider && Collision::IsOverlaps(i_collider, node.collider))
+				result.push_back(node.collider);
 		}
 		else
 		{
-			if (Collision::IsOverlaps(i_collider, dynamic_cast<cCollider*>(&current->children[0]->fatAABB)))
-				container.push(current->children[0]);
-			if (Collision::IsOverlaps(i_collider, dynamic_cast<cCollider*>(&current->children[1]->fatAABB)))
-				container.push(current->children[1]);
+			traversalStack.push_back(node.children[0]);
+			traversalStack.push_back(node.children[1]);
 		}
 	}
 
@@ -248,233 +508,814 @@ std::vector<eae6320::Physics::cCollider*> eae6320::Physics::cBVHTree::Query(cCol
 }
 
 
-void eae6320::Physics::cBVHTree::InitialzieRenderData()
+void eae6320::Physics::cBVHTree::Query(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, std::vector<cCollider*>& o_colliders) const
 {
-	m_renderData.clear();
-
-	if (m_root == nullptr)
+	if (m_root == BVH_NULL_NODE)
 		return;
 
-	std::queue<sBVHNode*> container;
-	container.push(m_root);
-
-	while (container.empty() == false)
+	cTraversalStack<int32_t> traversalStack;
+	traversalStack.push_back(m_root);
+	while (traversalStack.empty() == false)
 	{
-		sBVHNode* current = container.front();
-		container.pop();
+		const int32_t current = traversalStack.back();
+		traversalStack.pop_back();
 
-		m_renderData.push_back({ nullptr, Math::cMatrix_transformation() });
-		RenderInitializeHelper(m_renderData.back().first);
+		const sBVHNode& node = m_nodes[current];
+		if (IsOverlaps(current, i_minExtent, i_maxExtent) == false)
+			continue;
 
-		if (current->IsLeaf() == false)
+		if (node.IsLeaf())
 		{
-			container.push(current->children[0]);
-			container.push(current->children[1]);
+			o_colliders.push_back(node.collider);
+		}
+		else
+		{
+			traversalStack.push_back(node.children[0]);
+			traversalStack.push_back(node.children[1]);
 		}
 	}
 }
 
 
-std::list<std::pair<std::weak_ptr<eae6320::Graphics::cLine>, eae6320::Math::cMatrix_transformation>> eae6320::Physics::cBVHTree::GetRenderData()
+bool eae6320::Physics::cBVHTree::RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+	sRayCastHit& o_hit, const fQueryFilter& i_filter) const
 {
-	std::list<std::pair<std::weak_ptr<Graphics::cLine>, Math::cMatrix_transformation>> result;
-	for (auto iter = m_renderData.begin(); iter != m_renderData.end(); iter++)
+	return Cast(i_origin, 0.0f, i_direction, i_maxDistance, o_hit, i_filter);
+}
+
+
+void eae6320::Physics::cBVHTree::RayCastAll(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+	std::vector<sRayCastHit>& o_hits, const fQueryFilter& i_filter) const
+{
+	o_hits.clear();
+
+	if (m_root == BVH_NULL_NODE)
+		return;
+
+	cTraversalStack<int32_t> traversalStack;
+	traversalStack.push_back(m_root);
+	while (traversalStack.empty() == false)
 	{
-		result.push_back({ iter->first, iter->second });
+		const int32_t current = traversalStack.back();
+		traversalStack.pop_back();
+
+		float entry = 0.0f;
+		if (IntersectRay(current, i_origin, i_direction, 0.0f, i_maxDistance, entry) == false)
+			continue;
+
+		const sBVHNode& node = m_nodes[current];
+		if (node.IsLeaf())
+		{
+			sRayCastHit hit;
+			if (node.collider->RayCast(i_origin, i_direction, i_maxDistance, hit.distance, hit.normal) &&
+				(i_filter == nullptr || i_filter(node.collider)))
+			{
+				hit.collider = node.collider;
+				hit.point = i_origin + i_direction * hit.distance;
+				o_hits.push_back(hit);
+			}
+		}
+		else
+		{
+			traversalStack.push_back(node.children[0]);
+			traversalStack.push_back(node.children[1]);
+		}
 	}
 
-	return result;
+	// Ties are broken by id so that the order doesn't depend on the shape of the tree
+	std::sort(o_hits.begin(), o_hits.end(),
+		[](const sRayCastHit& i_lhs, const sRayCastHit& i_rhs)
+		{
+			return (i_lhs.distance != i_rhs.distance) ? (i_lhs.distance < i_rhs.distance) : (i_lhs.collider->GetID() < i_rhs.collider->GetID());
+		});
 }
 
 
-void eae6320::Physics::cBVHTree::InsertNode(sBVHNode* i_node, sBVHNode** i_parent)
+bool eae6320::Physics::cBVHTree::SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+	sRayCastHit& o_hit, const fQueryFilter& i_filter) const
 {
-	sBVHNode* p = *i_parent;
+	return Cast(i_origin, i_radius, i_direction, i_maxDistance, o_hit, i_filter);
+}
+
 
-	// If parent is leaf node, simply split
-	if (p->IsLeaf())
+void eae6320::Physics::cBVHTree::OverlapSphere(const Math::sVector& i_center, float i_radius, std::vector<cCollider*>& o_colliders, const fQueryFilter& i_filter) const
+{
+	if (m_root == BVH_NULL_NODE)
+		return;
+
+	cTraversalStack<int32_t> traversalStack;
+	traversalStack.push_back(m_root);
+	while (traversalStack.empty() == false)
 	{
-		sBVHNode* newParent = new sBVHNode();
-		newParent->parent = p->parent;
-		newParent->SetBranch(i_node, p);
-		*i_parent = newParent;
+		const int32_t current = traversalStack.back();
+		traversalStack.pop_back();
+
+		const sBVHNode& node = m_nodes[current];
+		const Math::sVector closestPoint = Math::Min(Math::Max(i_center, node.minExtent), node.maxExtent);
+		if (Math::SqDistance(closestPoint, i_center) > i_radius * i_radius)
+			continue;
+
+		if (node.IsLeaf())
+		{
+			if (node.collider->IsOverlapsSphere(i_center, i_radius) && (i_filter == nullptr || i_filter(node.collider)))
+				o_colliders.push_back(node.collider);
+		}
+		else
+		{
+			traversalStack.push_back(node.children[0]);
+			traversalStack.push_back(node.children[1]);
+		}
 	}
-	// If parent is branch node, compute volume differences between pre-insert and post-insert
-	else
+}
+
+
+void eae6320::Physics::cBVHTree::OverlapBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, std::vector<cCollider*>& o_colliders, const fQueryFilter& i_filter) const
+{
+	if (m_root == BVH_NULL_NODE)
+		return;
+
+	cTraversalStack<int32_t> traversalStack;
+	traversalStack.push_back(m_root);
+	while (traversalStack.empty() == false)
 	{
-		const cAABBCollider& aabb0 = p->children[0]->fatAABB;
-		const cAABBCollider& aabb1 = p->children[1]->fatAABB;
+		const int32_t current = traversalStack.back();
+		traversalStack.pop_back();
 
-		float volumeDiff0 = aabb0.Union(i_node->fatAABB).GetVolume() - aabb0.GetVolume();
-		float volumeDiff1 = aabb1.Union(i_node->fatAABB).GetVolume() - aabb1.GetVolume();
+		if (IsOverlaps(current, i_minExtent, i_maxExtent) == false)
+			continue;
 
-		// insert to the child that gives less volume increase
-		if (volumeDiff0 < volumeDiff1)
-			InsertNode(i_node, &p->children[0]);
+		const sBVHNode& node = m_nodes[current];
+		if (node.IsLeaf())
+		{
+			if (node.collider->IsOverlapsBox(i_minExtent, i_maxExtent) && (i_filter == nullptr || i_filter(node.collider)))
+				o_colliders.push_back(node.collider);
+		}
 		else
-			InsertNode(i_node, &p->children[1]);
+		{
+			traversalStack.push_back(node.children[0]);
+			traversalStack.push_back(node.children[1]);
+		}
 	}
-
-	// update parent AABB (propagates back up the recursion stack)
-	(*i_parent)->UpdateFatAABB(m_margin);
 }
 
 
-void eae6320::Physics::cBVHTree::RemoveNode(sBVHNode* i_node)
+eae6320::Physics::cCollider* eae6320::Physics::cBVHTree::Pick(const Math::sVector& i_point, const fQueryFilter& i_filter) const
 {
-	// replace parent with sibling, remove parent node
-	sBVHNode* parent = i_node->parent;
+	if (m_root == BVH_NULL_NODE)
+		return nullptr;
 
-	// if current node is not root
-	if (parent != nullptr)
+	cTraversalStack<int32_t> traversalStack;
+	traversalStack.push_back(m_root);
+	while (traversalStack.empty() == false)
 	{
-		sBVHNode* sibling = i_node->GetSibling();
+		const int32_t current = traversalStack.back();
+		traversalStack.pop_back();
+
+		if (IsOverlaps(current, i_point, i_point) == false)
+			continue;
 
-		// if there is a grandparent, update sibling with the grandparent
-		if (parent->parent != nullptr)
+		const sBVHNode& node = m_nodes[current];
+		if (node.IsLeaf())
 		{
-			sibling->parent = parent->parent;
-			(parent == parent->parent->children[0] ?
-				parent->parent->children[0] :
-				parent->parent->children[1]) = sibling;
+			if (node.collider->IsContainsPoint(i_point) && (i_filter == nullptr || i_filter(node.collider)))
+				return node.collider;
 		}
-		// if there is no grandparent, make sibling root
 		else
 		{
-			m_root = sibling;
-			sibling->parent = nullptr;
+			traversalStack.push_back(node.children[0]);
+			traversalStack.push_back(node.children[1]);
+		}
+	}
+
+	return nullptr;
+}
+
+
+void eae6320::Physics::cBVHTree::RayCast(const sRay* i_rays, size_t i_rayCount, sRayCastHit* o_hits, sRayBatchBuffers& io_buffers,
+	const fQueryFilter& i_filter) const
+{
+	for (size_t i = 0; i < i_rayCount; i++)
+	{
+		o_hits[i] = sRayCastHit();
+	}
+
+	if (m_root == BVH_NULL_NODE || i_rayCount == 0)
+		return;
+
+	// The distance of a ray without a hit is its max distance, so that nodes beyond it are skipped
+	for (size_t i = 0; i < i_rayCount; i++)
+	{
+		o_hits[i].distance = i_rays[i].maxDistance;
+	}
+
+	// The rays that reach a node at depth d are kept in slice d + 1 of rayIndices. A node only overwrites the slice
+	// below its parent's, and the nodes still on the stack read the slices of their parents, which are above it.
+	// The buffer is sized once from the height of the tree, so the traversal never allocates
+	const uint32_t rayCount = static_cast<uint32_t>(i_rayCount);
+	const size_t sliceCount = static_cast<size_t>(m_nodes[m_root].height) + 2;
+	io_buffers.rayIndices.resize(sliceCount * rayCount);
+	io_buffers.stack.clear();
+
+	for (uint32_t i = 0; i < rayCount; i++)
+	{
+		io_buffers.rayIndices[i] = i;
+	}
+	io_buffers.stack.push_back({ m_root, 0, 0, rayCount });
+
+	while (io_buffers.stack.empty() == false)
+	{
+		const sRayBatchBuffers::sEntry entry = io_buffers.stack.back();
+		io_buffers.stack.pop_back();
+
+		// Keep the rays that reach this node before their closest hit so far
+		const uint32_t begin = (entry.depth + 1) * rayCount;
+		uint32_t count = 0;
+		for (uint32_t i = entry.begin; i < entry.begin + entry.count; i++)
+		{
+			const uint32_t rayIndex = io_buffers.rayIndices[i];
+			const sRay& ray = i_rays[rayIndex];
+
+			float distance = 0.0f;
+			if (IntersectRay(entry.node, ray.origin, ray.direction, 0.0f, o_hits[rayIndex].distance, distance))
+				io_buffers.rayIndices[begin + count++] = rayIndex;
 		}
 
-		delete i_node;
-		delete parent;
+		if (count == 0)
+			continue;
 
-		// Release the cLine instance for both leaf node and branch node
-		if (Graphics::AcquireRenderObjectCleanUpMutex() == WAIT_OBJECT_0)
+		const sBVHNode& node = m_nodes[entry.node];
+		if (node.IsLeaf())
 		{
-			Graphics::AddLineCleanUpTask(m_renderData.back().first);
-			Graphics::ReleaseRenderObjectCleanUpMutex();
-			m_renderData.pop_back();
+			for (uint32_t i = begin; i < begin + count; i++)
+			{
+				const uint32_t rayIndex = io_buffers.rayIndices[i];
+				const sRay& ray = i_rays[rayIndex];
+				sRayCastHit& hit = o_hits[rayIndex];
+
+				float distance = 0.0f;
+				Math::sVector normal;
+				if (node.collider->RayCast(ray.origin, ray.direction, hit.distance, distance, normal) &&
+					(i_filter == nullptr || i_filter(node.collider)))
+				{
+					hit.collider = node.collider;
+					hit.distance = distance;
+					hit.point = ray.origin + ray.direction * distance;
+					hit.normal = normal;
+				}
+			}
 		}
-		if (Graphics::AcquireRenderObjectCleanUpMutex() == WAIT_OBJECT_0)
+		else
 		{
-			Graphics::AddLineCleanUpTask(m_renderData.back().first);
-			Graphics::ReleaseRenderObjectCleanUpMutex();
-			m_renderData.pop_back();
+			// The first ray decides which child is visited first, rays of one batch usually go the same way.
+			// A child beyond its closest hit so far goes last
+			const uint32_t rayIndex = io_buffers.rayIndices[begin];
+			const sRay& ray = i_rays[rayIndex];
+			float entry0 = 0.0f;
+			float entry1 = 0.0f;
+			const bool isHit0 = IntersectRay(node.children[0], ray.origin, ray.direction, 0.0f, o_hits[rayIndex].distance, entry0);
+			const bool isHit1 = IntersectRay(node.children[1], ray.origin, ray.direction, 0.0f, o_hits[rayIndex].distance, entry1);
+			const bool isFirstNearer = isHit0 && (isHit1 == false || entry0 <= entry1);
+
+			io_buffers.stack.push_back({ node.children[isFirstNearer ? 1 : 0], entry.depth + 1, begin, count });
+			io_buffers.stack.push_back({ node.children[isFirstNearer ? 0 : 1], entry.depth + 1, begin, count });
 		}
 	}
-	// if current node is root
-	else
+
+	for (size_t i = 0; i < i_rayCount; i++)
 	{
-		m_root = nullptr;
-		delete parent;
+		if (o_hits[i].collider == nullptr)
+			o_hits[i].distance = 0.0f;
+	}
+}
 
-		if (Graphics::AcquireRenderObjectCleanUpMutex() == WAIT_OBJECT_0)
+
+void eae6320::Physics::cBVHTree::InitialzieRenderData()
+{
+	m_renderData.clear();
+
+	for (int32_t i = 0; i < m_nodeCount; i++)
+	{
+		m_renderData.push_back({ nullptr, Math::cMatrix_transformation() });
+		RenderInitializeHelper(m_renderData.back().first);
+	}
+}
+
+
+std::list<std::pair<eae6320::Graphics::cRenderHandle<eae6320::Graphics::cLine>, eae6320::Math::cMatrix_transformation>> eae6320::Physics::cBVHTree::GetRenderData()
+{
+	std::list<std::pair<Graphics::cRenderHandle<Graphics::cLine>, Math::cMatrix_transformation>> result;
+	// A line that the render thread hasn't created yet has no handle and is skipped when drawing
+	for (auto iter = m_renderData.begin(); iter != m_renderData.end(); iter++)
+	{
+		result.push_back({ iter->first ? iter->first->GetHandle() : Graphics::cRenderHandle<Graphics::cLine>(), iter->second });
+	}
+
+	return result;
+}
+
+
+int32_t eae6320::Physics::cBVHTree::AllocateNode()
+{
+	// Grow the pool when the free list is empty
+	if (m_freeList == BVH_NULL_NODE)
+	{
+		const int32_t oldCapacity = static_cast<int32_t>(m_nodes.size());
+		const int32_t newCapacity = (oldCapacity == 0) ? 16 : oldCapacity * 2;
+
+		m_nodes.resize(newCapacity);
+		for (int32_t i = oldCapacity; i < newCapacity; i++)
 		{
-			Graphics::AddLineCleanUpTask(m_renderData.back().first);
-			Graphics::ReleaseRenderObjectCleanUpMutex();
-			m_renderData.pop_back();
+			m_nodes[i].parent = (i + 1 < newCapacity) ? i + 1 : BVH_NULL_NODE;
+			m_nodes[i].height = -1;
 		}
+		m_freeList = oldCapacity;
 	}
+
+	const int32_t node = m_freeList;
+	m_freeList = m_nodes[node].parent;
+
+	m_nodes[node] = sBVHNode();
+	m_nodes[node].height = 0;
+	m_nodeCount++;
+
+	return node;
 }
 
 
-void eae6320::Physics::cBVHTree::UpdateInvalidNodeHelper(sBVHNode* i_node, std::vector<sBVHNode*>& i_invalidNodes)
+void eae6320::Physics::cBVHTree::FreeNode(int32_t i_node)
 {
-	std::queue<sBVHNode*> container;
-	container.push(i_node);
+	m_nodes[i_node] = sBVHNode();
+	m_nodes[i_node].parent = m_freeList;
+	m_freeList = i_node;
+	m_nodeCount--;
+}
 
-	while (container.empty() == false)
+
+void eae6320::Physics::cBVHTree::InsertLeaf(int32_t i_leaf)
+{
+	if (m_root == BVH_NULL_NODE)
 	{
-		sBVHNode* current = container.front();
-		container.pop();
+		m_root = i_leaf;
+		m_nodes[m_root].parent = BVH_NULL_NODE;
+		return;
+	}
+
+	const int32_t sibling = FindBestSibling(i_leaf);
 
-		// check if fat AABB doesn't contain the collider's AABB anymore
-		if (current->IsLeaf())
+	// Replace the sibling with a new branch node that holds both sibling and the new leaf
+	const int32_t oldParent = m_nodes[sibling].parent;
+	const int32_t newParent = AllocateNode();
+	m_nodes[newParent].parent = oldParent;
+	m_nodes[newParent].children[0] = i_leaf;
+	m_nodes[newParent].children[1] = sibling;
+	m_nodes[i_leaf].parent = newParent;
+	m_nodes[sibling].parent = newParent;
+
+	if (oldParent != BVH_NULL_NODE)
+	{
+		sBVHNode& parent = m_nodes[oldParent];
+		(parent.children[0] == sibling ? parent.children[0] : parent.children[1]) = newParent;
+	}
+	else
+	{
+		m_root = newParent;
+	}
+
+	// update AABBs back up to the root
+	RefitAncestors(newParent);
+}
+
+
+int32_t eae6320::Physics::cBVHTree::FindBestSibling(int32_t i_leaf)
+{
+	/*
+	* Branch and bound search for the sibling that minimizes the surface area heuristic.
+	* Pairing the leaf with node N costs the area of (N + leaf) for the new branch node,
+	* plus the area growth of every ancestor of N (the inherited cost). A subtree can be
+	* skipped when its lower bound, area(leaf) + inherited cost, is no better than the best
+	* candidate found so far.
+	*/
+
+	const sBVHNode& leaf = m_nodes[i_leaf];
+	const float leafArea = leaf.GetSurfaceArea();
+
+	int32_t bestSibling = m_root;
+	float bestCost = GetUnionSurfaceArea(m_nodes[m_root], leaf);
+
+	// min-heap of (inherited cost, node)
+	auto comparator = [](const std::pair<float, int32_t>& i_lhs, const std::pair<float, int32_t>& i_rhs)
+	{
+		return i_lhs.first > i_rhs.first;
+	};
+
+	m_siblingCandidates.clear();
+	m_siblingCandidates.push_back({ 0.0f, m_root });
+
+	while (m_siblingCandidates.empty() == false)
+	{
+		std::pop_heap(m_siblingCandidates.begin(), m_siblingCandidates.end(), comparator);
+		const float inheritedCost = m_siblingCandidates.back().first;
+		const int32_t current = m_siblingCandidates.back().second;
+		m_siblingCandidates.pop_back();
+
+		if (inheritedCost + leafArea >= bestCost)
+			break;
+
+		const sBVHNode& node = m_nodes[current];
+		const float directCost = GetUnionSurfaceArea(node, leaf);
+		const float cost = directCost + inheritedCost;
+
+		if (cost < bestCost)
 		{
-			if (current->fatAABB.IsContains(*current->collider) == false)
-				i_invalidNodes.push_back(current);
+			bestSibling = current;
+			bestCost = cost;
 		}
-		else
+
+		if (node.IsLeaf() == false)
 		{
-			container.push(current->children[0]);
-			container.push(current->children[1]);
+			const float childInheritedCost = inheritedCost + directCost - node.GetSurfaceArea();
+
+			if (childInheritedCost + leafArea < bestCost)
+			{
+				m_siblingCandidates.push_back({ childInheritedCost, node.children[0] });
+				std::push_heap(m_siblingCandidates.begin(), m_siblingCandidates.end(), comparator);
+				m_siblingCandidates.push_back({ childInheritedCost, node.children[1] });
+				std::push_heap(m_siblingCandidates.begin(), m_siblingCandidates.end(), comparator);
+			}
 		}
 	}
+
+	return bestSibling;
 }
 
 
-void eae6320::Physics::cBVHTree::ComputePairsHelper(sBVHNode* i_node0, sBVHNode* i_node1)
+void eae6320::Physics::cBVHTree::Rotate(int32_t i_node)
 {
 	/*
-	* 2 Leaf Nodes C Weve reached the end of the tree, simply check the AABBs of the corresponding 
-	*	colliders and possibly add them to the pair list
-	* 
-	* 1 Leaf Node plus 1 Branch Node C Cross check the child nodes of the branch node (make a recursive 
-	*	call with the child nodes), and make recursive calls with the leaf node against each child nodes 
-	*	of the branch node.
-	* 
-	* 2 Branch Nodes C Make a recursive call on every combination of 2 nodes out of the 4 child nodes.
+	* Tree rotation: swap one child of this node with a grandchild on the other side when that
+	* shrinks the surface area of the branch node that the swapped child moves into. The box
+	* of this node is unchanged since it still covers the same leaves.
+	*
+	*        A                 A
+	*      /   \             /   \
+	*     B     C     =>     F     C
+	*          / \                / \
+	*         F   G              B   G
 	*/
 
-	if (i_node0->IsLeaf())
+	const int32_t B = m_nodes[i_node].children[0];
+	const int32_t C = m_nodes[i_node].children[1];
+
+	const bool isBLeaf = m_nodes[B].IsLeaf();
+	const bool isCLeaf = m_nodes[C].IsLeaf();
+
+	if (isBLeaf && isCLeaf)
+		return;
+
+	// Each candidate swaps an aunt with one of its nephews
+	int32_t bestAunt = BVH_NULL_NODE;
+	int32_t bestNephew = BVH_NULL_NODE;
+	float bestDelta = 0.0f;
+
+	auto evaluate = [this, &bestAunt, &bestNephew, &bestDelta](int32_t i_aunt, int32_t i_parent)
 	{
-		// 2 leaves, check proxies instead of fat AABBs
-		if (i_node1->IsLeaf())
+		const sBVHNode& aunt = m_nodes[i_aunt];
+		const sBVHNode& parent = m_nodes[i_parent];
+		const float parentArea = parent.GetSurfaceArea();
+
+		for (int i = 0; i < 2; i++)
 		{
-			if (Collision::IsOverlaps(i_node0->collider, i_node1->collider))
+			// After the swap, parent holds the aunt and the other nephew
+			const int32_t nephew = parent.children[i];
+			const int32_t otherNephew = parent.children[1 - i];
+			const float delta = GetUnionSurfaceArea(aunt, m_nodes[otherNephew]) - parentArea;
+
+			if (delta < bestDelta)
 			{
-				m_pairs.push_back(std::pair<cCollider*, cCollider*>(i_node0->collider, i_node1->collider));
+				bestAunt = i_aunt;
+				bestNephew = nephew;
+				bestDelta = delta;
 			}
 		}
-		// 1 branch / 1 leaf, 2 cross checks
-		else
-		{
-			CrossChildren(i_node1);
-			ComputePairsHelper(i_node0, i_node1->children[0]);
-			ComputePairsHelper(i_node0, i_node1->children[1]);
-		}
+	};
+
+	if (isCLeaf == false)
+		evaluate(B, C);
+	if (isBLeaf == false)
+		evaluate(C, B);
+
+	if (bestAunt == BVH_NULL_NODE)
+		return;
+
+	// Swap aunt and nephew
+	const int32_t parent = m_nodes[bestNephew].parent;
+	sBVHNode& node = m_nodes[i_node];
+	sBVHNode& parentNode = m_nodes[parent];
+
+	(node.children[0] == bestAunt ? node.children[0] : node.children[1]) = bestNephew;
+	(parentNode.children[0] == bestNephew ? parentNode.children[0] : parentNode.children[1]) = bestAunt;
+	m_nodes[bestNephew].parent = i_node;
+	m_nodes[bestAunt].parent = parent;
+
+	// Refit the parent that received the aunt, then the height of this node
+	const sBVHNode& child0 = m_nodes[parentNode.children[0]];
+	const sBVHNode& child1 = m_nodes[parentNode.children[1]];
+	parentNode.minExtent = Math::Min(child0.minExtent, child1.minExtent);
+	parentNode.maxExtent = Math::Max(child0.maxExtent, child1.maxExtent);
+	parentNode.height = 1 + std::max(child0.height, child1.height);
+	parentNode.categories = child0.categories | child1.categories;
+	parentNode.masks = child0.masks | child1.masks;
+
+	node.height = 1 + std::max(m_nodes[node.children[0]].height, m_nodes[node.children[1]].height);
+}
+
+
+void eae6320::Physics::cBVHTree::RemoveLeaf(int32_t i_leaf)
+{
+	if (i_leaf == m_root)
+	{
+		m_root = BVH_NULL_NODE;
+		return;
 	}
+
+	// replace parent with sibling, remove parent node
+	const int32_t parent = m_nodes[i_leaf].parent;
+	const int32_t grandParent = m_nodes[parent].parent;
+	const int32_t sibling = (m_nodes[parent].children[0] == i_leaf) ?
+		m_nodes[parent].children[1] :
+		m_nodes[parent].children[0];
+
+	// if there is a grandparent, update sibling with the grandparent
+	if (grandParent != BVH_NULL_NODE)
+	{
+		sBVHNode& grandParentNode = m_nodes[grandParent];
+		(grandParentNode.children[0] == parent ? grandParentNode.children[0] : grandParentNode.children[1]) = sibling;
+		m_nodes[sibling].parent = grandParent;
+
+		RefitAncestors(grandParent);
+	}
+	// if there is no grandparent, make sibling root
 	else
 	{
-		// 1 branch / 1 leaf, 2 cross checks
-		if (i_node1->IsLeaf())
+		m_root = sibling;
+		m_nodes[sibling].parent = BVH_NULL_NODE;
+	}
+
+	FreeNode(parent);
+	m_nodes[i_leaf].parent = BVH_NULL_NODE;
+}
+
+
+int32_t eae6320::Physics::cBVHTree::BuildSubtree(std::vector<int32_t>& io_leaves, size_t i_begin, size_t i_end)
+{
+	if (i_end - i_begin == 1)
+		return io_leaves[i_begin];
+
+	// Split the leaves at the median centroid along the longest axis of the centroid bounds
+	auto GetCentroid = [this](int32_t i_node) -> Math::sVector
+	{
+		return 0.5f * (m_nodes[i_node].minExtent + m_nodes[i_node].maxExtent);
+	};
+
+	Math::sVector minCentroid = GetCentroid(io_leaves[i_begin]);
+	Math::sVector maxCentroid = minCentroid;
+	for (size_t i = i_begin + 1; i < i_end; i++)
+	{
+		const Math::sVector centroid = GetCentroid(io_leaves[i]);
+		minCentroid = Math::Min(minCentroid, centroid);
+		maxCentroid = Math::Max(maxCentroid, centroid);
+	}
+
+	const Math::sVector size = maxCentroid - minCentroid;
+	const int axis = (size.x >= size.y && size.x >= size.z) ? 0 : (size.y >= size.z ? 1 : 2);
+
+	const size_t middle = i_begin + (i_end - i_begin) / 2;
+	std::nth_element(io_leaves.begin() + i_begin, io_leaves.begin() + middle, io_leaves.begin() + i_end,
+		[axis, &GetCentroid](int32_t i_lhs, int32_t i_rhs)
 		{
-			CrossChildren(i_node0);
-			ComputePairsHelper(i_node0->children[0], i_node1);
-			ComputePairsHelper(i_node0->children[1], i_node1);
-		}
-		// 2 branches, 4 cross checks
-		else
+			const Math::sVector lhs = GetCentroid(i_lhs);
+			const Math::sVector rhs = GetCentroid(i_rhs);
+			return (axis == 0) ? lhs.x < rhs.x : (axis == 1 ? lhs.y < rhs.y : lhs.z < rhs.z);
+		});
+
+	const int32_t child0 = BuildSubtree(io_leaves, i_begin, middle);
+	const int32_t child1 = BuildSubtree(io_leaves, middle, i_end);
+
+	const int32_t branch = AllocateNode();
+	sBVHNode& branchNode = m_nodes[branch];
+	branchNode.children[0] = child0;
+	branchNode.children[1] = child1;
+	branchNode.minExtent = Math::Min(m_nodes[child0].minExtent, m_nodes[child1].minExtent);
+	branchNode.maxExtent = Math::Max(m_nodes[child0].maxExtent, m_nodes[child1].maxExtent);
+	branchNode.height = 1 + std::max(m_nodes[child0].height, m_nodes[child1].height);
+	branchNode.categories = m_nodes[child0].categories | m_nodes[child1].categories;
+	branchNode.masks = m_nodes[child0].masks | m_nodes[child1].masks;
+	m_nodes[child0].parent = branch;
+	m_nodes[child1].parent = branch;
+
+	return branch;
+}
+
+
+void eae6320::Physics::cBVHTree::UpdateLeafExtents(int32_t i_leaf)
+{
+	// make fat AABB, the min/max extent directly represents the world cooridnate of the associated collider
+	sBVHNode& leaf = m_nodes[i_leaf];
+	const Math::sVector marginVec(m_margin, m_margin, m_margin);
+
+	leaf.minExtent = leaf.collider->GetMinExtent_world() - marginVec;
+	leaf.maxExtent = leaf.collider->GetMaxExtent_world() + marginVec;
+	leaf.categories = leaf.collider->GetCategory();
+	leaf.masks = leaf.collider->GetMask();
+}
+
+
+void eae6320::Physics::cBVHTree::RefitAncestors(int32_t i_node)
+{
+	// make union of child nodes' AABB from i_node up to the root, rotating each node on the way
+	int32_t current = i_node;
+	while (current != BVH_NULL_NODE)
+	{
+		sBVHNode& node = m_nodes[current];
+		const sBVHNode& child0 = m_nodes[node.children[0]];
+		const sBVHNode& child1 = m_nodes[node.children[1]];
+
+		node.minExtent = Math::Min(child0.minExtent, child1.minExtent);
+		node.maxExtent = Math::Max(child0.maxExtent, child1.maxExtent);
+		node.height = 1 + std::max(child0.height, child1.height);
+		node.categories = child0.categories | child1.categories;
+		node.masks = child0.masks | child1.masks;
+
+		Rotate(current);
+
+		current = m_nodes[current].parent;
+	}
+}
+
+
+bool eae6320::Physics::cBVHTree::DescendPair(int32_t i_node0, const cBVHTree& i_tree1, int32_t i_node1, std::vector<std::pair<int32_t, int32_t>>& io_pairStack) const
+{
+	const sBVHNode& node0 = m_nodes[i_node0];
+	const sBVHNode& node1 = i_tree1.m_nodes[i_node1];
+
+	// No leaf of one subtree is in the masks of the other subtree
+	if ((node0.categories & node1.masks) == 0 || (node1.categories & node0.masks) == 0)
+		return false;
+
+	// Self pair
+	if (&i_tree1 == this && i_node0 == i_node1)
+	{
+		if (node0.IsLeaf() == false)
 		{
-			CrossChildren(i_node0);
-			CrossChildren(i_node1);
-			ComputePairsHelper(i_node0->children[0], i_node1->children[0]);
-			ComputePairsHelper(i_node0->children[0], i_node1->children[1]);
-			ComputePairsHelper(i_node0->children[1], i_node1->children[0]);
-			ComputePairsHelper(i_node0->children[1], i_node1->children[1]);
+			io_pairStack.push_back({ node0.children[0], node0.children[0] });
+			io_pairStack.push_back({ node0.children[1], node0.children[1] });
+			io_pairStack.push_back({ node0.children[0], node0.children[1] });
 		}
+		return false;
+	}
+
+	if (IsOverlaps(i_node0, node1.minExtent, node1.maxExtent) == false)
+		return false;
+
+	if (node0.IsLeaf() && node1.IsLeaf())
+		return true;
+
+	// descend the larger branch node
+	if (node1.IsLeaf() || (node0.IsLeaf() == false && node0.GetSurfaceArea() >= node1.GetSurfaceArea()))
+	{
+		io_pairStack.push_back({ node0.children[0], i_node1 });
+		io_pairStack.push_back({ node0.children[1], i_node1 });
 	}
+	else
+	{
+		io_pairStack.push_back({ i_node0, node1.children[0] });
+		io_pairStack.push_back({ i_node0, node1.children[1] });
+	}
+	return false;
 }
 
 
-void eae6320::Physics::cBVHTree::ClearChildrenCrossFlagHelper(sBVHNode* i_node)
+bool eae6320::Physics::cBVHTree::IsOverlaps(int32_t i_node, const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const
 {
-	i_node->childrenCrossed = false;
-	if (i_node->IsLeaf() == false)
+	const sBVHNode& node = m_nodes[i_node];
+
+	return node.minExtent.x <= i_maxExtent.x && i_minExtent.x <= node.maxExtent.x &&
+		   node.minExtent.y <= i_maxExtent.y && i_minExtent.y <= node.maxExtent.y &&
+		   node.minExtent.z <= i_maxExtent.z && i_minExtent.z <= node.maxExtent.z;
+}
+
+
+bool eae6320::Physics::cBVHTree::IntersectRay(int32_t i_node, const Math::sVector& i_origin, const Math::sVector& i_direction, float i_margin,
+	float i_maxDistance, float& o_entry) const
+{
+	const sBVHNode& node = m_nodes[i_node];
+
+	const float origin[3] = { i_origin.x, i_origin.y, i_origin.z };
+	const float direction[3] = { i_direction.x, i_direction.y, i_direction.z };
+	const float minExtent[3] = { node.minExtent.x - i_margin, node.minExtent.y - i_margin, node.minExtent.z - i_margin };
+	const float maxExtent[3] = { node.maxExtent.x + i_margin, node.maxExtent.y + i_margin, node.maxExtent.z + i_margin };
+
+	float entry = 0.0f;
+	float exit = i_maxDistance;
+	for (size_t axis = 0; axis < 3; axis++)
 	{
-		ClearChildrenCrossFlagHelper(i_node->children[0]);
-		ClearChildrenCrossFlagHelper(i_node->children[1]);
+		if (direction[axis] == 0.0f)
+		{
+			if (origin[axis] < minExtent[axis] || origin[axis] > maxExtent[axis])
+				return false;
+			continue;
+		}
+
+		const float inverseDirection = 1.0f / direction[axis];
+		float t0 = (minExtent[axis] - origin[axis]) * inverseDirection;
+		float t1 = (maxExtent[axis] - origin[axis]) * inverseDirection;
+		if (t0 > t1)
+			std::swap(t0, t1);
+
+		entry = std::max(entry, t0);
+		exit = std::min(exit, t1);
+		if (entry > exit)
+			return false;
 	}
+
+	o_entry = entry;
+	return true;
 }
 
 
-void eae6320::Physics::cBVHTree::CrossChildren(sBVHNode* i_node)
+bool eae6320::Physics::cBVHTree::Cast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+	sRayCastHit& o_hit, const fQueryFilter& i_filter) const
 {
-	if (i_node->childrenCrossed == false)
+	o_hit = sRayCastHit();
+
+	if (m_root == BVH_NULL_NODE)
+		return false;
+
+	float closestDistance = i_maxDistance;
+
+	// Nodes along with the distance at which the ray enters them
+	cTraversalStack<std::pair<int32_t, float>> castStack;
+	castStack.push_back({ m_root, 0.0f });
+	while (castStack.empty() == false)
 	{
-		ComputePairsHelper(i_node->children[0], i_node->children[1]);
-		i_node->childrenCrossed = true;
+		const int32_t current = castStack.back().first;
+		const float entry = castStack.back().second;
+		castStack.pop_back();
+
+		// A closer hit was found after this node was pushed
+		if (entry > closestDistance)
+			continue;
+
+		const sBVHNode& node = m_nodes[current];
+		if (node.IsLeaf())
+		{
+			float distance = 0.0f;
+			Math::sVector normal;
+			const bool isHit = (i_radius > 0.0f) ?
+				node.collider->SphereCast(i_origin, i_radius, i_direction, closestDistance, distance, normal) :
+				node.collider->RayCast(i_origin, i_direction, closestDistance, distance, normal);
+
+			if (isHit && (i_filter == nullptr || i_filter(node.collider)))
+			{
+				closestDistance = distance;
+				o_hit.collider = node.collider;
+				o_hit.distance = distance;
+				o_hit.point = i_origin + i_direction * distance - normal * i_radius;
+				o_hit.normal = normal;
+			}
+			continue;
+		}
+
+		// Push the farther child first, so the nearer one is visited first
+		float entry0 = 0.0f;
+		float entry1 = 0.0f;
+		const bool isHit0 = IntersectRay(node.children[0], i_origin, i_direction, i_radius, closestDistance, entry0);
+		const bool isHit1 = IntersectRay(node.children[1], i_origin, i_direction, i_radius, closestDistance, entry1);
+
+		if (isHit0 && isHit1)
+		{
+			if (entry0 <= entry1)
+			{
+				castStack.push_back({ node.children[1], entry1 });
+				castStack.push_back({ node.children[0], entry0 });
+			}
+			else
+			{
+				castStack.push_back({ node.children[0], entry0 });
+				castStack.push_back({ node.children[1], entry1 });
+			}
+		}
+		else if (isHit0)
+		{
+			castStack.push_back({ node.children[0], entry0 });
+		}
+		else if (isHit1)
+		{
+			castStack.push_back({ node.children[1], entry1 });
+		}
 	}
+
+	return o_hit.collider != nullptr;
 }
 
 
@@ -543,29 +1384,19 @@ void eae6320::Physics::cBVHTree::RenderInitializeHelper(std::shared_ptr<Graphics
 
 void eae6320::Physics::cBVHTree::RenderUpdateHelper()
 {
-	if (m_root == nullptr)
-		return;
-
-	std::queue<sBVHNode*> container;
-	container.push(m_root);
+	// Each node in use takes one line, the pool order is stable between structural changes
 	auto index = m_renderData.begin();
 
-	while (container.empty() == false)
+	for (const sBVHNode& node : m_nodes)
 	{
-		sBVHNode* current = container.front();
-		container.pop();
+		if (node.height < 0 || index == m_renderData.end())
+			continue;
 
 		// Update aabb line transformation matrix
-		Math::sVector scale = current->fatAABB.GetMaxExtent_local() - current->fatAABB.GetMinExtent_local();
-		Math::sVector worldPos = current->fatAABB.GetCentroid_world();
+		Math::sVector scale = node.maxExtent - node.minExtent;
+		Math::sVector worldPos = 0.5f * (node.minExtent + node.maxExtent);
 		index->second = Math::cMatrix_transformation(scale, worldPos);
 
 		index++;
-
-		if (current->IsLeaf() == false)
-		{
-			container.push(current->children[0]);
-			container.push(current->children[1]);
-		}
 	}
-}
\ No newline at end of file
+}
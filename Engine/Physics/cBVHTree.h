@@ -6,11 +6,14 @@
 #include <Engine/Graphics/cLine.h>
 #include <Engine/Math/cMatrix_transformation.h>
 #include <Engine/Math/sVector.h>
-#include <Engine/Physics/cAABBCollider.h>
+#include <Engine/Physics/Snapshot.h>
 #include <Engine/Physics/cColliderBase.h>
 
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 
@@ -36,43 +39,119 @@ namespace eae6320
 namespace Physics
 {
 
+	// Index of an invalid node, used for null links and the end of the free list
+	constexpr int32_t BVH_NULL_NODE = -1;
+
+	/* Nodes live in a pool owned by the tree and link to each other by index */
 	struct sBVHNode
 	{
 
 		// Data
 		//=========================
 
-		sBVHNode* parent;
-		sBVHNode* children[2];
+		// Fat AABB whose world extents contain the world extents of all children of this node
+		Math::sVector minExtent;
+		Math::sVector maxExtent;
+
+		// link to the actual gameobject's collider, null for branch nodes
+		cCollider* collider = nullptr;
 
-		// fatAABB whose min/max extent contains the world extents of all children of this node
-		// min/max extent uses world coordinate directly. World position should be ZERO
-		cAABBCollider fatAABB;
+		// Union of the collision categories and masks of all leaves below this node. Two subtrees
+		// whose layers reject each other are skipped by the pair search
+		uint32_t categories = 0;
+		uint32_t masks = 0;
 
-		// link to the actual gameobject's collider
-		cCollider* collider;
+		// The parent link doubles as the next link of the free list when the node is not in use
+		int32_t parent = BVH_NULL_NODE;
+		int32_t children[2] = { BVH_NULL_NODE, BVH_NULL_NODE };
 
-		// TODO: need to optmize this
-		bool childrenCrossed;
+		// Leaf has height 0, free node has height -1
+		int32_t height = -1;
 
 
 		// Interface
 		//=========================
 
-		sBVHNode();
-
 		bool IsLeaf() const;
 
-		/* Make this ndoe a branch node */
-		void SetBranch(sBVHNode* i_node0, sBVHNode* i_node1);
+		float GetSurfaceArea() const;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
 
-		/* Make this node a leaf */
-		void SetLeaf(cCollider* i_collider);
 
-		/* Update the fat AABB */
-		void UpdateFatAABB(float i_margin);
+// BVH Tree Quality
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
 
-		sBVHNode* GetSibling() const;
+	struct sBVHTreeQuality
+	{
+		// Sum of the surface areas of all branch nodes divided by the surface area of the root.
+		// This is proportional to the expected cost of a query, lower is better
+		float totalSAHCost = 0.0f;
+
+		// Number of edges on the longest path from the root to a leaf
+		int32_t maxDepth = 0;
+
+		int32_t leafCount = 0;
+		int32_t nodeCount = 0;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// BVH Tree Queries
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Return false to ignore a collider in a query. A null filter accepts every collider */
+	using fQueryFilter = std::function<bool(const cCollider*)>;
+
+	struct sRay
+	{
+		Math::sVector origin;
+		// Unit vector
+		Math::sVector direction;
+		float maxDistance = 0.0f;
+	};
+
+	struct sRayCastHit
+	{
+		// Null if nothing was hit
+		cCollider* collider = nullptr;
+		// Along the direction of the ray, for a sphere cast this is how far the center of the sphere moved
+		float distance = 0.0f;
+		// Where the surface was hit, and its normal there
+		Math::sVector point;
+		Math::sVector normal;
+	};
+
+	/* Scratch space of a batched ray cast. Each thread that traces batches at the same time needs its own */
+	struct sRayBatchBuffers
+	{
+		struct sEntry
+		{
+			int32_t node;
+			// Edges from the root to the node
+			uint32_t depth;
+			// Range in rayIndices of the rays that reach the parent of the node
+			uint32_t begin;
+			uint32_t count;
+		};
+
+		// One slice of the ray count per depth of the tree
+		std::vector<uint32_t> rayIndices;
+		std::vector<sEntry> stack;
 	};
 
 }// Namespace Physics
@@ -93,25 +172,83 @@ namespace Physics
 		//=========================
 
 	public:
-		cBVHTree() : m_root(nullptr), m_margin(DEFAULT_BVH_MARGIN) {}
-		cBVHTree(float i_margin) : m_root(nullptr), m_margin(i_margin) { }
+		cBVHTree() : m_margin(DEFAULT_BVH_MARGIN) {}
+		cBVHTree(float i_margin) : m_margin(i_margin) { }
 
-		sBVHNode* Search(cCollider* i_collider);
+		int32_t Search(cCollider* i_collider) const;
 		void Add(cCollider* i_collider);
+		/* Build one subtree from all new leaves and insert it into the tree in a single pass */
+		void Add(const std::vector<cCollider*>& i_colliders);
 		void Remove(cCollider* i_collider);
-		void Update();
-
-		std::list<std::pair<cCollider*, cCollider*>>& ComputePairs();
+		/* Reinsert the leaves that left their fat AABB. Leaves of sleeping bodies are skipped
+		 * unless the bodies could have been moved from outside, like by restoring a snapshot */
+		void Update(const bool i_checkSleepingLeaves = false);
+
+		sBVHTreeQuality GetTreeQuality() const;
+
+		/* The nodes in use along with their index and the free list, so reading it back restores the exact shape
+		 * of the tree without rebuilding it. Reading fails without touching the tree unless the snapshot has one
+		 * leaf for each collider in the tree, ApplySnapshot() then swaps the checked nodes in */
+		void WriteSnapshot(Snapshot::cWriter& io_writer) const;
+		cResult ReadSnapshot(Snapshot::cReader& io_reader);
+		void ApplySnapshot();
+
+		/* Every pair of leaves whose fat AABBs overlap and whose colliders can collide with each other,
+		 * each pair is reported exactly once */
+		const std::vector<std::pair<cCollider*, cCollider*>>& ComputePairs();
+
+		/* Split the pair search into independent node pairs that can run on different threads, at least
+		 * i_minTaskCount of them if the tree is deep enough. Running ComputePairs() on every task reports
+		 * the same pairs as ComputePairs() on the whole tree */
+		void SplitPairTasks(size_t i_minTaskCount, std::vector<std::pair<int32_t, int32_t>>& o_tasks) const;
+		void ComputePairs(const std::pair<int32_t, int32_t>& i_task, std::vector<std::pair<cCollider*, cCollider*>>& o_pairs,
+			std::vector<std::pair<int32_t, int32_t>>& io_pairStack) const;
+
+		/* Same as above for the pairs of a leaf of this tree and a leaf of i_other. The first node
+		 * of a task belongs to this tree, the second one to i_other */
+		void SplitPairTasks(const cBVHTree& i_other, size_t i_minTaskCount, std::vector<std::pair<int32_t, int32_t>>& o_tasks) const;
+		void ComputePairs(const cBVHTree& i_other, const std::pair<int32_t, int32_t>& i_task, std::vector<std::pair<cCollider*, cCollider*>>& o_pairs,
+			std::vector<std::pair<int32_t, int32_t>>& io_pairStack) const;
 		std::vector<cCollider*> Query(cCollider* i_collider) const;
 
-		void InitialzieRenderData();
-		
-		std::list<std::pair<std::weak_ptr<Graphics::cLine>, Math::cMatrix_transformation>> GetRenderData();
+		/* Append every collider whose fat AABB overlaps the given box to o_colliders */
+		void Query(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, std::vector<cCollider*>& o_colliders) const;
+
+		// Scene Queries
+		//-------------
+		// Nodes are tested with slab tests and visited front to back, so the search for the closest hit
+		// skips every subtree that is farther away than the best hit so far
+		// The queries only read the tree and keep their traversal state on the stack of the caller,
+		// so any number of threads can run them at once as long as nothing changes the tree meanwhile
+
+		/* The closest collider along the ray, i_direction has to be a unit vector. Rays don't hit colliders they start in */
+		bool RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+			sRayCastHit& o_hit, const fQueryFilter& i_filter = nullptr) const;
+
+		/* Every collider along the ray, sorted by distance */
+		void RayCastAll(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+			std::vector<sRayCastHit>& o_hits, const fQueryFilter& i_filter = nullptr) const;
 
-		// TODO
-		//virtual cCollider* Pick(const Math::sVector& i_point) const;
-		//virtual RayCastResult RayCast(const Ray3& ray) const;
+		/* The first collider touched by a sphere of i_radius that moves along the ray */
+		bool SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+			sRayCastHit& o_hit, const fQueryFilter& i_filter = nullptr) const;
 
+		/* Append every collider that overlaps the sphere or the box to o_colliders */
+		void OverlapSphere(const Math::sVector& i_center, float i_radius, std::vector<cCollider*>& o_colliders, const fQueryFilter& i_filter = nullptr) const;
+		void OverlapBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, std::vector<cCollider*>& o_colliders, const fQueryFilter& i_filter = nullptr) const;
+
+		/* A collider that contains the point, null if there is none */
+		cCollider* Pick(const Math::sVector& i_point, const fQueryFilter& i_filter = nullptr) const;
+
+		/* Trace i_rayCount rays in one traversal and write the closest hit of each ray to o_hits. Every node is tested
+		 * against all rays that still reach it, so the rays share the traversal of the upper levels of the tree.
+		 * Threads can trace different batches at once, each with its own buffers */
+		void RayCast(const sRay* i_rays, size_t i_rayCount, sRayCastHit* o_hits, sRayBatchBuffers& io_buffers,
+			const fQueryFilter& i_filter = nullptr) const;
+
+		void InitialzieRenderData();
+		
+		std::list<std::pair<Graphics::cRenderHandle<Graphics::cLine>, Math::cMatrix_transformation>> GetRenderData();
 
 
 		// Implementation
@@ -119,13 +256,29 @@ namespace Physics
 
 	private:
 
-		void InsertNode(sBVHNode* i_node, sBVHNode** i_parent);
-		void RemoveNode(sBVHNode* i_node);
-
-		void UpdateInvalidNodeHelper(sBVHNode* i_node, std::vector<sBVHNode*>& i_invalidNodes);
-		void ComputePairsHelper(sBVHNode* i_node0, sBVHNode* i_node1);
-		void ClearChildrenCrossFlagHelper(sBVHNode* i_node);
-		void CrossChildren(sBVHNode* i_node);
+		int32_t AllocateNode();
+		void FreeNode(int32_t i_node);
+
+		void InsertLeaf(int32_t i_leaf);
+		int32_t FindBestSibling(int32_t i_leaf);
+		void Rotate(int32_t i_node);
+		void RemoveLeaf(int32_t i_leaf);
+		int32_t BuildSubtree(std::vector<int32_t>& io_leaves, size_t i_begin, size_t i_end);
+
+		void UpdateLeafExtents(int32_t i_leaf);
+		void RefitAncestors(int32_t i_node);
+		bool IsOverlaps(int32_t i_node, const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const;
+
+		/* Distance at which the ray enters the node grown by i_margin, 0 if it starts inside */
+		bool IntersectRay(int32_t i_node, const Math::sVector& i_origin, const Math::sVector& i_direction, float i_margin,
+			float i_maxDistance, float& o_entry) const;
+
+		/* Closest hit of a ray, or of a sphere moving along the ray if i_radius isn't 0 */
+		bool Cast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+			sRayCastHit& o_hit, const fQueryFilter& i_filter) const;
+		/* One step of the simultaneous descent of this tree and i_tree1, which may be this tree itself. Returns true
+		 * if the two nodes are overlapping leaves, otherwise pushes the child pairs that still have to be visited */
+		bool DescendPair(int32_t i_node0, const cBVHTree& i_tree1, int32_t i_node1, std::vector<std::pair<int32_t, int32_t>>& io_pairStack) const;
 		void RenderInitializeHelper(std::shared_ptr<Graphics::cLine>& io_AABBLine);
 		void RenderUpdateHelper();
 
@@ -135,9 +288,28 @@ namespace Physics
 	private:
 
 		float m_margin;
-		sBVHNode* m_root;
-		std::list<std::pair<cCollider*, cCollider*>> m_pairs;
-		std::vector<sBVHNode*> m_invalidNodes;
+		int32_t m_root = BVH_NULL_NODE;
+
+		// Node pool, released nodes are chained into a free list and reused
+		std::vector<sBVHNode> m_nodes;
+		int32_t m_freeList = BVH_NULL_NODE;
+		int32_t m_nodeCount = 0;
+
+		std::unordered_map<cCollider*, int32_t> m_leafIndices;
+		// A node in use is written to a snapshot as its index followed by the node
+		static constexpr size_t s_nodeSnapshotSize = sizeof(int32_t) + sizeof(sBVHNode);
+		// Nodes of a snapshot that has been read, swapped with the pool once it is applied
+		std::vector<sBVHNode> m_snapshotNodes;
+		std::vector<uint8_t> m_isSnapshotNodeRead;
+		int32_t m_snapshotRoot = BVH_NULL_NODE;
+		int32_t m_snapshotFreeList = BVH_NULL_NODE;
+		int32_t m_snapshotNodeCount = 0;
+		bool m_haveSnapshotLeavesMoved = false;
+
+		std::vector<std::pair<cCollider*, cCollider*>> m_pairs;
+		std::vector<std::pair<int32_t, int32_t>> m_pairStack;
+		std::vector<int32_t> m_invalidNodes;
+		std::vector<std::pair<float, int32_t>> m_siblingCandidates;
 		std::list<std::pair<std::shared_ptr<Graphics::cLine>, Math::cMatrix_transformation>> m_renderData;
 	};
 
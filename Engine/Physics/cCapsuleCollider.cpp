@@ -0,0 +1,197 @@
+// Includes
+//=========
+
+#include <Engine/Physics/Collision.h>
+#include <Engine/Physics/cAABBCollider.h>
+#include <Engine/Physics/cCapsuleCollider.h>
+#include <Engine/Physics/cOBBCollider.h>
+#include <Engine/Physics/cSphereCollider.h>
+
+#include <cmath>
+
+
+eae6320::Math::sVector eae6320::Physics::cCapsuleCollider::GetMinExtent_world() const
+{
+	Math::sVector pointA, pointB;
+	GetSegment_world(pointA, pointB);
+	return Math::Min(pointA, pointB) - m_radius;
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cCapsuleCollider::GetMaxExtent_world() const
+{
+	Math::sVector pointA, pointB;
+	GetSegment_world(pointA, pointB);
+	return Math::Max(pointA, pointB) + m_radius;
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cCapsuleCollider::GetMinExtent_local() const
+{
+	return Math::Min(m_pointA, m_pointB) - m_radius;
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cCapsuleCollider::GetMaxExtent_local() const
+{
+	return Math::Max(m_pointA, m_pointB) + m_radius;
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cCapsuleCollider::GetCentroid_world() const
+{
+	return m_objectRigidBody->position + m_objectRigidBody->orientation * GetCentroid_local();
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cCapsuleCollider::GetCentroid_local() const
+{
+	return 0.5f * (m_pointA + m_pointB);
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cCapsuleCollider::GetWorldPosition() const
+{
+	return m_objectRigidBody->position;
+}
+
+
+float eae6320::Physics::cCapsuleCollider::GetRadius() const
+{
+	return m_radius;
+}
+
+
+void eae6320::Physics::cCapsuleCollider::GetSegment_world(Math::sVector& o_pointA, Math::sVector& o_pointB) const
+{
+	o_pointA = m_objectRigidBody->position + m_objectRigidBody->orientation * m_pointA;
+	o_pointB = m_objectRigidBody->position + m_objectRigidBody->orientation * m_pointB;
+}
+
+
+bool eae6320::Physics::cCapsuleCollider::IsOverlaps(const cSphereCollider& i_other) const
+{
+	return IsOverlapsSphere(i_other.GetCentroid_world(), i_other.GetRadius());
+}
+
+
+bool eae6320::Physics::cCapsuleCollider::IsOverlaps(const cAABBCollider& i_other) const
+{
+	return IsOverlapsBox(i_other.GetMinExtent_world(), i_other.GetMaxExtent_world());
+}
+
+
+bool eae6320::Physics::cCapsuleCollider::IsOverlaps(const cOBBCollider& i_other) const
+{
+	Math::sVector pointA, pointB, boxPoint;
+	GetSegment_world(pointA, pointB);
+	const float t = Collision::GetClosestPointOfSegmentAndBox(pointA, pointB, i_other.GetBox_world(), boxPoint);
+	return Math::SqDistance(pointA + (pointB - pointA) * t, boxPoint) <= m_radius * m_radius;
+}
+
+
+bool eae6320::Physics::cCapsuleCollider::IsOverlaps(const cCapsuleCollider& i_other) const
+{
+	Math::sVector pointA, pointB, otherPointA, otherPointB;
+	GetSegment_world(pointA, pointB);
+	i_other.GetSegment_world(otherPointA, otherPointB);
+
+	float t, otherT;
+	Collision::GetClosestPointsOfSegments(pointA, pointB, otherPointA, otherPointB, t, otherT);
+	const float radiusDistance = m_radius + i_other.m_radius;
+	return Math::SqDistance(pointA + (pointB - pointA) * t, otherPointA + (otherPointB - otherPointA) * otherT) <= radiusDistance * radiusDistance;
+}
+
+
+bool eae6320::Physics::cCapsuleCollider::RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+	float& o_distance, Math::sVector& o_normal) const
+{
+	Math::sVector pointA, pointB;
+	GetSegment_world(pointA, pointB);
+	return Collision::RayCastCapsule(i_origin, i_direction, i_maxDistance, pointA, pointB, m_radius, o_distance, o_normal);
+}
+
+
+bool eae6320::Physics::cCapsuleCollider::SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+	float& o_distance, Math::sVector& o_normal) const
+{
+	// The center of the moving sphere against this capsule grown by its radius
+	Math::sVector pointA, pointB;
+	GetSegment_world(pointA, pointB);
+	return Collision::RayCastCapsule(i_origin, i_direction, i_maxDistance, pointA, pointB, m_radius + i_radius, o_distance, o_normal);
+}
+
+
+bool eae6320::Physics::cCapsuleCollider::IsContainsPoint(const Math::sVector& i_point) const
+{
+	return IsOverlapsSphere(i_point, 0.0f);
+}
+
+
+bool eae6320::Physics::cCapsuleCollider::IsOverlapsSphere(const Math::sVector& i_center, float i_radius) const
+{
+	Math::sVector pointA, pointB;
+	GetSegment_world(pointA, pointB);
+	const float t = Collision::GetClosestPointOnSegment(i_center, pointA, pointB);
+	const float radiusSum = m_radius + i_radius;
+	return Math::SqDistance(pointA + (pointB - pointA) * t, i_center) <= radiusSum * radiusSum;
+}
+
+
+bool eae6320::Physics::cCapsuleCollider::IsOverlapsBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const
+{
+	Math::sVector pointA, pointB, boxPoint;
+	GetSegment_world(pointA, pointB);
+	const float t = Collision::GetClosestPointOfSegmentAndBox(pointA, pointB, Collision::sOrientedBox(i_minExtent, i_maxExtent), boxPoint);
+	return Math::SqDistance(pointA + (pointB - pointA) * t, boxPoint) <= m_radius * m_radius;
+}
+
+
+void eae6320::Physics::cCapsuleCollider::GenerateRenderData(
+	uint32_t& o_vertexCount, std::vector<Math::sVector>& o_vertexData,
+	uint32_t& o_indexCount, std::vector<uint16_t>& o_indexData)
+{
+	// Two directions across the segment, at right angles to it and to each other
+	const Math::sVector segment = m_pointB - m_pointA;
+	const float length = segment.GetLength();
+	const Math::sVector axis = (length > 0.0f) ? (segment / length) : Math::sVector(0.0f, 1.0f, 0.0f);
+	const Math::sVector reference = (std::abs(axis.x) < 0.9f) ? Math::sVector(1.0f, 0.0f, 0.0f) : Math::sVector(0.0f, 1.0f, 0.0f);
+	const Math::sVector side0 = Cross(axis, reference).GetNormalized();
+	const Math::sVector side1 = Cross(axis, side0);
+
+	// Like the sphere collider, each end is a ring of 4 points around the segment joined to the tip of its cap
+	const Math::sVector sides[4] = { side0 * m_radius, side1 * m_radius, -side0 * m_radius, -side1 * m_radius };
+	const Math::sVector tipA = m_pointA - axis * m_radius;
+	const Math::sVector tipB = m_pointB + axis * m_radius;
+
+	// Vertex data
+	o_vertexCount = 40;
+	o_vertexData = std::vector<Math::sVector>();
+	o_vertexData.reserve(o_vertexCount);
+	for (size_t i = 0; i < 4; i++)
+	{
+		const Math::sVector& side = sides[i];
+		const Math::sVector& nextSide = sides[(i + 1) % 4];
+		// Rings
+		o_vertexData.push_back(m_pointA + side);
+		o_vertexData.push_back(m_pointA + nextSide);
+		o_vertexData.push_back(m_pointB + side);
+		o_vertexData.push_back(m_pointB + nextSide);
+		// Tips
+		o_vertexData.push_back(tipA);
+		o_vertexData.push_back(m_pointA + side);
+		o_vertexData.push_back(tipB);
+		o_vertexData.push_back(m_pointB + side);
+		// Side of the segment
+		o_vertexData.push_back(m_pointA + side);
+		o_vertexData.push_back(m_pointB + side);
+	}
+
+	// Index data
+	o_indexCount = o_vertexCount;
+	o_indexData = std::vector<uint16_t>(o_indexCount);
+	for (uint32_t i = 0; i < o_indexCount; i++)
+	{
+		o_indexData[i] = i;
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Math/sVector.h>
+#include <Engine/Physics/cColliderBase.h>
+
+#include <vector>
+
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* The points within a radius of a segment, which turns with its body */
+	class cCapsuleCollider : public cCollider
+	{
+		// Interface
+		//=====================
+
+	public:
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		cCapsuleCollider() : cCollider(eColliderType::Capsule) { };
+		cCapsuleCollider(const Math::sVector& i_pointA, const Math::sVector& i_pointB, float i_radius)
+			: cCollider(eColliderType::Capsule), m_pointA(i_pointA), m_pointB(i_pointB), m_radius(i_radius) { }
+
+		~cCapsuleCollider() = default;
+
+
+		// Property Getters
+		//--------------------------
+
+		Math::sVector GetMinExtent_world() const final;
+
+		Math::sVector GetMaxExtent_world() const final;
+
+		Math::sVector GetMinExtent_local() const final;
+
+		Math::sVector GetMaxExtent_local() const final;
+
+		Math::sVector GetCentroid_world() const final;
+
+		Math::sVector GetCentroid_local() const final;
+
+		Math::sVector GetWorldPosition() const final;
+
+		float GetRadius() const;
+
+		/* The end points of the segment with the position and orientation of its body applied */
+		void GetSegment_world(Math::sVector& o_pointA, Math::sVector& o_pointB) const;
+
+		// Overlap Detection
+		//--------------------------
+
+		bool IsOverlaps(const cSphereCollider& i_other) const;
+
+		bool IsOverlaps(const cAABBCollider& i_other) const;
+
+		bool IsOverlaps(const cOBBCollider& i_other) const;
+
+		bool IsOverlaps(const cCapsuleCollider& i_other) const;
+
+		// Queries
+		//--------------------------
+
+		bool RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+			float& o_distance, Math::sVector& o_normal) const final;
+
+		bool SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+			float& o_distance, Math::sVector& o_normal) const final;
+
+		bool IsContainsPoint(const Math::sVector& i_point) const final;
+
+		bool IsOverlapsSphere(const Math::sVector& i_center, float i_radius) const final;
+
+		bool IsOverlapsBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const final;
+
+		// Render / Debug
+		//--------------------------
+
+		void GenerateRenderData(
+			uint32_t& o_vertexCount, std::vector<Math::sVector>& o_vertexData,
+			uint32_t& o_indexCount, std::vector<uint16_t>& o_indexData) final;
+
+
+		// Data
+		//=====================
+
+	private:
+
+		// Relative to the owner object
+		Math::sVector m_pointA;
+		Math::sVector m_pointB;
+		float m_radius = 0.0f;
+	};
+
+
+}// Namespace Physics
+}// Namespace eae6320
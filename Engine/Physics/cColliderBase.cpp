@@ -3,7 +3,9 @@
 
 #include <Engine/GameObject/cGameObject.h>
 #include <Engine/Physics/cAABBCollider.h>
+#include <Engine/Physics/cCapsuleCollider.h>
 #include <Engine/Physics/cColliderBase.h>
+#include <Engine/Physics/cOBBCollider.h>
 #include <Engine/Physics/cSphereCollider.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
 
@@ -27,9 +29,50 @@ void eae6320::Physics::sColliderSetting::SettingForAABB(Math::sVector i_min, Mat
 }
 
 
+void eae6320::Physics::sColliderSetting::SettingForOBB(Math::sVector i_center, Math::sVector i_halfExtents, Math::cQuaternion i_orientation)
+{
+	type = eColliderType::OBB;
+	OBB_center = i_center;
+	OBB_halfExtents = i_halfExtents;
+	OBB_orientation = i_orientation;
+}
+
+
+void eae6320::Physics::sColliderSetting::SettingForCapsule(Math::sVector i_pointA, Math::sVector i_pointB, float i_radius)
+{
+	type = eColliderType::Capsule;
+	capsule_pointA = i_pointA;
+	capsule_pointB = i_pointB;
+	capsule_radius = i_radius;
+}
+
+
+// Static Data
+//============
+
+namespace
+{
+	// Ids start from 1, so that a pair key of 0 never belongs to a valid pair
+	uint32_t s_nextColliderID = 1;
+}
+
+
 // cCollider Implementation
 //==================
 
+eae6320::Physics::cCollider::cCollider() :
+	m_id(s_nextColliderID++)
+{
+
+}
+
+
+eae6320::Physics::cCollider::cCollider(eColliderType i_type) :
+	m_type(i_type), m_id(s_nextColliderID++)
+{
+
+}
+
 
 eae6320::cResult eae6320::Physics::cCollider::Create(cCollider*& o_collider, const sColliderSetting& i_setting, std::weak_ptr<cGameObject> i_ownerGameObject)
 {
@@ -55,12 +98,33 @@ eae6320::cResult eae6320::Physics::cCollider::Create(cCollider*& o_collider, con
 		newCollider->m_objectRigidBody = &(std::shared_ptr<cGameObject>(i_ownerGameObject)->GetRigidBody());
 		break;
 	}
+	case eColliderType::OBB:
+	{
+		newCollider = new cOBBCollider(i_setting.OBB_center, i_setting.OBB_halfExtents, i_setting.OBB_orientation);
+		newCollider->m_gameobject = i_ownerGameObject;
+		newCollider->m_objectRigidBody = &(std::shared_ptr<cGameObject>(i_ownerGameObject)->GetRigidBody());
+		break;
+	}
+	case eColliderType::Capsule:
+	{
+		newCollider = new cCapsuleCollider(i_setting.capsule_pointA, i_setting.capsule_pointB, i_setting.capsule_radius);
+		newCollider->m_gameobject = i_ownerGameObject;
+		newCollider->m_objectRigidBody = &(std::shared_ptr<cGameObject>(i_ownerGameObject)->GetRigidBody());
+		break;
+	}
 	case eColliderType::None:
 	{
 		break;
 	}
 	}
 
+	if (newCollider != nullptr)
+	{
+		newCollider->m_isContinuous = i_setting.isContinuous;
+		newCollider->m_category = i_setting.category;
+		newCollider->m_mask = i_setting.mask;
+	}
+
 	o_collider = newCollider;
 
 	return result;
@@ -72,3 +136,36 @@ eae6320::Physics::eColliderType eae6320::Physics::cCollider::GetType() const
 	return m_type;
 }
 
+
+uint32_t eae6320::Physics::cCollider::GetID() const
+{
+	return m_id;
+}
+
+
+bool eae6320::Physics::cCollider::IsContinuous() const
+{
+	return m_isContinuous;
+}
+
+
+uint32_t eae6320::Physics::cCollider::GetCategory() const
+{
+	return m_category;
+}
+
+
+uint32_t eae6320::Physics::cCollider::GetMask() const
+{
+	return m_mask;
+}
+
+
+bool eae6320::Physics::cCollider::CanCollideWith(const cCollider* i_other) const
+{
+	if ((m_category & i_other->m_mask) == 0 || (i_other->m_category & m_mask) == 0)
+		return false;
+
+	return m_objectRigidBody == nullptr || i_other->m_objectRigidBody == nullptr ||
+		m_objectRigidBody->isStatic == false || i_other->m_objectRigidBody->isStatic == false;
+}
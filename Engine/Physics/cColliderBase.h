@@ -3,6 +3,7 @@
 // Includes
 //=========
 
+#include <Engine/Math/cQuaternion.h>
 #include <Engine/Math/sVector.h>
 #include <Engine/Physics/cRigidBody.h>
 #include <Engine/Results/Results.h>
@@ -26,6 +27,10 @@ namespace Physics
 	class cSphereCollider;
 
 	class cAABBCollider;
+
+	class cOBBCollider;
+
+	class cCapsuleCollider;
 }
 }
 
@@ -48,6 +53,8 @@ namespace Physics
 		None	= 0,
 		Sphere	= 1,
 		AABB	= 2,
+		OBB		= 3,
+		Capsule	= 4,
 	};
 }
 }
@@ -72,9 +79,29 @@ namespace Physics
 		Math::sVector AABB_min;
 		Math::sVector AABB_max;
 
+		// Data for OBB collider, the orientation is relative to the owner object
+		Math::sVector OBB_center;
+		Math::sVector OBB_halfExtents;
+		Math::cQuaternion OBB_orientation;
+
+		// Data for capsule collider, the end points of its segment
+		Math::sVector capsule_pointA;
+		Math::sVector capsule_pointB;
+		float capsule_radius = 0.0f;
+
+		// Swept along the motion of every step, so that fast bodies can't pass through thin colliders
+		bool isContinuous = false;
+
+		// Collision layers. Two colliders are only paired by the broad phase if the category of each one
+		// is in the mask of the other, so pairs that are never interested in each other cost nothing
+		uint32_t category = 1;
+		uint32_t mask = 0xffffffff;
+
 
 		void SettingForAABB(Math::sVector i_min, Math::sVector i_max);
 		void SettingForSphere(Math::sVector i_center, float i_radius);
+		void SettingForOBB(Math::sVector i_center, Math::sVector i_halfExtents, Math::cQuaternion i_orientation = Math::cQuaternion());
+		void SettingForCapsule(Math::sVector i_pointA, Math::sVector i_pointB, float i_radius);
 	};
 }
 }
@@ -100,11 +127,27 @@ namespace Physics
 
 		static cResult Create(cCollider*& o_collider, const sColliderSetting& i_setting, std::weak_ptr<cGameObject> i_ownerGameObject);
 
+		/* Colliders are deleted through this base, by their game object */
+		virtual ~cCollider() = default;
+
 		// Property Getters
 		//--------------------------
 
 		eColliderType GetType() const;
 
+		/* Unique id assigned at construction, never reused */
+		uint32_t GetID() const;
+
+		bool IsContinuous() const;
+
+		uint32_t GetCategory() const;
+
+		uint32_t GetMask() const;
+
+		/* Whether the broad phase reports a pair of the two colliders. The layers of both have to
+		 * accept each other, and two static bodies never collide since neither of them moves */
+		bool CanCollideWith(const cCollider* i_other) const;
+
 		virtual Math::sVector GetMinExtent_world() const = 0;
 
 		virtual Math::sVector GetMaxExtent_world() const = 0;
@@ -119,6 +162,24 @@ namespace Physics
 
 		virtual Math::sVector GetWorldPosition() const = 0;
 
+		// Queries
+		//--------------------------
+
+		/* Distance along the unit vector i_direction at which a ray from i_origin enters the collider, along with
+		 * the surface normal there. A ray that starts inside the collider doesn't hit it */
+		virtual bool RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+			float& o_distance, Math::sVector& o_normal) const = 0;
+
+		/* Same as RayCast() for a sphere of i_radius that moves along the ray */
+		virtual bool SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+			float& o_distance, Math::sVector& o_normal) const = 0;
+
+		virtual bool IsContainsPoint(const Math::sVector& i_point) const = 0;
+
+		virtual bool IsOverlapsSphere(const Math::sVector& i_center, float i_radius) const = 0;
+
+		virtual bool IsOverlapsBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const = 0;
+
 		// Update
 		//--------------------------
 
@@ -133,8 +194,8 @@ namespace Physics
 
 	protected:
 
-		cCollider() = default;
-		cCollider(eColliderType i_type) : m_type(i_type) {};
+		cCollider();
+		cCollider(eColliderType i_type);
 
 
 		// Data
@@ -144,6 +205,13 @@ namespace Physics
 
 		eColliderType m_type = eColliderType::None;
 
+		uint32_t m_id = 0;
+
+		bool m_isContinuous = false;
+
+		uint32_t m_category = 1;
+		uint32_t m_mask = 0xffffffff;
+
 
 	public:
 
@@ -0,0 +1,404 @@
+// Includes
+//=========
+
+#include <Engine/Logging/Logging.h>
+#include <Engine/Physics/cCollisionPairCache.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+// SSE is part of every x64 target
+#if defined( _M_X64 ) || defined( __x86_64__ ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 ) || defined( __SSE__ )
+	#define EAE6320_COLLISIONPAIRCACHE_SSE
+	#include <xmmintrin.h>
+#endif
+
+
+
+// cCollisionPairCache Implementation
+//==================
+
+void eae6320::Physics::cCollisionPairCache::Update(const std::vector<std::pair<cCollider*, cCollider*>>& i_pairs, std::vector<sCollisionEvent>& o_events)
+{
+	m_frame++;
+
+	// Stamp every pair of this frame
+	for (const auto& pair : i_pairs)
+	{
+		const uint64_t key = MakePairKey(pair.first, pair.second);
+
+		bool isInserted = false;
+		sEntry& entry = FindOrInsert(key, isInserted);
+
+		if (isInserted)
+		{
+			const bool isFirstLower = pair.first->GetID() < pair.second->GetID();
+			entry.lhs = isFirstLower ? pair.first : pair.second;
+			entry.rhs = isFirstLower ? pair.second : pair.first;
+			entry.isNew = true;
+		}
+
+		entry.frame = m_frame;
+	}
+
+	// One sweep: stamped this frame is Enter or Stay, stamped earlier is Exit. The pairs of removed colliders are
+	// Exit as well, unless the collider came back in this frame and the pair is new
+	std::sort(m_removedIDs.begin(), m_removedIDs.end());
+	const bool haveCollidersBeenRemoved = m_removedIDs.empty() == false;
+
+	m_expiredKeys.clear();
+	for (sEntry& entry : m_entries)
+	{
+		if (entry.key == 0)
+			continue;
+
+		if ((entry.frame != m_frame) || (haveCollidersBeenRemoved && (entry.isNew == false) && IsRemoved(entry.key)))
+		{
+			o_events.push_back({ entry.lhs, entry.rhs, eCollisionEvent::Exit });
+			m_expiredKeys.push_back(entry.key);
+		}
+		else if (entry.isNew)
+		{
+			o_events.push_back({ entry.lhs, entry.rhs, eCollisionEvent::Enter });
+			entry.isNew = false;
+		}
+		else
+		{
+			o_events.push_back({ entry.lhs, entry.rhs, eCollisionEvent::Stay });
+		}
+	}
+
+	for (uint64_t key : m_expiredKeys)
+	{
+		Erase(key);
+	}
+	m_removedIDs.clear();
+	ShrinkIfSparse();
+}
+
+
+void eae6320::Physics::cCollisionPairCache::Remove(uint32_t i_colliderID)
+{
+	m_removedIDs.push_back(i_colliderID);
+}
+
+
+size_t eae6320::Physics::cCollisionPairCache::GetPairCount() const
+{
+	return m_count;
+}
+
+
+bool eae6320::Physics::cCollisionPairCache::Contains(const cCollider* i_lhs, const cCollider* i_rhs) const
+{
+	return FindSlot(MakePairKey(i_lhs, i_rhs)) != SIZE_MAX;
+}
+
+
+eae6320::Physics::sContactImpulse* eae6320::Physics::cCollisionPairCache::FindImpulse(const cCollider* i_lhs, const cCollider* i_rhs)
+{
+	const size_t slot = FindSlot(MakePairKey(i_lhs, i_rhs));
+	return (slot != SIZE_MAX) ? &m_entries[slot].impulse : nullptr;
+}
+
+
+void eae6320::Physics::cCollisionPairCache::WriteSnapshot(Snapshot::cWriter& io_writer) const
+{
+	io_writer.Write(static_cast<uint32_t>(m_entries.size()));
+	io_writer.Write(static_cast<uint32_t>(m_count));
+	io_writer.Write(m_frame);
+
+	// Records are copied field by field right where they go, like the bodies of cRigidBodyPool
+	uint8_t* data = io_writer.Allocate(m_count * sizeof(sEntrySnapshot));
+	for (size_t slot = 0; slot < m_entries.size(); slot++)
+	{
+		const sEntry& entry = m_entries[slot];
+		if (entry.key == 0)
+			continue;
+
+		const uint32_t slotIndex = static_cast<uint32_t>(slot);
+		const uint32_t isNew = entry.isNew ? 1 : 0;
+
+		std::memcpy(data + offsetof(sEntrySnapshot, key), &entry.key, sizeof(uint64_t));
+		std::memcpy(data + offsetof(sEntrySnapshot, lhs), &entry.lhs, sizeof(cCollider*));
+		std::memcpy(data + offsetof(sEntrySnapshot, rhs), &entry.rhs, sizeof(cCollider*));
+		std::memcpy(data + offsetof(sEntrySnapshot, slot), &slotIndex, sizeof(uint32_t));
+		std::memcpy(data + offsetof(sEntrySnapshot, frame), &entry.frame, sizeof(uint32_t));
+		std::memcpy(data + offsetof(sEntrySnapshot, isNew), &isNew, sizeof(uint32_t));
+		std::memcpy(data + offsetof(sEntrySnapshot, impulse), &entry.impulse, sizeof(sContactImpulse));
+		std::memset(data + s_entrySnapshotDataSize, 0, sizeof(sEntrySnapshot) - s_entrySnapshotDataSize);
+		data += sizeof(sEntrySnapshot);
+	}
+}
+
+
+eae6320::cResult eae6320::Physics::cCollisionPairCache::ReadSnapshot(Snapshot::cReader& io_reader)
+{
+	uint32_t capacity, count, frame;
+	if ((io_reader.Read(capacity) == false) || (io_reader.Read(count) == false) || (io_reader.Read(frame) == false)
+		|| (io_reader.GetRemainingSize() < count * sizeof(sEntrySnapshot)))
+	{
+		Logging::OutputError("Physics::cCollisionPairCache: The snapshot is truncated");
+		return Results::Failure;
+	}
+	// The live table never gets sparser than this, so a larger capacity can only come from a corrupted snapshot
+	if (((capacity & (capacity - 1)) != 0) || (count > capacity)
+		|| (capacity > std::max(static_cast<size_t>(count) * 4, s_minCapacity)))
+	{
+		Logging::OutputError("Physics::cCollisionPairCache: The snapshot has an invalid table size");
+		return Results::Failure;
+	}
+
+	// The live table is left alone until the whole snapshot has been checked
+	m_snapshotEntries.assign(capacity, sEntry());
+	m_snapshotCount = count;
+	m_snapshotFrame = frame;
+
+	const uint8_t* data = io_reader.Consume(count * sizeof(sEntrySnapshot));
+	for (uint32_t i = 0; i < count; i++, data += sizeof(sEntrySnapshot))
+	{
+		if (i + s_prefetchDistance < count)
+			PrefetchColliders(data + (s_prefetchDistance * sizeof(sEntrySnapshot)));
+		uint32_t slot, isNew;
+		uint64_t key;
+		std::memcpy(&slot, data + offsetof(sEntrySnapshot, slot), sizeof(uint32_t));
+		std::memcpy(&key, data + offsetof(sEntrySnapshot, key), sizeof(uint64_t));
+		if ((slot >= capacity) || (key == 0) || (m_snapshotEntries[slot].key != 0))
+		{
+			Logging::OutputError("Physics::cCollisionPairCache: The snapshot has a pair outside of the table or in a taken slot");
+			return Results::Failure;
+		}
+
+		sEntry& entry = m_snapshotEntries[slot];
+		entry.key = key;
+		std::memcpy(&entry.lhs, data + offsetof(sEntrySnapshot, lhs), sizeof(cCollider*));
+		std::memcpy(&entry.rhs, data + offsetof(sEntrySnapshot, rhs), sizeof(cCollider*));
+		// The colliders have to be alive anyway, and the pair has to be the one that its key says
+		if ((entry.lhs == nullptr) || (entry.rhs == nullptr) || (entry.lhs->GetID() >= entry.rhs->GetID())
+			|| (MakePairKey(entry.lhs, entry.rhs) != key))
+		{
+			Logging::OutputError("Physics::cCollisionPairCache: The snapshot has a pair whose key doesn't match its colliders");
+			return Results::Failure;
+		}
+		std::memcpy(&entry.frame, data + offsetof(sEntrySnapshot, frame), sizeof(uint32_t));
+		std::memcpy(&isNew, data + offsetof(sEntrySnapshot, isNew), sizeof(uint32_t));
+		std::memcpy(&entry.impulse, data + offsetof(sEntrySnapshot, impulse), sizeof(sContactImpulse));
+		entry.isNew = isNew != 0;
+	}
+
+	// Every pair has to be found by probing from its home slot, and no key can be in the table twice
+	if (capacity > 0)
+	{
+		const size_t mask = capacity - 1;
+		for (size_t slot = 0; slot < capacity; slot++)
+		{
+			const uint64_t key = m_snapshotEntries[slot].key;
+			if (key == 0)
+				continue;
+
+			for (size_t probe = GetSlot(key, capacity); probe != slot; probe = (probe + 1) & mask)
+			{
+				if ((m_snapshotEntries[probe].key == 0) || (m_snapshotEntries[probe].key == key))
+				{
+					Logging::OutputError("Physics::cCollisionPairCache: The snapshot has a pair that can't be found in its table");
+					return Results::Failure;
+				}
+			}
+		}
+	}
+
+	return Results::Success;
+}
+
+
+void eae6320::Physics::cCollisionPairCache::ApplySnapshot()
+{
+	// Swapping keeps the capacity of both tables, so restoring every tick doesn't allocate
+	std::swap(m_entries, m_snapshotEntries);
+	m_count = m_snapshotCount;
+	m_frame = m_snapshotFrame;
+}
+
+
+bool eae6320::Physics::cCollisionPairCache::IsRemoved(uint64_t i_key) const
+{
+	const uint32_t lhsID = static_cast<uint32_t>(i_key >> 32);
+	const uint32_t rhsID = static_cast<uint32_t>(i_key);
+
+	return std::binary_search(m_removedIDs.begin(), m_removedIDs.end(), lhsID) ||
+		std::binary_search(m_removedIDs.begin(), m_removedIDs.end(), rhsID);
+}
+
+
+void eae6320::Physics::cCollisionPairCache::PrefetchColliders(const uint8_t* i_entrySnapshot)
+{
+#ifdef EAE6320_COLLISIONPAIRCACHE_SSE
+	const char* lhs;
+	const char* rhs;
+	std::memcpy(&lhs, i_entrySnapshot + offsetof(sEntrySnapshot, lhs), sizeof(cCollider*));
+	std::memcpy(&rhs, i_entrySnapshot + offsetof(sEntrySnapshot, rhs), sizeof(cCollider*));
+	// Prefetching never faults, so even a corrupted pointer is safe here
+	_mm_prefetch(lhs, _MM_HINT_T0);
+	_mm_prefetch(rhs, _MM_HINT_T0);
+#else
+	static_cast<void>(i_entrySnapshot);
+#endif
+}
+
+
+uint64_t eae6320::Physics::cCollisionPairCache::MakePairKey(const cCollider* i_lhs, const cCollider* i_rhs)
+{
+	const uint32_t lhsID = i_lhs->GetID();
+	const uint32_t rhsID = i_rhs->GetID();
+
+	return (lhsID < rhsID) ?
+		(static_cast<uint64_t>(lhsID) << 32) | rhsID :
+		(static_cast<uint64_t>(rhsID) << 32) | lhsID;
+}
+
+
+size_t eae6320::Physics::cCollisionPairCache::GetSlot(uint64_t i_key) const
+{
+	return GetSlot(i_key, m_entries.size());
+}
+
+
+size_t eae6320::Physics::cCollisionPairCache::GetSlot(uint64_t i_key, size_t i_capacity)
+{
+	// Fibonacci hashing, the capacity is always a power of two
+	return static_cast<size_t>((i_key * 0x9E3779B97F4A7C15ull) >> 32) & (i_capacity - 1);
+}
+
+
+size_t eae6320::Physics::cCollisionPairCache::FindSlot(uint64_t i_key) const
+{
+	if (m_entries.empty())
+		return SIZE_MAX;
+
+	const size_t mask = m_entries.size() - 1;
+
+	for (size_t slot = GetSlot(i_key); m_entries[slot].key != 0; slot = (slot + 1) & mask)
+	{
+		if (m_entries[slot].key == i_key)
+			return slot;
+	}
+
+	return SIZE_MAX;
+}
+
+
+eae6320::Physics::cCollisionPairCache::sEntry& eae6320::Physics::cCollisionPairCache::FindOrInsert(uint64_t i_key, bool& o_isInserted)
+{
+	// Keep the load factor under 3/4
+	if ((m_count + 1) * 4 > m_entries.size() * 3)
+		Grow();
+
+	const size_t mask = m_entries.size() - 1;
+	size_t slot = GetSlot(i_key);
+
+	while (m_entries[slot].key != 0)
+	{
+		if (m_entries[slot].key == i_key)
+		{
+			o_isInserted = false;
+			return m_entries[slot];
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	m_entries[slot] = sEntry();
+	m_entries[slot].key = i_key;
+	m_count++;
+
+	o_isInserted = true;
+	return m_entries[slot];
+}
+
+
+void eae6320::Physics::cCollisionPairCache::Erase(uint64_t i_key)
+{
+	if (m_entries.empty())
+		return;
+
+	const size_t mask = m_entries.size() - 1;
+	size_t slot = GetSlot(i_key);
+
+	while (m_entries[slot].key != i_key)
+	{
+		if (m_entries[slot].key == 0)
+			return;
+
+		slot = (slot + 1) & mask;
+	}
+
+	// Backward shift deletion, so that probing never needs tombstones
+	size_t hole = slot;
+	size_t next = (hole + 1) & mask;
+	while (m_entries[next].key != 0)
+	{
+		const size_t home = GetSlot(m_entries[next].key);
+
+		// Move the entry into the hole if its home slot is not in (hole, next]
+		const bool canMove = (hole <= next) ?
+			(home <= hole || home > next) :
+			(home <= hole && home > next);
+
+		if (canMove)
+		{
+			m_entries[hole] = m_entries[next];
+			hole = next;
+		}
+
+		next = (next + 1) & mask;
+	}
+
+	m_entries[hole] = sEntry();
+	m_count--;
+}
+
+
+void eae6320::Physics::cCollisionPairCache::Grow()
+{
+	Rehash(m_entries.empty() ? s_minCapacity : m_entries.size() * 2);
+}
+
+
+void eae6320::Physics::cCollisionPairCache::ShrinkIfSparse()
+{
+	size_t capacity = m_entries.size();
+	while ((capacity > s_minCapacity) && (m_count * 4 < capacity))
+	{
+		capacity /= 2;
+	}
+
+	if (capacity != m_entries.size())
+		Rehash(capacity);
+}
+
+
+void eae6320::Physics::cCollisionPairCache::Rehash(size_t i_capacity)
+{
+	std::vector<sEntry> oldEntries;
+	oldEntries.swap(m_entries);
+
+	m_entries.resize(i_capacity);
+	m_count = 0;
+
+	const size_t mask = m_entries.size() - 1;
+	for (const sEntry& entry : oldEntries)
+	{
+		if (entry.key == 0)
+			continue;
+
+		size_t slot = GetSlot(entry.key);
+		while (m_entries[slot].key != 0)
+		{
+			slot = (slot + 1) & mask;
+		}
+
+		m_entries[slot] = entry;
+		m_count++;
+	}
+}
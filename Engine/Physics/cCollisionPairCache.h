@@ -0,0 +1,168 @@
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Math/sVector.h>
+#include <Engine/Physics/Snapshot.h>
+#include <Engine/Physics/cColliderBase.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+// Collision Events
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	enum class eCollisionEvent : uint8_t
+	{
+		Enter	= 0,
+		Stay	= 1,
+		Exit	= 2,
+	};
+
+	struct sCollisionEvent
+	{
+		cCollider* lhs;
+		cCollider* rhs;
+		eCollisionEvent type;
+	};
+
+	/* Impulse the contact solver applied to a pair in the last frame, pushing the collider
+	 * with the higher id away from the one with the lower id */
+	struct sContactImpulse
+	{
+		float normal = 0.0f;
+		Math::sVector tangent;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Collision Pair Cache Class Declaration
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Persistent set of overlapping pairs, keyed by the (lower id, higher id) of the two colliders.
+	 * Open addressing with linear probing keeps all pairs in one flat table. Every pair carries
+	 * the stamp of the last frame it was reported in, so Enter, Stay and Exit all come out of
+	 * a single sweep of the table. */
+	class cCollisionPairCache
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		/* Record the overlapping pairs of a new frame and append the resulting events to o_events */
+		void Update(const std::vector<std::pair<cCollider*, cCollider*>>& i_pairs, std::vector<sCollisionEvent>& o_events);
+
+		/* Every pair that involves the collider is dropped by the sweep of the next Update(), which sends an Exit
+		 * event for each of them. A pair that the collider forms again in that frame only stays if it is new.
+		 * The collider has to stay alive until then */
+		void Remove(uint32_t i_colliderID);
+
+		size_t GetPairCount() const;
+
+		/* True if the two colliders overlapped at the last Update() */
+		bool Contains(const cCollider* i_lhs, const cCollider* i_rhs) const;
+
+		/* Null if the two colliders are not a pair. The pointer stays valid until the next Update() */
+		sContactImpulse* FindImpulse(const cCollider* i_lhs, const cCollider* i_rhs);
+
+		/* Every pair along with the slot it is in, so the restored table is swept in the same order.
+		 * The pairs refer to colliders by address, they must still be alive when the snapshot is read.
+		 * Reading checks and decodes the table on the side, ApplySnapshot() then swaps it in */
+		void WriteSnapshot(Snapshot::cWriter& io_writer) const;
+		cResult ReadSnapshot(Snapshot::cReader& io_reader);
+		void ApplySnapshot();
+
+
+		// Implementation
+		//=========================
+
+	private:
+
+		struct sEntry
+		{
+			// 0 marks an empty slot, collider ids start from 1
+			uint64_t key = 0;
+			cCollider* lhs = nullptr;
+			cCollider* rhs = nullptr;
+			uint32_t frame = 0;
+			bool isNew = false;
+
+			// Kept for warm starting the contact solver, zero for a new pair
+			sContactImpulse impulse;
+		};
+
+		// An occupied slot of the table in a snapshot. The padding at its end is cleared,
+		// so that it doesn't show up as a change in a delta
+		struct sEntrySnapshot
+		{
+			uint64_t key;
+			cCollider* lhs;
+			cCollider* rhs;
+			uint32_t slot;
+			uint32_t frame;
+			uint32_t isNew;
+			sContactImpulse impulse;
+		};
+		static constexpr size_t s_entrySnapshotDataSize = offsetof(sEntrySnapshot, impulse) + sizeof(sContactImpulse);
+		static constexpr uint32_t s_prefetchDistance = 8;
+
+		static uint64_t MakePairKey(const cCollider* i_lhs, const cCollider* i_rhs);
+		/* Whether either collider of the pair was removed since the last Update(), m_removedIDs has to be sorted */
+		bool IsRemoved(uint64_t i_key) const;
+		/* Reading a snapshot checks the ids of both colliders of every pair, which are all over the heap.
+		 * They are fetched a few pairs ahead so the check doesn't wait on memory */
+		static void PrefetchColliders(const uint8_t* i_entrySnapshot);
+
+		size_t GetSlot(uint64_t i_key) const;
+		static size_t GetSlot(uint64_t i_key, size_t i_capacity);
+		// SIZE_MAX if the key is not in the table
+		size_t FindSlot(uint64_t i_key) const;
+		sEntry& FindOrInsert(uint64_t i_key, bool& o_isInserted);
+		void Erase(uint64_t i_key);
+		void Grow();
+		/* Halve the table while it is less than a quarter full, so its capacity stays under
+		 * max(4 * count, s_minCapacity). A snapshot with a larger capacity is rejected */
+		void ShrinkIfSparse();
+		void Rehash(size_t i_capacity);
+
+
+		// Data
+		//=========================
+
+	private:
+
+		static constexpr size_t s_minCapacity = 64;
+
+		std::vector<sEntry> m_entries;
+		size_t m_count = 0;
+		uint32_t m_frame = 0;
+
+		std::vector<uint64_t> m_expiredKeys;
+		// Ids of the colliders removed since the last Update(), their pairs are dropped by its sweep
+		std::vector<uint32_t> m_removedIDs;
+
+		// Table of the snapshot that was read last, swapped with the live one when it is applied
+		std::vector<sEntry> m_snapshotEntries;
+		size_t m_snapshotCount = 0;
+		uint32_t m_snapshotFrame = 0;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
@@ -0,0 +1,171 @@
+// Includes
+//=========
+
+#include <Engine/Physics/cCollisionPairCache.h>
+#include <Engine/Physics/cContactSolver.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+
+// cContactSolver Implementation
+//==================
+
+void eae6320::Physics::cContactSolver::SetIterationCount(uint32_t i_iterationCount)
+{
+	m_iterationCount = i_iterationCount;
+}
+
+
+uint32_t eae6320::Physics::cContactSolver::GetIterationCount() const
+{
+	return m_iterationCount;
+}
+
+
+void eae6320::Physics::cContactSolver::Solve(const std::vector<sContactManifold>& i_manifolds, cCollisionPairCache& io_pairCache)
+{
+	PrepareConstraints(i_manifolds, io_pairCache);
+
+	for (uint32_t iteration = 0; iteration < m_iterationCount; iteration++)
+	{
+		SolveVelocities();
+	}
+
+	// Keep the impulses for warm starting the next frame
+	for (const sConstraint& constraint : m_constraints)
+	{
+		constraint.cachedImpulse->normal = constraint.normalImpulse;
+		constraint.cachedImpulse->tangent =
+			constraint.tangents[0] * constraint.tangentImpulses[0] + constraint.tangents[1] * constraint.tangentImpulses[1];
+	}
+
+	for (uint32_t iteration = 0; iteration < s_positionIterationCount; iteration++)
+	{
+		SolvePositions();
+	}
+}
+
+
+void eae6320::Physics::cContactSolver::PrepareConstraints(const std::vector<sContactManifold>& i_manifolds, cCollisionPairCache& io_pairCache)
+{
+	m_constraints.clear();
+
+	for (const sContactManifold& manifold : i_manifolds)
+	{
+		sRigidBodyState* rigidBody_lhs = manifold.lhs->m_objectRigidBody;
+		sRigidBodyState* rigidBody_rhs = manifold.rhs->m_objectRigidBody;
+
+		if (rigidBody_lhs->isTrigger || rigidBody_rhs->isTrigger)
+			continue;
+
+		const float inverseMass_lhs = rigidBody_lhs->GetInverseMass();
+		const float inverseMass_rhs = rigidBody_rhs->GetInverseMass();
+		if (inverseMass_lhs + inverseMass_rhs <= 0.0f)
+			continue;
+
+		sContactImpulse* cachedImpulse = io_pairCache.FindImpulse(manifold.lhs, manifold.rhs);
+		if (cachedImpulse == nullptr)
+			continue;
+
+		sConstraint constraint;
+		constraint.lhs = rigidBody_lhs;
+		constraint.rhs = rigidBody_rhs;
+		constraint.inverseMass_lhs = inverseMass_lhs;
+		constraint.inverseMass_rhs = inverseMass_rhs;
+		constraint.normal = manifold.normal;
+		constraint.effectiveMass = 1.0f / (inverseMass_lhs + inverseMass_rhs);
+		constraint.friction = std::sqrt(rigidBody_lhs->friction * rigidBody_rhs->friction);
+		constraint.depth = manifold.depth;
+		constraint.position_lhs = rigidBody_lhs->position;
+		constraint.position_rhs = rigidBody_rhs->position;
+		constraint.cachedImpulse = cachedImpulse;
+
+		// Any two directions perpendicular to the normal and to each other
+		{
+			const Math::sVector axis = (std::fabs(manifold.normal.x) < 0.57735f) ? Math::sVector(1.0f, 0.0f, 0.0f) :
+				((std::fabs(manifold.normal.y) < 0.57735f) ? Math::sVector(0.0f, 1.0f, 0.0f) : Math::sVector(0.0f, 0.0f, 1.0f));
+			constraint.tangents[0] = Cross(manifold.normal, axis).GetNormalized();
+			constraint.tangents[1] = Cross(manifold.normal, constraint.tangents[0]);
+		}
+
+		// Only fast impacts bounce off
+		{
+			const float approachingSpeed = -Dot(rigidBody_rhs->velocity - rigidBody_lhs->velocity, manifold.normal);
+			const float restitution = std::max(rigidBody_lhs->restitution, rigidBody_rhs->restitution);
+
+			constraint.bias = (approachingSpeed > s_restitutionThreshold) ? (restitution * approachingSpeed) : 0.0f;
+		}
+
+		// Warm start from the impulse of the previous frame. The tangent impulse is
+		// projected onto this frame's tangents since they are picked anew
+		constraint.normalImpulse = cachedImpulse->normal;
+		constraint.tangentImpulses[0] = Dot(cachedImpulse->tangent, constraint.tangents[0]);
+		constraint.tangentImpulses[1] = Dot(cachedImpulse->tangent, constraint.tangents[1]);
+
+		ApplyImpulse(constraint, constraint.normal * constraint.normalImpulse +
+			constraint.tangents[0] * constraint.tangentImpulses[0] + constraint.tangents[1] * constraint.tangentImpulses[1]);
+
+		m_constraints.push_back(constraint);
+	}
+}
+
+
+void eae6320::Physics::cContactSolver::SolveVelocities()
+{
+	for (sConstraint& constraint : m_constraints)
+	{
+		// Friction first, so the non-penetration constraint has the last word
+		for (size_t i = 0; i < 2; i++)
+		{
+			const Math::sVector& tangent = constraint.tangents[i];
+			const float relativeVelocity = Dot(constraint.rhs->velocity - constraint.lhs->velocity, tangent);
+
+			// Coulomb friction can't exceed the normal impulse times the friction coefficient
+			const float maxImpulse = constraint.friction * constraint.normalImpulse;
+			const float oldImpulse = constraint.tangentImpulses[i];
+			constraint.tangentImpulses[i] = std::max(-maxImpulse, std::min(oldImpulse - relativeVelocity * constraint.effectiveMass, maxImpulse));
+
+			ApplyImpulse(constraint, tangent * (constraint.tangentImpulses[i] - oldImpulse));
+		}
+
+		// The accumulated normal impulse may only push, but a single iteration may take some of it back
+		{
+			const float relativeVelocity = Dot(constraint.rhs->velocity - constraint.lhs->velocity, constraint.normal);
+
+			const float oldImpulse = constraint.normalImpulse;
+			constraint.normalImpulse = std::max(oldImpulse + (constraint.bias - relativeVelocity) * constraint.effectiveMass, 0.0f);
+
+			ApplyImpulse(constraint, constraint.normal * (constraint.normalImpulse - oldImpulse));
+		}
+	}
+}
+
+
+void eae6320::Physics::cContactSolver::SolvePositions()
+{
+	for (sConstraint& constraint : m_constraints)
+	{
+		// The penetration left after the bodies moved in the previous iterations
+		const Math::sVector displacement = (constraint.rhs->position - constraint.position_rhs) - (constraint.lhs->position - constraint.position_lhs);
+		const float depth = constraint.depth - Dot(displacement, constraint.normal);
+
+		const float correction = std::min(s_penetrationRecoveryFactor * (depth - s_penetrationSlop), s_maxPositionCorrection);
+		if (correction <= 0.0f)
+			continue;
+
+		// Heavier bodies move less
+		const Math::sVector translation = constraint.normal * (correction * constraint.effectiveMass);
+		constraint.lhs->position -= translation * constraint.inverseMass_lhs;
+		constraint.rhs->position += translation * constraint.inverseMass_rhs;
+	}
+}
+
+
+void eae6320::Physics::cContactSolver::ApplyImpulse(sConstraint& io_constraint, const Math::sVector& i_impulse)
+{
+	// The impulse pushes rhs along the normal and lhs the other way
+	io_constraint.lhs->velocity -= i_impulse * io_constraint.inverseMass_lhs;
+	io_constraint.rhs->velocity += i_impulse * io_constraint.inverseMass_rhs;
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Math/sVector.h>
+#include <Engine/Physics/cColliderBase.h>
+#include <Engine/Physics/cRigidBody.h>
+
+#include <cstdint>
+#include <vector>
+
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+namespace Physics
+{
+	class cCollisionPairCache;
+	struct sContactImpulse;
+}
+}
+
+
+// Contact Manifold
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Contact of one overlapping pair, generated once per frame before solving. Bodies only
+	 * respond to contacts linearly, so the deepest point of the pair is all the solver needs */
+	struct sContactManifold
+	{
+		// The collider with the lower id is always lhs
+		cCollider* lhs = nullptr;
+		cCollider* rhs = nullptr;
+
+		// Unit normal pointing from lhs to rhs
+		Math::sVector normal;
+		// World position halfway between the two surfaces
+		Math::sVector point;
+		// Penetration along the normal, positive when overlapping
+		float depth = 0.0f;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Contact Solver Class Declaration
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Sequential impulse solver. Every contact is a non-penetration constraint along its normal
+	 * plus two friction constraints along its tangents, solved one after another over a number
+	 * of iterations. The accumulated impulses are kept in the pair cache and applied again at the
+	 * beginning of the next frame, which lets stacks settle in a few frames instead of jittering.
+	 * Penetration is removed by a few position iterations afterwards, split by inverse mass, so
+	 * pushing bodies apart never adds velocity to them. */
+	class cContactSolver
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		void SetIterationCount(uint32_t i_iterationCount);
+		uint32_t GetIterationCount() const;
+
+		/* Change the velocities of the bodies so that the contacts stop approaching, then move
+		 * the bodies out of penetration. Pairs that involve a trigger are skipped */
+		void Solve(const std::vector<sContactManifold>& i_manifolds, cCollisionPairCache& io_pairCache);
+
+
+		// Implementation
+		//=========================
+
+	private:
+
+		struct sConstraint
+		{
+			sRigidBodyState* lhs;
+			sRigidBodyState* rhs;
+			float inverseMass_lhs;
+			float inverseMass_rhs;
+
+			Math::sVector normal;
+			Math::sVector tangents[2];
+
+			// 1 / (inverse mass of lhs + inverse mass of rhs)
+			float effectiveMass;
+			// Target separating velocity from restitution
+			float bias;
+			float friction;
+
+			// Penetration at the time the manifold was generated, along with the positions of both bodies then
+			float depth;
+			Math::sVector position_lhs;
+			Math::sVector position_rhs;
+
+			// Accumulated over the iterations, including the warm start
+			float normalImpulse;
+			float tangentImpulses[2];
+
+			sContactImpulse* cachedImpulse;
+		};
+
+		void PrepareConstraints(const std::vector<sContactManifold>& i_manifolds, cCollisionPairCache& io_pairCache);
+		void SolveVelocities();
+		void SolvePositions();
+
+		static void ApplyImpulse(sConstraint& io_constraint, const Math::sVector& i_impulse);
+
+
+		// Data
+		//=========================
+
+	private:
+
+		// Fraction of the remaining penetration removed by each position iteration
+		static constexpr float s_penetrationRecoveryFactor = 0.2f;
+		// Penetration that is allowed to remain, so resting contacts don't lose touch every other frame
+		static constexpr float s_penetrationSlop = 0.01f;
+		// Limits the correction of one iteration, so deep overlaps are resolved over a few frames
+		static constexpr float s_maxPositionCorrection = 0.2f;
+		// Slower impacts don't bounce, otherwise resting bodies never come to rest
+		static constexpr float s_restitutionThreshold = 1.0f;
+
+		static constexpr uint32_t s_positionIterationCount = 3;
+
+		uint32_t m_iterationCount = 8;
+
+		std::vector<sConstraint> m_constraints;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
@@ -0,0 +1,152 @@
+// Includes
+//=========
+
+#include <Engine/Physics/cIslandGraph.h>
+
+#include <cmath>
+
+
+
+// cIslandGraph Implementation
+//==================
+
+void eae6320::Physics::cIslandGraph::SetSleepSettings(const sSleepSettings& i_settings)
+{
+	m_settings = i_settings;
+}
+
+
+const eae6320::Physics::sSleepSettings& eae6320::Physics::cIslandGraph::GetSleepSettings() const
+{
+	return m_settings;
+}
+
+
+void eae6320::Physics::cIslandGraph::Update(const std::vector<sRigidBodyState*>& i_awakeBodies,
+	const std::vector<std::pair<cCollider*, cCollider*>>& i_contacts, const float i_secondCountToIntegrate)
+{
+	m_nodeOfBody.clear();
+	m_bodies.clear();
+	m_parents.clear();
+	m_sizes.clear();
+	m_islandCount = 0;
+
+	// Nothing moved, so nothing can fall asleep or wake up. A sleeping body that gets
+	// woken up by gameplay code is awake again at the next integration
+	if (i_awakeBodies.empty())
+		return;
+
+	// Bodies that have been slow since the last update get closer to sleeping. The position solver moves
+	// bodies without giving them any velocity, so the distance moved during the step counts as well
+	{
+		const float linearSpeedThresholdSquared = m_settings.linearSpeedThreshold * m_settings.linearSpeedThreshold;
+		const float maxDistance = m_settings.linearSpeedThreshold * i_secondCountToIntegrate;
+
+		for (sRigidBodyState* rigidBody : i_awakeBodies)
+		{
+			GetNode(rigidBody);
+
+			const Math::sVector displacement = rigidBody->position - rigidBody->sleepPosition;
+			const bool isSlow = m_settings.isEnabled &&
+				Dot(rigidBody->velocity, rigidBody->velocity) <= linearSpeedThresholdSquared &&
+				Dot(displacement, displacement) <= maxDistance * maxDistance &&
+				std::fabs(rigidBody->angularSpeed) <= m_settings.angularSpeedThreshold;
+
+			rigidBody->sleepTime = isSlow ? (rigidBody->sleepTime + i_secondCountToIntegrate) : 0.0f;
+			rigidBody->sleepPosition = rigidBody->position;
+		}
+	}
+
+	// Touching bodies share an island, triggers don't push anything so they don't connect bodies.
+	// Islands that are entirely asleep end up in the graph too, but nothing about them changes
+	for (const auto& contact : i_contacts)
+	{
+		sRigidBodyState* rigidBody_lhs = contact.first->m_objectRigidBody;
+		sRigidBodyState* rigidBody_rhs = contact.second->m_objectRigidBody;
+
+		if (rigidBody_lhs == nullptr || rigidBody_rhs == nullptr ||
+			rigidBody_lhs->isTrigger || rigidBody_rhs->isTrigger ||
+			rigidBody_lhs->isStatic || rigidBody_rhs->isStatic)
+			continue;
+
+		Join(GetNode(rigidBody_lhs), GetNode(rigidBody_rhs));
+	}
+
+	// An island stays awake as long as any of its bodies is still moving
+	const size_t nodeCount = m_bodies.size();
+	m_isIslandAwake.assign(nodeCount, 0);
+	for (uint32_t node = 0; node < nodeCount; node++)
+	{
+		const sRigidBodyState* rigidBody = m_bodies[node];
+		if (rigidBody->isSleeping == false && rigidBody->sleepTime < m_settings.timeToSleep)
+			m_isIslandAwake[FindRoot(node)] = 1;
+	}
+
+	for (uint32_t node = 0; node < nodeCount; node++)
+	{
+		sRigidBodyState* rigidBody = m_bodies[node];
+		const uint32_t root = FindRoot(node);
+
+		if (root == node)
+			m_islandCount++;
+
+		if (m_isIslandAwake[root] != 0)
+		{
+			if (rigidBody->isSleeping)
+				rigidBody->WakeUp();
+		}
+		else if (rigidBody->isSleeping == false)
+		{
+			rigidBody->Sleep();
+		}
+	}
+}
+
+
+size_t eae6320::Physics::cIslandGraph::GetIslandCount() const
+{
+	return m_islandCount;
+}
+
+
+uint32_t eae6320::Physics::cIslandGraph::GetNode(sRigidBodyState* i_rigidBody)
+{
+	auto result = m_nodeOfBody.emplace(i_rigidBody, static_cast<uint32_t>(m_bodies.size()));
+	if (result.second)
+	{
+		m_bodies.push_back(i_rigidBody);
+		m_parents.push_back(result.first->second);
+		m_sizes.push_back(1);
+	}
+
+	return result.first->second;
+}
+
+
+uint32_t eae6320::Physics::cIslandGraph::FindRoot(uint32_t i_node)
+{
+	// Path halving, every visited node skips its parent
+	while (m_parents[i_node] != i_node)
+	{
+		m_parents[i_node] = m_parents[m_parents[i_node]];
+		i_node = m_parents[i_node];
+	}
+
+	return i_node;
+}
+
+
+void eae6320::Physics::cIslandGraph::Join(uint32_t i_node_lhs, uint32_t i_node_rhs)
+{
+	uint32_t root_lhs = FindRoot(i_node_lhs);
+	uint32_t root_rhs = FindRoot(i_node_rhs);
+	if (root_lhs == root_rhs)
+		return;
+
+	// The smaller island hangs under the larger one, which keeps the trees shallow
+	if (m_sizes[root_lhs] < m_sizes[root_rhs])
+		std::swap(root_lhs, root_rhs);
+
+	m_parents[root_rhs] = root_lhs;
+	m_sizes[root_lhs] += m_sizes[root_rhs];
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Physics/cColliderBase.h>
+#include <Engine/Physics/cRigidBody.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+// Sleep Settings
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	struct sSleepSettings
+	{
+		// A body is slow enough to fall asleep below both speeds, in distance and radians per second
+		float linearSpeedThreshold = 0.01f;
+		float angularSpeedThreshold = 0.035f;
+		// Seconds every body of an island has to stay slow before the island falls asleep
+		float timeToSleep = 0.5f;
+
+		bool isEnabled = true;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Island Graph Class Declaration
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Groups rigid bodies that touch each other into islands, using union-find over the contacts of
+	 * a step. Bodies of one island fall asleep and wake up together: a body that falls asleep on its
+	 * own would be pushed by its neighbours right away, and a sleeping body under a moving one would
+	 * let it sink in. Static bodies never join an island, otherwise one floor would connect the whole
+	 * scene. */
+	class cIslandGraph
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		void SetSleepSettings(const sSleepSettings& i_settings);
+		const sSleepSettings& GetSleepSettings() const;
+
+		/* Advance the sleep time of the awake bodies, then put every island whose bodies have all been slow
+		 * for long enough to sleep and wake up every island that still has a moving body. A scene that is
+		 * entirely asleep returns right away */
+		void Update(const std::vector<sRigidBodyState*>& i_awakeBodies,
+			const std::vector<std::pair<cCollider*, cCollider*>>& i_contacts, const float i_secondCountToIntegrate);
+
+		size_t GetIslandCount() const;
+
+
+		// Implementation
+		//=========================
+
+	private:
+
+		uint32_t GetNode(sRigidBodyState* i_rigidBody);
+		uint32_t FindRoot(uint32_t i_node);
+		void Join(uint32_t i_node_lhs, uint32_t i_node_rhs);
+
+
+		// Data
+		//=========================
+
+	private:
+
+		sSleepSettings m_settings;
+
+		// One node per body of the current update, the map is only used to find the node of a body
+		std::unordered_map<sRigidBodyState*, uint32_t> m_nodeOfBody;
+		std::vector<sRigidBodyState*> m_bodies;
+		std::vector<uint32_t> m_parents;
+		std::vector<uint32_t> m_sizes;
+
+		// Indexed by the root node of each island
+		std::vector<uint8_t> m_isIslandAwake;
+
+		size_t m_islandCount = 0;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
@@ -0,0 +1,191 @@
+// Includes
+//=========
+
+#include <Engine/Physics/cAABBCollider.h>
+#include <Engine/Physics/cOBBCollider.h>
+#include <Engine/Physics/cSphereCollider.h>
+
+#include <cmath>
+
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Half the size along each world axis of a box with the given axes
+	eae6320::Math::sVector GetBoundingHalfExtents(const eae6320::Physics::Collision::sOrientedBox& i_box);
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cOBBCollider::GetMinExtent_world() const
+{
+	const Collision::sOrientedBox box = GetBox_world();
+	return box.center - GetBoundingHalfExtents(box);
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cOBBCollider::GetMaxExtent_world() const
+{
+	const Collision::sOrientedBox box = GetBox_world();
+	return box.center + GetBoundingHalfExtents(box);
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cOBBCollider::GetMinExtent_local() const
+{
+	return m_center - GetBoundingHalfExtents(Collision::sOrientedBox(m_center, m_orientation, m_halfExtents));
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cOBBCollider::GetMaxExtent_local() const
+{
+	return m_center + GetBoundingHalfExtents(Collision::sOrientedBox(m_center, m_orientation, m_halfExtents));
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cOBBCollider::GetCentroid_world() const
+{
+	return m_objectRigidBody->position + m_objectRigidBody->orientation * m_center;
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cOBBCollider::GetCentroid_local() const
+{
+	return m_center;
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cOBBCollider::GetWorldPosition() const
+{
+	return m_objectRigidBody->position;
+}
+
+
+eae6320::Math::sVector eae6320::Physics::cOBBCollider::GetHalfExtents() const
+{
+	return m_halfExtents;
+}
+
+
+eae6320::Physics::Collision::sOrientedBox eae6320::Physics::cOBBCollider::GetBox_world() const
+{
+	return Collision::sOrientedBox(GetCentroid_world(), m_objectRigidBody->orientation * m_orientation, m_halfExtents);
+}
+
+
+bool eae6320::Physics::cOBBCollider::IsOverlaps(const cSphereCollider& i_other) const
+{
+	return IsOverlapsSphere(i_other.GetCentroid_world(), i_other.GetRadius());
+}
+
+
+bool eae6320::Physics::cOBBCollider::IsOverlaps(const cAABBCollider& i_other) const
+{
+	return IsOverlapsBox(i_other.GetMinExtent_world(), i_other.GetMaxExtent_world());
+}
+
+
+bool eae6320::Physics::cOBBCollider::IsOverlaps(const cOBBCollider& i_other) const
+{
+	Math::sVector normal;
+	float depth;
+	return Collision::IsOverlaps(GetBox_world(), i_other.GetBox_world(), normal, depth);
+}
+
+
+bool eae6320::Physics::cOBBCollider::RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+	float& o_distance, Math::sVector& o_normal) const
+{
+	return Collision::RayCastBox(i_origin, i_direction, i_maxDistance, GetBox_world(), o_distance, o_normal);
+}
+
+
+bool eae6320::Physics::cOBBCollider::SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+	float& o_distance, Math::sVector& o_normal) const
+{
+	// The box is grown by the radius without rounding its edges, so hits near an edge come slightly early
+	Collision::sOrientedBox box = GetBox_world();
+	box.halfExtents += i_radius;
+	return Collision::RayCastBox(i_origin, i_direction, i_maxDistance, box, o_distance, o_normal);
+}
+
+
+bool eae6320::Physics::cOBBCollider::IsContainsPoint(const Math::sVector& i_point) const
+{
+	const Math::sVector point_local = GetBox_world().ToLocal(i_point);
+
+	return std::abs(point_local.x) <= m_halfExtents.x &&
+		   std::abs(point_local.y) <= m_halfExtents.y &&
+		   std::abs(point_local.z) <= m_halfExtents.z;
+}
+
+
+bool eae6320::Physics::cOBBCollider::IsOverlapsSphere(const Math::sVector& i_center, float i_radius) const
+{
+	return Math::SqDistance(GetBox_world().GetClosestPoint(i_center), i_center) <= i_radius * i_radius;
+}
+
+
+bool eae6320::Physics::cOBBCollider::IsOverlapsBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const
+{
+	Math::sVector normal;
+	float depth;
+	return Collision::IsOverlaps(GetBox_world(), Collision::sOrientedBox(i_minExtent, i_maxExtent), normal, depth);
+}
+
+
+void eae6320::Physics::cOBBCollider::GenerateRenderData(
+	uint32_t& o_vertexCount, std::vector<Math::sVector>& o_vertexData,
+	uint32_t& o_indexCount, std::vector<uint16_t>& o_indexData)
+{
+	// Corners of the box relative to the owner object, corner i is on the positive side of axis j if bit j of i is set
+	const Collision::sOrientedBox box(m_center, m_orientation, m_halfExtents);
+	Math::sVector corners[8];
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		corners[i] = box.ToWorld(Math::sVector(
+			(i & 1) ? m_halfExtents.x : -m_halfExtents.x,
+			(i & 2) ? m_halfExtents.y : -m_halfExtents.y,
+			(i & 4) ? m_halfExtents.z : -m_halfExtents.z));
+	}
+
+	// Vertex data, one line for each pair of corners that differ in a single bit
+	o_vertexCount = 24;
+	o_vertexData = std::vector<Math::sVector>();
+	o_vertexData.reserve(o_vertexCount);
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		for (uint32_t bit = 1; bit < 8; bit <<= 1)
+		{
+			if ((i & bit) == 0)
+			{
+				o_vertexData.push_back(corners[i]);
+				o_vertexData.push_back(corners[i | bit]);
+			}
+		}
+	}
+
+	// Index data
+	o_indexCount = o_vertexCount;
+	o_indexData = std::vector<uint16_t>(o_indexCount);
+	for (uint32_t i = 0; i < o_indexCount; i++)
+	{
+		o_indexData[i] = i;
+	}
+}
+
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::Math::sVector GetBoundingHalfExtents(const eae6320::Physics::Collision::sOrientedBox& i_box)
+	{
+		return eae6320::Math::sVector(
+			i_box.GetProjectedRadius(eae6320::Math::sVector(1.0f, 0.0f, 0.0f)),
+			i_box.GetProjectedRadius(eae6320::Math::sVector(0.0f, 1.0f, 0.0f)),
+			i_box.GetProjectedRadius(eae6320::Math::sVector(0.0f, 0.0f, 1.0f)));
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Math/cQuaternion.h>
+#include <Engine/Math/sVector.h>
+#include <Engine/Physics/cColliderBase.h>
+#include <Engine/Physics/Collision.h>
+
+#include <vector>
+
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* A box that turns with its body, unlike cAABBCollider which keeps to the world axes */
+	class cOBBCollider : public cCollider
+	{
+		// Interface
+		//=====================
+
+	public:
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		cOBBCollider() : cCollider(eColliderType::OBB) { };
+		cOBBCollider(const Math::sVector& i_center, const Math::sVector& i_halfExtents, const Math::cQuaternion& i_orientation)
+			: cCollider(eColliderType::OBB), m_center(i_center), m_halfExtents(i_halfExtents), m_orientation(i_orientation) { }
+
+		~cOBBCollider() = default;
+
+
+		// Property Getters
+		//--------------------------
+
+		/* The extents bound the box as it is turned right now, so the broad phase doesn't pair the empty corners */
+
+		Math::sVector GetMinExtent_world() const final;
+
+		Math::sVector GetMaxExtent_world() const final;
+
+		Math::sVector GetMinExtent_local() const final;
+
+		Math::sVector GetMaxExtent_local() const final;
+
+		Math::sVector GetCentroid_world() const final;
+
+		Math::sVector GetCentroid_local() const final;
+
+		Math::sVector GetWorldPosition() const final;
+
+		Math::sVector GetHalfExtents() const;
+
+		/* The box with the position and orientation of its body applied */
+		Collision::sOrientedBox GetBox_world() const;
+
+		// Overlap Detection
+		//--------------------------
+
+		bool IsOverlaps(const cSphereCollider& i_other) const;
+
+		bool IsOverlaps(const cAABBCollider& i_other) const;
+
+		bool IsOverlaps(const cOBBCollider& i_other) const;
+
+		// Queries
+		//--------------------------
+
+		bool RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+			float& o_distance, Math::sVector& o_normal) const final;
+
+		bool SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+			float& o_distance, Math::sVector& o_normal) const final;
+
+		bool IsContainsPoint(const Math::sVector& i_point) const final;
+
+		bool IsOverlapsSphere(const Math::sVector& i_center, float i_radius) const final;
+
+		bool IsOverlapsBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const final;
+
+		// Render / Debug
+		//--------------------------
+
+		void GenerateRenderData(
+			uint32_t& o_vertexCount, std::vector<Math::sVector>& o_vertexData,
+			uint32_t& o_indexCount, std::vector<uint16_t>& o_indexData) final;
+
+
+		// Data
+		//=====================
+
+	private:
+
+		// Relative to the owner object
+		Math::sVector m_center;
+		Math::sVector m_halfExtents;
+		Math::cQuaternion m_orientation;
+	};
+
+
+}// Namespace Physics
+}// Namespace eae6320
@@ -0,0 +1,1605 @@
+// Includes
+//=========
+
+#include <Engine/GameObject/cGameObject.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Physics/Collision.h>
+#include <Engine/Physics/cAABBCollider.h>
+#include <Engine/Physics/cPhysicsWorld.h>
+#include <Engine/Physics/cSphereCollider.h>
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <unordered_map>
+
+
+
+// Helper Definitions
+//============
+
+namespace
+{
+	// Comparators
+	//----------------------
+
+	auto s_comparator_xAxis = [](eae6320::Physics::cCollider* i_lhs, eae6320::Physics::cCollider* i_rhs) -> bool
+	{
+		return i_lhs->GetMinExtent_world().x < i_rhs->GetMinExtent_world().x;
+	};
+
+	auto s_comparator_yAxis = [](eae6320::Physics::cCollider* i_lhs, eae6320::Physics::cCollider* i_rhs) -> bool
+	{
+		return i_lhs->GetMinExtent_world().y < i_rhs->GetMinExtent_world().y;
+	};
+
+	auto s_comparator_zAxis = [](eae6320::Physics::cCollider* i_lhs, eae6320::Physics::cCollider* i_rhs) -> bool
+	{
+		return i_lhs->GetMinExtent_world().z < i_rhs->GetMinExtent_world().z;
+	};
+
+	bool IsStatic(const eae6320::Physics::cCollider* i_collider)
+	{
+		return i_collider->m_objectRigidBody != nullptr && i_collider->m_objectRigidBody->isStatic;
+	}
+
+	// Ties are broken by id so that the order doesn't depend on the shape of the trees
+	bool IsCloser(const eae6320::Physics::sRayCastHit& i_lhs, const eae6320::Physics::sRayCastHit& i_rhs)
+	{
+		return (i_lhs.distance != i_rhs.distance) ? (i_lhs.distance < i_rhs.distance) : (i_lhs.collider->GetID() < i_rhs.collider->GetID());
+	}
+
+	// Inactive game objects are invisible to queries
+	eae6320::Physics::fQueryFilter MakeActiveFilter(const eae6320::Physics::fQueryFilter& i_filter)
+	{
+		return [&i_filter](const eae6320::Physics::cCollider* i_collider) -> bool
+		{
+			return i_collider->m_gameobject.lock()->IsActive() && (i_filter == nullptr || i_filter(i_collider));
+		};
+	}
+
+	uint64_t MakePairKey(const eae6320::Physics::cCollider* i_lhs, const eae6320::Physics::cCollider* i_rhs)
+	{
+		const uint64_t id_lhs = i_lhs->GetID();
+		const uint64_t id_rhs = i_rhs->GetID();
+		return id_lhs < id_rhs ? ((id_lhs << 32) | id_rhs) : ((id_rhs << 32) | id_lhs);
+	}
+
+	// FNV-1a over the bits of the floats, so that any difference shows up, even between 0 and -0
+	constexpr uint64_t s_hashOffsetBasis = 14695981039346656037ull;
+	constexpr uint64_t s_hashPrime = 1099511628211ull;
+
+	void HashFloats(uint64_t& io_hash, std::initializer_list<float> i_values)
+	{
+		for (const float value : i_values)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			for (int byte = 0; byte < 4; byte++)
+			{
+				io_hash ^= (bits >> (byte * 8)) & 0xff;
+				io_hash *= s_hashPrime;
+			}
+		}
+	}
+
+	// Neither body moves by itself and at least one of them is asleep, so the pair overlaps exactly when it did last step
+	bool IsResting(const eae6320::Physics::cCollider* i_lhs, const eae6320::Physics::cCollider* i_rhs)
+	{
+		const eae6320::Physics::sRigidBodyState* rigidBody_lhs = i_lhs->m_objectRigidBody;
+		const eae6320::Physics::sRigidBodyState* rigidBody_rhs = i_rhs->m_objectRigidBody;
+
+		return rigidBody_lhs != nullptr && rigidBody_rhs != nullptr &&
+			rigidBody_lhs->IsAwake() == false && rigidBody_rhs->IsAwake() == false &&
+			(rigidBody_lhs->isSleeping || rigidBody_rhs->isSleeping);
+	}
+}
+
+
+
+// Interface Implementation
+//============
+
+eae6320::Physics::cPhysicsWorld::cPhysicsWorld()
+	: m_threadContexts(m_workerPool.GetThreadCount())
+{
+
+}
+
+
+
+// Threading
+//============
+
+void eae6320::Physics::cPhysicsWorld::SetThreadCount(uint32_t i_threadCount)
+{
+	m_workerPool.SetThreadCount(i_threadCount);
+	m_threadContexts.resize(m_workerPool.GetThreadCount());
+}
+
+
+uint32_t eae6320::Physics::cPhysicsWorld::GetThreadCount() const
+{
+	return m_workerPool.GetThreadCount();
+}
+
+
+
+// Solver
+//============
+
+void eae6320::Physics::cPhysicsWorld::SetSolverIterationCount(uint32_t i_iterationCount)
+{
+	m_contactSolver.SetIterationCount(i_iterationCount);
+}
+
+
+uint32_t eae6320::Physics::cPhysicsWorld::GetSolverIterationCount() const
+{
+	return m_contactSolver.GetIterationCount();
+}
+
+
+
+// Sleeping
+//============
+
+void eae6320::Physics::cPhysicsWorld::SetSleepSettings(const sSleepSettings& i_settings)
+{
+	m_islandGraph.SetSleepSettings(i_settings);
+}
+
+
+const eae6320::Physics::sSleepSettings& eae6320::Physics::cPhysicsWorld::GetSleepSettings() const
+{
+	return m_islandGraph.GetSleepSettings();
+}
+
+
+
+// Spatial Hash
+//============
+
+void eae6320::Physics::cPhysicsWorld::SetSpatialHashCellSize(float i_cellSize)
+{
+	m_spatialHash.SetCellSize(i_cellSize);
+}
+
+
+float eae6320::Physics::cPhysicsWorld::GetSpatialHashCellSize() const
+{
+	return m_spatialHash.GetCellSize();
+}
+
+
+
+// Determinism
+//============
+
+void eae6320::Physics::cPhysicsWorld::SetDeterministic(bool i_isDeterministic)
+{
+	m_isDeterministic = i_isDeterministic;
+	m_workerPool.SetSharesFloatingPointEnvironment(i_isDeterministic);
+}
+
+
+bool eae6320::Physics::cPhysicsWorld::IsDeterministic() const
+{
+	return m_isDeterministic;
+}
+
+
+uint64_t eae6320::Physics::cPhysicsWorld::ComputeStateHash() const
+{
+	uint64_t hash = s_hashOffsetBasis;
+
+	for (const sRigidBodyState* rigidBody : m_rigidBodyPool.GetBodies())
+	{
+		HashFloats(hash, { rigidBody->position.x, rigidBody->position.y, rigidBody->position.z });
+		HashFloats(hash, { rigidBody->velocity.x, rigidBody->velocity.y, rigidBody->velocity.z });
+		HashFloats(hash, { rigidBody->acceleration.x, rigidBody->acceleration.y, rigidBody->acceleration.z });
+		HashFloats(hash, { rigidBody->orientation.GetW(), rigidBody->orientation.GetX(), rigidBody->orientation.GetY(), rigidBody->orientation.GetZ() });
+		HashFloats(hash, { rigidBody->angularVelocity_axis_local.x, rigidBody->angularVelocity_axis_local.y, rigidBody->angularVelocity_axis_local.z,
+			rigidBody->angularSpeed });
+		HashFloats(hash, { rigidBody->sleepTime, rigidBody->isSleeping ? 1.0f : 0.0f });
+	}
+
+	return hash;
+}
+
+
+
+// Snapshots
+//============
+
+void eae6320::Physics::cPhysicsWorld::Snapshot(std::vector<uint8_t>& o_snapshot, const bool i_includeBVHTrees) const
+{
+	Snapshot::cWriter writer(o_snapshot);
+
+	// The other broad phases keep nothing between steps that the restored positions don't give back
+	const uint32_t hasBVHTrees = (i_includeBVHTrees && (GetBroadPhase() == Collision::eCollisionType::BroadPhase_BVH)) ? 1 : 0;
+
+	writer.Write(s_snapshotTag);
+	writer.Write(s_snapshotVersion);
+	writer.Write(static_cast<uint32_t>(m_collisionType));
+	writer.Write(hasBVHTrees);
+	writer.Write(m_secondCountOfLastStep);
+
+	m_rigidBodyPool.WriteSnapshot(writer);
+	m_pairCache.WriteSnapshot(writer);
+
+	if (hasBVHTrees != 0)
+	{
+		m_dynamicBVHTree.WriteSnapshot(writer);
+		m_staticBVHTree.WriteSnapshot(writer);
+	}
+}
+
+
+eae6320::cResult eae6320::Physics::cPhysicsWorld::Restore(const std::vector<uint8_t>& i_snapshot)
+{
+	Snapshot::cReader reader(i_snapshot);
+
+	uint32_t tag, version, collisionType, hasBVHTrees;
+	float secondCountOfLastStep;
+	if ((reader.Read(tag) == false) || (reader.Read(version) == false) || (reader.Read(collisionType) == false)
+		|| (reader.Read(hasBVHTrees) == false) || (reader.Read(secondCountOfLastStep) == false))
+	{
+		Logging::OutputError("Physics::cPhysicsWorld: The snapshot is too short");
+		return Results::Failure;
+	}
+	if ((tag != s_snapshotTag) || (version != s_snapshotVersion))
+	{
+		Logging::OutputError("Physics::cPhysicsWorld: The data isn't a physics snapshot of version %u", s_snapshotVersion);
+		return Results::Failure;
+	}
+	if (collisionType != m_collisionType)
+	{
+		Logging::OutputError("Physics::cPhysicsWorld: The snapshot was taken with another collision type");
+		return Results::Failure;
+	}
+	if ((hasBVHTrees > 1) || ((hasBVHTrees != 0) && (GetBroadPhase() != Collision::eCollisionType::BroadPhase_BVH)))
+	{
+		Logging::OutputError("Physics::cPhysicsWorld: The snapshot has BVH trees that the world doesn't have");
+		return Results::Failure;
+	}
+
+	// Every section is checked and decoded on the side first, so a snapshot that fails anywhere changes nothing
+	const bool isBVH = hasBVHTrees != 0;
+	cResult result;
+	if (!(result = m_rigidBodyPool.ReadSnapshot(reader)))
+		return result;
+	if (!(result = m_pairCache.ReadSnapshot(reader)))
+		return result;
+	if (isBVH)
+	{
+		if (!(result = m_dynamicBVHTree.ReadSnapshot(reader)))
+			return result;
+		if (!(result = m_staticBVHTree.ReadSnapshot(reader)))
+			return result;
+	}
+	if (reader.IsAtEnd() == false)
+	{
+		Logging::OutputError("Physics::cPhysicsWorld: The snapshot has data past its end");
+		return Results::Failure;
+	}
+
+	m_rigidBodyPool.ApplySnapshot();
+	m_pairCache.ApplySnapshot();
+	if (isBVH)
+	{
+		m_dynamicBVHTree.ApplySnapshot();
+		m_staticBVHTree.ApplySnapshot();
+	}
+	m_shouldCheckSleepingLeaves = !isBVH;
+	m_secondCountOfLastStep = secondCountOfLastStep;
+
+	return Results::Success;
+}
+
+
+// Rigid Bodies
+//============
+
+eae6320::Physics::sRigidBodyHandle eae6320::Physics::cPhysicsWorld::RegisterRigidBody(sRigidBodyState* i_rigidBody)
+{
+	return m_rigidBodyPool.Add(i_rigidBody);
+}
+
+
+eae6320::cResult eae6320::Physics::cPhysicsWorld::DeregisterRigidBody(const sRigidBodyHandle& i_handle)
+{
+	return m_rigidBodyPool.Remove(i_handle);
+}
+
+
+eae6320::Physics::sRigidBodyState* eae6320::Physics::cPhysicsWorld::GetRigidBody(const sRigidBodyHandle& i_handle) const
+{
+	return m_rigidBodyPool.Get(i_handle);
+}
+
+
+
+// Colliders
+//============
+
+void eae6320::Physics::cPhysicsWorld::Initialize(const std::vector<cCollider*>& i_allColliderList, uint8_t i_collisionType)
+{
+	m_collisionType = i_collisionType;
+
+	RegisterContinuousColliders(i_allColliderList);
+
+	switch (GetBroadPhase())
+	{
+	case Collision::eCollisionType::BroadPhase_BVH:
+		Initialize_BVH(i_allColliderList);
+		break;
+	case Collision::eCollisionType::BroadPhase_IncrementalSweepAndPrune:
+		Initialize_IncrementalSweepAndPrune(i_allColliderList);
+		break;
+	case Collision::eCollisionType::BroadPhase_SpatialHash:
+		Initialize_SpatialHash(i_allColliderList);
+		break;
+	default:
+		Initialize_SweepAndPrune(i_allColliderList);
+		break;
+	}
+}
+
+
+void eae6320::Physics::cPhysicsWorld::RegisterCollider(cCollider* i_collider)
+{
+	m_pendingColliderList.push_back(i_collider);
+}
+
+
+void eae6320::Physics::cPhysicsWorld::RegisterColliders(const std::vector<cCollider*>& i_colliders)
+{
+	m_pendingColliderList.insert(m_pendingColliderList.end(), i_colliders.begin(), i_colliders.end());
+}
+
+
+eae6320::cResult eae6320::Physics::cPhysicsWorld::DeregisterCollider(cCollider* i_collider)
+{
+	// A collider that is registered in this frame hasn't joined the broad phase yet
+	{
+		auto iter = std::find(m_pendingColliderList.begin(), m_pendingColliderList.end(), i_collider);
+		if (iter != m_pendingColliderList.end())
+		{
+			m_pendingColliderList.erase(iter);
+			return Results::Success;
+		}
+	}
+
+	// Callbacks of several pairs may deregister the same collider in one frame
+	if (std::find(m_pendingRemovalList.begin(), m_pendingRemovalList.end(), i_collider) != m_pendingRemovalList.end())
+		return Results::Success;
+
+	// The collider leaves the broad phase at the next update, and its game object is kept alive until its
+	// Exit events have been sent by that update
+	m_pendingRemovalList.push_back(i_collider);
+	if (std::shared_ptr<cGameObject> owner = i_collider->m_gameobject.lock())
+		m_deregisteredColliderOwners.push_back(std::move(owner));
+
+	// The contacts of this frame may still be resolved before the next collision detection
+	m_contactList.erase(
+		std::remove_if(m_contactList.begin(), m_contactList.end(),
+			[i_collider](const std::pair<cCollider*, cCollider*>& i_contact) { return i_contact.first == i_collider || i_contact.second == i_collider; }),
+		m_contactList.end());
+
+	return Results::Success;
+}
+
+
+std::list<std::pair<eae6320::Graphics::cRenderHandle<eae6320::Graphics::cLine>, eae6320::Math::cMatrix_transformation>> eae6320::Physics::cPhysicsWorld::GetBVHRenderData()
+{
+	auto renderData = m_dynamicBVHTree.GetRenderData();
+	renderData.splice(renderData.end(), m_staticBVHTree.GetRenderData());
+
+	return renderData;
+}
+
+
+
+// Queries
+//============
+
+bool eae6320::Physics::cPhysicsWorld::RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+	sRayCastHit& o_hit, const fQueryFilter& i_filter) const
+{
+	const fQueryFilter filter = MakeActiveFilter(i_filter);
+
+	// The static tree only has to be searched up to the closest dynamic hit
+	sRayCastHit staticHit;
+	const bool isDynamicHit = m_dynamicBVHTree.RayCast(i_origin, i_direction, i_maxDistance, o_hit, filter);
+	const bool isStaticHit = m_staticBVHTree.RayCast(i_origin, i_direction, isDynamicHit ? o_hit.distance : i_maxDistance, staticHit, filter);
+
+	if (isStaticHit && (isDynamicHit == false || IsCloser(staticHit, o_hit)))
+		o_hit = staticHit;
+
+	return isDynamicHit || isStaticHit;
+}
+
+
+void eae6320::Physics::cPhysicsWorld::RayCastAll(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+	std::vector<sRayCastHit>& o_hits, const fQueryFilter& i_filter) const
+{
+	const fQueryFilter filter = MakeActiveFilter(i_filter);
+
+	std::vector<sRayCastHit> staticHits;
+	m_dynamicBVHTree.RayCastAll(i_origin, i_direction, i_maxDistance, o_hits, filter);
+	m_staticBVHTree.RayCastAll(i_origin, i_direction, i_maxDistance, staticHits, filter);
+
+	// Both lists are sorted already
+	const size_t dynamicHitCount = o_hits.size();
+	o_hits.insert(o_hits.end(), staticHits.begin(), staticHits.end());
+	std::inplace_merge(o_hits.begin(), o_hits.begin() + dynamicHitCount, o_hits.end(), IsCloser);
+}
+
+
+bool eae6320::Physics::cPhysicsWorld::SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+	sRayCastHit& o_hit, const fQueryFilter& i_filter) const
+{
+	const fQueryFilter filter = MakeActiveFilter(i_filter);
+
+	sRayCastHit staticHit;
+	const bool isDynamicHit = m_dynamicBVHTree.SphereCast(i_origin, i_radius, i_direction, i_maxDistance, o_hit, filter);
+	const bool isStaticHit = m_staticBVHTree.SphereCast(i_origin, i_radius, i_direction, isDynamicHit ? o_hit.distance : i_maxDistance, staticHit, filter);
+
+	if (isStaticHit && (isDynamicHit == false || IsCloser(staticHit, o_hit)))
+		o_hit = staticHit;
+
+	return isDynamicHit || isStaticHit;
+}
+
+
+void eae6320::Physics::cPhysicsWorld::OverlapSphere(const Math::sVector& i_center, float i_radius, std::vector<cCollider*>& o_colliders, const fQueryFilter& i_filter) const
+{
+	const fQueryFilter filter = MakeActiveFilter(i_filter);
+
+	m_dynamicBVHTree.OverlapSphere(i_center, i_radius, o_colliders, filter);
+	m_staticBVHTree.OverlapSphere(i_center, i_radius, o_colliders, filter);
+}
+
+
+void eae6320::Physics::cPhysicsWorld::OverlapBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, std::vector<cCollider*>& o_colliders, const fQueryFilter& i_filter) const
+{
+	const fQueryFilter filter = MakeActiveFilter(i_filter);
+
+	m_dynamicBVHTree.OverlapBox(i_minExtent, i_maxExtent, o_colliders, filter);
+	m_staticBVHTree.OverlapBox(i_minExtent, i_maxExtent, o_colliders, filter);
+}
+
+
+eae6320::Physics::cCollider* eae6320::Physics::cPhysicsWorld::Pick(const Math::sVector& i_point, const fQueryFilter& i_filter) const
+{
+	const fQueryFilter filter = MakeActiveFilter(i_filter);
+
+	cCollider* collider = m_dynamicBVHTree.Pick(i_point, filter);
+	return (collider != nullptr) ? collider : m_staticBVHTree.Pick(i_point, filter);
+}
+
+
+void eae6320::Physics::cPhysicsWorld::RayCast(const std::vector<sRay>& i_rays, std::vector<sRayCastHit>& o_hits, const fQueryFilter& i_filter)
+{
+	const size_t count = i_rays.size();
+	const size_t batchCount = (count + s_rayBatchSize - 1) / s_rayBatchSize;
+	const fQueryFilter filter = MakeActiveFilter(i_filter);
+
+	o_hits.resize(count);
+
+	// Neighbouring rays usually go the same way, so each batch is a contiguous range
+	m_workerPool.ParallelFor(batchCount,
+		[this, &i_rays, &o_hits, &filter, count](size_t i_batchIndex, uint32_t i_threadIndex)
+		{
+			const size_t begin = i_batchIndex * s_rayBatchSize;
+			const size_t end = std::min(begin + s_rayBatchSize, count);
+
+			sThreadContext& context = m_threadContexts[i_threadIndex];
+			context.rayHits.resize(end - begin);
+
+			m_dynamicBVHTree.RayCast(i_rays.data() + begin, end - begin, o_hits.data() + begin, context.rayBatchBuffers, filter);
+			m_staticBVHTree.RayCast(i_rays.data() + begin, end - begin, context.rayHits.data(), context.rayBatchBuffers, filter);
+
+			for (size_t i = begin; i < end; i++)
+			{
+				const sRayCastHit& staticHit = context.rayHits[i - begin];
+				if (staticHit.collider != nullptr && (o_hits[i].collider == nullptr || IsCloser(staticHit, o_hits[i])))
+					o_hits[i] = staticHit;
+			}
+		});
+}
+
+
+
+// Diagnostics
+//============
+
+const std::vector<std::pair<eae6320::Physics::cCollider*, eae6320::Physics::cCollider*>>& eae6320::Physics::cPhysicsWorld::GetBroadPhasePairs() const
+{
+	return m_broadPhasePairList;
+}
+
+
+eae6320::Physics::sBVHTreeQuality eae6320::Physics::cPhysicsWorld::GetDynamicBVHTreeQuality() const
+{
+	return m_dynamicBVHTree.GetTreeQuality();
+}
+
+
+eae6320::Physics::sBVHTreeQuality eae6320::Physics::cPhysicsWorld::GetStaticBVHTreeQuality() const
+{
+	return m_staticBVHTree.GetTreeQuality();
+}
+
+
+
+// Update
+//============
+
+void eae6320::Physics::cPhysicsWorld::Update_Integration(const float i_secondCountToIntegrate)
+{
+	m_secondCountOfLastStep = i_secondCountToIntegrate;
+
+	// Continuous colliders are swept from here after the integration
+	for (size_t i = 0; i < m_continuousColliderList.size(); i++)
+	{
+		m_continuousStartPositions[i] = m_continuousColliderList[i]->m_objectRigidBody->position;
+	}
+
+	m_rigidBodyPool.Integrate(i_secondCountToIntegrate, m_workerPool);
+}
+
+
+void eae6320::Physics::cPhysicsWorld::Update_CollisionDetection()
+{
+	// Colliders deregistered since the last update leave the broad phase and colliders registered since then join it,
+	// each in one batch
+	FlushPendingColliders();
+
+	// Colliders deregistered since the last update get their Exit events in this one
+	m_exitingColliderOwners.insert(m_exitingColliderOwners.end(),
+		std::make_move_iterator(m_deregisteredColliderOwners.begin()), std::make_move_iterator(m_deregisteredColliderOwners.end()));
+	m_deregisteredColliderOwners.clear();
+
+	switch (GetBroadPhase())
+	{
+	case Collision::eCollisionType::BroadPhase_BVH:
+		CollisionDetection_BroadPhase_BVH();
+		break;
+	case Collision::eCollisionType::BroadPhase_IncrementalSweepAndPrune:
+		CollisionDetection_BroadPhase_IncrementalSweepAndPrune();
+		break;
+	case Collision::eCollisionType::BroadPhase_SpatialHash:
+		CollisionDetection_BroadPhase_SpatialHash();
+		break;
+	default:
+		CollisionDetection_BroadPhase_SweepAndPrune();
+		break;
+	}
+}
+
+
+void eae6320::Physics::cPhysicsWorld::Update_CollisionResolution()
+{
+	// Contacts are independent of each other, their manifolds are generated in parallel
+	{
+		const size_t count = m_contactList.size();
+		const size_t chunkCount = (count + s_contactChunkSize - 1) / s_contactChunkSize;
+
+		m_manifoldList.resize(count);
+
+		m_workerPool.ParallelFor(chunkCount,
+			[this, count](size_t i_chunkIndex, uint32_t)
+			{
+				const size_t begin = i_chunkIndex * s_contactChunkSize;
+				const size_t end = std::min(begin + s_contactChunkSize, count);
+
+				for (size_t i = begin; i < end; i++)
+				{
+					cCollider* collider_lhs = m_contactList[i].first;
+					cCollider* collider_rhs = m_contactList[i].second;
+
+					// If the owner of the collider is not active, or neither body can move, do nothing
+					if (collider_lhs->m_gameobject.lock()->IsActive() == false ||
+						(collider_lhs->m_objectRigidBody->IsAwake() == false && collider_rhs->m_objectRigidBody->IsAwake() == false) ||
+						Collision::GenerateContact(collider_lhs, collider_rhs, m_manifoldList[i]) == false)
+					{
+						m_manifoldList[i].lhs = nullptr;
+					}
+				}
+			});
+
+		m_manifoldList.erase(
+			std::remove_if(m_manifoldList.begin(), m_manifoldList.end(),
+				[](const sContactManifold& i_manifold) { return i_manifold.lhs == nullptr; }),
+			m_manifoldList.end());
+	}
+
+	// Contacts share rigid bodies, so they are solved one after another in the sorted order
+	m_contactSolver.Solve(m_manifoldList, m_pairCache);
+
+	// Islands that came to rest fall asleep, islands with a moving body wake up entirely
+	m_islandGraph.Update(m_rigidBodyPool.GetAwakeBodies(), m_contactList, m_secondCountOfLastStep);
+
+	// The awake bodies of this step are not used again, so the game objects of colliders that have
+	// had their Exit events can go, along with their bodies
+	m_exitingColliderOwners.clear();
+}
+
+
+
+// Helper Funcitons Implementation
+//==================================
+
+// Broad Phase: Sweep and Prune
+//============
+
+void eae6320::Physics::cPhysicsWorld::Initialize_SweepAndPrune(const std::vector<cCollider*>& i_allColliderList)
+{
+	// Initialize buffers
+	{
+		m_orderedColliderList_xAxis = std::vector<cCollider*>(i_allColliderList);
+		m_orderedColliderList_yAxis = std::vector<cCollider*>(i_allColliderList);
+		m_orderedColliderList_zAxis = std::vector<cCollider*>(i_allColliderList);
+	}
+
+	// Initial collision detection
+	{
+		CollisionDetection_BroadPhase_SweepAndPrune();
+	}
+}
+
+
+void eae6320::Physics::cPhysicsWorld::RegisterColliders_SweepAndPrune(const std::vector<cCollider*>& i_colliders)
+{
+	m_orderedColliderList_xAxis.insert(m_orderedColliderList_xAxis.end(), i_colliders.begin(), i_colliders.end());
+	m_orderedColliderList_yAxis.insert(m_orderedColliderList_yAxis.end(), i_colliders.begin(), i_colliders.end());
+	m_orderedColliderList_zAxis.insert(m_orderedColliderList_zAxis.end(), i_colliders.begin(), i_colliders.end());
+}
+
+
+eae6320::cResult eae6320::Physics::cPhysicsWorld::DeregisterCollider_SweepAndPrune(cCollider* i_collider)
+{
+	// Remove collider from axis order list
+	{
+		auto iter_xAxis = m_orderedColliderList_xAxis.begin();
+		auto iter_yAxis = m_orderedColliderList_yAxis.begin();
+		auto iter_zAxis = m_orderedColliderList_zAxis.begin();
+
+		if ((iter_xAxis = std::find(m_orderedColliderList_xAxis.begin(), m_orderedColliderList_xAxis.end(), i_collider)) != m_orderedColliderList_xAxis.end() &&
+			(iter_yAxis = std::find(m_orderedColliderList_yAxis.begin(), m_orderedColliderList_yAxis.end(), i_collider)) != m_orderedColliderList_yAxis.end() &&
+			(iter_zAxis = std::find(m_orderedColliderList_zAxis.begin(), m_orderedColliderList_zAxis.end(), i_collider)) != m_orderedColliderList_zAxis.end())
+		{
+			m_orderedColliderList_xAxis.erase(iter_xAxis);
+			m_orderedColliderList_yAxis.erase(iter_yAxis);
+			m_orderedColliderList_zAxis.erase(iter_zAxis);
+		}
+		else
+		{
+			Logging::OutputError("Physics::Collision: Trying to remove a non-existed collider");
+			return Results::Failure;
+		}
+	}
+
+	return Results::Success;
+}
+
+
+void eae6320::Physics::cPhysicsWorld::CollisionDetection_BroadPhase_SweepAndPrune()
+{
+	// Update collider data, the three axes are sorted at the same time
+	{
+		m_workerPool.ParallelFor(3,
+			[this](size_t i_axis, uint32_t)
+			{
+				if (i_axis == 0)
+					std::sort(m_orderedColliderList_xAxis.begin(), m_orderedColliderList_xAxis.end(), s_comparator_xAxis);
+				else if (i_axis == 1)
+					std::sort(m_orderedColliderList_yAxis.begin(), m_orderedColliderList_yAxis.end(), s_comparator_yAxis);
+				else
+					std::sort(m_orderedColliderList_zAxis.begin(), m_orderedColliderList_zAxis.end(), s_comparator_zAxis);
+			});
+	}
+
+	std::unordered_map<cCollider*, std::vector<cCollider*>> collisionMap_broadPhase;
+	for (cCollider* collider : m_orderedColliderList_xAxis)
+	{
+		collisionMap_broadPhase[collider] = std::vector<cCollider*>(0);
+	}
+
+	// Sweep and prune the X axis
+	{
+		// Iterate X axis, find all potential collision along X axis
+		for (size_t i = 0; i < m_orderedColliderList_xAxis.size() - 1; i++)
+		{
+			for (size_t j = i + 1; j < m_orderedColliderList_xAxis.size(); j++)
+			{
+				cCollider* collider_i = m_orderedColliderList_xAxis[i];
+				cCollider* collider_j = m_orderedColliderList_xAxis[j];
+
+				// Possible to have collision, unless the layers of the two colliders reject each other
+				if (collider_i->GetMaxExtent_world().x >= collider_j->GetMinExtent_world().x)
+				{
+					if (collider_i->CanCollideWith(collider_j))
+						collisionMap_broadPhase[collider_i].push_back(collider_j);
+				}
+				// Impossbile to have collision
+				else
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	// Sweep and prune the Y axis
+	{
+		// Create buffer
+		std::unordered_map<cCollider*, std::vector<cCollider*>> collisionAtYAxis;
+		for (const auto& item : collisionMap_broadPhase)
+		{
+			collisionAtYAxis[item.first] = std::vector<cCollider*>(0);
+		}
+
+		// Iterate Y axis, find all potential collision along Y axis, select those who already have potential collision in X axis
+		for (size_t i = 0; i < m_orderedColliderList_yAxis.size() - 1; i++)
+		{
+			for (size_t j = i + 1; j < m_orderedColliderList_yAxis.size(); j++)
+			{
+				cCollider* collider_i = m_orderedColliderList_yAxis[i];
+				cCollider* collider_j = m_orderedColliderList_yAxis[j];
+
+				// Possible to have collision
+				if (collider_i->GetMaxExtent_world().y >= collider_j->GetMinExtent_world().y)
+				{
+					const auto& collisionList_i = collisionMap_broadPhase[collider_i];
+					const auto& collisionList_j = collisionMap_broadPhase[collider_j];
+
+					if (std::find(collisionList_i.begin(), collisionList_i.end(), collider_j) != collisionList_i.end())
+						collisionAtYAxis[collider_i].push_back(collider_j);
+					else if (std::find(collisionList_j.begin(), collisionList_j.end(), collider_i) != collisionList_j.end())
+						collisionAtYAxis[collider_j].push_back(collider_i);
+				}
+				// Impossbile to have collision
+				else
+				{
+					break;
+				}
+			}
+		}
+
+		for (auto& collision : collisionMap_broadPhase)
+		{
+			collision.second.swap(collisionAtYAxis[collision.first]);
+		}
+	}
+
+	// Sweep and prune the Z axis
+	{
+		// Create buffer
+		std::unordered_map<cCollider*, std::vector<cCollider*>> collisionAtZAxis;
+		for (const auto& item : collisionMap_broadPhase)
+		{
+			collisionAtZAxis[item.first] = std::vector<cCollider*>(0);
+		}
+
+		// Iterate Z axis, find all potential collision along Z axis, select those who already have potential collision in X and Y axis
+		for (size_t i = 0; i < m_orderedColliderList_zAxis.size() - 1; i++)
+		{
+			for (size_t j = i + 1; j < m_orderedColliderList_zAxis.size(); j++)
+			{
+				cCollider* collider_i = m_orderedColliderList_zAxis[i];
+				cCollider* collider_j = m_orderedColliderList_zAxis[j];
+
+				// Possible to have collision
+				if (collider_i->GetMaxExtent_world().z >= collider_j->GetMinExtent_world().z)
+				{
+					const auto& collisionList_i = collisionMap_broadPhase[collider_i];
+					const auto& collisionList_j = collisionMap_broadPhase[collider_j];
+
+					if (std::find(collisionList_i.begin(), collisionList_i.end(), collider_j) != collisionList_i.end())
+						collisionAtZAxis[collider_i].push_back(collider_j);
+					else if (std::find(collisionList_j.begin(), collisionList_j.end(), collider_i) != collisionList_j.end())
+						collisionAtZAxis[collider_j].push_back(collider_i);
+				}
+				// Impossbile to have collision
+				else
+				{
+					break;
+				}
+			}
+		}
+
+		for (auto& collision : collisionMap_broadPhase)
+		{
+			collision.second.swap(collisionAtZAxis[collision.first]);
+		}
+	}
+
+	// Flatten the potential collisions into a pair list. The map is ordered by address,
+	// which changes from run to run, so the list is sorted by collider id
+	m_broadPhasePairList.clear();
+	for (const auto& collision : collisionMap_broadPhase)
+	{
+		for (cCollider* collider_rhs : collision.second)
+		{
+			m_broadPhasePairList.push_back({ collision.first, collider_rhs });
+		}
+	}
+	SortPairs(m_broadPhasePairList);
+
+	// Proceed to narrow phase collision detection
+	CollisionDetection_NarrowPhase_Overlap(m_broadPhasePairList);
+}
+
+
+
+// Broad Phase: Incremental Sweep and Prune
+//============
+
+void eae6320::Physics::cPhysicsWorld::Initialize_IncrementalSweepAndPrune(const std::vector<cCollider*>& i_allColliderList)
+{
+	// Initialize buffers
+	for (cCollider* collider : i_allColliderList)
+	{
+		m_sweepAndPrune.Add(collider);
+	}
+
+	// Initial collision detection
+	CollisionDetection_BroadPhase_IncrementalSweepAndPrune();
+}
+
+
+void eae6320::Physics::cPhysicsWorld::RegisterColliders_IncrementalSweepAndPrune(const std::vector<cCollider*>& i_colliders)
+{
+	for (cCollider* collider : i_colliders)
+	{
+		m_sweepAndPrune.Add(collider);
+	}
+}
+
+
+eae6320::cResult eae6320::Physics::cPhysicsWorld::DeregisterCollider_IncrementalSweepAndPrune(cCollider* i_collider)
+{
+	// Remove collider from the endpoint arrays and the pair set
+	m_sweepAndPrune.Remove(i_collider);
+
+	return Results::Success;
+}
+
+
+void eae6320::Physics::cPhysicsWorld::CollisionDetection_BroadPhase_IncrementalSweepAndPrune()
+{
+	// Update endpoints, only the swapped endpoints change the pair set. The insertion sort
+	// depends on the previous order, so this broad phase stays on the calling thread
+	m_sweepAndPrune.Update();
+
+	// The pair set is ordered by the history of swaps and removals, so it is sorted like the pairs of the other broad phases
+	m_broadPhasePairList.assign(m_sweepAndPrune.GetPairs().begin(), m_sweepAndPrune.GetPairs().end());
+	SortPairs(m_broadPhasePairList);
+
+	// Proceed to narrow phase collision detection
+	CollisionDetection_NarrowPhase_Overlap(m_broadPhasePairList);
+}
+
+
+
+// Broad Phase: BVH Tree
+//============
+
+void eae6320::Physics::cPhysicsWorld::Initialize_BVH(const std::vector<cCollider*>& i_allColliderList)
+{
+	// Initialize collision detection
+	RegisterColliders_BVH(i_allColliderList);
+
+	// Initialize BVH tree rendering data
+	//m_dynamicBVHTree.InitialzieRenderData();
+
+	// Initial collision detection
+	CollisionDetection_BroadPhase_BVH();
+}
+
+
+void eae6320::Physics::cPhysicsWorld::RegisterColliders_BVH(const std::vector<cCollider*>& i_colliders)
+{
+	// All new leaves of each tree are inserted in one pass
+	std::vector<cCollider*> dynamicColliders;
+	std::vector<cCollider*> staticColliders;
+	for (cCollider* collider : i_colliders)
+	{
+		(IsStatic(collider) ? staticColliders : dynamicColliders).push_back(collider);
+	}
+
+	m_dynamicBVHTree.Add(dynamicColliders);
+	m_staticBVHTree.Add(staticColliders);
+}
+
+
+eae6320::cResult eae6320::Physics::cPhysicsWorld::DeregisterCollider_BVH(cCollider* i_collider)
+{
+	// Remove collider from the BVH tree it was put in
+	if (m_dynamicBVHTree.Search(i_collider) != BVH_NULL_NODE)
+	{
+		m_dynamicBVHTree.Remove(i_collider);
+	}
+	else if (m_staticBVHTree.Search(i_collider) != BVH_NULL_NODE)
+	{
+		m_staticBVHTree.Remove(i_collider);
+	}
+	else
+	{
+		Logging::OutputError("Physics::Collision: Trying to remove a non-existed collider");
+		return Results::Failure;
+	}
+
+	return Results::Success;
+}
+
+
+void eae6320::Physics::cPhysicsWorld::CollisionDetection_BroadPhase_BVH()
+{
+	// Update collider data. Static bodies may still be placed by hand, which is rare enough
+	// that checking their leaves costs next to nothing
+	m_dynamicBVHTree.Update(m_shouldCheckSleepingLeaves);
+	m_staticBVHTree.Update(m_shouldCheckSleepingLeaves);
+	m_shouldCheckSleepingLeaves = false;
+
+	// The self-descent of the dynamic tree and its descent against the static tree are split into
+	// independent subtree pairs, each thread collects the pairs of the subtrees it picks up into its own buffer
+	{
+		const size_t minTaskCount = m_workerPool.GetThreadCount() * s_broadPhaseTasksPerThread;
+		m_dynamicBVHTree.SplitPairTasks(minTaskCount, m_BVHPairTasks);
+		m_dynamicBVHTree.SplitPairTasks(m_staticBVHTree, minTaskCount, m_BVHStaticPairTasks);
+
+		for (sThreadContext& context : m_threadContexts)
+		{
+			context.pairList.clear();
+		}
+
+		const size_t dynamicTaskCount = m_BVHPairTasks.size();
+		m_workerPool.ParallelFor(dynamicTaskCount + m_BVHStaticPairTasks.size(),
+			[this, dynamicTaskCount](size_t i_taskIndex, uint32_t i_threadIndex)
+			{
+				sThreadContext& context = m_threadContexts[i_threadIndex];
+				if (i_taskIndex < dynamicTaskCount)
+					m_dynamicBVHTree.ComputePairs(m_BVHPairTasks[i_taskIndex], context.pairList, context.pairStack);
+				else
+					m_dynamicBVHTree.ComputePairs(m_staticBVHTree, m_BVHStaticPairTasks[i_taskIndex - dynamicTaskCount], context.pairList, context.pairStack);
+			});
+	}
+
+	// Merge the per-thread buffers
+	m_broadPhasePairList.clear();
+	for (const sThreadContext& context : m_threadContexts)
+	{
+		for (const auto& pair : context.pairList)
+		{
+			// If the owner of either collider is not active, do nothing
+			if (pair.first->m_gameobject.lock()->IsActive() == false ||
+				pair.second->m_gameobject.lock()->IsActive() == false)
+				continue;
+
+			m_broadPhasePairList.push_back(pair);
+		}
+	}
+	SortPairs(m_broadPhasePairList);
+
+	// Proceed to narrow phase collision detection
+	CollisionDetection_NarrowPhase_Overlap(m_broadPhasePairList);
+}
+
+
+
+// Broad Phase: Spatial Hash
+//============
+
+void eae6320::Physics::cPhysicsWorld::Initialize_SpatialHash(const std::vector<cCollider*>& i_allColliderList)
+{
+	// Initialize buffers
+	RegisterColliders_SpatialHash(i_allColliderList);
+
+	// Initial collision detection
+	CollisionDetection_BroadPhase_SpatialHash();
+}
+
+
+void eae6320::Physics::cPhysicsWorld::RegisterColliders_SpatialHash(const std::vector<cCollider*>& i_colliders)
+{
+	for (cCollider* collider : i_colliders)
+	{
+		m_spatialHash.Add(collider);
+	}
+}
+
+
+eae6320::cResult eae6320::Physics::cPhysicsWorld::DeregisterCollider_SpatialHash(cCollider* i_collider)
+{
+	// Remove collider from the grid
+	m_spatialHash.Remove(i_collider);
+
+	return Results::Success;
+}
+
+
+void eae6320::Physics::cPhysicsWorld::CollisionDetection_BroadPhase_SpatialHash()
+{
+	// Rebuild the grid
+	m_spatialHash.Update();
+
+	// The cells and the colliders that look for larger levels are split into chunks,
+	// each thread collects the pairs of the chunks it picks up into its own buffer
+	{
+		const size_t cellChunkCount = (m_spatialHash.GetCellCount() + s_spatialHashChunkSize - 1) / s_spatialHashChunkSize;
+		const size_t proxyChunkCount = (m_spatialHash.GetProxyCount() + s_spatialHashChunkSize - 1) / s_spatialHashChunkSize;
+
+		for (sThreadContext& context : m_threadContexts)
+		{
+			context.pairList.clear();
+		}
+
+		m_workerPool.ParallelFor(cellChunkCount + proxyChunkCount,
+			[this, cellChunkCount](size_t i_taskIndex, uint32_t i_threadIndex)
+			{
+				sThreadContext& context = m_threadContexts[i_threadIndex];
+
+				if (i_taskIndex < cellChunkCount)
+				{
+					const size_t begin = i_taskIndex * s_spatialHashChunkSize;
+					const size_t end = std::min(begin + s_spatialHashChunkSize, m_spatialHash.GetCellCount());
+					m_spatialHash.ComputeCellPairs(begin, end, context.pairList);
+				}
+				else
+				{
+					const size_t begin = (i_taskIndex - cellChunkCount) * s_spatialHashChunkSize;
+					const size_t end = std::min(begin + s_spatialHashChunkSize, m_spatialHash.GetProxyCount());
+					m_spatialHash.ComputeLevelPairs(begin, end, context.pairList);
+				}
+			});
+	}
+
+	// Merge the per-thread buffers
+	m_broadPhasePairList.clear();
+	for (const sThreadContext& context : m_threadContexts)
+	{
+		for (const auto& pair : context.pairList)
+		{
+			// If the owner of either collider is not active, do nothing
+			if (pair.first->m_gameobject.lock()->IsActive() == false ||
+				pair.second->m_gameobject.lock()->IsActive() == false)
+				continue;
+
+			m_broadPhasePairList.push_back(pair);
+		}
+	}
+	SortPairs(m_broadPhasePairList);
+
+	// Proceed to narrow phase collision detection
+	CollisionDetection_NarrowPhase_Overlap(m_broadPhasePairList);
+}
+
+
+uint8_t eae6320::Physics::cPhysicsWorld::GetBroadPhase() const
+{
+	if ((m_collisionType & Collision::eCollisionType::BroadPhase_SweepAndPrune) != 0)
+		return Collision::eCollisionType::BroadPhase_SweepAndPrune;
+	else if ((m_collisionType & Collision::eCollisionType::BroadPhase_BVH) != 0)
+		return Collision::eCollisionType::BroadPhase_BVH;
+	else if ((m_collisionType & Collision::eCollisionType::BroadPhase_IncrementalSweepAndPrune) != 0)
+		return Collision::eCollisionType::BroadPhase_IncrementalSweepAndPrune;
+	else if ((m_collisionType & Collision::eCollisionType::BroadPhase_SpatialHash) != 0)
+		return Collision::eCollisionType::BroadPhase_SpatialHash;
+	else
+		return Collision::eCollisionType::BroadPhase_SweepAndPrune;
+}
+
+
+
+// Registration
+//============
+
+void eae6320::Physics::cPhysicsWorld::FlushPendingColliders()
+{
+	m_newColliderList.clear();
+
+	// Deregistered colliders leave first, so one that is registered again in the same frame joins as a new collider.
+	// Their pairs end in the sweep of the pair cache in this update, which sends their Exit events
+	for (cCollider* collider : m_pendingRemovalList)
+	{
+		DeregisterContinuousCollider(collider);
+
+		switch (GetBroadPhase())
+		{
+		case Collision::eCollisionType::BroadPhase_BVH:
+			DeregisterCollider_BVH(collider);
+			break;
+		case Collision::eCollisionType::BroadPhase_IncrementalSweepAndPrune:
+			DeregisterCollider_IncrementalSweepAndPrune(collider);
+			break;
+		case Collision::eCollisionType::BroadPhase_SpatialHash:
+			DeregisterCollider_SpatialHash(collider);
+			break;
+		default:
+			DeregisterCollider_SweepAndPrune(collider);
+			break;
+		}
+
+		m_pairCache.Remove(collider->GetID());
+	}
+	m_pendingRemovalList.clear();
+
+	if (m_pendingColliderList.empty())
+		return;
+
+	switch (GetBroadPhase())
+	{
+	case Collision::eCollisionType::BroadPhase_BVH:
+		RegisterColliders_BVH(m_pendingColliderList);
+		break;
+	case Collision::eCollisionType::BroadPhase_IncrementalSweepAndPrune:
+		RegisterColliders_IncrementalSweepAndPrune(m_pendingColliderList);
+		break;
+	case Collision::eCollisionType::BroadPhase_SpatialHash:
+		RegisterColliders_SpatialHash(m_pendingColliderList);
+		break;
+	default:
+		RegisterColliders_SweepAndPrune(m_pendingColliderList);
+		break;
+	}
+
+	RegisterContinuousColliders(m_pendingColliderList);
+
+	m_newColliderList.swap(m_pendingColliderList);
+	std::sort(m_newColliderList.begin(), m_newColliderList.end());
+
+	m_pendingColliderList.clear();
+}
+
+
+bool eae6320::Physics::cPhysicsWorld::IsNewCollider(const cCollider* i_collider) const
+{
+	return m_newColliderList.empty() == false &&
+		std::binary_search(m_newColliderList.begin(), m_newColliderList.end(), i_collider);
+}
+
+
+void eae6320::Physics::cPhysicsWorld::RegisterContinuousColliders(const std::vector<cCollider*>& i_colliders)
+{
+	for (cCollider* collider : i_colliders)
+	{
+		if (collider->IsContinuous() == false || collider->m_objectRigidBody == nullptr)
+			continue;
+
+		// Nothing to sweep until the body has been integrated once
+		m_continuousColliderList.push_back(collider);
+		m_continuousStartPositions.push_back(collider->m_objectRigidBody->position);
+	}
+}
+
+
+void eae6320::Physics::cPhysicsWorld::DeregisterContinuousCollider(cCollider* i_collider)
+{
+	if (i_collider->IsContinuous() == false)
+		return;
+
+	auto iter = std::find(m_continuousColliderList.begin(), m_continuousColliderList.end(), i_collider);
+	if (iter == m_continuousColliderList.end())
+		return;
+
+	const size_t index = static_cast<size_t>(iter - m_continuousColliderList.begin());
+	m_continuousColliderList.erase(iter);
+	m_continuousStartPositions.erase(m_continuousStartPositions.begin() + index);
+}
+
+
+
+// Narrow Phase
+//============
+
+void eae6320::Physics::cPhysicsWorld::SortPairs(std::vector<std::pair<cCollider*, cCollider*>>& io_pairList)
+{
+	std::sort(io_pairList.begin(), io_pairList.end(),
+		[](const std::pair<cCollider*, cCollider*>& i_lhs, const std::pair<cCollider*, cCollider*>& i_rhs)
+		{
+			return MakePairKey(i_lhs.first, i_lhs.second) < MakePairKey(i_rhs.first, i_rhs.second);
+		});
+}
+
+
+void eae6320::Physics::cPhysicsWorld::SortEvents(std::vector<sCollisionEvent>& io_eventList)
+{
+	// A pair has at most one event per update
+	std::sort(io_eventList.begin(), io_eventList.end(),
+		[](const sCollisionEvent& i_lhs, const sCollisionEvent& i_rhs)
+		{
+			return MakePairKey(i_lhs.lhs, i_lhs.rhs) < MakePairKey(i_rhs.lhs, i_rhs.rhs);
+		});
+}
+
+
+void eae6320::Physics::cPhysicsWorld::CollisionDetection_NarrowPhase_Overlap(const std::vector<std::pair<cCollider*, cCollider*>>& i_pairList_broadPhase)
+{
+	// Group the candidates by collider type combination
+	{
+		m_pairList_sphereSphere.clear();
+		m_pairList_sphereAABB.clear();
+		m_pairList_AABBAABB.clear();
+		m_pairList_other.clear();
+		m_restingContactList.clear();
+
+		for (const auto& pair : i_pairList_broadPhase)
+		{
+			// Resting pairs keep their state from the last step. New colliders have no state yet
+			if (IsResting(pair.first, pair.second) && IsNewCollider(pair.first) == false && IsNewCollider(pair.second) == false)
+			{
+				if (m_pairCache.Contains(pair.first, pair.second))
+					m_restingContactList.push_back(pair);
+				continue;
+			}
+
+			const eColliderType type_lhs = pair.first->GetType();
+			const eColliderType type_rhs = pair.second->GetType();
+
+			if (type_lhs == eColliderType::Sphere && type_rhs == eColliderType::Sphere)
+				m_pairList_sphereSphere.push_back(pair);
+			else if (type_lhs == eColliderType::Sphere && type_rhs == eColliderType::AABB)
+				m_pairList_sphereAABB.push_back(pair);
+			else if (type_lhs == eColliderType::AABB && type_rhs == eColliderType::Sphere)
+				m_pairList_sphereAABB.push_back({ pair.second, pair.first });
+			else if (type_lhs == eColliderType::AABB && type_rhs == eColliderType::AABB)
+				m_pairList_AABBAABB.push_back(pair);
+			else
+				m_pairList_other.push_back(pair);
+		}
+	}
+
+	// Perform narrow phase collision detection for the data from broad phase, one batch per combination.
+	// Each batch is split into chunks that are gathered and tested by the worker threads
+	m_contactList.clear();
+
+	TestOverlaps(m_pairList_sphereSphere,
+		[](const std::pair<cCollider*, cCollider*>& i_pair, sThreadContext& io_context)
+		{
+			const cSphereCollider* sphere_lhs = static_cast<const cSphereCollider*>(i_pair.first);
+			const cSphereCollider* sphere_rhs = static_cast<const cSphereCollider*>(i_pair.second);
+			io_context.sphereArray_lhs.Push(sphere_lhs->GetCentroid_world(), sphere_lhs->GetRadius());
+			io_context.sphereArray_rhs.Push(sphere_rhs->GetCentroid_world(), sphere_rhs->GetRadius());
+		},
+		[](sThreadContext& io_context)
+		{
+			OverlapKernels::IsOverlaps(io_context.sphereArray_lhs, io_context.sphereArray_rhs, io_context.overlapResults);
+		});
+
+	TestOverlaps(m_pairList_sphereAABB,
+		[](const std::pair<cCollider*, cCollider*>& i_pair, sThreadContext& io_context)
+		{
+			const cSphereCollider* sphere_lhs = static_cast<const cSphereCollider*>(i_pair.first);
+			const cAABBCollider* AABB_rhs = static_cast<const cAABBCollider*>(i_pair.second);
+			io_context.sphereArray_lhs.Push(sphere_lhs->GetCentroid_world(), sphere_lhs->GetRadius());
+			io_context.AABBArray_rhs.Push(AABB_rhs->GetMinExtent_world(), AABB_rhs->GetMaxExtent_world());
+		},
+		[](sThreadContext& io_context)
+		{
+			OverlapKernels::IsOverlaps(io_context.sphereArray_lhs, io_context.AABBArray_rhs, io_context.overlapResults);
+		});
+
+	TestOverlaps(m_pairList_AABBAABB,
+		[](const std::pair<cCollider*, cCollider*>& i_pair, sThreadContext& io_context)
+		{
+			const cAABBCollider* AABB_lhs = static_cast<const cAABBCollider*>(i_pair.first);
+			const cAABBCollider* AABB_rhs = static_cast<const cAABBCollider*>(i_pair.second);
+			io_context.AABBArray_lhs.Push(AABB_lhs->GetMinExtent_world(), AABB_lhs->GetMaxExtent_world());
+			io_context.AABBArray_rhs.Push(AABB_rhs->GetMinExtent_world(), AABB_rhs->GetMaxExtent_world());
+		},
+		[](sThreadContext& io_context)
+		{
+			OverlapKernels::IsOverlaps(io_context.AABBArray_lhs, io_context.AABBArray_rhs, io_context.overlapResults);
+		});
+
+	TestOverlaps(m_pairList_other,
+		[](const std::pair<cCollider*, cCollider*>& i_pair, sThreadContext& io_context)
+		{
+			io_context.overlapResults.push_back(Collision::IsOverlaps(i_pair.first, i_pair.second) ? 1 : 0);
+		},
+		[](sThreadContext&) {});
+
+	m_contactList.insert(m_contactList.end(), m_restingContactList.begin(), m_restingContactList.end());
+
+	// Only the BVH and the spatial hash can be queried for the colliders along a path
+	if (GetBroadPhase() == Collision::eCollisionType::BroadPhase_BVH || GetBroadPhase() == Collision::eCollisionType::BroadPhase_SpatialHash)
+		CollisionDetection_Continuous();
+
+	WakeUpTouchedBodies();
+
+	// Enter, Stay and Exit events come out of one sweep of the pair cache,
+	// callbacks are invoked on this thread after the cache is settled
+	m_collisionEventList.clear();
+	m_pairCache.Update(m_contactList, m_collisionEventList);
+	if (m_isDeterministic)
+		SortEvents(m_collisionEventList);
+
+	InvokeCollisionCallback(m_collisionEventList);
+}
+
+
+template <class tGatherFunction, class tKernelFunction>
+void eae6320::Physics::cPhysicsWorld::TestOverlaps(const std::vector<std::pair<cCollider*, cCollider*>>& i_pairList,
+	const tGatherFunction& i_gatherFunction, const tKernelFunction& i_kernelFunction)
+{
+	const size_t count = i_pairList.size();
+	const size_t chunkCount = (count + s_narrowPhaseChunkSize - 1) / s_narrowPhaseChunkSize;
+
+	// Every chunk writes its own range of the results, so no merge is needed
+	m_overlapResults.resize(count);
+
+	m_workerPool.ParallelFor(chunkCount,
+		[this, &i_pairList, &i_gatherFunction, &i_kernelFunction, count](size_t i_chunkIndex, uint32_t i_threadIndex)
+		{
+			const size_t begin = i_chunkIndex * s_narrowPhaseChunkSize;
+			const size_t end = std::min(begin + s_narrowPhaseChunkSize, count);
+
+			sThreadContext& context = m_threadContexts[i_threadIndex];
+			context.sphereArray_lhs.Clear();
+			context.sphereArray_rhs.Clear();
+			context.AABBArray_lhs.Clear();
+			context.AABBArray_rhs.Clear();
+			context.overlapResults.clear();
+
+			for (size_t i = begin; i < end; i++)
+			{
+				i_gatherFunction(i_pairList[i], context);
+			}
+
+			i_kernelFunction(context);
+			std::copy(context.overlapResults.begin(), context.overlapResults.end(), m_overlapResults.begin() + begin);
+		});
+
+	CollectContacts(i_pairList);
+}
+
+
+void eae6320::Physics::cPhysicsWorld::CollectContacts(const std::vector<std::pair<cCollider*, cCollider*>>& i_pairList)
+{
+	for (size_t i = 0; i < i_pairList.size(); i++)
+	{
+		if (m_overlapResults[i] != 0)
+			m_contactList.push_back(i_pairList[i]);
+	}
+}
+
+
+void eae6320::Physics::cPhysicsWorld::CollisionDetection_Continuous()
+{
+	// Everything before this was found at the end of the step
+	const size_t narrowPhaseContactCount = m_contactList.size();
+	m_movedBackBodies.clear();
+	m_movedBackColliders.clear();
+
+	// Only awake colliders that moved are swept
+	m_sweptColliders.clear();
+	for (size_t i = 0; i < m_continuousColliderList.size(); i++)
+	{
+		cCollider* collider = m_continuousColliderList[i];
+		const sRigidBodyState* rigidBody = collider->m_objectRigidBody;
+		const Math::sVector translation = rigidBody->position - m_continuousStartPositions[i];
+
+		if (rigidBody->IsAwake() && collider->m_gameobject.lock()->IsActive() && Dot(translation, translation) > 0.0f)
+			m_sweptColliders.push_back(collider);
+	}
+	std::sort(m_sweptColliders.begin(), m_sweptColliders.end());
+	const auto isSwept = [this](const cCollider* i_collider)
+	{
+		return std::binary_search(m_sweptColliders.begin(), m_sweptColliders.end(), i_collider);
+	};
+
+	for (size_t i = 0; i < m_continuousColliderList.size(); i++)
+	{
+		cCollider* collider = m_continuousColliderList[i];
+		sRigidBodyState* rigidBody = collider->m_objectRigidBody;
+
+		if (isSwept(collider) == false)
+			continue;
+
+		const Math::sVector startPosition = m_continuousStartPositions[i];
+		const Math::sVector translation = rigidBody->position - startPosition;
+
+		// Every collider that may be on the way is in the box around the start and the end of the motion
+		{
+			const Math::sVector minExtent = collider->GetMinExtent_world();
+			const Math::sVector maxExtent = collider->GetMaxExtent_world();
+			const Math::sVector sweptMinExtent = Math::sVector(
+				std::min(minExtent.x, minExtent.x - translation.x), std::min(minExtent.y, minExtent.y - translation.y), std::min(minExtent.z, minExtent.z - translation.z));
+			const Math::sVector sweptMaxExtent = Math::sVector(
+				std::max(maxExtent.x, maxExtent.x - translation.x), std::max(maxExtent.y, maxExtent.y - translation.y), std::max(maxExtent.z, maxExtent.z - translation.z));
+
+			m_sweepCandidates.clear();
+			QueryBroadPhase(sweptMinExtent, sweptMaxExtent, m_sweepCandidates);
+		}
+
+		float earliestTimeOfImpact = 1.0f;
+		cCollider* earliestTarget = nullptr;
+		m_sweepTriggerHits.clear();
+
+		for (cCollider* target : m_sweepCandidates)
+		{
+			if (target == collider || target->m_objectRigidBody == rigidBody || target->m_gameobject.lock()->IsActive() == false ||
+				collider->CanCollideWith(target) == false)
+				continue;
+
+			// Two continuous colliders are swept only once, by the one with the lower id unless that one isn't swept at all
+			if (target->IsContinuous() && target->GetID() < collider->GetID() && isSwept(target))
+				continue;
+
+			// Pairs that still overlap at the end of the step are found by the narrow phase
+			if (Collision::IsOverlaps(collider, target))
+				continue;
+
+			float timeOfImpact = 0.0f;
+			if (Collision::Sweep(collider, translation, target, timeOfImpact) == false)
+				continue;
+
+			// Triggers don't stop anything, every one of them on the way gets its events
+			if (rigidBody->isTrigger || target->m_objectRigidBody->isTrigger)
+			{
+				m_sweepTriggerHits.push_back({ timeOfImpact, target });
+			}
+			else if (timeOfImpact < earliestTimeOfImpact)
+			{
+				earliestTimeOfImpact = timeOfImpact;
+				earliestTarget = target;
+			}
+		}
+
+		// Triggers behind the first solid collider are never reached
+		for (const auto& triggerHit : m_sweepTriggerHits)
+		{
+			if (triggerHit.first <= earliestTimeOfImpact)
+				m_contactList.push_back({ collider, triggerHit.second });
+		}
+
+		// A solid body stops at the first solid collider on the way, just inside of it so that the solver resolves the contact
+		if (earliestTarget != nullptr)
+		{
+			const float fraction = std::min(earliestTimeOfImpact + s_continuousPenetration / translation.GetLength(), 1.0f);
+			rigidBody->position = startPosition + translation * fraction;
+			m_movedBackBodies.push_back(rigidBody);
+			m_movedBackColliders.push_back(collider);
+
+			m_contactList.push_back({ collider, earliestTarget });
+		}
+	}
+
+	if (m_movedBackBodies.empty())
+		return;
+
+	// The narrow phase tested the bodies that were moved back where they ended the step, which they never reached.
+	// Their contacts are tested again where they are now, and the ones that don't overlap anymore never happened
+	std::sort(m_movedBackBodies.begin(), m_movedBackBodies.end());
+	const auto isMovedBack = [this](const sRigidBodyState* i_rigidBody)
+	{
+		return std::binary_search(m_movedBackBodies.begin(), m_movedBackBodies.end(), i_rigidBody);
+	};
+	const auto end_narrowPhase = m_contactList.begin() + narrowPhaseContactCount;
+	const auto end_kept = std::remove_if(m_contactList.begin(), end_narrowPhase,
+		[&isMovedBack](const std::pair<cCollider*, cCollider*>& i_contact)
+		{
+			return (isMovedBack(i_contact.first->m_objectRigidBody) || isMovedBack(i_contact.second->m_objectRigidBody)) &&
+				Collision::IsOverlaps(i_contact.first, i_contact.second) == false;
+		});
+	m_contactList.erase(end_kept, end_narrowPhase);
+
+	// Where they are now, the bodies that were moved back may also touch colliders that the narrow phase never
+	// tested them against. The broad phase is queried around each of them and the new contacts are added
+	m_contactKeys.clear();
+	for (const auto& contact : m_contactList)
+		m_contactKeys.push_back(MakePairKey(contact.first, contact.second));
+	std::sort(m_contactKeys.begin(), m_contactKeys.end());
+
+	m_movedBackContacts.clear();
+	for (cCollider* collider : m_movedBackColliders)
+	{
+		m_sweepCandidates.clear();
+		QueryBroadPhase(collider->GetMinExtent_world(), collider->GetMaxExtent_world(), m_sweepCandidates);
+
+		for (cCollider* target : m_sweepCandidates)
+		{
+			if (target == collider || target->m_objectRigidBody == collider->m_objectRigidBody || target->m_gameobject.lock()->IsActive() == false ||
+				collider->CanCollideWith(target) == false)
+				continue;
+
+			if (std::binary_search(m_contactKeys.begin(), m_contactKeys.end(), MakePairKey(collider, target)) ||
+				Collision::IsOverlaps(collider, target) == false)
+				continue;
+
+			m_movedBackContacts.push_back({ collider, target });
+		}
+	}
+
+	// Two bodies that were both moved back into each other find the pair twice. Sorting also keeps the
+	// order of the contacts independent of the shape of the broad phase
+	SortPairs(m_movedBackContacts);
+	m_movedBackContacts.erase(
+		std::unique(m_movedBackContacts.begin(), m_movedBackContacts.end(),
+			[](const std::pair<cCollider*, cCollider*>& i_lhs, const std::pair<cCollider*, cCollider*>& i_rhs)
+			{
+				return MakePairKey(i_lhs.first, i_lhs.second) == MakePairKey(i_rhs.first, i_rhs.second);
+			}),
+		m_movedBackContacts.end());
+	m_contactList.insert(m_contactList.end(), m_movedBackContacts.begin(), m_movedBackContacts.end());
+}
+
+
+void eae6320::Physics::cPhysicsWorld::QueryBroadPhase(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent,
+	std::vector<cCollider*>& o_colliders) const
+{
+	if (GetBroadPhase() == Collision::eCollisionType::BroadPhase_SpatialHash)
+	{
+		m_spatialHash.Query(i_minExtent, i_maxExtent, o_colliders);
+	}
+	else
+	{
+		m_dynamicBVHTree.Query(i_minExtent, i_maxExtent, o_colliders);
+		m_staticBVHTree.Query(i_minExtent, i_maxExtent, o_colliders);
+	}
+}
+
+
+void eae6320::Physics::cPhysicsWorld::WakeUpTouchedBodies()
+{
+	for (const auto& contact : m_contactList)
+	{
+		sRigidBodyState* rigidBody_lhs = contact.first->m_objectRigidBody;
+		sRigidBodyState* rigidBody_rhs = contact.second->m_objectRigidBody;
+
+		// Triggers don't push, so they don't wake anything up either
+		if (rigidBody_lhs == nullptr || rigidBody_rhs == nullptr || rigidBody_lhs->isTrigger || rigidBody_rhs->isTrigger)
+			continue;
+
+		if (rigidBody_lhs->isSleeping && rigidBody_rhs->IsAwake())
+			rigidBody_lhs->WakeUp();
+		else if (rigidBody_rhs->isSleeping && rigidBody_lhs->IsAwake())
+			rigidBody_rhs->WakeUp();
+	}
+}
+
+
+void eae6320::Physics::cPhysicsWorld::InvokeCollisionCallback(const std::vector<sCollisionEvent>& i_eventList)
+{
+	for (const sCollisionEvent& collisionEvent : i_eventList)
+	{
+		cCollider* collider_lhs = collisionEvent.lhs;
+		cCollider* collider_rhs = collisionEvent.rhs;
+
+		switch (collisionEvent.type)
+		{
+		case eCollisionEvent::Enter:
+		{
+			if (collider_lhs->OnCollisionEnter != nullptr && collider_lhs->m_gameobject.lock()->IsActive())
+				collider_lhs->OnCollisionEnter(collider_lhs, collider_rhs);
+			if (collider_rhs->OnCollisionEnter != nullptr && collider_rhs->m_gameobject.lock()->IsActive())
+				collider_rhs->OnCollisionEnter(collider_rhs, collider_lhs);
+			break;
+		}
+		case eCollisionEvent::Stay:
+		{
+			if (collider_lhs->OnCollisionStay != nullptr && collider_lhs->m_gameobject.lock()->IsActive())
+				collider_lhs->OnCollisionStay(collider_lhs, collider_rhs);
+			if (collider_rhs->OnCollisionStay != nullptr && collider_rhs->m_gameobject.lock()->IsActive())
+				collider_rhs->OnCollisionStay(collider_rhs, collider_lhs);
+			break;
+		}
+		case eCollisionEvent::Exit:
+		{
+			if (collider_lhs->OnCollisionExit != nullptr && collider_lhs->m_gameobject.lock()->IsActive())
+				collider_lhs->OnCollisionExit(collider_lhs, collider_rhs);
+			if (collider_rhs->OnCollisionExit != nullptr && collider_rhs->m_gameobject.lock()->IsActive())
+				collider_rhs->OnCollisionExit(collider_rhs, collider_lhs);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+}
@@ -0,0 +1,408 @@
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Physics/OverlapKernels.h>
+#include <Engine/Physics/cBVHTree.h>
+#include <Engine/Physics/cColliderBase.h>
+#include <Engine/Physics/cCollisionPairCache.h>
+#include <Engine/Physics/cContactSolver.h>
+#include <Engine/Physics/cIslandGraph.h>
+#include <Engine/Physics/cRigidBodyPool.h>
+#include <Engine/Physics/cSpatialHash.h>
+#include <Engine/Physics/cSweepAndPrune.h>
+#include <Engine/Physics/cWorkerPool.h>
+#include <Engine/Results/Results.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+// Physics World Class Declaration
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Owns everything a physics step works on: the rigid body pool, the broad phase structures,
+	 * the pair cache and the buffers of each stage. The step runs its broad phase, narrow phase
+	 * and integration on a worker pool. Pairs found by different threads are merged and sorted by
+	 * collider id before the pair cache sees them, so contacts, events and callbacks come out in
+	 * the same order no matter how many threads are used. Callbacks and collision resolution
+	 * always run on the calling thread. Islands of touching bodies that come to rest fall asleep and
+	 * drop out of integration, broad phase refit, narrow phase and solving until something wakes them.
+	 * With the BVH or the spatial hash broad phase, continuous colliders are also swept along the motion of each step.
+	 * Pairs whose collision layers reject each other, or that only involve static bodies, are dropped
+	 * by the broad phase before any narrow phase work. */
+	class cPhysicsWorld
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		cPhysicsWorld();
+
+		cPhysicsWorld(const cPhysicsWorld&) = delete;
+		cPhysicsWorld& operator =(const cPhysicsWorld&) = delete;
+
+		// Threading
+		//-------------
+
+		/* Counts the calling thread. 0 uses every hardware thread, 1 runs the whole step on the calling thread */
+		void SetThreadCount(uint32_t i_threadCount);
+		uint32_t GetThreadCount() const;
+
+		// Solver
+		//-------------
+
+		/* More iterations let taller stacks settle, at a linear cost per contact */
+		void SetSolverIterationCount(uint32_t i_iterationCount);
+		uint32_t GetSolverIterationCount() const;
+
+		// Sleeping
+		//-------------
+
+		/* Bodies that are asleep when sleeping gets disabled stay asleep until they are woken up */
+		void SetSleepSettings(const sSleepSettings& i_settings);
+		const sSleepSettings& GetSleepSettings() const;
+
+		// Spatial Hash
+		//-------------
+
+		/* Edge length of the smallest cells of the spatial hash broad phase, takes effect at the next collision detection */
+		void SetSpatialHashCellSize(float i_cellSize);
+		float GetSpatialHashCellSize() const;
+
+		// Determinism
+		//-------------
+		// Pairs, contacts and solving always run in the order of collider ids, which are handed out in creation
+		// order, so the same scene built the same way steps the same way with any number of threads. Deterministic
+		// mode also rules out what can still differ between two runs of the same binary:
+		//	- Worker threads use the floating point environment of the thread that steps the world
+		//	- Collision events are sent in the order of collider ids, instead of the order of the pair cache table,
+		//	  which depends on the absolute ids and on how the table has grown
+		// Physics has to be built without floating point contraction (no FMA) for results to match across machines
+
+		void SetDeterministic(bool i_isDeterministic);
+		bool IsDeterministic() const;
+
+		/* Hash of the bits of the state of every registered rigid body, in registration order.
+		 * Two runs that stay in lockstep have the same hash after every step */
+		uint64_t ComputeStateHash() const;
+
+		// Snapshots
+		//-------------
+		// A snapshot holds the motion and sleep state of every body and the collision pair cache with its warm starting
+		// impulses, so stepping on from a restored snapshot gives the same results as stepping on from the moment it
+		// was taken. It refers to bodies by registration order and to colliders by address, so it can only be restored
+		// into the world that took it, with the same bodies and colliders registered. Take and restore snapshots
+		// between steps. The broad phases read the restored positions back at the next collision detection
+
+		/* Reusing o_snapshot from an earlier tick keeps its capacity, so snapshots of the same size don't allocate.
+		 * With the BVH broad phase, i_includeBVHTrees adds the nodes of both trees, which more than doubles the size
+		 * of the snapshot. Without them the trees keep their shape and only the leaves that the restored positions
+		 * moved out of their fat AABB are reinserted, which finds the same pairs but can leave the trees less tight */
+		void Snapshot(std::vector<uint8_t>& o_snapshot, const bool i_includeBVHTrees = false) const;
+
+		/* Fails without changing anything if the snapshot doesn't match the registered bodies and colliders
+		 * or any part of it is corrupted. i_snapshot is read in place, so it is only copied once */
+		cResult Restore(const std::vector<uint8_t>& i_snapshot);
+
+		// Rigid Bodies
+		//-------------
+
+		sRigidBodyHandle RegisterRigidBody(sRigidBodyState* i_rigidBody);
+
+		cResult DeregisterRigidBody(const sRigidBodyHandle& i_handle);
+
+		sRigidBodyState* GetRigidBody(const sRigidBodyHandle& i_handle) const;
+
+		// Colliders
+		//-------------
+
+		void Initialize(const std::vector<cCollider*>& i_allColliderList, uint8_t i_collisionType);
+
+		void RegisterCollider(cCollider* i_collider);
+
+		void RegisterColliders(const std::vector<cCollider*>& i_colliders);
+
+		/* Deregistration is deferred as well, the collider leaves the broad phase at the beginning of the next
+		 * Update_CollisionDetection(). The colliders that still touch it get OnCollisionExit in that update, and so does
+		 * the collider itself. Until then queries can still find it. Its game object is kept alive until then,
+		 * a collider without one has to be kept alive by the caller */
+		cResult DeregisterCollider(cCollider* i_collider);
+
+		std::list<std::pair<Graphics::cRenderHandle<Graphics::cLine>, Math::cMatrix_transformation>> GetBVHRenderData();
+
+		// Queries
+		//-------------
+		// These search the BVH trees, so they find nothing with the other broad phases. Colliders of inactive
+		// game objects are skipped. See cBVHTree for the details of each query
+
+		bool RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+			sRayCastHit& o_hit, const fQueryFilter& i_filter = nullptr) const;
+
+		void RayCastAll(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+			std::vector<sRayCastHit>& o_hits, const fQueryFilter& i_filter = nullptr) const;
+
+		bool SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+			sRayCastHit& o_hit, const fQueryFilter& i_filter = nullptr) const;
+
+		void OverlapSphere(const Math::sVector& i_center, float i_radius, std::vector<cCollider*>& o_colliders, const fQueryFilter& i_filter = nullptr) const;
+
+		void OverlapBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, std::vector<cCollider*>& o_colliders, const fQueryFilter& i_filter = nullptr) const;
+
+		cCollider* Pick(const Math::sVector& i_point, const fQueryFilter& i_filter = nullptr) const;
+
+		/* The closest hit of every ray. Batches of rays are traced on the worker threads,
+		 * so the filter may be called from several threads at once */
+		void RayCast(const std::vector<sRay>& i_rays, std::vector<sRayCastHit>& o_hits, const fQueryFilter& i_filter = nullptr);
+
+		// Diagnostics
+		//-------------
+
+		/* Candidate pairs the broad phase handed to the narrow phase in the last collision detection. The BVH pairs
+		 * colliders by their fat AABBs, so it reports a superset of the pairs whose world AABBs overlap */
+		const std::vector<std::pair<cCollider*, cCollider*>>& GetBroadPhasePairs() const;
+
+		/* Shape of the two BVH trees, only meaningful with the BVH broad phase */
+		sBVHTreeQuality GetDynamicBVHTreeQuality() const;
+		sBVHTreeQuality GetStaticBVHTreeQuality() const;
+
+		// Update
+		//-------------
+
+		void Update_Integration(const float i_secondCountToIntegrate);
+
+		void Update_CollisionDetection();
+
+		void Update_CollisionResolution();
+
+
+		// Implementation
+		//=========================
+
+	private:
+
+		// Broad Phase: Sweep and Prune
+		//----------------------
+
+		void Initialize_SweepAndPrune(const std::vector<cCollider*>& i_allColliderList);
+
+		void RegisterColliders_SweepAndPrune(const std::vector<cCollider*>& i_colliders);
+
+		cResult DeregisterCollider_SweepAndPrune(cCollider* i_collider);
+
+		void CollisionDetection_BroadPhase_SweepAndPrune();
+
+		// Broad Phase: Incremental Sweep and Prune
+		//----------------------
+
+		void Initialize_IncrementalSweepAndPrune(const std::vector<cCollider*>& i_allColliderList);
+
+		void RegisterColliders_IncrementalSweepAndPrune(const std::vector<cCollider*>& i_colliders);
+
+		cResult DeregisterCollider_IncrementalSweepAndPrune(cCollider* i_collider);
+
+		void CollisionDetection_BroadPhase_IncrementalSweepAndPrune();
+
+		// Broad Phase: BVH Tree
+		//----------------------
+
+		void Initialize_BVH(const std::vector<cCollider*>& i_allColliderList);
+
+		void RegisterColliders_BVH(const std::vector<cCollider*>& i_colliders);
+
+		cResult DeregisterCollider_BVH(cCollider* i_collider);
+
+		void CollisionDetection_BroadPhase_BVH();
+
+		// Broad Phase: Spatial Hash
+		//----------------------
+
+		void Initialize_SpatialHash(const std::vector<cCollider*>& i_allColliderList);
+
+		void RegisterColliders_SpatialHash(const std::vector<cCollider*>& i_colliders);
+
+		cResult DeregisterCollider_SpatialHash(cCollider* i_collider);
+
+		void CollisionDetection_BroadPhase_SpatialHash();
+
+		/* The one broad phase bit of the collision type that is in use. Sweep and prune wins over the others
+		 * and is also used when no broad phase bit is set */
+		uint8_t GetBroadPhase() const;
+
+		// Registration
+		//----------------------
+
+		void FlushPendingColliders();
+
+		bool IsNewCollider(const cCollider* i_collider) const;
+
+		void RegisterContinuousColliders(const std::vector<cCollider*>& i_colliders);
+
+		void DeregisterContinuousCollider(cCollider* i_collider);
+
+		// Narrow Phase
+		//----------------------
+
+		/* Sort the pairs by (lower collider id, higher collider id), which makes the rest of the step
+		 * independent of the order in which the broad phase threads reported them */
+		static void SortPairs(std::vector<std::pair<cCollider*, cCollider*>>& io_pairList);
+
+		/* Same order for events, used in deterministic mode */
+		static void SortEvents(std::vector<sCollisionEvent>& io_eventList);
+
+		void CollisionDetection_NarrowPhase_Overlap(const std::vector<std::pair<cCollider*, cCollider*>>& i_pairList_broadPhase);
+
+		/* i_gatherFunction pushes the shapes of one pair into the thread's arrays, i_kernelFunction tests all of them */
+		template <class tGatherFunction, class tKernelFunction>
+		void TestOverlaps(const std::vector<std::pair<cCollider*, cCollider*>>& i_pairList,
+			const tGatherFunction& i_gatherFunction, const tKernelFunction& i_kernelFunction);
+
+		void CollectContacts(const std::vector<std::pair<cCollider*, cCollider*>>& i_pairList);
+
+		/* Sweep every continuous collider from where its body started the step to where it is now. Colliders it
+		 * passed through without overlapping at the end become contacts, a solid body is moved back to the first
+		 * solid collider on its way. Only the BVH and the spatial hash can be searched for the colliders on the way.
+		 * Triggers behind that collider are never reached. A body that is moved back is tested again at its new position,
+		 * against its narrow phase contacts and against the colliders the broad phase finds around it there.
+		 * Two continuous colliders are swept once, from the one with the lower id unless that one isn't moving */
+		void CollisionDetection_Continuous();
+		/* Append the colliders of the BVH trees or the spatial hash whose bounds overlap the given box */
+		void QueryBroadPhase(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, std::vector<cCollider*>& o_colliders) const;
+
+		/* A sleeping body touched by an awake one wakes up, the rest of its island follows after solving */
+		void WakeUpTouchedBodies();
+
+		void InvokeCollisionCallback(const std::vector<sCollisionEvent>& i_eventList);
+
+
+		// Data
+		//=========================
+
+	private:
+
+		/* Scratch buffers of one thread, only touched by that thread during a parallel stage */
+		struct sThreadContext
+		{
+			std::vector<std::pair<cCollider*, cCollider*>> pairList;
+			std::vector<std::pair<int32_t, int32_t>> pairStack;
+
+			OverlapKernels::sSphereArray sphereArray_lhs;
+			OverlapKernels::sSphereArray sphereArray_rhs;
+			OverlapKernels::sAABBArray AABBArray_lhs;
+			OverlapKernels::sAABBArray AABBArray_rhs;
+			std::vector<uint8_t> overlapResults;
+
+			sRayBatchBuffers rayBatchBuffers;
+			std::vector<sRayCastHit> rayHits;
+		};
+
+		// Candidate pairs per narrow phase task
+		static constexpr size_t s_narrowPhaseChunkSize = 1024;
+		// Contacts per manifold generation task
+		static constexpr size_t s_contactChunkSize = 1024;
+		// BVH pair search tasks per thread, more tasks balance uneven subtrees better
+		static constexpr size_t s_broadPhaseTasksPerThread = 4;
+		// Rays per batched ray cast task
+		static constexpr size_t s_rayBatchSize = 64;
+		// Cells or colliders per spatial hash pair search task
+		static constexpr size_t s_spatialHashChunkSize = 256;
+		// Written at the start of every snapshot, a snapshot of another format is rejected
+		static constexpr uint32_t s_snapshotTag = 0x50485953;	// "PHYS"
+		static constexpr uint32_t s_snapshotVersion = 2;
+		// How far a continuous body is moved past its time of impact, so that the contact is found by the solver
+		static constexpr float s_continuousPenetration = 0.005f;
+
+		cWorkerPool m_workerPool;
+		std::vector<sThreadContext> m_threadContexts;
+
+		uint8_t m_collisionType = 0;
+
+		bool m_isDeterministic = false;
+
+		cRigidBodyPool m_rigidBodyPool;
+
+		// Overlapping pairs of the last frame, along with their Enter/Stay/Exit state
+		cCollisionPairCache m_pairCache;
+
+		// Buffers reused by every collision detection
+		std::vector<std::pair<cCollider*, cCollider*>> m_broadPhasePairList;
+		std::vector<std::pair<cCollider*, cCollider*>> m_contactList;
+		std::vector<sCollisionEvent> m_collisionEventList;
+		std::vector<sContactManifold> m_manifoldList;
+
+		cContactSolver m_contactSolver;
+		cIslandGraph m_islandGraph;
+
+		// Contacts between sleeping bodies, or sleeping and static bodies, carried over from the pair cache without testing
+		std::vector<std::pair<cCollider*, cCollider*>> m_restingContactList;
+
+		float m_secondCountOfLastStep = 0.0f;
+
+		// Colliders swept by continuous collision detection, along with the position of their bodies at the start of the step
+		std::vector<cCollider*> m_continuousColliderList;
+		std::vector<Math::sVector> m_continuousStartPositions;
+		std::vector<cCollider*> m_sweepCandidates;
+		// Triggers on the way of the collider being swept along with their time of impact, and the bodies that were moved back
+		std::vector<std::pair<float, cCollider*>> m_sweepTriggerHits;
+		std::vector<sRigidBodyState*> m_movedBackBodies;
+		std::vector<cCollider*> m_movedBackColliders;
+		// Continuous colliders that are awake and moved this step, sorted by address
+		std::vector<cCollider*> m_sweptColliders;
+		// Keys of the contacts so far and the new contacts of the bodies that were moved back
+		std::vector<uint64_t> m_contactKeys;
+		std::vector<std::pair<cCollider*, cCollider*>> m_movedBackContacts;
+
+		// Narrow phase candidates grouped by collider type combination. Sphere-AABB pairs
+		// always store the sphere first. Pairs with an OBB or a capsule have no batched kernel
+		// and go through the dispatch table one at a time
+		std::vector<std::pair<cCollider*, cCollider*>> m_pairList_sphereSphere;
+		std::vector<std::pair<cCollider*, cCollider*>> m_pairList_sphereAABB;
+		std::vector<std::pair<cCollider*, cCollider*>> m_pairList_AABBAABB;
+		std::vector<std::pair<cCollider*, cCollider*>> m_pairList_other;
+
+		// Overlap result of every candidate of the combination being tested, written by the narrow phase tasks
+		std::vector<uint8_t> m_overlapResults;
+
+		// Buffer for sweep and prune algorithm
+		std::vector<cCollider*> m_orderedColliderList_xAxis;
+		std::vector<cCollider*> m_orderedColliderList_yAxis;
+		std::vector<cCollider*> m_orderedColliderList_zAxis;
+
+		// Buffer for incremental sweep and prune algorithm
+		cSweepAndPrune m_sweepAndPrune;
+
+		// Buffer for BVH algorithm. Colliders of static bodies have a tree of their own that is only searched
+		// against the dynamic tree, so static pairs are never visited. The tree is picked at registration
+		cBVHTree m_dynamicBVHTree;
+		cBVHTree m_staticBVHTree;
+		// Set by restoring a snapshot without the trees, the bodies of sleeping leaves may have been moved
+		bool m_shouldCheckSleepingLeaves = false;
+		std::vector<std::pair<int32_t, int32_t>> m_BVHPairTasks;
+		std::vector<std::pair<int32_t, int32_t>> m_BVHStaticPairTasks;
+
+		// Buffer for spatial hash algorithm
+		cSpatialHash m_spatialHash;
+
+		// Command buffers of colliders registered and deregistered since the last collision detection
+		std::vector<cCollider*> m_pendingColliderList;
+		std::vector<cCollider*> m_pendingRemovalList;
+		// Colliders that joined the broad phase in this update, sorted by address. They have no pairs in the cache yet
+		std::vector<cCollider*> m_newColliderList;
+		// Game objects of deregistered colliders, kept alive until the Exit events of the colliders have been sent at
+		// the next collision detection and that step has been resolved
+		std::vector<std::shared_ptr<cGameObject>> m_deregisteredColliderOwners;
+		std::vector<std::shared_ptr<cGameObject>> m_exitingColliderOwners;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
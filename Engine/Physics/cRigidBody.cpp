@@ -52,7 +52,36 @@ eae6320::Math::cMatrix_transformation eae6320::Physics::sRigidBodyState::Predict
 }
 
 
+float eae6320::Physics::sRigidBodyState::GetInverseMass() const
+{
+	return ( isStatic || mass <= 0.0f ) ? 0.0f : ( 1.0f / mass );
+}
+
+
+bool eae6320::Physics::sRigidBodyState::IsAwake() const
+{
+	return ( isStatic == false ) && ( isSleeping == false );
+}
+
+
+void eae6320::Physics::sRigidBodyState::WakeUp()
+{
+	isSleeping = false;
+	sleepTime = 0.0f;
+}
+
+
+void eae6320::Physics::sRigidBodyState::Sleep()
+{
+	isSleeping = true;
+	sleepPosition = position;
+	velocity = Math::sVector( 0.0f, 0.0f, 0.0f );
+	angularSpeed = 0.0f;
+}
+
+
 void eae6320::Physics::sRigidBodyState::Translate(Math::sVector& i_translation)
 {
 	position += i_translation;
+	WakeUp();
 }
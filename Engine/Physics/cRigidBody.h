@@ -44,9 +44,18 @@ namespace Physics
 		Math::sVector angularVelocity_axis_local = Math::sVector( 0.0f, 0.0f, 0.0f );	// In local space (not world space)
 		float angularSpeed = 0.0f;	// Radians per second (positive values rotate right-handed, negative rotate left-handed)
 
+		float mass = 1.0f;	// Ignored for static bodies
+		float restitution = 0.0f;	// 0 stops at an impact, 1 bounces back at the same speed. The larger value of two bodies is used
+		float friction = 0.5f;	// Coulomb friction coefficient. Two bodies use the geometric mean of theirs
+
 		bool isStatic = false;
 		bool isTrigger = false;
 
+		// Managed by the physics world. A sleeping body is skipped by integration, the broad phase refit and the narrow phase
+		bool isSleeping = false;
+		float sleepTime = 0.0f;	// Seconds the body has been slow enough to fall asleep
+		Math::sVector sleepPosition;	// Position at the end of the last step. Moving a sleeping body away from here wakes it up
+
 		// Interface
 		//==========
 
@@ -55,6 +64,15 @@ namespace Physics
 		Math::sVector PredictFuturePosition( const float i_secondCountToExtrapolate ) const;
 		Math::cQuaternion PredictFutureOrientation( const float i_secondCountToExtrapolate ) const;
 		Math::cMatrix_transformation PredictFutureTransform( const float i_secondCountToExtrapolate ) const;
+		// 0 for static bodies, they can't be moved by contacts
+		float GetInverseMass() const;
+		// Only awake dynamic bodies are moved by integration and contacts
+		bool IsAwake() const;
+
+		// The rest of the body's island wakes up at the end of the next physics step
+		void WakeUp();
+		// Stops the body where it is, until it is woken up again
+		void Sleep();
 
 		void Translate(Math::sVector& i_translation);
 	};
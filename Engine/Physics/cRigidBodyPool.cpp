@@ -0,0 +1,371 @@
+// Includes
+//=========
+
+#include <Engine/Logging/Logging.h>
+#include <Engine/Physics/cRigidBodyPool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+// SSE2 is part of every x64 target
+#if defined( _M_X64 ) || defined( __x86_64__ ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ) || defined( __SSE2__ )
+	#define EAE6320_RIGIDBODYPOOL_SSE
+	#include <emmintrin.h>
+#endif
+
+
+
+// cRigidBodyPool Implementation
+//==================
+
+eae6320::Physics::sRigidBodyHandle eae6320::Physics::cRigidBodyPool::Add(sRigidBodyState* i_rigidBody)
+{
+	if (i_rigidBody == nullptr)
+	{
+		Logging::OutputError("Physics::cRigidBodyPool: Trying to add a null rigid body");
+		return sRigidBodyHandle();
+	}
+
+	// Reuse a released slot if there is one, its generation was already advanced on removal
+	uint32_t slot;
+	if (m_freeSlots.empty() == false)
+	{
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		slot = static_cast<uint32_t>(m_slots.size());
+		m_slots.push_back(sSlot());
+	}
+
+	m_slots[slot].index = static_cast<uint32_t>(m_rigidBodies.size());
+	m_rigidBodies.push_back(i_rigidBody);
+	m_slotOfBody.push_back(slot);
+
+	sRigidBodyHandle handle;
+	handle.slot = slot;
+	handle.generation = m_slots[slot].generation;
+	return handle;
+}
+
+
+eae6320::cResult eae6320::Physics::cRigidBodyPool::Remove(const sRigidBodyHandle& i_handle)
+{
+	if (IsValid(i_handle) == false)
+	{
+		Logging::OutputError("Physics::cRigidBodyPool: Trying to remove a non-existed rigid body");
+		return Results::Failure;
+	}
+
+	// Swap with the last body and pop
+	const uint32_t index = m_slots[i_handle.slot].index;
+	const uint32_t lastIndex = static_cast<uint32_t>(m_rigidBodies.size() - 1);
+	if (index != lastIndex)
+	{
+		m_rigidBodies[index] = m_rigidBodies[lastIndex];
+		m_slotOfBody[index] = m_slotOfBody[lastIndex];
+		m_slots[m_slotOfBody[index]].index = index;
+	}
+
+	m_rigidBodies.pop_back();
+	m_slotOfBody.pop_back();
+
+	m_slots[i_handle.slot].generation++;
+	m_freeSlots.push_back(i_handle.slot);
+
+	return Results::Success;
+}
+
+
+bool eae6320::Physics::cRigidBodyPool::IsValid(const sRigidBodyHandle& i_handle) const
+{
+	return i_handle.slot < m_slots.size() && m_slots[i_handle.slot].generation == i_handle.generation;
+}
+
+
+eae6320::Physics::sRigidBodyState* eae6320::Physics::cRigidBodyPool::Get(const sRigidBodyHandle& i_handle) const
+{
+	return IsValid(i_handle) ? m_rigidBodies[m_slots[i_handle.slot].index] : nullptr;
+}
+
+
+size_t eae6320::Physics::cRigidBodyPool::GetCount() const
+{
+	return m_rigidBodies.size();
+}
+
+
+const std::vector<eae6320::Physics::sRigidBodyState*>& eae6320::Physics::cRigidBodyPool::GetBodies() const
+{
+	return m_rigidBodies;
+}
+
+
+const std::vector<eae6320::Physics::sRigidBodyState*>& eae6320::Physics::cRigidBodyPool::GetAwakeBodies() const
+{
+	return m_dynamicBodies;
+}
+
+
+void eae6320::Physics::cRigidBodyPool::Integrate(const float i_secondCountToIntegrate, cWorkerPool& i_workerPool)
+{
+	CollectDynamicBodies();
+
+	// Each chunk is gathered, integrated and written back by one thread. Bodies of different
+	// chunks never share any data, and chunks start at multiples of 4 so aligned loads still work
+	const size_t count = m_dynamicBodies.size();
+	const size_t chunkCount = (count + s_integrationChunkSize - 1) / s_integrationChunkSize;
+
+	i_workerPool.ParallelFor(chunkCount,
+		[this, i_secondCountToIntegrate, count](size_t i_chunkIndex, uint32_t)
+		{
+			const size_t begin = i_chunkIndex * s_integrationChunkSize;
+			const size_t end = std::min(begin + s_integrationChunkSize, count);
+
+			Gather(begin, end, i_secondCountToIntegrate);
+			IntegrateBatch(begin, end, i_secondCountToIntegrate);
+			Scatter(begin, end);
+		});
+}
+
+
+void eae6320::Physics::cRigidBodyPool::WriteSnapshot(Snapshot::cWriter& io_writer) const
+{
+	io_writer.Write(static_cast<uint32_t>(m_rigidBodies.size()));
+
+	uint8_t* data = io_writer.Allocate(m_rigidBodies.size() * s_bodySnapshotSize);
+	const size_t count = m_rigidBodies.size();
+	for (size_t i = 0; i < count; i++)
+	{
+		PrefetchBody(i + s_snapshotPrefetchDistance);
+		std::memcpy(data, static_cast<const void*>(m_rigidBodies[i]), s_bodySnapshotSize);
+		data += s_bodySnapshotSize;
+	}
+}
+
+
+eae6320::cResult eae6320::Physics::cRigidBodyPool::ReadSnapshot(Snapshot::cReader& io_reader)
+{
+	uint32_t count;
+	if ((io_reader.Read(count) == false) || (io_reader.GetRemainingSize() < count * s_bodySnapshotSize))
+	{
+		Logging::OutputError("Physics::cRigidBodyPool: The snapshot is truncated");
+		return Results::Failure;
+	}
+	if (count != m_rigidBodies.size())
+	{
+		Logging::OutputError("Physics::cRigidBodyPool: The snapshot has %u bodies but the pool has %u",
+			count, static_cast<uint32_t>(m_rigidBodies.size()));
+		return Results::Failure;
+	}
+
+	m_snapshotBodies = io_reader.Consume(count * s_bodySnapshotSize);
+
+	return Results::Success;
+}
+
+
+void eae6320::Physics::cRigidBodyPool::ApplySnapshot()
+{
+	const uint8_t* data = m_snapshotBodies;
+	const size_t count = m_rigidBodies.size();
+	for (size_t i = 0; i < count; i++)
+	{
+		PrefetchBody(i + s_snapshotPrefetchDistance);
+		uint8_t* const body = reinterpret_cast<uint8_t*>(m_rigidBodies[i]);
+		std::memcpy(body, data, s_motionStateSize);
+		// The sleep flag is set on its own, so a corrupted byte can't end up in a bool as anything but true or false
+		m_rigidBodies[i]->isSleeping = data[s_sleepStateOffset] != 0;
+		std::memcpy(body + s_sleepTimeOffset, data + s_sleepTimeOffset, s_bodySnapshotSize - s_sleepTimeOffset);
+		data += s_bodySnapshotSize;
+	}
+	m_snapshotBodies = nullptr;
+}
+
+
+void eae6320::Physics::cRigidBodyPool::PrefetchBody(const size_t i_index) const
+{
+#ifdef EAE6320_RIGIDBODYPOOL_SSE
+	if (i_index < m_rigidBodies.size())
+	{
+		// A body may start anywhere in a cache line, so it can span three of them
+		const char* const body = reinterpret_cast<const char*>(m_rigidBodies[i_index]);
+		_mm_prefetch(body, _MM_HINT_T0);
+		_mm_prefetch(body + 64, _MM_HINT_T0);
+		_mm_prefetch(body + s_bodySnapshotSize - 1, _MM_HINT_T0);
+	}
+#else
+	static_cast<void>(i_index);
+#endif
+}
+
+
+void eae6320::Physics::cRigidBodyPool::CollectDynamicBodies()
+{
+	m_dynamicBodies.clear();
+
+	for (sRigidBodyState* rigidBody : m_rigidBodies)
+	{
+		// Static bodies never move
+		if (rigidBody->isStatic)
+			continue;
+
+		// Sleeping bodies stay where they are, unless gameplay code teleported or pushed them
+		if (rigidBody->isSleeping)
+		{
+			if (rigidBody->position == rigidBody->sleepPosition &&
+				rigidBody->velocity == Math::sVector(0.0f, 0.0f, 0.0f) && rigidBody->angularSpeed == 0.0f)
+				continue;
+
+			rigidBody->WakeUp();
+		}
+
+		m_dynamicBodies.push_back(rigidBody);
+	}
+
+	const size_t count = m_dynamicBodies.size();
+	m_positionX.resize(count); m_positionY.resize(count); m_positionZ.resize(count);
+	m_velocityX.resize(count); m_velocityY.resize(count); m_velocityZ.resize(count);
+	m_accelerationX.resize(count); m_accelerationY.resize(count); m_accelerationZ.resize(count);
+	m_orientationW.resize(count); m_orientationX.resize(count); m_orientationY.resize(count); m_orientationZ.resize(count);
+	m_rotationW.resize(count); m_rotationX.resize(count); m_rotationY.resize(count); m_rotationZ.resize(count);
+}
+
+
+void eae6320::Physics::cRigidBodyPool::Gather(const size_t i_begin, const size_t i_end, const float i_secondCountToIntegrate)
+{
+	for (size_t i = i_begin; i < i_end; i++)
+	{
+		const sRigidBodyState* rigidBody = m_dynamicBodies[i];
+
+		m_positionX[i] = rigidBody->position.x;
+		m_positionY[i] = rigidBody->position.y;
+		m_positionZ[i] = rigidBody->position.z;
+		m_velocityX[i] = rigidBody->velocity.x;
+		m_velocityY[i] = rigidBody->velocity.y;
+		m_velocityZ[i] = rigidBody->velocity.z;
+		m_accelerationX[i] = rigidBody->acceleration.x;
+		m_accelerationY[i] = rigidBody->acceleration.y;
+		m_accelerationZ[i] = rigidBody->acceleration.z;
+		m_orientationW[i] = rigidBody->orientation.GetW();
+		m_orientationX[i] = rigidBody->orientation.GetX();
+		m_orientationY[i] = rigidBody->orientation.GetY();
+		m_orientationZ[i] = rigidBody->orientation.GetZ();
+
+		// Most bodies don't spin, their rotation is the identity and needs no trigonometry
+		if (rigidBody->angularSpeed == 0.0f)
+		{
+			m_rotationW[i] = 1.0f;
+			m_rotationX[i] = 0.0f;
+			m_rotationY[i] = 0.0f;
+			m_rotationZ[i] = 0.0f;
+		}
+		else
+		{
+			const Math::cQuaternion rotation(rigidBody->angularSpeed * i_secondCountToIntegrate, rigidBody->angularVelocity_axis_local);
+			m_rotationW[i] = rotation.GetW();
+			m_rotationX[i] = rotation.GetX();
+			m_rotationY[i] = rotation.GetY();
+			m_rotationZ[i] = rotation.GetZ();
+		}
+	}
+}
+
+
+void eae6320::Physics::cRigidBodyPool::IntegrateBatch(const size_t i_begin, const size_t i_end, const float i_secondCountToIntegrate)
+{
+	const float dt = i_secondCountToIntegrate;
+	size_t i = i_begin;
+
+#if defined( EAE6320_RIGIDBODYPOOL_SSE )
+	// 4 bodies per iteration. The arrays are 32 byte aligned and i_begin is a multiple of 4, so loads can be aligned
+	const __m128 dt4 = _mm_set1_ps(dt);
+	const __m128 one4 = _mm_set1_ps(1.0f);
+
+	for (; i + 4 <= i_end; i += 4)
+	{
+		// Update position, then velocity
+		{
+			const __m128 velocityX = _mm_load_ps(&m_velocityX[i]);
+			const __m128 velocityY = _mm_load_ps(&m_velocityY[i]);
+			const __m128 velocityZ = _mm_load_ps(&m_velocityZ[i]);
+
+			_mm_store_ps(&m_positionX[i], _mm_add_ps(_mm_load_ps(&m_positionX[i]), _mm_mul_ps(velocityX, dt4)));
+			_mm_store_ps(&m_positionY[i], _mm_add_ps(_mm_load_ps(&m_positionY[i]), _mm_mul_ps(velocityY, dt4)));
+			_mm_store_ps(&m_positionZ[i], _mm_add_ps(_mm_load_ps(&m_positionZ[i]), _mm_mul_ps(velocityZ, dt4)));
+
+			_mm_store_ps(&m_velocityX[i], _mm_add_ps(velocityX, _mm_mul_ps(_mm_load_ps(&m_accelerationX[i]), dt4)));
+			_mm_store_ps(&m_velocityY[i], _mm_add_ps(velocityY, _mm_mul_ps(_mm_load_ps(&m_accelerationY[i]), dt4)));
+			_mm_store_ps(&m_velocityZ[i], _mm_add_ps(velocityZ, _mm_mul_ps(_mm_load_ps(&m_accelerationZ[i]), dt4)));
+		}
+
+		// Update orientation: orientation * rotation, then normalize
+		{
+			const __m128 qw = _mm_load_ps(&m_orientationW[i]);
+			const __m128 qx = _mm_load_ps(&m_orientationX[i]);
+			const __m128 qy = _mm_load_ps(&m_orientationY[i]);
+			const __m128 qz = _mm_load_ps(&m_orientationZ[i]);
+			const __m128 rw = _mm_load_ps(&m_rotationW[i]);
+			const __m128 rx = _mm_load_ps(&m_rotationX[i]);
+			const __m128 ry = _mm_load_ps(&m_rotationY[i]);
+			const __m128 rz = _mm_load_ps(&m_rotationZ[i]);
+
+			const __m128 w = _mm_sub_ps(_mm_mul_ps(qw, rw),
+				_mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, rx), _mm_mul_ps(qy, ry)), _mm_mul_ps(qz, rz)));
+			const __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qw, rx), _mm_mul_ps(qx, rw)),
+				_mm_sub_ps(_mm_mul_ps(qy, rz), _mm_mul_ps(qz, ry)));
+			const __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qw, ry), _mm_mul_ps(qy, rw)),
+				_mm_sub_ps(_mm_mul_ps(qz, rx), _mm_mul_ps(qx, rz)));
+			const __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qw, rz), _mm_mul_ps(qz, rw)),
+				_mm_sub_ps(_mm_mul_ps(qx, ry), _mm_mul_ps(qy, rx)));
+
+			const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(w, w), _mm_mul_ps(x, x)), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+			const __m128 length_reciprocal = _mm_div_ps(one4, length);
+
+			_mm_store_ps(&m_orientationW[i], _mm_mul_ps(w, length_reciprocal));
+			_mm_store_ps(&m_orientationX[i], _mm_mul_ps(x, length_reciprocal));
+			_mm_store_ps(&m_orientationY[i], _mm_mul_ps(y, length_reciprocal));
+			_mm_store_ps(&m_orientationZ[i], _mm_mul_ps(z, length_reciprocal));
+		}
+	}
+#endif
+
+	// Remaining bodies, or all of them without SSE
+	for (; i < i_end; i++)
+	{
+		m_positionX[i] += m_velocityX[i] * dt;
+		m_positionY[i] += m_velocityY[i] * dt;
+		m_positionZ[i] += m_velocityZ[i] * dt;
+
+		m_velocityX[i] += m_accelerationX[i] * dt;
+		m_velocityY[i] += m_accelerationY[i] * dt;
+		m_velocityZ[i] += m_accelerationZ[i] * dt;
+
+		Math::cQuaternion orientation =
+			Math::cQuaternion(m_orientationW[i], m_orientationX[i], m_orientationY[i], m_orientationZ[i]) *
+			Math::cQuaternion(m_rotationW[i], m_rotationX[i], m_rotationY[i], m_rotationZ[i]);
+		orientation.Normalize();
+
+		m_orientationW[i] = orientation.GetW();
+		m_orientationX[i] = orientation.GetX();
+		m_orientationY[i] = orientation.GetY();
+		m_orientationZ[i] = orientation.GetZ();
+	}
+}
+
+
+void eae6320::Physics::cRigidBodyPool::Scatter(const size_t i_begin, const size_t i_end)
+{
+	for (size_t i = i_begin; i < i_end; i++)
+	{
+		sRigidBodyState* rigidBody = m_dynamicBodies[i];
+
+		rigidBody->position = Math::sVector(m_positionX[i], m_positionY[i], m_positionZ[i]);
+		rigidBody->velocity = Math::sVector(m_velocityX[i], m_velocityY[i], m_velocityZ[i]);
+		rigidBody->orientation = Math::cQuaternion(m_orientationW[i], m_orientationX[i], m_orientationY[i], m_orientationZ[i]);
+	}
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Physics/Snapshot.h>
+#include <Engine/Physics/cRigidBody.h>
+#include <Engine/Physics/cWorkerPool.h>
+#include <Engine/Results/Results.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+
+// Rigid Body Handle
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Stable reference to a body in cRigidBodyPool. The generation tells a handle of a
+	 * removed body apart from a handle of a new body that reuses the same slot */
+	struct sRigidBodyHandle
+	{
+		uint32_t slot = UINT32_MAX;
+		uint32_t generation = 0;
+
+		bool IsValid() const { return slot != UINT32_MAX; }
+	};
+
+	/* Minimal allocator that aligns every array to i_alignment bytes, so SIMD loops can use aligned loads */
+	template <class T, size_t i_alignment>
+	struct sAlignedAllocator
+	{
+		using value_type = T;
+
+		template <class U>
+		struct rebind { using other = sAlignedAllocator<U, i_alignment>; };
+
+		sAlignedAllocator() = default;
+		template <class U>
+		sAlignedAllocator(const sAlignedAllocator<U, i_alignment>&) {}
+
+		T* allocate(size_t i_count) { return static_cast<T*>(::operator new(i_count * sizeof(T), std::align_val_t(i_alignment))); }
+		void deallocate(T* i_pointer, size_t) { ::operator delete(i_pointer, std::align_val_t(i_alignment)); }
+
+		template <class U>
+		bool operator ==(const sAlignedAllocator<U, i_alignment>&) const { return true; }
+		template <class U>
+		bool operator !=(const sAlignedAllocator<U, i_alignment>&) const { return false; }
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Rigid Body Pool Class Declaration
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Physics-owned store of rigid bodies. Gameplay code keeps reading and writing its
+	 * sRigidBodyState, the pool refers to it through a stable handle. Each step the dynamic
+	 * bodies are packed into structure-of-arrays buffers, integrated in one SIMD loop and
+	 * written back. Static and sleeping bodies are not touched at all. Packing included, this
+	 * is still several times faster than updating every body on its own, which
+	 * PhysicsBenchmark --integration measures */
+	class cRigidBodyPool
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		sRigidBodyHandle Add(sRigidBodyState* i_rigidBody);
+		cResult Remove(const sRigidBodyHandle& i_handle);
+
+		bool IsValid(const sRigidBodyHandle& i_handle) const;
+		sRigidBodyState* Get(const sRigidBodyHandle& i_handle) const;
+
+		size_t GetCount() const;
+
+		/* Every body, in the order of registration as long as none was removed */
+		const std::vector<sRigidBodyState*>& GetBodies() const;
+
+		/* The bodies that were integrated by the last step */
+		const std::vector<sRigidBodyState*>& GetAwakeBodies() const;
+
+		/* Same result as calling sRigidBodyState::Update() on every dynamic body.
+		 * Large pools are split into chunks that are integrated on the worker threads */
+		void Integrate(const float i_secondCountToIntegrate, cWorkerPool& i_workerPool);
+
+		/* The motion and sleep state of every body, in the order of GetBodies(). Mass, material and flags
+		 * are set up by the game, they are copied along with the rest but never read back */
+		void WriteSnapshot(Snapshot::cWriter& io_writer) const;
+		/* Checks the snapshot without touching any body, and fails if it was taken with a different number of bodies.
+		 * ApplySnapshot() then copies the bodies in, while the snapshot buffer is still alive */
+		cResult ReadSnapshot(Snapshot::cReader& io_reader);
+		void ApplySnapshot();
+
+
+		// Implementation
+		//=========================
+
+	private:
+
+		void CollectDynamicBodies();
+		/* Bodies are owned by the game and lie all over the heap, so copying them for a snapshot waits on memory
+		 * unless they are fetched a few bodies ahead. Does nothing past the last body */
+		void PrefetchBody(const size_t i_index) const;
+
+		// Each of these only touches bodies in [i_begin, i_end)
+		void Gather(const size_t i_begin, const size_t i_end, const float i_secondCountToIntegrate);
+		void IntegrateBatch(const size_t i_begin, const size_t i_end, const float i_secondCountToIntegrate);
+		void Scatter(const size_t i_begin, const size_t i_end);
+
+
+		// Data
+		//=========================
+
+	private:
+
+		using tFloatArray = std::vector<float, sAlignedAllocator<float, 32>>;
+
+		// Bodies per parallel task, a multiple of 4 to keep the SIMD loop aligned
+		static constexpr size_t s_integrationChunkSize = 1024;
+
+		struct sSlot
+		{
+			uint32_t index = 0;
+			uint32_t generation = 0;
+		};
+
+		// A snapshot copies each body in one piece, from its position up to its sleep position. The motion state
+		// comes first, up to the mass, and the sleep state last. Mass, material and flags in between are not read back
+		static constexpr size_t s_motionStateSize = offsetof(sRigidBodyState, mass);
+		static constexpr size_t s_sleepStateOffset = offsetof(sRigidBodyState, isSleeping);
+		static constexpr size_t s_sleepTimeOffset = offsetof(sRigidBodyState, sleepTime);
+		static constexpr size_t s_bodySnapshotSize = offsetof(sRigidBodyState, sleepPosition) + sizeof(Math::sVector);
+		static constexpr size_t s_snapshotPrefetchDistance = 8;
+
+		// Handle slots point into the packed body list. Removed slots are reused
+		std::vector<sSlot> m_slots;
+		std::vector<uint32_t> m_freeSlots;
+
+		// Packed list of all bodies, removal swaps with the last body
+		std::vector<sRigidBodyState*> m_rigidBodies;
+		std::vector<uint32_t> m_slotOfBody;
+
+		// Bodies of the snapshot that was read last, still in the buffer of its reader
+		const uint8_t* m_snapshotBodies = nullptr;
+
+		// Awake dynamic bodies of the current step, the arrays keep their capacity between steps
+		std::vector<sRigidBodyState*> m_dynamicBodies;
+
+		tFloatArray m_positionX, m_positionY, m_positionZ;
+		tFloatArray m_velocityX, m_velocityY, m_velocityZ;
+		tFloatArray m_accelerationX, m_accelerationY, m_accelerationZ;
+		tFloatArray m_orientationW, m_orientationX, m_orientationY, m_orientationZ;
+
+		// Rotation of this step, built from the angular velocity during the gather
+		tFloatArray m_rotationW, m_rotationX, m_rotationY, m_rotationZ;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
@@ -0,0 +1,407 @@
+// Includes
+//=========
+
+#include <Engine/Logging/Logging.h>
+#include <Engine/Physics/cSpatialHash.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+
+
+// Helper Definitions
+//============
+
+namespace
+{
+	// Cell coordinates are stored in 20 bits each, cells further out than this are clamped to the border cells
+	constexpr int32_t s_coordinateBias = 1 << 19;
+	constexpr int32_t s_maxCoordinate = s_coordinateBias - 1;
+
+	constexpr uint32_t s_emptySlot = UINT32_MAX;
+
+	bool IsFinite(const eae6320::Math::sVector& i_vector)
+	{
+		return std::isfinite(i_vector.x) && std::isfinite(i_vector.y) && std::isfinite(i_vector.z);
+	}
+}
+
+
+
+// cSpatialHash Implementation
+//==================
+
+void eae6320::Physics::cSpatialHash::SetCellSize(float i_cellSize)
+{
+	if (i_cellSize <= 0.0f)
+	{
+		Logging::OutputError("Physics::cSpatialHash: The cell size has to be positive");
+		return;
+	}
+
+	m_cellSize = i_cellSize;
+}
+
+
+float eae6320::Physics::cSpatialHash::GetCellSize() const
+{
+	return m_cellSize;
+}
+
+
+void eae6320::Physics::cSpatialHash::Add(cCollider* i_collider)
+{
+	if (m_proxyIndices.find(i_collider) != m_proxyIndices.end())
+		return;
+
+	// The new proxy joins the grid at the next Update()
+	m_proxyIndices[i_collider] = static_cast<uint32_t>(m_proxies.size());
+	m_proxies.push_back(sSpatialHashProxy());
+	m_proxies.back().collider = i_collider;
+}
+
+
+void eae6320::Physics::cSpatialHash::Remove(cCollider* i_collider)
+{
+	auto iter = m_proxyIndices.find(i_collider);
+	if (iter == m_proxyIndices.end())
+	{
+		Logging::OutputError("Physics::cSpatialHash: Trying to remove a non-existed collider");
+		return;
+	}
+
+	// Swap with the last proxy and pop
+	const uint32_t index = iter->second;
+	const uint32_t lastIndex = static_cast<uint32_t>(m_proxies.size() - 1);
+	if (index != lastIndex)
+	{
+		m_proxies[index] = m_proxies[lastIndex];
+		m_proxyIndices[m_proxies[index].collider] = index;
+	}
+
+	m_proxies.pop_back();
+	m_proxyIndices.erase(iter);
+
+	// The entries refer to proxies by index, so the grid is empty until the next Update()
+	m_entries.clear();
+	m_cells.clear();
+	m_levelMask = 0;
+}
+
+
+void eae6320::Physics::cSpatialHash::Update()
+{
+	// Cache the extents and levels, and emit an entry for every cell each proxy touches
+	m_entries.clear();
+	m_levelMask = 0;
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(m_proxies.size()); i++)
+	{
+		sSpatialHashProxy& proxy = m_proxies[i];
+		proxy.minExtent = proxy.collider->GetMinExtent_world();
+		proxy.maxExtent = proxy.collider->GetMaxExtent_world();
+		// A collider that isn't anywhere gets an inverted box, which is in no cell and overlaps nothing
+		if ((IsFinite(proxy.minExtent) == false) || (IsFinite(proxy.maxExtent) == false))
+		{
+			Logging::OutputError("Physics::cSpatialHash: A collider has non-finite extents and is left out of the grid");
+			proxy.minExtent = Math::sVector(FLT_MAX, FLT_MAX, FLT_MAX);
+			proxy.maxExtent = Math::sVector(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		}
+		proxy.level = GetLevel(proxy.minExtent, proxy.maxExtent);
+		m_levelMask |= 1u << proxy.level;
+
+		const int32_t minX = GetCoordinate(proxy.minExtent.x, proxy.level), maxX = GetCoordinate(proxy.maxExtent.x, proxy.level);
+		const int32_t minY = GetCoordinate(proxy.minExtent.y, proxy.level), maxY = GetCoordinate(proxy.maxExtent.y, proxy.level);
+		const int32_t minZ = GetCoordinate(proxy.minExtent.z, proxy.level), maxZ = GetCoordinate(proxy.maxExtent.z, proxy.level);
+
+		for (int32_t x = minX; x <= maxX; x++)
+		{
+			for (int32_t y = minY; y <= maxY; y++)
+			{
+				for (int32_t z = minZ; z <= maxZ; z++)
+				{
+					m_entries.push_back({ MakeCellKey(proxy.level, x, y, z), i });
+				}
+			}
+		}
+	}
+
+	// Sorting by key groups the entries of each cell, and by proxy index within a cell
+	// so that the pairs come out in the same order every run
+	std::sort(m_entries.begin(), m_entries.end());
+
+	// One cell per run of equal keys
+	m_cells.clear();
+	for (uint32_t i = 0; i < static_cast<uint32_t>(m_entries.size()); i++)
+	{
+		const uint64_t key = m_entries[i].first;
+
+		if (m_cells.empty() || m_cells.back().key != key)
+		{
+			sSpatialHashCell cell;
+			cell.key = key;
+			cell.level = static_cast<uint32_t>(key >> 60);
+			cell.coordinates[0] = static_cast<int32_t>((key >> 40) & 0xfffff) - s_coordinateBias;
+			cell.coordinates[1] = static_cast<int32_t>((key >> 20) & 0xfffff) - s_coordinateBias;
+			cell.coordinates[2] = static_cast<int32_t>(key & 0xfffff) - s_coordinateBias;
+			cell.begin = i;
+			m_cells.push_back(cell);
+		}
+
+		m_cells.back().count++;
+	}
+
+	BuildCellTable();
+}
+
+
+size_t eae6320::Physics::cSpatialHash::GetColliderCount() const
+{
+	return m_proxies.size();
+}
+
+
+size_t eae6320::Physics::cSpatialHash::GetCellCount() const
+{
+	return m_cells.size();
+}
+
+
+size_t eae6320::Physics::cSpatialHash::GetProxyCount() const
+{
+	return m_proxies.size();
+}
+
+
+void eae6320::Physics::cSpatialHash::ComputeCellPairs(size_t i_cellBegin, size_t i_cellEnd, std::vector<std::pair<cCollider*, cCollider*>>& o_pairs) const
+{
+	for (size_t c = i_cellBegin; c < i_cellEnd; c++)
+	{
+		const sSpatialHashCell& cell = m_cells[c];
+		const uint32_t end = cell.begin + cell.count;
+
+		for (uint32_t i = cell.begin; i < end; i++)
+		{
+			const sSpatialHashProxy& proxy0 = m_proxies[m_entries[i].second];
+
+			for (uint32_t j = i + 1; j < end; j++)
+			{
+				const sSpatialHashProxy& proxy1 = m_proxies[m_entries[j].second];
+
+				if (proxy0.maxExtent.x < proxy1.minExtent.x || proxy1.maxExtent.x < proxy0.minExtent.x ||
+					proxy0.maxExtent.y < proxy1.minExtent.y || proxy1.maxExtent.y < proxy0.minExtent.y ||
+					proxy0.maxExtent.z < proxy1.minExtent.z || proxy1.maxExtent.z < proxy0.minExtent.z)
+					continue;
+
+				if (IsReportingCell(cell, proxy0.minExtent, proxy1.minExtent) && proxy0.collider->CanCollideWith(proxy1.collider))
+					o_pairs.push_back({ proxy0.collider, proxy1.collider });
+			}
+		}
+	}
+}
+
+
+void eae6320::Physics::cSpatialHash::ComputeLevelPairs(size_t i_proxyBegin, size_t i_proxyEnd, std::vector<std::pair<cCollider*, cCollider*>>& o_pairs) const
+{
+	for (size_t p = i_proxyBegin; p < i_proxyEnd; p++)
+	{
+		const sSpatialHashProxy& proxy0 = m_proxies[p];
+
+		// Only the larger levels, the pairs of the same level are found in the shared cells
+		for (uint32_t level = proxy0.level + 1; level < s_levelCount; level++)
+		{
+			if ((m_levelMask & (1u << level)) == 0)
+				continue;
+
+			const int32_t minX = GetCoordinate(proxy0.minExtent.x, level), maxX = GetCoordinate(proxy0.maxExtent.x, level);
+			const int32_t minY = GetCoordinate(proxy0.minExtent.y, level), maxY = GetCoordinate(proxy0.maxExtent.y, level);
+			const int32_t minZ = GetCoordinate(proxy0.minExtent.z, level), maxZ = GetCoordinate(proxy0.maxExtent.z, level);
+
+			for (int32_t x = minX; x <= maxX; x++)
+			{
+				for (int32_t y = minY; y <= maxY; y++)
+				{
+					for (int32_t z = minZ; z <= maxZ; z++)
+					{
+						const uint32_t cellIndex = FindCell(MakeCellKey(level, x, y, z));
+						if (cellIndex == s_emptySlot)
+							continue;
+
+						const sSpatialHashCell& cell = m_cells[cellIndex];
+						for (uint32_t i = cell.begin; i < cell.begin + cell.count; i++)
+						{
+							const sSpatialHashProxy& proxy1 = m_proxies[m_entries[i].second];
+
+							if (proxy0.maxExtent.x < proxy1.minExtent.x || proxy1.maxExtent.x < proxy0.minExtent.x ||
+								proxy0.maxExtent.y < proxy1.minExtent.y || proxy1.maxExtent.y < proxy0.minExtent.y ||
+								proxy0.maxExtent.z < proxy1.minExtent.z || proxy1.maxExtent.z < proxy0.minExtent.z)
+								continue;
+
+							if (IsReportingCell(cell, proxy0.minExtent, proxy1.minExtent) && proxy0.collider->CanCollideWith(proxy1.collider))
+								o_pairs.push_back({ proxy0.collider, proxy1.collider });
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+
+void eae6320::Physics::cSpatialHash::Query(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, std::vector<cCollider*>& o_colliders) const
+{
+	if ((IsFinite(i_minExtent) == false) || (IsFinite(i_maxExtent) == false))
+		return;
+
+	for (uint32_t level = 0; level < s_levelCount; level++)
+	{
+		if ((m_levelMask & (1u << level)) == 0)
+			continue;
+
+		const int32_t minX = GetCoordinate(i_minExtent.x, level), maxX = GetCoordinate(i_maxExtent.x, level);
+		const int32_t minY = GetCoordinate(i_minExtent.y, level), maxY = GetCoordinate(i_maxExtent.y, level);
+		const int32_t minZ = GetCoordinate(i_minExtent.z, level), maxZ = GetCoordinate(i_maxExtent.z, level);
+
+		auto visitCell = [this, &i_minExtent, &i_maxExtent, &o_colliders](const sSpatialHashCell& i_cell)
+		{
+			for (uint32_t i = i_cell.begin; i < i_cell.begin + i_cell.count; i++)
+			{
+				const sSpatialHashProxy& proxy = m_proxies[m_entries[i].second];
+
+				if (proxy.maxExtent.x < i_minExtent.x || i_maxExtent.x < proxy.minExtent.x ||
+					proxy.maxExtent.y < i_minExtent.y || i_maxExtent.y < proxy.minExtent.y ||
+					proxy.maxExtent.z < i_minExtent.z || i_maxExtent.z < proxy.minExtent.z)
+					continue;
+
+				if (IsReportingCell(i_cell, i_minExtent, proxy.minExtent))
+					o_colliders.push_back(proxy.collider);
+			}
+		};
+
+		// A box that covers more cells than are occupied is faster to test against the occupied cells
+		const uint64_t rangeCellCount =
+			static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxY - minY + 1) * static_cast<uint64_t>(maxZ - minZ + 1);
+
+		if (rangeCellCount > m_cells.size())
+		{
+			for (const sSpatialHashCell& cell : m_cells)
+			{
+				if (cell.level == level &&
+					cell.coordinates[0] >= minX && cell.coordinates[0] <= maxX &&
+					cell.coordinates[1] >= minY && cell.coordinates[1] <= maxY &&
+					cell.coordinates[2] >= minZ && cell.coordinates[2] <= maxZ)
+					visitCell(cell);
+			}
+			continue;
+		}
+
+		for (int32_t x = minX; x <= maxX; x++)
+		{
+			for (int32_t y = minY; y <= maxY; y++)
+			{
+				for (int32_t z = minZ; z <= maxZ; z++)
+				{
+					const uint32_t cellIndex = FindCell(MakeCellKey(level, x, y, z));
+					if (cellIndex != s_emptySlot)
+						visitCell(m_cells[cellIndex]);
+				}
+			}
+		}
+	}
+}
+
+
+uint32_t eae6320::Physics::cSpatialHash::GetLevel(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const
+{
+	const Math::sVector size = i_maxExtent - i_minExtent;
+	const float maxSize = std::max(size.x, std::max(size.y, size.z));
+
+	uint32_t level = 0;
+	float cellSize = m_cellSize;
+	while (maxSize > cellSize && level < s_levelCount - 1)
+	{
+		cellSize *= 2.0f;
+		level++;
+	}
+
+	return level;
+}
+
+
+int32_t eae6320::Physics::cSpatialHash::GetCoordinate(float i_position, uint32_t i_level) const
+{
+	const float coordinate = std::floor(i_position / (m_cellSize * static_cast<float>(1u << i_level)));
+
+	// Written so that NaN fails both comparisons and never reaches the cast
+	if ((coordinate >= -static_cast<float>(s_maxCoordinate)) == false)
+		return -s_maxCoordinate;
+	if ((coordinate <= static_cast<float>(s_maxCoordinate)) == false)
+		return s_maxCoordinate;
+
+	return static_cast<int32_t>(coordinate);
+}
+
+
+uint64_t eae6320::Physics::cSpatialHash::MakeCellKey(uint32_t i_level, int32_t i_x, int32_t i_y, int32_t i_z)
+{
+	return (static_cast<uint64_t>(i_level) << 60) |
+		(static_cast<uint64_t>(i_x + s_coordinateBias) << 40) |
+		(static_cast<uint64_t>(i_y + s_coordinateBias) << 20) |
+		static_cast<uint64_t>(i_z + s_coordinateBias);
+}
+
+
+void eae6320::Physics::cSpatialHash::BuildCellTable()
+{
+	// Keep the load factor under 1/2. The table only grows, so a scene of a steady size never reallocates it
+	size_t capacity = 64;
+	while (capacity < m_cells.size() * 2)
+	{
+		capacity *= 2;
+	}
+
+	if (m_cellTable.size() < capacity)
+		m_cellTable.resize(capacity);
+	std::fill(m_cellTable.begin(), m_cellTable.end(), s_emptySlot);
+
+	const size_t mask = m_cellTable.size() - 1;
+	for (uint32_t i = 0; i < static_cast<uint32_t>(m_cells.size()); i++)
+	{
+		// Fibonacci hashing
+		size_t slot = static_cast<size_t>((m_cells[i].key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+		while (m_cellTable[slot] != s_emptySlot)
+		{
+			slot = (slot + 1) & mask;
+		}
+
+		m_cellTable[slot] = i;
+	}
+}
+
+
+uint32_t eae6320::Physics::cSpatialHash::FindCell(uint64_t i_key) const
+{
+	if (m_cells.empty())
+		return s_emptySlot;
+
+	const size_t mask = m_cellTable.size() - 1;
+	for (size_t slot = static_cast<size_t>((i_key * 0x9E3779B97F4A7C15ull) >> 32) & mask; m_cellTable[slot] != s_emptySlot; slot = (slot + 1) & mask)
+	{
+		if (m_cells[m_cellTable[slot]].key == i_key)
+			return m_cellTable[slot];
+	}
+
+	return s_emptySlot;
+}
+
+
+bool eae6320::Physics::cSpatialHash::IsReportingCell(const sSpatialHashCell& i_cell,
+	const Math::sVector& i_minExtent0, const Math::sVector& i_minExtent1) const
+{
+	const Math::sVector corner = Math::Max(i_minExtent0, i_minExtent1);
+
+	return GetCoordinate(corner.x, i_cell.level) == i_cell.coordinates[0] &&
+		GetCoordinate(corner.y, i_cell.level) == i_cell.coordinates[1] &&
+		GetCoordinate(corner.z, i_cell.level) == i_cell.coordinates[2];
+}
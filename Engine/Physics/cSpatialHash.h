@@ -0,0 +1,157 @@
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Math/sVector.h>
+#include <Engine/Physics/cColliderBase.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+// Spatial Hash Default Setting
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+#define DEFAULT_SPATIAL_HASH_CELL_SIZE 2.0f
+
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Spatial Hash Data
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* A registered collider, along with its world extents and level cached at the beginning of each update */
+	struct sSpatialHashProxy
+	{
+		cCollider* collider = nullptr;
+
+		Math::sVector minExtent;
+		Math::sVector maxExtent;
+
+		uint32_t level = 0;
+	};
+
+	/* One occupied cell. Its proxies are the range [begin, begin + count) of the sorted entries */
+	struct sSpatialHashCell
+	{
+		uint64_t key = 0;
+		int32_t coordinates[3] = { 0, 0, 0 };
+		uint32_t level = 0;
+
+		uint32_t begin = 0;
+		uint32_t count = 0;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Spatial Hash Class Declaration
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Hashed uniform grid over several levels. The cells of level L are 2^L times as large as the cells of
+	 * level 0, and every collider goes to the lowest level whose cells are at least as large as the collider,
+	 * so it touches at most 2 cells per axis no matter how large it is. Colliders are paired with the colliders
+	 * in the same cells of their own level, and with the colliders of the larger levels in the cells around them.
+	 * The grid is rebuilt by every update into buffers that keep their capacity, so once the scene stops
+	 * growing neither the update nor the queries allocate. */
+	class cSpatialHash
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		cSpatialHash() : m_cellSize(DEFAULT_SPATIAL_HASH_CELL_SIZE) {}
+		cSpatialHash(float i_cellSize) : m_cellSize(i_cellSize) {}
+
+		/* Edge length of the cells of level 0. Objects of about this size or a bit smaller work best.
+		 * A new cell size is used from the next update on */
+		void SetCellSize(float i_cellSize);
+		float GetCellSize() const;
+
+		void Add(cCollider* i_collider);
+		void Remove(cCollider* i_collider);
+		/* Colliders with non-finite extents are logged and left out of every cell until their extents are finite again */
+		void Update();
+
+		size_t GetColliderCount() const;
+
+		/* Occupied cells and registered colliders after the last Update(), the two ranges that pairs are searched over */
+		size_t GetCellCount() const;
+		size_t GetProxyCount() const;
+
+		/* Pairs of colliders of the same level in the cells [i_cellBegin, i_cellEnd) whose world AABBs overlap and that
+		 * can collide with each other. A pair that shares several cells is only reported by one of them */
+		void ComputeCellPairs(size_t i_cellBegin, size_t i_cellEnd, std::vector<std::pair<cCollider*, cCollider*>>& o_pairs) const;
+
+		/* Same as above for the pairs of the proxies [i_proxyBegin, i_proxyEnd) with the colliders of larger levels */
+		void ComputeLevelPairs(size_t i_proxyBegin, size_t i_proxyEnd, std::vector<std::pair<cCollider*, cCollider*>>& o_pairs) const;
+
+		/* Append every collider whose world AABB, as of the last Update(), overlaps the given box to o_colliders */
+		void Query(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent, std::vector<cCollider*>& o_colliders) const;
+
+
+		// Implementation
+		//=========================
+
+	private:
+
+		uint32_t GetLevel(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const;
+		int32_t GetCoordinate(float i_position, uint32_t i_level) const;
+		static uint64_t MakeCellKey(uint32_t i_level, int32_t i_x, int32_t i_y, int32_t i_z);
+
+		void BuildCellTable();
+		/* Index of the occupied cell with the key, UINT32_MAX if the cell is empty */
+		uint32_t FindCell(uint64_t i_key) const;
+
+		/* Whether i_cell is the cell of its level that holds the min corner of the overlap of the two boxes,
+		 * which is exactly one of the cells both boxes are in */
+		bool IsReportingCell(const sSpatialHashCell& i_cell,
+			const Math::sVector& i_minExtent0, const Math::sVector& i_minExtent1) const;
+
+
+		// Data
+		//=========================
+
+	private:
+
+		// Levels above the last one are merged into it, its cells are 2^15 times as large as the cells of level 0
+		static constexpr uint32_t s_levelCount = 16;
+
+		float m_cellSize;
+		// Set of the levels that hold any collider in this update
+		uint32_t m_levelMask = 0;
+
+		std::vector<sSpatialHashProxy> m_proxies;
+		std::unordered_map<cCollider*, uint32_t> m_proxyIndices;
+
+		// (cell key, proxy index) for every cell a proxy touches, sorted by key
+		std::vector<std::pair<uint64_t, uint32_t>> m_entries;
+		std::vector<sSpatialHashCell> m_cells;
+
+		// Open addressing table from a cell key to its index in m_cells, the capacity is always a power of two
+		std::vector<uint32_t> m_cellTable;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
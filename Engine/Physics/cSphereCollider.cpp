@@ -1,6 +1,7 @@
 // Includes
 //=========
 
+#include <Engine/Physics/Collision.h>
 #include <Engine/Physics/cSphereCollider.h>
 
 #include <cmath>
@@ -54,18 +55,54 @@ float eae6320::Physics::cSphereCollider::GetRadius() const
 }
 
 
-bool eae6320::Physics::cSphereCollider::IsOverlaps(const cSphereCollider& i_other)
+bool eae6320::Physics::cSphereCollider::IsOverlaps(const cSphereCollider& i_other) const
 {
 	float centerSqDistance = Math::SqDistance(GetCentroid_world(), i_other.GetCentroid_world());
-	float radiusSqDistance = powf(m_radius + i_other.m_radius, 2);
+	float radiusDistance = m_radius + i_other.m_radius;
 
-	return centerSqDistance <= radiusSqDistance;
+	return centerSqDistance <= radiusDistance * radiusDistance;
 }
 
 
-bool eae6320::Physics::cSphereCollider::IsOverlaps(const cAABBCollider& i_other)
+bool eae6320::Physics::cSphereCollider::IsOverlaps(const cAABBCollider& i_other) const
 {
-	return i_other.GetSqDistanceTo(GetCentroid_world()) <= powf(m_radius, 2);
+	return i_other.GetSqDistanceTo(GetCentroid_world()) <= m_radius * m_radius;
+}
+
+
+bool eae6320::Physics::cSphereCollider::RayCast(const Math::sVector& i_origin, const Math::sVector& i_direction, float i_maxDistance,
+	float& o_distance, Math::sVector& o_normal) const
+{
+	return Collision::RayCastSphere(i_origin, i_direction, i_maxDistance, GetCentroid_world(), m_radius, o_distance, o_normal);
+}
+
+
+bool eae6320::Physics::cSphereCollider::SphereCast(const Math::sVector& i_origin, float i_radius, const Math::sVector& i_direction, float i_maxDistance,
+	float& o_distance, Math::sVector& o_normal) const
+{
+	// The center of the moving sphere against this sphere grown by its radius
+	return Collision::RayCastSphere(i_origin, i_direction, i_maxDistance, GetCentroid_world(), m_radius + i_radius, o_distance, o_normal);
+}
+
+
+bool eae6320::Physics::cSphereCollider::IsContainsPoint(const Math::sVector& i_point) const
+{
+	return Math::SqDistance(GetCentroid_world(), i_point) <= m_radius * m_radius;
+}
+
+
+bool eae6320::Physics::cSphereCollider::IsOverlapsSphere(const Math::sVector& i_center, float i_radius) const
+{
+	const float radiusSum = m_radius + i_radius;
+	return Math::SqDistance(GetCentroid_world(), i_center) <= radiusSum * radiusSum;
+}
+
+
+bool eae6320::Physics::cSphereCollider::IsOverlapsBox(const Math::sVector& i_minExtent, const Math::sVector& i_maxExtent) const
+{
+	const Math::sVector centroid = GetCentroid_world();
+	const Math::sVector closestPoint = Math::Min(Math::Max(centroid, i_minExtent), i_maxExtent);
+	return Math::SqDistance(closestPoint, centroid) <= m_radius * m_radius;
 }
 
 
@@ -0,0 +1,394 @@
+// Includes
+//=========
+
+#include <Engine/Logging/Logging.h>
+#include <Engine/Physics/cSweepAndPrune.h>
+
+#include <algorithm>
+
+
+
+// cSweepAndPrune Implementation
+//==================
+
+void eae6320::Physics::cSweepAndPrune::Add(cCollider* i_collider)
+{
+	if (m_boxIndices.Find(i_collider->GetID()) != nullptr)
+		return;
+
+	// Reuse a released box slot if there is one
+	uint32_t boxIndex;
+	if (m_freeBoxes.empty() == false)
+	{
+		boxIndex = m_freeBoxes.back();
+		m_freeBoxes.pop_back();
+	}
+	else
+	{
+		boxIndex = static_cast<uint32_t>(m_boxes.size());
+		m_boxes.push_back(sSAPBox());
+	}
+
+	sSAPBox& box = m_boxes[boxIndex];
+	box.collider = i_collider;
+	m_boxIndices.Insert(i_collider->GetID(), boxIndex);
+
+	// Append the endpoints to the end of each axis. The next Update() moves them
+	// into place and the swaps on the way generate the pairs of the new box
+	const Math::sVector minExtent = i_collider->GetMinExtent_world();
+	const Math::sVector maxExtent = i_collider->GetMaxExtent_world();
+	box.min[0] = minExtent.x; box.min[1] = minExtent.y; box.min[2] = minExtent.z;
+	box.max[0] = maxExtent.x; box.max[1] = maxExtent.y; box.max[2] = maxExtent.z;
+
+	for (uint8_t axis = 0; axis < 3; axis++)
+	{
+		box.endpointIndices[axis][0] = static_cast<uint32_t>(m_endpoints[axis].size());
+		box.endpointIndices[axis][1] = box.endpointIndices[axis][0] + 1;
+		m_endpoints[axis].push_back(sSAPEndpoint{ box.min[axis], boxIndex << 1 });
+		m_endpoints[axis].push_back(sSAPEndpoint{ box.max[axis], (boxIndex << 1) | 1 });
+	}
+}
+
+
+void eae6320::Physics::cSweepAndPrune::Remove(cCollider* i_collider)
+{
+	const uint32_t* const boxIndexEntry = m_boxIndices.Find(i_collider->GetID());
+	if (boxIndexEntry == nullptr)
+	{
+		Logging::OutputError("Physics::cSweepAndPrune: Trying to remove a non-existed collider");
+		return;
+	}
+
+	const uint32_t boxIndex = *boxIndexEntry;
+	m_boxIndices.Erase(i_collider->GetID());
+	sSAPBox& box = m_boxes[boxIndex];
+
+	// Mark the endpoints as removed where they are, the next Update() drops them
+	// from the arrays and keeps the relative order of the remaining endpoints
+	for (uint8_t axis = 0; axis < 3; axis++)
+	{
+		m_endpoints[axis][box.endpointIndices[axis][0]].data = s_removedEndpoint;
+		m_endpoints[axis][box.endpointIndices[axis][1]].data = s_removedEndpoint;
+	}
+	m_removedEndpointCount += 6;
+
+	// Remove all pairs that involve this box, each removal takes the box off the list
+	while (box.pairedBoxes.empty() == false)
+	{
+		RemovePair(boxIndex, box.pairedBoxes.back());
+	}
+
+	box.collider = nullptr;
+	m_freeBoxes.push_back(boxIndex);
+}
+
+
+void eae6320::Physics::cSweepAndPrune::Update()
+{
+	RemoveMarkedEndpoints();
+	UpdateBoxExtents();
+
+	SortAxis(0);
+	SortAxis(1);
+	SortAxis(2);
+}
+
+
+const std::vector<std::pair<eae6320::Physics::cCollider*, eae6320::Physics::cCollider*>>& eae6320::Physics::cSweepAndPrune::GetPairs() const
+{
+	return m_pairs;
+}
+
+
+size_t eae6320::Physics::cSweepAndPrune::GetColliderCount() const
+{
+	return m_boxIndices.GetCount();
+}
+
+
+void eae6320::Physics::cSweepAndPrune::RemoveMarkedEndpoints()
+{
+	if (m_removedEndpointCount == 0)
+		return;
+
+	// One pass per axis however many boxes were removed since the last update
+	for (uint8_t axis = 0; axis < 3; axis++)
+	{
+		auto& endpoints = m_endpoints[axis];
+
+		uint32_t count = 0;
+		for (const sSAPEndpoint endpoint : endpoints)
+		{
+			if (endpoint.data == s_removedEndpoint)
+				continue;
+
+			m_boxes[endpoint.GetBoxIndex()].endpointIndices[axis][endpoint.data & 1] = count;
+			endpoints[count++] = endpoint;
+		}
+		endpoints.resize(count);
+	}
+
+	m_removedEndpointCount = 0;
+}
+
+
+void eae6320::Physics::cSweepAndPrune::UpdateBoxExtents()
+{
+	for (sSAPBox& box : m_boxes)
+	{
+		if (box.collider == nullptr)
+			continue;
+
+		// Sleeping bodies keep the extents of the step they fell asleep in
+		if (box.collider->m_objectRigidBody != nullptr && box.collider->m_objectRigidBody->isSleeping)
+			continue;
+
+		const Math::sVector minExtent = box.collider->GetMinExtent_world();
+		const Math::sVector maxExtent = box.collider->GetMaxExtent_world();
+		box.min[0] = minExtent.x; box.min[1] = minExtent.y; box.min[2] = minExtent.z;
+		box.max[0] = maxExtent.x; box.max[1] = maxExtent.y; box.max[2] = maxExtent.z;
+	}
+
+	for (uint8_t axis = 0; axis < 3; axis++)
+	{
+		for (sSAPEndpoint& endpoint : m_endpoints[axis])
+		{
+			const sSAPBox& box = m_boxes[endpoint.GetBoxIndex()];
+			endpoint.value = endpoint.IsMax() ? box.max[axis] : box.min[axis];
+		}
+	}
+}
+
+
+void eae6320::Physics::cSweepAndPrune::SortAxis(uint8_t i_axis)
+{
+	auto& endpoints = m_endpoints[i_axis];
+	const size_t count = endpoints.size();
+
+	for (size_t i = 1; i < count; i++)
+	{
+		const sSAPEndpoint current = endpoints[i];
+		size_t j = i;
+
+		// A min endpoint goes before a max endpoint of the same value, so touching boxes count as overlapping
+		while (j > 0)
+		{
+			const sSAPEndpoint& previous = endpoints[j - 1];
+
+			const bool isLess = current.value < previous.value ||
+				(current.value == previous.value && current.IsMax() == false && previous.IsMax());
+			if (isLess == false)
+				break;
+
+			// A min moves to the left of a max: the two boxes start to overlap on this axis. Boxes whose
+			// layers reject each other never enter the pair set, so they never have to leave it either
+			if (current.IsMax() == false && previous.IsMax())
+			{
+				if (IsOverlapsOnOtherAxes(current.GetBoxIndex(), previous.GetBoxIndex(), i_axis) &&
+					m_boxes[current.GetBoxIndex()].collider->CanCollideWith(m_boxes[previous.GetBoxIndex()].collider))
+					AddPair(current.GetBoxIndex(), previous.GetBoxIndex());
+			}
+			// A max moves to the left of a min: the two boxes stop overlapping on this axis
+			else if (current.IsMax() && previous.IsMax() == false)
+			{
+				RemovePair(current.GetBoxIndex(), previous.GetBoxIndex());
+			}
+
+			endpoints[j] = previous;
+			m_boxes[previous.GetBoxIndex()].endpointIndices[i_axis][previous.data & 1] = static_cast<uint32_t>(j);
+			j--;
+		}
+
+		if (j != i)
+		{
+			endpoints[j] = current;
+			m_boxes[current.GetBoxIndex()].endpointIndices[i_axis][current.data & 1] = static_cast<uint32_t>(j);
+		}
+	}
+}
+
+
+bool eae6320::Physics::cSweepAndPrune::IsOverlapsOnOtherAxes(uint32_t i_box0, uint32_t i_box1, uint8_t i_axis) const
+{
+	const sSAPBox& box0 = m_boxes[i_box0];
+	const sSAPBox& box1 = m_boxes[i_box1];
+
+	for (uint8_t axis = 0; axis < 3; axis++)
+	{
+		if (axis == i_axis)
+			continue;
+
+		if (box0.max[axis] < box1.min[axis] || box1.max[axis] < box0.min[axis])
+			return false;
+	}
+
+	return true;
+}
+
+
+void eae6320::Physics::cSweepAndPrune::AddPair(uint32_t i_box0, uint32_t i_box1)
+{
+	const uint64_t key = MakePairKey(i_box0, i_box1);
+
+	if (m_pairIndices.Find(key) != nullptr)
+		return;
+
+	m_pairIndices.Insert(key, static_cast<uint32_t>(m_pairs.size()));
+	m_pairKeys.push_back(key);
+	m_pairs.push_back({ m_boxes[key >> 32].collider, m_boxes[key & 0xffffffff].collider });
+
+	m_boxes[i_box0].pairedBoxes.push_back(i_box1);
+	m_boxes[i_box1].pairedBoxes.push_back(i_box0);
+}
+
+
+void eae6320::Physics::cSweepAndPrune::RemovePair(uint32_t i_box0, uint32_t i_box1)
+{
+	const uint64_t key = MakePairKey(i_box0, i_box1);
+
+	const uint32_t* const indexEntry = m_pairIndices.Find(key);
+	if (indexEntry == nullptr)
+		return;
+
+	// Swap with the last pair and pop
+	const uint32_t index = *indexEntry;
+	const uint32_t lastIndex = static_cast<uint32_t>(m_pairs.size() - 1);
+	m_pairIndices.Erase(key);
+	if (index != lastIndex)
+	{
+		m_pairs[index] = m_pairs[lastIndex];
+		m_pairKeys[index] = m_pairKeys[lastIndex];
+		*m_pairIndices.Find(m_pairKeys[index]) = index;
+	}
+
+	m_pairs.pop_back();
+	m_pairKeys.pop_back();
+
+	// A box has few pairs, and the one that goes is often the last one added
+	const auto removePairedBox = [this](uint32_t i_box, uint32_t i_pairedBox)
+	{
+		auto& pairedBoxes = m_boxes[i_box].pairedBoxes;
+		*std::find(pairedBoxes.rbegin(), pairedBoxes.rend(), i_pairedBox) = pairedBoxes.back();
+		pairedBoxes.pop_back();
+	};
+	removePairedBox(i_box0, i_box1);
+	removePairedBox(i_box1, i_box0);
+}
+
+
+uint64_t eae6320::Physics::cSweepAndPrune::MakePairKey(uint32_t i_box0, uint32_t i_box1)
+{
+	return (i_box0 < i_box1) ?
+		(static_cast<uint64_t>(i_box0) << 32) | i_box1 :
+		(static_cast<uint64_t>(i_box1) << 32) | i_box0;
+}
+
+
+
+// cSAPIndexMap Implementation
+//==================
+
+uint32_t* eae6320::Physics::cSAPIndexMap::Find(uint64_t i_key)
+{
+	if (m_entries.empty())
+		return nullptr;
+
+	const size_t mask = m_entries.size() - 1;
+	for (size_t slot = GetSlot(i_key); m_entries[slot].key != 0; slot = (slot + 1) & mask)
+	{
+		if (m_entries[slot].key == i_key)
+			return &m_entries[slot].index;
+	}
+
+	return nullptr;
+}
+
+
+void eae6320::Physics::cSAPIndexMap::Insert(uint64_t i_key, uint32_t i_index)
+{
+	// Keep the load factor under 3/4
+	if ((m_count + 1) * 4 > m_entries.size() * 3)
+		Grow();
+
+	const size_t mask = m_entries.size() - 1;
+	size_t slot = GetSlot(i_key);
+	while (m_entries[slot].key != 0)
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	m_entries[slot].key = i_key;
+	m_entries[slot].index = i_index;
+	m_count++;
+}
+
+
+void eae6320::Physics::cSAPIndexMap::Erase(uint64_t i_key)
+{
+	if (m_entries.empty())
+		return;
+
+	const size_t mask = m_entries.size() - 1;
+	size_t slot = GetSlot(i_key);
+
+	while (m_entries[slot].key != i_key)
+	{
+		if (m_entries[slot].key == 0)
+			return;
+
+		slot = (slot + 1) & mask;
+	}
+
+	// Backward shift deletion, so that probing never needs tombstones
+	size_t hole = slot;
+	size_t next = (hole + 1) & mask;
+	while (m_entries[next].key != 0)
+	{
+		const size_t home = GetSlot(m_entries[next].key);
+
+		// Move the entry into the hole if its home slot is not in (hole, next]
+		const bool canMove = (hole <= next) ?
+			(home <= hole || home > next) :
+			(home <= hole && home > next);
+
+		if (canMove)
+		{
+			m_entries[hole] = m_entries[next];
+			hole = next;
+		}
+
+		next = (next + 1) & mask;
+	}
+
+	m_entries[hole] = sEntry();
+	m_count--;
+}
+
+
+size_t eae6320::Physics::cSAPIndexMap::GetCount() const
+{
+	return m_count;
+}
+
+
+size_t eae6320::Physics::cSAPIndexMap::GetSlot(uint64_t i_key) const
+{
+	// Fibonacci hashing, the capacity is always a power of two
+	return static_cast<size_t>((i_key * 0x9E3779B97F4A7C15ull) >> 32) & (m_entries.size() - 1);
+}
+
+
+void eae6320::Physics::cSAPIndexMap::Grow()
+{
+	std::vector<sEntry> oldEntries;
+	oldEntries.swap(m_entries);
+
+	m_entries.resize(oldEntries.empty() ? 64 : oldEntries.size() * 2);
+	m_count = 0;
+
+	for (const sEntry& entry : oldEntries)
+	{
+		if (entry.key != 0)
+			Insert(entry.key, entry.index);
+	}
+}
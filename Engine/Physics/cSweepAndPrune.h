@@ -0,0 +1,151 @@
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Physics/cColliderBase.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+// Sweep And Prune Data
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* One end of a box's projection on an axis. The box index and the min/max flag
+	 * are packed in one integer so an endpoint is only 8 bytes */
+	struct sSAPEndpoint
+	{
+		float value;
+		uint32_t data;
+
+		uint32_t GetBoxIndex() const { return data >> 1; }
+		bool IsMax() const { return (data & 1) != 0; }
+	};
+
+	struct sSAPBox
+	{
+		cCollider* collider = nullptr;
+
+		// World extents cached at the beginning of each update
+		float min[3] = { 0.0f, 0.0f, 0.0f };
+		float max[3] = { 0.0f, 0.0f, 0.0f };
+
+		// Where the min [0] and max [1] endpoints of the box are on each axis, kept up to date by the sort
+		uint32_t endpointIndices[3][2] = {};
+
+		// Boxes this box is in a pair with. The list keeps its capacity when the box slot is reused
+		std::vector<uint32_t> pairedBoxes;
+	};
+
+	/* Map from a nonzero 64 bit key to an index, with the same open addressing and linear probing as
+	 * cCollisionPairCache. All entries live in one flat table that only allocates when it grows */
+	class cSAPIndexMap
+	{
+	public:
+
+		/* Null if the key is not in the map. The pointer stays valid until the next Insert() or Erase() */
+		uint32_t* Find(uint64_t i_key);
+		/* The key must not be in the map yet */
+		void Insert(uint64_t i_key, uint32_t i_index);
+		void Erase(uint64_t i_key);
+
+		size_t GetCount() const;
+
+	private:
+
+		struct sEntry
+		{
+			// 0 marks an empty slot
+			uint64_t key = 0;
+			uint32_t index = 0;
+		};
+
+		size_t GetSlot(uint64_t i_key) const;
+		void Grow();
+
+		std::vector<sEntry> m_entries;
+		size_t m_count = 0;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
+
+
+// Sweep And Prune Class Declaration
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Incremental sweep and prune. The endpoint arrays persist across frames and are
+	 * re-sorted by insertion sort, which is close to linear when objects move a little
+	 * each frame. The overlapping pair set only changes when two endpoints swap.
+	 * Removing a box only visits its own endpoints and pairs, its endpoints are
+	 * marked as removed and dropped from the arrays by the next Update(). */
+	class cSweepAndPrune
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		void Add(cCollider* i_collider);
+		void Remove(cCollider* i_collider);
+		void Update();
+
+		/* Pairs whose world AABBs overlap on all three axes after the last Update(), and whose colliders can collide with each other */
+		const std::vector<std::pair<cCollider*, cCollider*>>& GetPairs() const;
+
+		size_t GetColliderCount() const;
+
+
+		// Implementation
+		//=========================
+
+	private:
+
+		void RemoveMarkedEndpoints();
+		void UpdateBoxExtents();
+		void SortAxis(uint8_t i_axis);
+
+		bool IsOverlapsOnOtherAxes(uint32_t i_box0, uint32_t i_box1, uint8_t i_axis) const;
+		void AddPair(uint32_t i_box0, uint32_t i_box1);
+		void RemovePair(uint32_t i_box0, uint32_t i_box1);
+
+		static uint64_t MakePairKey(uint32_t i_box0, uint32_t i_box1);
+
+
+		// Data
+		//=========================
+
+	private:
+
+		// The data of an endpoint whose box has been removed
+		static constexpr uint32_t s_removedEndpoint = UINT32_MAX;
+
+		std::vector<sSAPBox> m_boxes;
+		std::vector<uint32_t> m_freeBoxes;
+		// Keyed by collider id, which is never 0
+		cSAPIndexMap m_boxIndices;
+
+		std::vector<sSAPEndpoint> m_endpoints[3];
+		size_t m_removedEndpointCount = 0;
+
+		// Flat pair set, the index map gives O(1) removal by swapping with the last pair
+		std::vector<std::pair<cCollider*, cCollider*>> m_pairs;
+		std::vector<uint64_t> m_pairKeys;
+		cSAPIndexMap m_pairIndices;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
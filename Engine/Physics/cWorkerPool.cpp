@@ -0,0 +1,201 @@
+// Includes
+//=========
+
+#include <Engine/Physics/cWorkerPool.h>
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+	#define EAE6320_WORKERPOOL_X86
+
+	#include <xmmintrin.h>
+#endif
+
+
+
+// cWorkerPool Implementation
+//==================
+
+eae6320::Physics::cWorkerPool::cWorkerPool(uint32_t i_threadCount)
+{
+	SetThreadCount(i_threadCount);
+}
+
+
+eae6320::Physics::cWorkerPool::~cWorkerPool()
+{
+	Stop();
+}
+
+
+void eae6320::Physics::cWorkerPool::SetThreadCount(uint32_t i_threadCount)
+{
+	if (i_threadCount == 0)
+		i_threadCount = std::thread::hardware_concurrency();
+
+	// hardware_concurrency() returns 0 if it can't tell
+	if (i_threadCount == 0)
+		i_threadCount = 1;
+
+	if (i_threadCount == m_threadCount)
+		return;
+
+	// The new threads are started by the next ParallelFor()
+	Stop();
+	m_threadCount = i_threadCount;
+}
+
+
+uint32_t eae6320::Physics::cWorkerPool::GetThreadCount() const
+{
+	return m_threadCount;
+}
+
+
+void eae6320::Physics::cWorkerPool::SetSharesFloatingPointEnvironment(bool i_sharesEnvironment)
+{
+	m_sharesFloatingPointEnvironment = i_sharesEnvironment;
+}
+
+
+bool eae6320::Physics::cWorkerPool::GetSharesFloatingPointEnvironment() const
+{
+	return m_sharesFloatingPointEnvironment;
+}
+
+
+void eae6320::Physics::cWorkerPool::ParallelFor(size_t i_taskCount, const fTask& i_task)
+{
+	if (i_taskCount == 0)
+		return;
+
+	// Not worth waking anyone up
+	if (m_threadCount <= 1 || i_taskCount == 1)
+	{
+		for (size_t i = 0; i < i_taskCount; i++)
+		{
+			i_task(i, 0);
+		}
+		return;
+	}
+
+	if (m_threads.empty())
+		Start();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_task = &i_task;
+		m_taskCount = i_taskCount;
+		m_nextTask.store(0);
+		m_busyThreadCount = static_cast<uint32_t>(m_threads.size());
+		m_batchID++;
+
+		if (m_sharesFloatingPointEnvironment)
+			CaptureFloatingPointEnvironment();
+	}
+	m_wakeCondition.notify_all();
+
+	RunTasks(0);
+
+	// The task object lives on the caller's stack, so every thread must be done with it before returning
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneCondition.wait(lock, [this]() { return m_busyThreadCount == 0; });
+
+		m_task = nullptr;
+		m_taskCount = 0;
+	}
+}
+
+
+void eae6320::Physics::cWorkerPool::Start()
+{
+	m_isStopping = false;
+
+	// A thread may only get to run after the first batch is published, so it is told which batch it has already seen
+	for (uint32_t i = 1; i < m_threadCount; i++)
+	{
+		m_threads.emplace_back(&cWorkerPool::WorkerLoop, this, i, m_batchID);
+	}
+}
+
+
+void eae6320::Physics::cWorkerPool::Stop()
+{
+	if (m_threads.empty())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+	m_wakeCondition.notify_all();
+
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+	m_threads.clear();
+}
+
+
+void eae6320::Physics::cWorkerPool::WorkerLoop(uint32_t i_threadIndex, uint64_t i_batchID)
+{
+	uint64_t lastBatchID = i_batchID;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wakeCondition.wait(lock, [this, lastBatchID]() { return m_isStopping || m_batchID != lastBatchID; });
+
+			if (m_isStopping)
+				return;
+
+			lastBatchID = m_batchID;
+		}
+
+		RunTasks(i_threadIndex);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (--m_busyThreadCount == 0)
+				m_doneCondition.notify_one();
+		}
+	}
+}
+
+
+void eae6320::Physics::cWorkerPool::RunTasks(uint32_t i_threadIndex)
+{
+	const fTask& task = *m_task;
+	const size_t taskCount = m_taskCount;
+
+	// The calling thread already has the environment. It was captured before the batch was published, so the workers see it
+	if (i_threadIndex != 0 && m_sharesFloatingPointEnvironment)
+		ApplyFloatingPointEnvironment();
+
+	for (size_t i = m_nextTask.fetch_add(1); i < taskCount; i = m_nextTask.fetch_add(1))
+	{
+		task(i, i_threadIndex);
+	}
+}
+
+
+void eae6320::Physics::cWorkerPool::CaptureFloatingPointEnvironment()
+{
+	std::fegetenv(&m_floatingPointEnvironment);
+
+#if defined( EAE6320_WORKERPOOL_X86 )
+	m_SSEControl = _mm_getcsr();
+#endif
+}
+
+
+void eae6320::Physics::cWorkerPool::ApplyFloatingPointEnvironment() const
+{
+	std::fesetenv(&m_floatingPointEnvironment);
+
+#if defined( EAE6320_WORKERPOOL_X86 )
+	_mm_setcsr(m_SSEControl);
+#endif
+}
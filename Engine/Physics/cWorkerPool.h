@@ -0,0 +1,103 @@
+#pragma once
+
+// Includes
+//=========
+
+#include <atomic>
+#include <cfenv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Worker Pool Class Declaration
+//=============
+
+namespace eae6320
+{
+namespace Physics
+{
+
+	/* Fixed set of threads that run the parallel parts of a physics step. The threads are
+	 * started on first use and sleep between steps. The calling thread always works on the
+	 * tasks as well, so a pool of N threads only starts N - 1 of them. */
+	class cWorkerPool
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		using fTask = std::function<void(size_t i_taskIndex, uint32_t i_threadIndex)>;
+
+		/* 0 uses every hardware thread */
+		cWorkerPool(uint32_t i_threadCount = 0);
+		~cWorkerPool();
+
+		cWorkerPool(const cWorkerPool&) = delete;
+		cWorkerPool& operator =(const cWorkerPool&) = delete;
+
+		/* Counts the calling thread. 0 uses every hardware thread, 1 runs every task on the calling thread */
+		void SetThreadCount(uint32_t i_threadCount);
+		uint32_t GetThreadCount() const;
+
+		/* Workers switch to the floating point environment (rounding mode, and on x86 the denormal flushing of SSE)
+		 * of the thread that calls ParallelFor() before they run its tasks, so the results of a task don't depend
+		 * on which thread picked it up */
+		void SetSharesFloatingPointEnvironment(bool i_sharesEnvironment);
+		bool GetSharesFloatingPointEnvironment() const;
+
+		/* Run i_task for every task index in [0, i_taskCount) and block until all of them are done.
+		 * Tasks are handed out in order but may finish in any order. i_threadIndex is in [0, GetThreadCount())
+		 * and is 0 for the calling thread, so tasks can write to per-thread buffers without locking */
+		void ParallelFor(size_t i_taskCount, const fTask& i_task);
+
+
+		// Implementation
+		//=========================
+
+	private:
+
+		void Start();
+		void Stop();
+
+		void WorkerLoop(uint32_t i_threadIndex, uint64_t i_batchID);
+		void RunTasks(uint32_t i_threadIndex);
+
+		void CaptureFloatingPointEnvironment();
+		void ApplyFloatingPointEnvironment() const;
+
+
+		// Data
+		//=========================
+
+	private:
+
+		uint32_t m_threadCount = 1;
+		std::vector<std::thread> m_threads;
+
+		std::mutex m_mutex;
+		std::condition_variable m_wakeCondition;
+		std::condition_variable m_doneCondition;
+
+		// The batch currently being run, guarded by m_mutex except for the task counter
+		const fTask* m_task = nullptr;
+		size_t m_taskCount = 0;
+		std::atomic<size_t> m_nextTask{ 0 };
+		uint64_t m_batchID = 0;
+		uint32_t m_busyThreadCount = 0;
+		bool m_isStopping = false;
+
+		bool m_sharesFloatingPointEnvironment = false;
+		// Environment of the calling thread for the current batch. The flush-to-zero and denormals-are-zero
+		// bits of SSE aren't part of the standard environment, so on x86 the whole control register is copied too
+		std::fenv_t m_floatingPointEnvironment;
+		uint32_t m_SSEControl = 0;
+	};
+
+}// Namespace Physics
+}// Namespace eae6320
@@ -27,11 +27,13 @@ PFNGLACTIVETEXTUREPROC glActiveTexture = nullptr;
 PFNGLATTACHSHADERPROC glAttachShader = nullptr;
 PFNGLBINDBUFFERPROC glBindBuffer = nullptr;
 PFNGLBINDBUFFERBASEPROC glBindBufferBase = nullptr;
+PFNGLBINDBUFFERRANGEPROC glBindBufferRange = nullptr;
 PFNGLBINDSAMPLERPROC glBindSampler = nullptr;
 PFNGLBINDVERTEXARRAYPROC glBindVertexArray = nullptr;
 PFNGLBLENDEQUATIONPROC glBlendEquation = nullptr;
 PFNGLBUFFERDATAPROC glBufferData = nullptr;
 PFNGLBUFFERSUBDATAPROC glBufferSubData = nullptr;
+PFNGLCLIENTWAITSYNCPROC glClientWaitSync = nullptr;
 PFNGLCOMPILESHADERPROC glCompileShader = nullptr;
 PFNGLCOMPRESSEDTEXIMAGE2DPROC glCompressedTexImage2D = nullptr;
 PFNGLCREATEPROGRAMPROC glCreateProgram = nullptr;
@@ -40,8 +42,11 @@ PFNGLDELETEBUFFERSPROC glDeleteBuffers = nullptr;
 PFNGLDELETEPROGRAMPROC glDeleteProgram = nullptr;
 PFNGLDELETESAMPLERSPROC glDeleteSamplers = nullptr;
 PFNGLDELETESHADERPROC glDeleteShader = nullptr;
+PFNGLDELETESYNCPROC glDeleteSync = nullptr;
 PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced = nullptr;
 PFNGLENABLEVERTEXATTRIBARRAYARBPROC glEnableVertexAttribArray = nullptr;
+PFNGLFENCESYNCPROC glFenceSync = nullptr;
 PFNGLGENBUFFERSPROC glGenBuffers = nullptr;
 PFNGLGENSAMPLERSPROC glGenSamplers = nullptr;
 PFNGLGENVERTEXARRAYSPROC glGenVertexArrays = nullptr;
@@ -52,6 +57,7 @@ PFNGLGETSHADERIVPROC glGetShaderiv = nullptr;
 PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = nullptr;
 PFNGLINVALIDATEBUFFERDATAPROC glInvalidateBufferData = nullptr;
 PFNGLLINKPROGRAMPROC glLinkProgram = nullptr;
+PFNGLMAPBUFFERRANGEPROC glMapBufferRange = nullptr;
 PFNGLSAMPLERPARAMETERIPROC glSamplerParameteri = nullptr;
 PFNGLSHADERSOURCEPROC glShaderSource = nullptr;
 PFNGLUSEPROGRAMPROC glUseProgram = nullptr;
@@ -62,6 +68,7 @@ PFNGLUNIFORM3FVPROC glUniform3fv = nullptr;
 PFNGLUNIFORM4FVPROC glUniform4fv = nullptr;
 PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding = nullptr;
 PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv = nullptr;
+PFNGLUNMAPBUFFERPROC glUnmapBuffer = nullptr;
 PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = nullptr;
 PFNWGLCHOOSEPIXELFORMATARBPROC wglChoosePixelFormatARB = nullptr;
 PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB = nullptr;
@@ -116,11 +123,13 @@ eae6320::cResult eae6320::OpenGlExtensions::Load( std::string* const o_errorMess
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glAttachShader, PFNGLATTACHSHADERPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindBuffer, PFNGLBINDBUFFERPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindBufferBase, PFNGLBINDBUFFERBASEPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindBufferRange, PFNGLBINDBUFFERRANGEPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindSampler, PFNGLBINDSAMPLERPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindVertexArray, PFNGLBINDVERTEXARRAYPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBlendEquation, PFNGLBLENDEQUATIONPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBufferData, PFNGLBUFFERDATAPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBufferSubData, PFNGLBUFFERSUBDATAPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glClientWaitSync, PFNGLCLIENTWAITSYNCPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glCompileShader, PFNGLCOMPILESHADERPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glCompressedTexImage2D, PFNGLCOMPRESSEDTEXIMAGE2DPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glCreateProgram, PFNGLCREATEPROGRAMPROC );
@@ -130,7 +139,10 @@ eae6320::cResult eae6320::OpenGlExtensions::Load( std::string* const o_errorMess
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteSamplers, PFNGLDELETESAMPLERSPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteShader, PFNGLDELETESHADERPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteSync, PFNGLDELETESYNCPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDrawElementsInstanced, PFNGLDRAWELEMENTSINSTANCEDPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glEnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYARBPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glFenceSync, PFNGLFENCESYNCPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGenBuffers, PFNGLGENBUFFERSPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGenSamplers, PFNGLGENSAMPLERSPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGenVertexArrays, PFNGLGENVERTEXARRAYSPROC );
@@ -141,6 +153,7 @@ eae6320::cResult eae6320::OpenGlExtensions::Load( std::string* const o_errorMess
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetUniformLocation, PFNGLGETUNIFORMLOCATIONPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glInvalidateBufferData, PFNGLINVALIDATEBUFFERDATAPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glLinkProgram, PFNGLLINKPROGRAMPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glMapBufferRange, PFNGLMAPBUFFERRANGEPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glSamplerParameteri, PFNGLSAMPLERPARAMETERIPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glShaderSource, PFNGLSHADERSOURCEPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniform1fv, PFNGLUNIFORM1FVPROC );
@@ -150,6 +163,7 @@ eae6320::cResult eae6320::OpenGlExtensions::Load( std::string* const o_errorMess
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniform4fv, PFNGLUNIFORM4FVPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniformBlockBinding, PFNGLUNIFORMBLOCKBINDINGPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUnmapBuffer, PFNGLUNMAPBUFFERPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUseProgram, PFNGLUSEPROGRAMPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glVertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( wglChoosePixelFormatARB, PFNWGLCHOOSEPIXELFORMATARBPROC );
@@ -19,6 +19,7 @@
 #include <Engine/UserOutput/UserOutput.h>
 #include <Engine/Physics/cAABBCollider.h>
 #include <Engine/Physics/Collision.h>
+#include <Engine/Physics/Physics.h>
 #include <vector>
 #include <iostream>
 
@@ -68,6 +69,8 @@ void eae6320::cMyGame::UpdateSimulationBasedOnInput()
 
 void eae6320::cMyGame::UpdateSimulationBasedOnTime(const float i_elapsedSecondCount_sinceLastUpdate)
 {
+	Physics::Update_Integration(i_elapsedSecondCount_sinceLastUpdate);
+
 	m_camera.UpdateBasedOnTime(i_elapsedSecondCount_sinceLastUpdate);
 
 	m_renderObject_triangle.UpdateBasedOnTime(i_elapsedSecondCount_sinceLastUpdate);
@@ -118,22 +121,13 @@ void eae6320::cMyGame::SubmitDataToBeRendered(
 		// Render data of render objects 
 		for (size_t i = 0; i < arraySize; i++)
 		{
-			if (m_renderObjectList[i]->GetMesh().expired() || m_renderObjectList[i]->GetEffect().expired())
-				continue;
-
 			normalRenderDataArray[i].Initialize(
-				m_renderObjectList[i]->GetMesh(), m_renderObjectList[i]->GetEffect(),
+				m_renderObjectList[i]->GetMeshHandle(), m_renderObjectList[i]->GetEffectHandle(),
 				m_renderObjectList[i]->GetPredictedTransform(i_elapsedSecondCount_sinceLastSimulationUpdate));
 		}
 
 		Graphics::SubmitNormalRenderData(normalRenderDataArray, static_cast<uint32_t>(arraySize));
 
-		// clean up 
-		for (size_t i = 0; i < arraySize; i++)
-		{
-			normalRenderDataArray[i].CleanUp();
-		}
-
 		delete[] normalRenderDataArray;
 	}
 
@@ -152,9 +146,6 @@ void eae6320::cMyGame::SubmitDataToBeRendered(
 		{
 			auto collider = m_colliderObjectList[i];
 
-			if (collider->GetColliderLine().expired())
-				continue;
-
 			debugDataArray[i].Initialize(collider->GetColliderLine(), collider->GetPredictedTransform(i_elapsedSecondCount_sinceLastSimulationUpdate));
 		}
 
@@ -162,21 +153,12 @@ void eae6320::cMyGame::SubmitDataToBeRendered(
 		int idx = 0;
 		for (auto iter = BVHRenderData.begin(); iter != BVHRenderData.end(); iter++)
 		{
-			if (iter->first.expired())
-				continue;
-
 			debugDataArray[idx].Initialize(iter->first, iter->second);
 			idx++;
 		}
 
 		Graphics::SubmitDebugRenderData(debugDataArray, static_cast<uint32_t>(totalArraySize));
 
-		// Clean up
-		for (size_t i = 0; i < totalArraySize; i++)
-		{
-			debugDataArray[i].CleanUp();
-		}
-
 		delete[] debugDataArray;
 	}
 }
@@ -121,11 +121,9 @@ void eae6320::cPhysicDebugObject::InitializeColliderLine()
 }
 
 
-std::weak_ptr<eae6320::Graphics::cLine> eae6320::cPhysicDebugObject::GetColliderLine() const
+eae6320::Graphics::cRenderHandle<eae6320::Graphics::cLine> eae6320::cPhysicDebugObject::GetColliderLine() const
 {
-	if (m_isCollide)
-		return m_collisionLine;
-	else
-		return m_colliderLine;
+	const auto& line = m_isCollide ? m_collisionLine : m_colliderLine;
+	return line ? line->GetHandle() : Graphics::cRenderHandle<Graphics::cLine>();
 }
 
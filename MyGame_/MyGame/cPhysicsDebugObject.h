@@ -23,7 +23,7 @@ namespace eae6320
 
 		void InitializeColliderLine();
 
-		std::weak_ptr<eae6320::Graphics::cLine> GetColliderLine() const;
+		eae6320::Graphics::cRenderHandle<eae6320::Graphics::cLine> GetColliderLine() const;
 
 		void SetIsCollide(bool isCollide)
 		{
@@ -8,6 +8,7 @@
 
 #include <ScrollShooterGame_/ScrollShooterGame/Bullet/cBullet.Enemy.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Bullet/cBullet.Player.h>
+#include <ScrollShooterGame_/ScrollShooterGame/CollisionLayers.h>
 #include <ScrollShooterGame_/ScrollShooterGame/cPlayer.h>
 #include <ScrollShooterGame_/ScrollShooterGame/cScrollShooterGame.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Enemy/cEnemy.Rock.h>
@@ -33,6 +34,10 @@ void ScrollShooterGame::cBullet_Enemy::Initialize(
 	{
 		Physics::sColliderSetting setting_sphere;
 		setting_sphere.SettingForSphere(Math::sVector(0, 0, 0), 0.3f);
+		// Bullets cover more than their own size in one step
+		setting_sphere.isContinuous = true;
+		setting_sphere.category = CollisionLayer::EnemyBullet;
+		setting_sphere.mask = CollisionLayer::EnemyBulletMask;
 		InitializeCollider(setting_sphere);
 		InitializeColliderLine();
 	}
@@ -6,6 +6,7 @@
 
 #include <ScrollShooterGame_/ScrollShooterGame/Bullet/cBullet.Enemy.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Bullet/cBullet.Player.h>
+#include <ScrollShooterGame_/ScrollShooterGame/CollisionLayers.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Enemy/cEnemy.h>
 #include <ScrollShooterGame_/ScrollShooterGame/cScrollShooterGame.h>
 
@@ -33,6 +34,10 @@ void ScrollShooterGame::cBullet_Player::Initialize(
 	{
 		Physics::sColliderSetting setting_sphere;
 		setting_sphere.SettingForSphere(Math::sVector(0, 0, 0), 0.45f);
+		// Bullets cover more than their own size in one step
+		setting_sphere.isContinuous = true;
+		setting_sphere.category = CollisionLayer::PlayerBullet;
+		setting_sphere.mask = CollisionLayer::PlayerBulletMask;
 		InitializeCollider(setting_sphere);
 		InitializeColliderLine();
 	}
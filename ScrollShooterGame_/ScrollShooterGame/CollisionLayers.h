@@ -0,0 +1,37 @@
+#pragma once
+
+// Includes
+//========
+
+#include <cstdint>
+
+
+// Collision Layers
+//=============
+
+namespace ScrollShooterGame
+{
+namespace CollisionLayer
+{
+
+	// Categories
+	//-------------
+
+	constexpr uint32_t Player		= 1 << 0;
+	constexpr uint32_t PlayerBullet	= 1 << 1;
+	constexpr uint32_t Enemy		= 1 << 2;
+	constexpr uint32_t EnemyBullet	= 1 << 3;
+	constexpr uint32_t Generator	= 1 << 4;
+
+	// Masks
+	//-------------
+	// Bullets never hit bullets of the same side, and the enemy generator only spawns enemies
+
+	constexpr uint32_t PlayerMask		= Enemy | EnemyBullet;
+	constexpr uint32_t PlayerBulletMask	= Enemy | EnemyBullet;
+	constexpr uint32_t EnemyMask		= Player | PlayerBullet | Enemy | EnemyBullet;
+	constexpr uint32_t EnemyBulletMask	= Player | PlayerBullet | Enemy;
+	constexpr uint32_t GeneratorMask	= 0;
+
+}// Namespace CollisionLayer
+}// Namespace ScrollShooterGame
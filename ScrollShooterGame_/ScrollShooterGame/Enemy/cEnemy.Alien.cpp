@@ -9,6 +9,7 @@
 
 #include <ScrollShooterGame_/ScrollShooterGame/Bullet/cBullet.Enemy.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Bullet/cBullet.Player.h>
+#include <ScrollShooterGame_/ScrollShooterGame/CollisionLayers.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Enemy/cEnemy.Alien.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Enemy/cEnemy.Rock.h>
 #include <ScrollShooterGame_/ScrollShooterGame/cPlayer.h>
@@ -53,6 +54,8 @@ void ScrollShooterGame::cEnemy_Alien::Initialize(
 	{
 		Physics::sColliderSetting setting_AABB;
 		setting_AABB.SettingForAABB(Math::sVector(-0.5f, -0.5f, -0.5f), Math::sVector(0.5f, 0.5f, 0.5f));
+		setting_AABB.category = CollisionLayer::Enemy;
+		setting_AABB.mask = CollisionLayer::EnemyMask;
 		InitializeCollider(setting_AABB);
 		InitializeColliderLine();
 	}
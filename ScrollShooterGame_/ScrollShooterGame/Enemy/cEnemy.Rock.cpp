@@ -5,6 +5,7 @@
 #include <Engine/Audio/Audio.h>
 
 #include <ScrollShooterGame_/ScrollShooterGame/Bullet/cBullet.Player.h>
+#include <ScrollShooterGame_/ScrollShooterGame/CollisionLayers.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Enemy/cEnemy.Alien.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Enemy/cEnemy.Rock.h>
 #include <ScrollShooterGame_/ScrollShooterGame/cPlayer.h>
@@ -40,6 +41,8 @@ void ScrollShooterGame::cEnemy_Rock::Initialize(
 	{
 		Physics::sColliderSetting setting_sphere;
 		setting_sphere.SettingForSphere(Math::sVector(0, 0, 0), 0.5f);
+		setting_sphere.category = CollisionLayer::Enemy;
+		setting_sphere.mask = CollisionLayer::EnemyMask;
 		InitializeCollider(setting_sphere);
 		InitializeColliderLine();
 	}
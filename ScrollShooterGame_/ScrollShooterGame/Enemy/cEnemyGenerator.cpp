@@ -8,6 +8,7 @@
 #include <Engine/Time/Time.h>
 #include <Engine/Utilities/SmartPtrs.h>
 
+#include <ScrollShooterGame_/ScrollShooterGame/CollisionLayers.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Enemy/cEnemy.Alien.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Enemy/cEnemy.Rock.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Enemy/cEnemyGenerator.h>
@@ -48,6 +49,8 @@ void ScrollShooterGame::cEnemyGenerator::Initialize(eae6320::Math::sVector i_pos
 	{
 		Physics::sColliderSetting setting_AABB;
 		setting_AABB.SettingForAABB(Math::sVector(m_width * -0.5f, -0.2f, -0.2f), Math::sVector(m_width * 0.5f, 0.2f, 0.2f));
+		setting_AABB.category = CollisionLayer::Generator;
+		setting_AABB.mask = CollisionLayer::GeneratorMask;
 		InitializeCollider(setting_AABB);
 	}
 
@@ -12,6 +12,7 @@
 
 #include <ScrollShooterGame_/ScrollShooterGame/Bullet/cBullet.Player.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Bullet/cBullet.Enemy.h>
+#include <ScrollShooterGame_/ScrollShooterGame/CollisionLayers.h>
 #include <ScrollShooterGame_/ScrollShooterGame/Enemy/cEnemy.h>
 #include <ScrollShooterGame_/ScrollShooterGame/cPlayer.h>
 #include <ScrollShooterGame_/ScrollShooterGame/cScrollShooterGame.h>
@@ -45,6 +46,8 @@ void ScrollShooterGame::cPlayer::Initialize(eae6320::Math::sVector i_position, e
 	{
 		Physics::sColliderSetting setting_AABB1;
 		setting_AABB1.SettingForAABB(Math::sVector(-0.9f, -0.9f, -0.9f), Math::sVector(0.9f, 0.9f, 0.9f));
+		setting_AABB1.category = CollisionLayer::Player;
+		setting_AABB1.mask = CollisionLayer::PlayerMask;
 		InitializeCollider(setting_AABB1);
 		InitializeColliderLine();
 	}
@@ -16,6 +16,7 @@
 // TODO: Tempory code for collider testing
 #include <Engine/UserOutput/UserOutput.h>
 #include <Engine/Physics/Collision.h>
+#include <Engine/Physics/Physics.h>
 
 #include <ScrollShooterGame_/ScrollShooterGame/cScrollShooterGame.h>
 
@@ -59,6 +60,8 @@ void ScrollShooterGame::cScrollShooterGame::UpdateSimulationBasedOnInput()
 
 void ScrollShooterGame::cScrollShooterGame::UpdateSimulationBasedOnTime(const float i_elapsedSecondCount_sinceLastUpdate)
 {
+	Physics::Update_Integration(i_elapsedSecondCount_sinceLastUpdate);
+
 	m_camera->UpdateBasedOnTime(i_elapsedSecondCount_sinceLastUpdate);
 
 	size_t listSize = m_gameObjectList.size();
@@ -96,7 +99,7 @@ void ScrollShooterGame::cScrollShooterGame::SubmitDataToBeRendered(
 		Graphics::SubmitBackgroundColor(0.5f, 0.5f, 0.5f);
 	}
 
-	// Submit normal render data - smart pointers
+	// Submit normal render data - render handles
 	{
 		size_t renderObjectNum = m_gameObjectList.size();
 		size_t arraySize = m_gameObjectList.size();
@@ -106,24 +109,16 @@ void ScrollShooterGame::cScrollShooterGame::SubmitDataToBeRendered(
 		// Render data of game objects
 		for (size_t i = 0; i < m_gameObjectList.size(); i++)
 		{
-			if (m_gameObjectList[i] == nullptr ||
-				m_gameObjectList[i]->GetMesh().expired() ||
-				m_gameObjectList[i]->GetEffect().expired())
+			if (m_gameObjectList[i] == nullptr)
 				continue;
 
 			normalRenderDataArray[i].Initialize(
-				m_gameObjectList[i]->GetMesh(), m_gameObjectList[i]->GetEffect(),
+				m_gameObjectList[i]->GetMeshHandle(), m_gameObjectList[i]->GetEffectHandle(),
 				m_gameObjectList[i]->GetPredictedTransform(i_elapsedSecondCount_sinceLastSimulationUpdate));
 		}
 
 		Graphics::SubmitNormalRenderData(normalRenderDataArray, static_cast<uint32_t>(arraySize));
 
-		// clean up 
-		for (size_t i = 0; i < arraySize; i++)
-		{
-			normalRenderDataArray[i].CleanUp();
-		}
-
 		delete[] normalRenderDataArray;
 	}
 
@@ -141,21 +136,12 @@ void ScrollShooterGame::cScrollShooterGame::SubmitDataToBeRendered(
 		int idx = 0;
 		for (auto iter = BVHRenderData.begin(); iter != BVHRenderData.end(); iter++)
 		{
-			if (iter->first.expired())
-				continue;
-
 			debugDataArray[idx].Initialize(iter->first, iter->second);
 			idx++;
 		}
 
 		Graphics::SubmitDebugRenderData(debugDataArray, static_cast<uint32_t>(totalArraySize));
 
-		// Clean up
-		for (size_t i = 0; i < totalArraySize; i++)
-		{
-			debugDataArray[i].CleanUp();
-		}
-
 		delete[] debugDataArray;
 	}
 }
@@ -309,7 +295,8 @@ void ScrollShooterGame::cScrollShooterGame::InitializeCollisionSystem()
 	colliderList.push_back(m_player->GetCollider());
 	colliderList.push_back(m_enemyGenerator->GetCollider());
 
-	Physics::Collision::Initialize(colliderList, Physics::Collision::BroadPhase_BVH | Physics::Collision::NarrowPhase_Overlaps);
+	// The playfield is bounded and everything in it is about the same size, which is what a uniform grid is good at
+	Physics::Collision::Initialize(colliderList, Physics::Collision::BroadPhase_SpatialHash | Physics::Collision::NarrowPhase_Overlaps);
 }
 
 
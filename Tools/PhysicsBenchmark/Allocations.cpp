@@ -0,0 +1,133 @@
+// Includes
+//=========
+
+#include "Allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Static Data
+//============
+
+namespace
+{
+	// The worker threads of the physics world allocate too, so the counters are shared
+	std::atomic<uint64_t> s_allocationCount(0);
+	std::atomic<uint64_t> s_byteCount(0);
+
+	void* Allocate(size_t i_size)
+	{
+		s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+		s_byteCount.fetch_add(i_size, std::memory_order_relaxed);
+
+		void* const memory = std::malloc(i_size > 0 ? i_size : 1);
+		if (memory == nullptr)
+			throw std::bad_alloc();
+
+		return memory;
+	}
+
+	void* AllocateAligned(size_t i_size, std::align_val_t i_alignment)
+	{
+		s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+		s_byteCount.fetch_add(i_size, std::memory_order_relaxed);
+
+		// aligned_alloc() wants the size to be a multiple of the alignment
+		const size_t alignment = static_cast<size_t>(i_alignment);
+		const size_t size = ((i_size > 0 ? i_size : 1) + alignment - 1) / alignment * alignment;
+
+		void* const memory = std::aligned_alloc(alignment, size);
+		if (memory == nullptr)
+			throw std::bad_alloc();
+
+		return memory;
+	}
+}
+
+// Interface
+//==========
+
+eae6320::PhysicsBenchmark::sAllocationCount eae6320::PhysicsBenchmark::GetAllocationCount()
+{
+	sAllocationCount count;
+	count.allocationCount = s_allocationCount.load(std::memory_order_relaxed);
+	count.byteCount = s_byteCount.load(std::memory_order_relaxed);
+
+	return count;
+}
+
+// Global Allocation Functions
+//============================
+
+void* operator new(size_t i_size)
+{
+	return Allocate(i_size);
+}
+
+void* operator new[](size_t i_size)
+{
+	return Allocate(i_size);
+}
+
+void* operator new(size_t i_size, const std::nothrow_t&) noexcept
+{
+	try { return Allocate(i_size); }
+	catch (...) { return nullptr; }
+}
+
+void* operator new[](size_t i_size, const std::nothrow_t&) noexcept
+{
+	try { return Allocate(i_size); }
+	catch (...) { return nullptr; }
+}
+
+void* operator new(size_t i_size, std::align_val_t i_alignment)
+{
+	return AllocateAligned(i_size, i_alignment);
+}
+
+void* operator new[](size_t i_size, std::align_val_t i_alignment)
+{
+	return AllocateAligned(i_size, i_alignment);
+}
+
+void operator delete(void* i_memory) noexcept
+{
+	std::free(i_memory);
+}
+
+void operator delete[](void* i_memory) noexcept
+{
+	std::free(i_memory);
+}
+
+void operator delete(void* i_memory, size_t) noexcept
+{
+	std::free(i_memory);
+}
+
+void operator delete[](void* i_memory, size_t) noexcept
+{
+	std::free(i_memory);
+}
+
+void operator delete(void* i_memory, std::align_val_t) noexcept
+{
+	std::free(i_memory);
+}
+
+void operator delete[](void* i_memory, std::align_val_t) noexcept
+{
+	std::free(i_memory);
+}
+
+void operator delete(void* i_memory, size_t, std::align_val_t) noexcept
+{
+	std::free(i_memory);
+}
+
+void operator delete[](void* i_memory, size_t, std::align_val_t) noexcept
+{
+	std::free(i_memory);
+}
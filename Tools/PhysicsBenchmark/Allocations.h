@@ -0,0 +1,31 @@
+/*
+	The benchmark replaces the global allocation functions so that it can count
+	how often a broad phase allocates while it runs
+*/
+
+#pragma once
+
+// Includes
+//=========
+
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+namespace PhysicsBenchmark
+{
+
+	struct sAllocationCount
+	{
+		uint64_t allocationCount = 0;
+		uint64_t byteCount = 0;
+	};
+
+	/* Allocations made by every thread since the program started */
+	sAllocationCount GetAllocationCount();
+
+}// Namespace PhysicsBenchmark
+}// Namespace eae6320
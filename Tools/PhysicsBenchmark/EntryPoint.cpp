@@ -0,0 +1,558 @@
+/*
+	Headless benchmark of the broad phases of the physics world
+
+	Every scene is built once per broad phase with the same seed and stepped for the same number of ticks,
+	timing the collision detection of each tick. The pairs whose world AABBs overlap have to be the same
+	for every broad phase at every tick, the program exits with 1 if they aren't.
+
+	With --integration the integration is timed instead: the rigid body pool, which packs the moving bodies
+	into arrays, integrates them and writes them back every tick, against calling sRigidBodyState::Update()
+	on every moving body the way each game object used to. Both have to end up with the same state at every tick
+*/
+
+// Includes
+//=========
+
+#include "Allocations.h"
+#include "cScene.h"
+
+#include <Engine/Physics/Collision.h>
+#include <Engine/Physics/cPhysicsWorld.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Static Data
+//============
+
+namespace
+{
+	struct sBroadPhase
+	{
+		const char* name;
+		uint8_t collisionType;
+	};
+
+	const sBroadPhase s_broadPhases[] =
+	{
+		{ "sap", eae6320::Physics::Collision::BroadPhase_SweepAndPrune },
+		{ "isap", eae6320::Physics::Collision::BroadPhase_IncrementalSweepAndPrune },
+		{ "bvh", eae6320::Physics::Collision::BroadPhase_BVH },
+		{ "hash", eae6320::Physics::Collision::BroadPhase_SpatialHash },
+	};
+	constexpr size_t s_broadPhaseCount = sizeof(s_broadPhases) / sizeof(s_broadPhases[0]);
+
+	constexpr float s_secondCountPerTick = 1.0f / 60.0f;
+
+	struct sOptions
+	{
+		std::vector<eae6320::PhysicsBenchmark::eSceneType> scenes;
+		std::vector<size_t> colliderCounts;
+		std::vector<size_t> broadPhases;
+
+		uint32_t tickCount = 60;
+		// Ticks stepped before timing starts, so that buffers have grown to their final size
+		uint32_t warmUpTickCount = 5;
+		uint32_t threadCount = 1;
+		uint32_t seed = 6320;
+		// Sweep and prune rebuilds its pair map every tick, which takes seconds per tick from 10000 colliders on
+		size_t sweepAndPruneLimit = 2000;
+		// Incremental sweep and prune inserts the whole scene with its insertion sort, which takes
+		// minutes from 50000 colliders on
+		size_t incrementalSweepAndPruneLimit = 20000;
+		bool outputCsv = false;
+		bool benchmarkIntegration = false;
+	};
+
+	struct sRunResult
+	{
+		double nanosecondsPerTick = 0.0;
+		double candidatePairsPerTick = 0.0;
+		double overlappingPairsPerTick = 0.0;
+		double allocationsPerTick = 0.0;
+		double bytesPerTick = 0.0;
+
+		eae6320::Physics::sBVHTreeQuality dynamicTree;
+		eae6320::Physics::sBVHTreeQuality staticTree;
+
+		// Digest of the overlapping pairs of every tick, compared across broad phases
+		std::vector<uint64_t> pairDigests;
+		std::vector<size_t> overlappingPairCounts;
+	};
+
+	struct sIntegrationResult
+	{
+		double nanosecondsPerTick_pool = 0.0;
+		double nanosecondsPerTick_perBody = 0.0;
+		double movingBodiesPerTick = 0.0;
+
+		// The first tick whose state differs between the two, or UINT32_MAX
+		uint32_t firstMismatchTick = UINT32_MAX;
+	};
+
+	void PrintUsage()
+	{
+		std::printf(
+			"Usage: PhysicsBenchmark [options]\n"
+			"  --scenes a,b,...       uniform, clustered, stream, static (default: all)\n"
+			"  --sizes n,m,...        collider counts (default: 100,1000,10000,100000)\n"
+			"  --broadphases a,b,...  sap, isap, bvh, hash (default: all)\n"
+			"  --ticks n              timed ticks per run (default: 60)\n"
+			"  --warmup n             untimed ticks before them (default: 5)\n"
+			"  --threads n            worker threads of the world, 0 uses every hardware thread (default: 1)\n"
+			"  --seed n               scene seed (default: 6320)\n"
+			"  --sap-limit n          skip sweep and prune above this many colliders (default: 2000)\n"
+			"  --isap-limit n         skip incremental sweep and prune above this many colliders (default: 20000)\n"
+			"  --integration          time the integration instead of the broad phases\n"
+			"  --csv                  print comma separated values\n");
+	}
+
+	std::vector<std::string> Split(const char* i_list)
+	{
+		std::vector<std::string> items;
+		std::string item;
+		for (const char* character = i_list; ; character++)
+		{
+			if (*character == ',' || *character == '\0')
+			{
+				if (item.empty() == false)
+					items.push_back(item);
+				item.clear();
+
+				if (*character == '\0')
+					break;
+			}
+			else
+			{
+				item.push_back(*character);
+			}
+		}
+
+		return items;
+	}
+
+	bool ParseOptions(int i_argumentCount, char** i_arguments, sOptions& o_options)
+	{
+		for (int i = 1; i < i_argumentCount; i++)
+		{
+			const char* const option = i_arguments[i];
+
+			if (std::strcmp(option, "--csv") == 0)
+			{
+				o_options.outputCsv = true;
+				continue;
+			}
+			if (std::strcmp(option, "--integration") == 0)
+			{
+				o_options.benchmarkIntegration = true;
+				continue;
+			}
+			if (std::strcmp(option, "--help") == 0 || i + 1 >= i_argumentCount)
+				return false;
+
+			const char* const value = i_arguments[++i];
+
+			if (std::strcmp(option, "--scenes") == 0)
+			{
+				o_options.scenes.clear();
+				for (const std::string& name : Split(value))
+				{
+					eae6320::PhysicsBenchmark::eSceneType type;
+					if (eae6320::PhysicsBenchmark::GetSceneType(name.c_str(), type) == false)
+						return false;
+					o_options.scenes.push_back(type);
+				}
+			}
+			else if (std::strcmp(option, "--sizes") == 0)
+			{
+				o_options.colliderCounts.clear();
+				for (const std::string& size : Split(value))
+				{
+					o_options.colliderCounts.push_back(std::strtoul(size.c_str(), nullptr, 10));
+				}
+			}
+			else if (std::strcmp(option, "--broadphases") == 0)
+			{
+				o_options.broadPhases.clear();
+				for (const std::string& name : Split(value))
+				{
+					size_t index = 0;
+					while (index < s_broadPhaseCount && name != s_broadPhases[index].name)
+						index++;
+					if (index == s_broadPhaseCount)
+						return false;
+					o_options.broadPhases.push_back(index);
+				}
+			}
+			else if (std::strcmp(option, "--ticks") == 0)
+				o_options.tickCount = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+			else if (std::strcmp(option, "--warmup") == 0)
+				o_options.warmUpTickCount = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+			else if (std::strcmp(option, "--threads") == 0)
+				o_options.threadCount = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+			else if (std::strcmp(option, "--seed") == 0)
+				o_options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+			else if (std::strcmp(option, "--sap-limit") == 0)
+				o_options.sweepAndPruneLimit = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(option, "--isap-limit") == 0)
+				o_options.incrementalSweepAndPruneLimit = std::strtoul(value, nullptr, 10);
+			else
+				return false;
+		}
+
+		if (o_options.scenes.empty())
+		{
+			for (size_t i = 0; i < static_cast<size_t>(eae6320::PhysicsBenchmark::eSceneType::Count); i++)
+				o_options.scenes.push_back(static_cast<eae6320::PhysicsBenchmark::eSceneType>(i));
+		}
+		if (o_options.colliderCounts.empty())
+			o_options.colliderCounts = { 100, 1000, 10000, 100000 };
+		if (o_options.broadPhases.empty())
+		{
+			for (size_t i = 0; i < s_broadPhaseCount; i++)
+				o_options.broadPhases.push_back(i);
+		}
+
+		return o_options.tickCount > 0;
+	}
+
+	bool IsOverlaps(const eae6320::Physics::cCollider* i_lhs, const eae6320::Physics::cCollider* i_rhs)
+	{
+		const eae6320::Math::sVector minExtent_lhs = i_lhs->GetMinExtent_world();
+		const eae6320::Math::sVector maxExtent_lhs = i_lhs->GetMaxExtent_world();
+		const eae6320::Math::sVector minExtent_rhs = i_rhs->GetMinExtent_world();
+		const eae6320::Math::sVector maxExtent_rhs = i_rhs->GetMaxExtent_world();
+
+		return maxExtent_lhs.x >= minExtent_rhs.x && maxExtent_rhs.x >= minExtent_lhs.x &&
+			maxExtent_lhs.y >= minExtent_rhs.y && maxExtent_rhs.y >= minExtent_lhs.y &&
+			maxExtent_lhs.z >= minExtent_rhs.z && maxExtent_rhs.z >= minExtent_lhs.z;
+	}
+
+	/* Digest of the candidates whose world AABBs overlap. Broad phases that pair fat AABBs report more
+	 * candidates, so only these are compared. Ids are never reused, so every run of a scene has its own
+	 * and they are taken relative to i_firstID. io_keys is scratch space kept across ticks */
+	uint64_t ComputePairDigest(const std::vector<std::pair<eae6320::Physics::cCollider*, eae6320::Physics::cCollider*>>& i_pairs,
+		uint32_t i_firstID, std::vector<uint64_t>& io_keys)
+	{
+		io_keys.clear();
+		for (const auto& pair : i_pairs)
+		{
+			if (IsOverlaps(pair.first, pair.second) == false)
+				continue;
+
+			const uint64_t id_lhs = pair.first->GetID() - i_firstID;
+			const uint64_t id_rhs = pair.second->GetID() - i_firstID;
+			io_keys.push_back((std::min(id_lhs, id_rhs) << 32) | std::max(id_lhs, id_rhs));
+		}
+		std::sort(io_keys.begin(), io_keys.end());
+
+		// FNV-1a
+		uint64_t digest = 14695981039346656037ull;
+		for (uint64_t key : io_keys)
+		{
+			for (int byte = 0; byte < 8; byte++)
+			{
+				digest ^= (key >> (byte * 8)) & 0xff;
+				digest *= 1099511628211ull;
+			}
+		}
+
+		return digest;
+	}
+
+	eae6320::cResult Run(eae6320::PhysicsBenchmark::eSceneType i_sceneType, size_t i_colliderCount,
+		const sBroadPhase& i_broadPhase, const sOptions& i_options, sRunResult& o_result)
+	{
+		// The world has to go before the scene that owns the colliders
+		eae6320::PhysicsBenchmark::cScene scene;
+		if (!scene.Initialize(i_sceneType, i_colliderCount, i_options.seed))
+			return eae6320::Results::Failure;
+
+		eae6320::Physics::cPhysicsWorld world;
+		world.SetThreadCount(i_options.threadCount);
+		scene.Register(world, i_broadPhase.collisionType | eae6320::Physics::Collision::NarrowPhase_Overlaps);
+
+		// The scene creates its colliders one after another, so their ids are consecutive
+		uint32_t firstID = UINT32_MAX;
+		for (const eae6320::Physics::cCollider* collider : scene.GetColliders())
+		{
+			firstID = std::min(firstID, collider->GetID());
+		}
+
+		std::vector<uint64_t> keys;
+		double nanosecondCount = 0.0;
+		size_t candidatePairCount = 0;
+		size_t overlappingPairCount = 0;
+		uint64_t allocationCount = 0;
+		uint64_t byteCount = 0;
+
+		const uint32_t totalTickCount = i_options.warmUpTickCount + i_options.tickCount;
+		o_result.pairDigests.reserve(totalTickCount);
+		o_result.overlappingPairCounts.reserve(totalTickCount);
+
+		for (uint32_t tick = 0; tick < totalTickCount; tick++)
+		{
+			// Contacts are never resolved, so the motion is the same for every broad phase
+			scene.Update(world);
+			world.Update_Integration(s_secondCountPerTick);
+
+			const eae6320::PhysicsBenchmark::sAllocationCount allocationsBefore = eae6320::PhysicsBenchmark::GetAllocationCount();
+			const auto timeBefore = std::chrono::steady_clock::now();
+
+			world.Update_CollisionDetection();
+
+			const auto timeAfter = std::chrono::steady_clock::now();
+			const eae6320::PhysicsBenchmark::sAllocationCount allocationsAfter = eae6320::PhysicsBenchmark::GetAllocationCount();
+
+			const auto& pairs = world.GetBroadPhasePairs();
+			o_result.pairDigests.push_back(ComputePairDigest(pairs, firstID, keys));
+			o_result.overlappingPairCounts.push_back(keys.size());
+
+			if (tick < i_options.warmUpTickCount)
+				continue;
+
+			nanosecondCount += std::chrono::duration<double, std::nano>(timeAfter - timeBefore).count();
+			candidatePairCount += pairs.size();
+			overlappingPairCount += keys.size();
+			allocationCount += allocationsAfter.allocationCount - allocationsBefore.allocationCount;
+			byteCount += allocationsAfter.byteCount - allocationsBefore.byteCount;
+		}
+
+		const double tickCount = static_cast<double>(i_options.tickCount);
+		o_result.nanosecondsPerTick = nanosecondCount / tickCount;
+		o_result.candidatePairsPerTick = static_cast<double>(candidatePairCount) / tickCount;
+		o_result.overlappingPairsPerTick = static_cast<double>(overlappingPairCount) / tickCount;
+		o_result.allocationsPerTick = static_cast<double>(allocationCount) / tickCount;
+		o_result.bytesPerTick = static_cast<double>(byteCount) / tickCount;
+
+		if (i_broadPhase.collisionType == eae6320::Physics::Collision::BroadPhase_BVH)
+		{
+			o_result.dynamicTree = world.GetDynamicBVHTreeQuality();
+			o_result.staticTree = world.GetStaticBVHTreeQuality();
+		}
+
+		return eae6320::Results::Success;
+	}
+
+	/* Both scenes are stepped the same way. The pool integrates one of them as part of its world, and the other
+	 * one is integrated body by body. Its world never integrates, it only recycles colliders and hashes the state */
+	eae6320::cResult RunIntegration(eae6320::PhysicsBenchmark::eSceneType i_sceneType, size_t i_colliderCount,
+		const sOptions& i_options, sIntegrationResult& o_result)
+	{
+		eae6320::PhysicsBenchmark::cScene scene_pool, scene_perBody;
+		if (!scene_pool.Initialize(i_sceneType, i_colliderCount, i_options.seed) ||
+			!scene_perBody.Initialize(i_sceneType, i_colliderCount, i_options.seed))
+			return eae6320::Results::Failure;
+
+		// The spatial hash is the cheapest broad phase to keep up to date
+		constexpr uint8_t collisionType = eae6320::Physics::Collision::BroadPhase_SpatialHash | eae6320::Physics::Collision::NarrowPhase_Overlaps;
+		eae6320::Physics::cPhysicsWorld world_pool, world_perBody;
+		world_pool.SetThreadCount(i_options.threadCount);
+		scene_pool.Register(world_pool, collisionType);
+		scene_perBody.Register(world_perBody, collisionType);
+
+		double nanosecondCount_pool = 0.0;
+		double nanosecondCount_perBody = 0.0;
+		size_t movingBodyCount = 0;
+
+		const uint32_t totalTickCount = i_options.warmUpTickCount + i_options.tickCount;
+		for (uint32_t tick = 0; tick < totalTickCount; tick++)
+		{
+			scene_pool.Update(world_pool);
+			scene_perBody.Update(world_perBody);
+
+			const auto timeBefore_pool = std::chrono::steady_clock::now();
+			world_pool.Update_Integration(s_secondCountPerTick);
+			const auto timeAfter_pool = std::chrono::steady_clock::now();
+
+			// Every game object used to integrate its own body in its update
+			size_t movingBodyCountOfTick = 0;
+			const auto timeBefore_perBody = std::chrono::steady_clock::now();
+			for (eae6320::Physics::cCollider* collider : scene_perBody.GetColliders())
+			{
+				eae6320::Physics::sRigidBodyState& rigidBody = *collider->m_objectRigidBody;
+				if (rigidBody.isStatic == false)
+				{
+					rigidBody.Update(s_secondCountPerTick);
+					movingBodyCountOfTick++;
+				}
+			}
+			const auto timeAfter_perBody = std::chrono::steady_clock::now();
+
+			world_pool.Update_CollisionDetection();
+			world_perBody.Update_CollisionDetection();
+
+			if ((o_result.firstMismatchTick == UINT32_MAX) && (world_pool.ComputeStateHash() != world_perBody.ComputeStateHash()))
+				o_result.firstMismatchTick = tick;
+
+			if (tick < i_options.warmUpTickCount)
+				continue;
+
+			nanosecondCount_pool += std::chrono::duration<double, std::nano>(timeAfter_pool - timeBefore_pool).count();
+			nanosecondCount_perBody += std::chrono::duration<double, std::nano>(timeAfter_perBody - timeBefore_perBody).count();
+			movingBodyCount += movingBodyCountOfTick;
+		}
+
+		const double tickCount = static_cast<double>(i_options.tickCount);
+		o_result.nanosecondsPerTick_pool = nanosecondCount_pool / tickCount;
+		o_result.nanosecondsPerTick_perBody = nanosecondCount_perBody / tickCount;
+		o_result.movingBodiesPerTick = static_cast<double>(movingBodyCount) / tickCount;
+
+		return eae6320::Results::Success;
+	}
+
+	void PrintIntegrationResult(const char* i_sceneName, size_t i_colliderCount, const sIntegrationResult& i_result, bool i_outputCsv)
+	{
+		const double speedUp = (i_result.nanosecondsPerTick_pool > 0.0) ?
+			i_result.nanosecondsPerTick_perBody / i_result.nanosecondsPerTick_pool : 0.0;
+
+		if (i_outputCsv)
+		{
+			std::printf("%s,%zu,%.1f,%.0f,%.0f,%.2f\n",
+				i_sceneName, i_colliderCount, i_result.movingBodiesPerTick,
+				i_result.nanosecondsPerTick_pool, i_result.nanosecondsPerTick_perBody, speedUp);
+		}
+		else
+		{
+			std::printf("%-10s %9zu %12.1f %14.0f %14.0f %8.2fx\n",
+				i_sceneName, i_colliderCount, i_result.movingBodiesPerTick,
+				i_result.nanosecondsPerTick_pool, i_result.nanosecondsPerTick_perBody, speedUp);
+		}
+		std::fflush(stdout);
+	}
+
+	void PrintResult(const char* i_sceneName, size_t i_colliderCount, const sBroadPhase& i_broadPhase, const sRunResult& i_result, bool i_outputCsv)
+	{
+		const bool hasTree = i_broadPhase.collisionType == eae6320::Physics::Collision::BroadPhase_BVH;
+
+		if (i_outputCsv)
+		{
+			std::printf("%s,%zu,%s,%.0f,%.1f,%.1f,%.2f,%.0f,%.2f,%d,%.2f,%d\n",
+				i_sceneName, i_colliderCount, i_broadPhase.name, i_result.nanosecondsPerTick,
+				i_result.candidatePairsPerTick, i_result.overlappingPairsPerTick, i_result.allocationsPerTick, i_result.bytesPerTick,
+				i_result.dynamicTree.totalSAHCost, i_result.dynamicTree.maxDepth, i_result.staticTree.totalSAHCost, i_result.staticTree.maxDepth);
+		}
+		else
+		{
+			std::printf("%-10s %9zu  %-5s %14.0f %12.1f %12.1f %10.2f %12.0f",
+				i_sceneName, i_colliderCount, i_broadPhase.name, i_result.nanosecondsPerTick,
+				i_result.candidatePairsPerTick, i_result.overlappingPairsPerTick, i_result.allocationsPerTick, i_result.bytesPerTick);
+			if (hasTree)
+			{
+				std::printf("   SAH %.1f/%.1f depth %d/%d",
+					i_result.dynamicTree.totalSAHCost, i_result.staticTree.totalSAHCost, i_result.dynamicTree.maxDepth, i_result.staticTree.maxDepth);
+			}
+			std::printf("\n");
+		}
+		std::fflush(stdout);
+	}
+}
+
+// Entry Point
+//============
+
+int main(int i_argumentCount, char** i_arguments)
+{
+	sOptions options;
+	if (ParseOptions(i_argumentCount, i_arguments, options) == false)
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	if (options.benchmarkIntegration)
+	{
+		if (options.outputCsv)
+			std::printf("scene,colliders,moving_bodies,pool_ns_per_tick,per_body_ns_per_tick,speed_up\n");
+		else
+			std::printf("%-10s %9s %12s %14s %14s %9s\n", "scene", "colliders", "moving", "pool ns/tick", "per body ns", "speed-up");
+
+		bool haveAllStatesMatched = true;
+		for (const auto sceneType : options.scenes)
+		{
+			for (const size_t colliderCount : options.colliderCounts)
+			{
+				sIntegrationResult result;
+				if (!RunIntegration(sceneType, colliderCount, options, result))
+					return 1;
+
+				PrintIntegrationResult(eae6320::PhysicsBenchmark::GetSceneName(sceneType), colliderCount, result, options.outputCsv);
+
+				if (result.firstMismatchTick != UINT32_MAX)
+				{
+					std::fprintf(stderr, "MISMATCH %s %zu: the pool and sRigidBodyState::Update() differ at tick %u\n",
+						eae6320::PhysicsBenchmark::GetSceneName(sceneType), colliderCount, result.firstMismatchTick);
+					haveAllStatesMatched = false;
+				}
+			}
+		}
+
+		return haveAllStatesMatched ? 0 : 1;
+	}
+
+	if (options.outputCsv)
+	{
+		std::printf("scene,colliders,broadphase,ns_per_tick,candidates_per_tick,overlaps_per_tick,allocations_per_tick,bytes_per_tick,"
+			"dynamic_sah,dynamic_depth,static_sah,static_depth\n");
+	}
+	else
+	{
+		std::printf("%-10s %9s  %-5s %14s %12s %12s %10s %12s   %s\n",
+			"scene", "colliders", "phase", "ns/tick", "candidates", "overlaps", "allocs", "bytes", "BVH dynamic/static");
+	}
+
+	bool haveAllPairSetsMatched = true;
+
+	for (const auto sceneType : options.scenes)
+	{
+		for (const size_t colliderCount : options.colliderCounts)
+		{
+			// The first broad phase that runs is the reference for the others
+			sRunResult reference;
+			const sBroadPhase* referenceBroadPhase = nullptr;
+
+			for (const size_t broadPhaseIndex : options.broadPhases)
+			{
+				const sBroadPhase& broadPhase = s_broadPhases[broadPhaseIndex];
+
+				if ((broadPhase.collisionType == eae6320::Physics::Collision::BroadPhase_SweepAndPrune && colliderCount > options.sweepAndPruneLimit) ||
+					(broadPhase.collisionType == eae6320::Physics::Collision::BroadPhase_IncrementalSweepAndPrune && colliderCount > options.incrementalSweepAndPruneLimit))
+					continue;
+
+				sRunResult result;
+				if (!Run(sceneType, colliderCount, broadPhase, options, result))
+					return 1;
+
+				PrintResult(eae6320::PhysicsBenchmark::GetSceneName(sceneType), colliderCount, broadPhase, result, options.outputCsv);
+
+				if (referenceBroadPhase == nullptr)
+				{
+					reference = std::move(result);
+					referenceBroadPhase = &broadPhase;
+					continue;
+				}
+
+				for (size_t tick = 0; tick < reference.pairDigests.size(); tick++)
+				{
+					if (result.pairDigests[tick] != reference.pairDigests[tick])
+					{
+						std::fprintf(stderr, "MISMATCH %s %zu: %s found %zu overlapping pairs at tick %zu, %s found %zu\n",
+							eae6320::PhysicsBenchmark::GetSceneName(sceneType), colliderCount,
+							broadPhase.name, result.overlappingPairCounts[tick], tick,
+							referenceBroadPhase->name, reference.overlappingPairCounts[tick]);
+						haveAllPairSetsMatched = false;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	return haveAllPairSetsMatched ? 0 : 1;
+}
@@ -0,0 +1,59 @@
+/*
+	Headless stand-in for Engine/GameObject/cGameObject.h
+
+	Colliders keep a weak link to the game object that owns them, and only ask it for its
+	rigid body and whether it is active. The benchmark owns one of these per collider
+*/
+
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/Physics/cColliderBase.h>
+#include <Engine/Physics/cRigidBody.h>
+
+#include <memory>
+
+
+namespace eae6320
+{
+
+	class cGameObject
+	{
+
+	// Interface
+	//=========================
+
+	public:
+
+		// Property Getters
+		//--------------------------
+
+		bool IsActive() { return m_active; }
+
+		Physics::sRigidBodyState& GetRigidBody() { return m_rigidBody; }
+
+		Physics::cCollider* GetCollider() const { return m_collider; }
+
+		// Property Setters
+		//--------------------------
+
+		void SetActive(bool i_active) { m_active = i_active; }
+
+		void SetCollider(Physics::cCollider* i_collider) { m_collider = i_collider; }
+
+
+	// Data
+	//=========================
+
+	private:
+
+		Physics::sRigidBodyState m_rigidBody;
+
+		Physics::cCollider* m_collider = nullptr;
+
+		bool m_active = true;
+	};
+
+}
@@ -0,0 +1,58 @@
+/*
+	Headless stand-in for Engine/Graphics/Graphics.h
+
+	The physics library only uses the graphics interface to create and release the debug
+	lines of the BVH tree. The benchmark has no renderer, so it declares just those functions
+	and Headless.cpp implements them without creating anything
+*/
+
+#ifndef EAE6320_GRAPHICS_H
+#define EAE6320_GRAPHICS_H
+
+// Includes
+//=========
+
+#include <Engine/Graphics/VertexFormats.h>
+#include <Engine/Results/Results.h>
+
+#include <cstdint>
+#include <memory>
+
+// Windows Types
+//==============
+
+#if !defined( EAE6320_PLATFORM_WINDOWS )
+	typedef unsigned long DWORD;
+	#define INFINITE 0xFFFFFFFF
+	#define WAIT_OBJECT_0 0x00000000L
+#endif
+
+// Interface
+//==========
+
+namespace eae6320
+{
+namespace Graphics
+{
+	class cLine;
+
+	// Render Objects Initialization / Clean Up
+	//-------
+
+	DWORD AcquireRenderObjectInitMutex(DWORD i_waitTime_MS = INFINITE);
+
+	void ReleaseRenderObjectInitMutex();
+
+	DWORD AcquireRenderObjectCleanUpMutex(DWORD i_waitTime_MS = INFINITE);
+
+	void ReleaseRenderObjectCleanUpMutex();
+
+	void AddLineInitializeTask(std::shared_ptr<cLine>& i_linePtr,
+		VertexFormats::sVertex_line i_vertexData[], const uint32_t i_vertexCount,
+		uint16_t i_indexData[], const uint32_t i_indexCount);
+
+	void AddLineCleanUpTask(std::shared_ptr<cLine> i_line);
+}
+}
+
+#endif	// EAE6320_GRAPHICS_H
@@ -0,0 +1,83 @@
+/*
+	Headless implementations of the engine functions that the physics library calls
+	outside of Engine/Physics and Engine/Math
+*/
+
+// Includes
+//=========
+
+#include <Engine/Graphics/Graphics.h>
+#include <Engine/Logging/Logging.h>
+
+#include <cstdarg>
+#include <cstdio>
+
+// Graphics
+//=========
+
+// There is no render thread to share the render objects with, so the mutexes are always free
+// and the debug lines of the BVH tree are never created
+
+DWORD eae6320::Graphics::AcquireRenderObjectInitMutex(DWORD)
+{
+	return WAIT_OBJECT_0;
+}
+
+void eae6320::Graphics::ReleaseRenderObjectInitMutex()
+{
+}
+
+DWORD eae6320::Graphics::AcquireRenderObjectCleanUpMutex(DWORD)
+{
+	return WAIT_OBJECT_0;
+}
+
+void eae6320::Graphics::ReleaseRenderObjectCleanUpMutex()
+{
+}
+
+void eae6320::Graphics::AddLineInitializeTask(std::shared_ptr<cLine>&,
+	VertexFormats::sVertex_line[], const uint32_t, uint16_t[], const uint32_t)
+{
+}
+
+void eae6320::Graphics::AddLineCleanUpTask(std::shared_ptr<cLine>)
+{
+}
+
+// Logging
+//========
+
+// Messages go to the standard streams instead of a log file
+
+eae6320::cResult eae6320::Logging::OutputMessage(const char* const i_message, ...)
+{
+	va_list arguments;
+	va_start(arguments, i_message);
+	std::vprintf(i_message, arguments);
+	va_end(arguments);
+	std::printf("\n");
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Logging::OutputError(const char* const i_errorMessage, ...)
+{
+	va_list arguments;
+	va_start(arguments, i_errorMessage);
+	std::vfprintf(stderr, i_errorMessage, arguments);
+	va_end(arguments);
+	std::fprintf(stderr, "\n");
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Logging::Initialize()
+{
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Logging::CleanUp()
+{
+	return Results::Success;
+}
@@ -0,0 +1,402 @@
+// Includes
+//=========
+
+#include "cScene.h"
+
+#include <Engine/Logging/Logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Static Data
+//============
+
+namespace
+{
+	const char* const s_sceneNames[] = { "uniform", "clustered", "stream", "static" };
+
+	// The layers of ScrollShooterGame/CollisionLayers.h, the benchmark can't include game code
+	namespace CollisionLayer
+	{
+		constexpr uint32_t Player		= 1 << 0;
+		constexpr uint32_t PlayerBullet	= 1 << 1;
+		constexpr uint32_t Enemy		= 1 << 2;
+		constexpr uint32_t EnemyBullet	= 1 << 3;
+		constexpr uint32_t Generator	= 1 << 4;
+
+		constexpr uint32_t PlayerMask		= Enemy | EnemyBullet;
+		constexpr uint32_t PlayerBulletMask	= Enemy | EnemyBullet;
+		constexpr uint32_t EnemyMask		= Player | PlayerBullet | Enemy | EnemyBullet;
+		constexpr uint32_t EnemyBulletMask	= Player | PlayerBullet | Enemy;
+		constexpr uint32_t GeneratorMask	= 0;
+	}
+
+	// Colliders per group in the clustered scene
+	constexpr size_t s_clusterSize = 256;
+
+	eae6320::Physics::sColliderSetting MakeSphere(float i_radius, uint32_t i_category = 1, uint32_t i_mask = 0xffffffff)
+	{
+		eae6320::Physics::sColliderSetting setting;
+		setting.SettingForSphere(eae6320::Math::sVector(), i_radius);
+		setting.category = i_category;
+		setting.mask = i_mask;
+		return setting;
+	}
+
+	eae6320::Physics::sColliderSetting MakeBox(const eae6320::Math::sVector& i_halfSize, uint32_t i_category = 1, uint32_t i_mask = 0xffffffff)
+	{
+		eae6320::Physics::sColliderSetting setting;
+		setting.SettingForAABB(-i_halfSize, i_halfSize);
+		setting.category = i_category;
+		setting.mask = i_mask;
+		return setting;
+	}
+
+	// Turn the velocity around on every axis on which the body left the box and still moves away from it
+	void Bounce(eae6320::Physics::sRigidBodyState& io_rigidBody, const eae6320::Math::sVector& i_min, const eae6320::Math::sVector& i_max)
+	{
+		float* const position = &io_rigidBody.position.x;
+		float* const velocity = &io_rigidBody.velocity.x;
+		const float* const minBound = &i_min.x;
+		const float* const maxBound = &i_max.x;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if ((position[axis] < minBound[axis] && velocity[axis] < 0.0f) || (position[axis] > maxBound[axis] && velocity[axis] > 0.0f))
+				velocity[axis] = -velocity[axis];
+		}
+	}
+}
+
+// Scene Types
+//============
+
+const char* eae6320::PhysicsBenchmark::GetSceneName(eSceneType i_type)
+{
+	return (i_type < eSceneType::Count) ? s_sceneNames[static_cast<size_t>(i_type)] : "unknown";
+}
+
+
+bool eae6320::PhysicsBenchmark::GetSceneType(const char* i_name, eSceneType& o_type)
+{
+	for (size_t i = 0; i < static_cast<size_t>(eSceneType::Count); i++)
+	{
+		if (std::strcmp(i_name, s_sceneNames[i]) == 0)
+		{
+			o_type = static_cast<eSceneType>(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Interface
+//==========
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::PhysicsBenchmark::cScene::Initialize(eSceneType i_type, size_t i_colliderCount, uint32_t i_seed)
+{
+	m_type = i_type;
+	// The generator gets stuck at 0
+	m_randomState = (i_seed != 0) ? i_seed : 1;
+
+	m_gameObjects.reserve(i_colliderCount);
+	m_colliders.reserve(i_colliderCount);
+	m_anchors.reserve(i_colliderCount);
+
+	switch (i_type)
+	{
+	case eSceneType::Uniform:
+		InitializeUniform(i_colliderCount);
+		break;
+	case eSceneType::Clustered:
+		InitializeClustered(i_colliderCount);
+		break;
+	case eSceneType::Stream:
+		InitializeStream(i_colliderCount);
+		break;
+	case eSceneType::MostlyStatic:
+		InitializeMostlyStatic(i_colliderCount);
+		break;
+	default:
+		Logging::OutputError("PhysicsBenchmark: Unknown scene type %u", static_cast<unsigned int>(i_type));
+		return Results::Failure;
+	}
+
+	if (m_colliders.size() != i_colliderCount)
+	{
+		Logging::OutputError("PhysicsBenchmark: Created %zu of %zu colliders", m_colliders.size(), i_colliderCount);
+		return Results::Failure;
+	}
+
+	return Results::Success;
+}
+
+
+void eae6320::PhysicsBenchmark::cScene::Register(Physics::cPhysicsWorld& io_world, uint8_t i_collisionType)
+{
+	for (const auto& gameObject : m_gameObjects)
+	{
+		io_world.RegisterRigidBody(&gameObject->GetRigidBody());
+	}
+
+	io_world.Initialize(m_colliders, i_collisionType);
+}
+
+
+eae6320::PhysicsBenchmark::cScene::~cScene()
+{
+	// Colliders are owned by their game objects in the engine, here the scene owns both
+	for (Physics::cCollider* collider : m_colliders)
+		delete collider;
+}
+
+// Update
+//--------------------------
+
+void eae6320::PhysicsBenchmark::cScene::Update(Physics::cPhysicsWorld& io_world)
+{
+	for (size_t i = 0; i < m_colliders.size(); i++)
+	{
+		Physics::cCollider* const collider = m_colliders[i];
+		Physics::sRigidBodyState& rigidBody = *collider->m_objectRigidBody;
+
+		if (rigidBody.isStatic)
+			continue;
+
+		switch (m_type)
+		{
+		case eSceneType::Clustered:
+		{
+			Bounce(rigidBody, m_anchors[i] - m_anchorRadius, m_anchors[i] + m_anchorRadius);
+			break;
+		}
+		case eSceneType::Stream:
+		{
+			Bounce(rigidBody, m_minBound, m_maxBound);
+
+			// Bullets and enemies that left the band are despawned and come back in at the other end,
+			// the way the game spawns new ones
+			const float width = m_maxBound.x - m_minBound.x;
+			const bool isOut = (rigidBody.position.x > m_maxBound.x && rigidBody.velocity.x > 0.0f) ||
+				(rigidBody.position.x < m_minBound.x && rigidBody.velocity.x < 0.0f);
+
+			if (isOut)
+			{
+				io_world.DeregisterCollider(collider);
+
+				rigidBody.position.x += (rigidBody.velocity.x > 0.0f) ? -width : width;
+				rigidBody.position.y = GetRandom(m_minBound.y, m_maxBound.y);
+
+				io_world.RegisterCollider(collider);
+			}
+			break;
+		}
+		default:
+		{
+			Bounce(rigidBody, m_minBound, m_maxBound);
+			break;
+		}
+		}
+	}
+}
+
+// Property Getters
+//--------------------------
+
+const std::vector<eae6320::Physics::cCollider*>& eae6320::PhysicsBenchmark::cScene::GetColliders() const
+{
+	return m_colliders;
+}
+
+// Implementation
+//===============
+
+float eae6320::PhysicsBenchmark::cScene::GetRandom()
+{
+	// xorshift32
+	m_randomState ^= m_randomState << 13;
+	m_randomState ^= m_randomState >> 17;
+	m_randomState ^= m_randomState << 5;
+
+	return static_cast<float>(m_randomState >> 8) * (1.0f / 16777216.0f);
+}
+
+
+float eae6320::PhysicsBenchmark::cScene::GetRandom(float i_min, float i_max)
+{
+	return i_min + (i_max - i_min) * GetRandom();
+}
+
+
+float eae6320::PhysicsBenchmark::cScene::GetRandomNormal()
+{
+	// The sum of uniform numbers is close enough to normal for placing colliders
+	return (GetRandom() + GetRandom() + GetRandom() + GetRandom() - 2.0f) * std::sqrt(3.0f);
+}
+
+
+void eae6320::PhysicsBenchmark::cScene::AddCollider(const Physics::sColliderSetting& i_setting, const Math::sVector& i_position,
+	const Math::sVector& i_velocity, bool i_isStatic, bool i_isTrigger)
+{
+	auto gameObject = std::make_shared<cGameObject>();
+
+	Physics::sRigidBodyState& rigidBody = gameObject->GetRigidBody();
+	rigidBody.position = i_position;
+	rigidBody.velocity = i_isStatic ? Math::sVector() : i_velocity;
+	rigidBody.isStatic = i_isStatic;
+	rigidBody.isTrigger = i_isTrigger;
+
+	Physics::cCollider* collider = nullptr;
+	Physics::cCollider::Create(collider, i_setting, gameObject);
+	if (collider == nullptr)
+		return;
+
+	gameObject->SetCollider(collider);
+
+	m_gameObjects.push_back(gameObject);
+	m_colliders.push_back(collider);
+	m_anchors.push_back(i_position);
+}
+
+
+void eae6320::PhysicsBenchmark::cScene::InitializeUniform(size_t i_colliderCount)
+{
+	// About one collider per 8 cubic units
+	const float size = std::cbrt(static_cast<float>(i_colliderCount) * 8.0f);
+	m_minBound = Math::sVector(0.0f, 0.0f, 0.0f);
+	m_maxBound = Math::sVector(size, size, size);
+
+	for (size_t i = 0; i < i_colliderCount; i++)
+	{
+		const Math::sVector position(GetRandom(0.0f, size), GetRandom(0.0f, size), GetRandom(0.0f, size));
+		const Math::sVector velocity(GetRandom(-2.0f, 2.0f), GetRandom(-2.0f, 2.0f), GetRandom(-2.0f, 2.0f));
+
+		if (i % 2 == 0)
+			AddCollider(MakeSphere(GetRandom(0.25f, 0.75f)), position, velocity, false, false);
+		else
+			AddCollider(MakeBox(Math::sVector(GetRandom(0.25f, 0.75f), GetRandom(0.25f, 0.75f), GetRandom(0.25f, 0.75f))),
+				position, velocity, false, false);
+	}
+}
+
+
+void eae6320::PhysicsBenchmark::cScene::InitializeClustered(size_t i_colliderCount)
+{
+	// One in a hundred colliders is large and wanders between the clusters
+	const size_t largeCount = i_colliderCount / 100;
+	const size_t smallCount = i_colliderCount - largeCount;
+	const size_t clusterCount = (smallCount + s_clusterSize - 1) / s_clusterSize;
+
+	// The clusters fill an eighth of the volume of the uniform scene
+	const float size = std::cbrt(static_cast<float>(i_colliderCount) * 64.0f);
+	const float clusterSpread = 2.0f;
+	m_minBound = Math::sVector(0.0f, 0.0f, 0.0f);
+	m_maxBound = Math::sVector(size, size, size);
+	m_anchorRadius = 3.0f * clusterSpread;
+
+	for (size_t cluster = 0; cluster < clusterCount; cluster++)
+	{
+		const Math::sVector center(GetRandom(0.0f, size), GetRandom(0.0f, size), GetRandom(0.0f, size));
+		const size_t end = std::min((cluster + 1) * s_clusterSize, smallCount);
+
+		for (size_t i = cluster * s_clusterSize; i < end; i++)
+		{
+			const Math::sVector position = center +
+				Math::sVector(GetRandomNormal(), GetRandomNormal(), GetRandomNormal()) * clusterSpread;
+			const Math::sVector velocity(GetRandom(-1.0f, 1.0f), GetRandom(-1.0f, 1.0f), GetRandom(-1.0f, 1.0f));
+
+			if (i % 2 == 0)
+				AddCollider(MakeSphere(GetRandom(0.1f, 0.3f)), position, velocity, false, false);
+			else
+				AddCollider(MakeBox(Math::sVector(GetRandom(0.1f, 0.3f), GetRandom(0.1f, 0.3f), GetRandom(0.1f, 0.3f))),
+					position, velocity, false, false);
+
+			// Bodies bounce back toward the center of their cluster, not toward where they started
+			m_anchors.back() = center;
+		}
+	}
+
+	for (size_t i = 0; i < largeCount; i++)
+	{
+		const Math::sVector position(GetRandom(0.0f, size), GetRandom(0.0f, size), GetRandom(0.0f, size));
+		const Math::sVector velocity(GetRandom(-0.5f, 0.5f), GetRandom(-0.5f, 0.5f), GetRandom(-0.5f, 0.5f));
+
+		AddCollider(MakeBox(Math::sVector(GetRandom(4.0f, 8.0f), GetRandom(4.0f, 8.0f), GetRandom(4.0f, 8.0f))),
+			position, velocity, false, false);
+	}
+}
+
+
+void eae6320::PhysicsBenchmark::cScene::InitializeStream(size_t i_colliderCount)
+{
+	// A band four times as wide as it is high with about one collider per 2 square units
+	const float width = std::sqrt(static_cast<float>(i_colliderCount) * 8.0f);
+	const float height = width / 4.0f;
+	m_minBound = Math::sVector(0.0f, 0.0f, -0.5f);
+	m_maxBound = Math::sVector(width, height, 0.5f);
+
+	const size_t generatorCount = std::max<size_t>(i_colliderCount / 1000, 1);
+	const size_t enemyCount = i_colliderCount / 5;
+	const size_t playerBulletCount = (i_colliderCount - generatorCount - enemyCount - 1) / 2;
+	const size_t enemyBulletCount = i_colliderCount - generatorCount - enemyCount - playerBulletCount - 1;
+
+	// The player moves up and down at the left end of the band
+	AddCollider(MakeBox(Math::sVector(0.5f, 0.5f, 0.5f), CollisionLayer::Player, CollisionLayer::PlayerMask),
+		Math::sVector(width * 0.1f, height * 0.5f, 0.0f), Math::sVector(0.0f, 4.0f, 0.0f), false, false);
+
+	for (size_t i = 0; i < generatorCount; i++)
+	{
+		AddCollider(MakeBox(Math::sVector(1.0f, 1.0f, 1.0f), CollisionLayer::Generator, CollisionLayer::GeneratorMask),
+			Math::sVector(width + 2.0f, GetRandom(0.0f, height), 0.0f), Math::sVector(), true, true);
+	}
+
+	for (size_t i = 0; i < enemyCount; i++)
+	{
+		AddCollider(MakeBox(Math::sVector(0.4f, 0.4f, 0.4f), CollisionLayer::Enemy, CollisionLayer::EnemyMask),
+			Math::sVector(GetRandom(0.0f, width), GetRandom(0.0f, height), 0.0f),
+			Math::sVector(-GetRandom(1.0f, 3.0f), GetRandom(-1.0f, 1.0f), 0.0f), false, false);
+	}
+
+	for (size_t i = 0; i < playerBulletCount; i++)
+	{
+		AddCollider(MakeSphere(0.1f, CollisionLayer::PlayerBullet, CollisionLayer::PlayerBulletMask),
+			Math::sVector(GetRandom(0.0f, width), GetRandom(0.0f, height), 0.0f), Math::sVector(15.0f, 0.0f, 0.0f), false, true);
+	}
+
+	for (size_t i = 0; i < enemyBulletCount; i++)
+	{
+		AddCollider(MakeSphere(0.15f, CollisionLayer::EnemyBullet, CollisionLayer::EnemyBulletMask),
+			Math::sVector(GetRandom(0.0f, width), GetRandom(0.0f, height), 0.0f),
+			Math::sVector(-8.0f, GetRandom(-0.5f, 0.5f), 0.0f), false, true);
+	}
+}
+
+
+void eae6320::PhysicsBenchmark::cScene::InitializeMostlyStatic(size_t i_colliderCount)
+{
+	// A floor of about 6 square units per collider, with boxes up to 3 units high
+	const float size = std::sqrt(static_cast<float>(i_colliderCount) * 6.0f);
+	m_minBound = Math::sVector(0.0f, 0.0f, 0.0f);
+	m_maxBound = Math::sVector(size, 4.0f, size);
+
+	const size_t dynamicCount = i_colliderCount / 10;
+	const size_t staticCount = i_colliderCount - dynamicCount;
+
+	for (size_t i = 0; i < staticCount; i++)
+	{
+		AddCollider(MakeBox(Math::sVector(GetRandom(0.5f, 2.0f), GetRandom(0.25f, 1.5f), GetRandom(0.5f, 2.0f))),
+			Math::sVector(GetRandom(0.0f, size), GetRandom(0.0f, 3.0f), GetRandom(0.0f, size)), Math::sVector(), true, false);
+	}
+
+	for (size_t i = 0; i < dynamicCount; i++)
+	{
+		AddCollider(MakeSphere(GetRandom(0.3f, 0.6f)),
+			Math::sVector(GetRandom(0.0f, size), GetRandom(0.0f, 4.0f), GetRandom(0.0f, size)),
+			Math::sVector(GetRandom(-3.0f, 3.0f), GetRandom(-0.5f, 0.5f), GetRandom(-3.0f, 3.0f)), false, false);
+	}
+}
@@ -0,0 +1,137 @@
+/*
+	A synthetic scene of colliders that moves the same way every time it is built with the same seed.
+	Collisions are never resolved, so the motion doesn't depend on the broad phase and every broad
+	phase sees exactly the same colliders at every tick
+*/
+
+#pragma once
+
+// Includes
+//=========
+
+#include <Engine/GameObject/cGameObject.h>
+#include <Engine/Math/sVector.h>
+#include <Engine/Physics/cColliderBase.h>
+#include <Engine/Physics/cPhysicsWorld.h>
+#include <Engine/Results/Results.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Scene Types
+//============
+
+namespace eae6320
+{
+namespace PhysicsBenchmark
+{
+
+	enum class eSceneType : uint8_t
+	{
+		// Spheres and boxes of similar size spread evenly over a cube, bouncing off its walls
+		Uniform,
+		// Dense groups of small colliders far apart from each other, with a few large ones in between
+		Clustered,
+		// A thin band like the scroll shooter: bullets of both sides streaming across, enemies drifting
+		// against them and a few static generators. Colliders that leave the band are deregistered and
+		// registered again on the other side
+		Stream,
+		// Static level geometry with a tenth of the colliders moving through it
+		MostlyStatic,
+
+		Count
+	};
+
+	const char* GetSceneName(eSceneType i_type);
+
+	/* Returns false if the name isn't one of the names above */
+	bool GetSceneType(const char* i_name, eSceneType& o_type);
+
+}// Namespace PhysicsBenchmark
+}// Namespace eae6320
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+namespace PhysicsBenchmark
+{
+
+	class cScene
+	{
+		// Interface
+		//=========================
+
+	public:
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		cResult Initialize(eSceneType i_type, size_t i_colliderCount, uint32_t i_seed);
+
+		/* Register every body and collider with the world and run its first collision detection.
+		 * The world must be destroyed before the scene */
+		void Register(Physics::cPhysicsWorld& io_world, uint8_t i_collisionType);
+
+		cScene() = default;
+		~cScene();
+
+		cScene(const cScene&) = delete;
+		cScene& operator =(const cScene&) = delete;
+
+		// Update
+		//--------------------------
+
+		/* Steer the bodies before the world integrates them, and recycle the ones that left the scene */
+		void Update(Physics::cPhysicsWorld& io_world);
+
+		// Property Getters
+		//--------------------------
+
+		const std::vector<Physics::cCollider*>& GetColliders() const;
+
+
+		// Implementation
+		//=========================
+
+	private:
+
+		/* Uniform float in [0, 1) that doesn't depend on the standard library */
+		float GetRandom();
+		float GetRandom(float i_min, float i_max);
+		/* Roughly normal with a standard deviation of 1 */
+		float GetRandomNormal();
+
+		void AddCollider(const Physics::sColliderSetting& i_setting, const Math::sVector& i_position,
+			const Math::sVector& i_velocity, bool i_isStatic, bool i_isTrigger);
+
+		void InitializeUniform(size_t i_colliderCount);
+		void InitializeClustered(size_t i_colliderCount);
+		void InitializeStream(size_t i_colliderCount);
+		void InitializeMostlyStatic(size_t i_colliderCount);
+
+
+		// Data
+		//=========================
+
+	private:
+
+		eSceneType m_type = eSceneType::Uniform;
+		uint32_t m_randomState = 0;
+
+		// Moving bodies bounce back into this box, or are recycled at its other end in the stream scene
+		Math::sVector m_minBound;
+		Math::sVector m_maxBound;
+
+		std::vector<std::shared_ptr<cGameObject>> m_gameObjects;
+		std::vector<Physics::cCollider*> m_colliders;
+
+		// Where each body bounces back to in the clustered scene
+		std::vector<Math::sVector> m_anchors;
+		float m_anchorRadius = 0.0f;
+	};
+
+}// Namespace PhysicsBenchmark
+}// Namespace eae6320